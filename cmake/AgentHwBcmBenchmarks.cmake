@@ -39,6 +39,22 @@ target_link_libraries(bcm_ecmp_shrink_with_competing_route_updates_speed
   Folly::follybenchmark
 )
 
+add_executable(bcm_rib_pipelined_route_update_speed /dev/null)
+
+target_link_libraries(bcm_rib_pipelined_route_update_speed
+  -Wl,--whole-archive
+  bcm
+  config
+  bcm_switch_ensemble
+  config_factory
+  hw_rib_pipelined_route_update_speed
+  -Wl,--no-whole-archive
+  hw_benchmark_main
+  ${OPENNSA}
+  Folly::folly
+  Folly::follybenchmark
+)
+
 add_executable(bcm_fsw_scale_route_add_speed /dev/null)
 
 target_link_libraries(bcm_fsw_scale_route_add_speed
@@ -218,6 +234,15 @@ target_link_libraries(bcm_stats_collection_speed
   -Wl,--no-whole-archive
 )
 
+add_executable(bcm_warm_boot_state_speed /dev/null)
+
+target_link_libraries(bcm_warm_boot_state_speed
+  -Wl,--whole-archive
+  bcm_switch_ensemble
+  hw_warm_boot_state_speed
+  -Wl,--no-whole-archive
+)
+
 add_executable(bcm_tx_slow_path_rate /dev/null)
 
 target_link_libraries(bcm_tx_slow_path_rate
@@ -340,6 +365,7 @@ target_link_libraries(bcm_rib_sync_fib_speed
 if (BENCHMARK_INSTALL)
   install(TARGETS bcm_ecmp_shrink_speed)
   install(TARGETS bcm_ecmp_shrink_with_competing_route_updates_speed)
+  install(TARGETS bcm_rib_pipelined_route_update_speed)
   install(TARGETS bcm_fsw_scale_route_add_speed)
   install(TARGETS bcm_fsw_scale_route_del_speed)
   install(TARGETS bcm_th_alpm_scale_route_add_speed)
@@ -351,6 +377,7 @@ if (BENCHMARK_INSTALL)
   install(TARGETS bcm_stats_collection_speed)
   install(TARGETS bcm_tx_slow_path_rate)
   install(TARGETS bcm_warm_boot_exit_speed)
+  install(TARGETS bcm_warm_boot_state_speed)
   install(TARGETS bcm_rx_slow_path_rate)
   install(TARGETS bcm_init_and_exit_40Gx10G)
   install(TARGETS bcm_init_and_exit_100Gx10G)
@@ -25,6 +25,20 @@ target_link_libraries(hw_warm_boot_exit_speed
   Folly::folly
 )
 
+add_library(hw_warm_boot_state_speed
+  fboss/agent/hw/benchmarks/HwWarmbootStateBenchmark.cpp
+)
+
+target_link_libraries(hw_warm_boot_state_speed
+  config_factory
+  hw_switch_ensemble
+  hw_switch_warmboot_helper
+  route_scale_gen
+  hw_benchmark_main
+  Folly::folly
+  Folly::follybenchmark
+)
+
 add_library(hw_stats_collection_speed
   fboss/agent/hw/benchmarks/HwStatsCollectionBenchmark.cpp
 )
@@ -189,14 +203,27 @@ target_link_libraries(hw_ecmp_shrink_with_competing_route_updates_speed
   Folly::folly
 )
 
+add_library(hw_rib_pipelined_route_update_speed
+  fboss/agent/hw/benchmarks/HwRibPipelinedRouteUpdateBenchmark.cpp
+)
+
+target_link_libraries(hw_rib_pipelined_route_update_speed
+  route_distribution_gen
+  config_factory
+  hw_benchmark_main
+  Folly::folly
+)
+
 add_library(hw_rx_slow_path_rate
   fboss/agent/hw/benchmarks/HwRxSlowPathBenchmark.cpp
 )
 
 target_link_libraries(hw_rx_slow_path_rate
   config_factory
+  core
   hw_packet_utils
   ecmp_helper
+  pkt
   Folly::folly
 )
 
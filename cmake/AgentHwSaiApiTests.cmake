@@ -29,6 +29,7 @@ add_executable(api_test
     fboss/agent/hw/sai/api/tests/QueueApiTest.cpp
     fboss/agent/hw/sai/api/tests/RouteApiTest.cpp
     fboss/agent/hw/sai/api/tests/RouterInterfaceApiTest.cpp
+    fboss/agent/hw/sai/api/tests/SaiApiLockTest.cpp
     fboss/agent/hw/sai/api/tests/SamplePacketApiTest.cpp
     fboss/agent/hw/sai/api/tests/SchedulerApiTest.cpp
     fboss/agent/hw/sai/api/tests/SwitchApiTest.cpp
@@ -52,3 +53,20 @@ set_target_properties(api_test PROPERTIES COMPILE_FLAGS
 )
 
 gtest_discover_tests(api_test)
+
+add_executable(sai_api_lock_benchmark
+    fboss/agent/hw/sai/api/tests/SaiApiLockBenchmark.cpp
+)
+
+target_link_libraries(sai_api_lock_benchmark
+    fake_sai
+    sai_api
+    Folly::folly
+    Folly::follybenchmark
+)
+
+set_target_properties(sai_api_lock_benchmark PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
@@ -6,6 +6,64 @@
 # NOTE: All the benchmark executables need to link in ${SAI_IMPL_ARG}
 # using '--whole-archive' flag in order to ensure SAI_IMPL symbols are included
 
+add_library(sai_rx_packet_speed
+  fboss/agent/hw/sai/benchmarks/SaiRxPacketBenchmark.cpp
+)
+
+target_link_libraries(sai_rx_packet_speed
+  config_factory
+  sai_switch # //fboss/agent/hw/sai/switch:sai_switch
+  trunk_utils
+  hw_benchmark_main
+  Folly::folly
+  Folly::follybenchmark
+)
+
+set_target_properties(sai_rx_packet_speed PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
+
+add_library(sai_store_memory
+  fboss/agent/hw/sai/benchmarks/SaiStoreMemoryBenchmark.cpp
+)
+
+target_link_libraries(sai_store_memory
+  config_factory
+  route_distribution_gen
+  sai_switch # //fboss/agent/hw/sai/switch:sai_switch
+  hw_benchmark_main
+  Folly::folly
+  Folly::follybenchmark
+)
+
+set_target_properties(sai_store_memory PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
+
+add_library(sai_tracer_route_programming
+  fboss/agent/hw/sai/benchmarks/SaiTracerRouteProgrammingBenchmark.cpp
+)
+
+target_link_libraries(sai_tracer_route_programming
+  config_factory
+  route_distribution_gen
+  sai_switch # //fboss/agent/hw/sai/switch:sai_switch
+  sai_tracer
+  hw_benchmark_main
+  Folly::folly
+  Folly::follybenchmark
+)
+
+set_target_properties(sai_tracer_route_programming PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
+
 function(BUILD_SAI_BENCHMARKS SAI_IMPL_NAME SAI_IMPL_ARG)
 
   message(STATUS "Building SAI benchmarks SAI_IMPL_NAME: ${SAI_IMPL_NAME} SAI_IMPL_ARG: ${SAI_IMPL_ARG}")
@@ -206,6 +264,24 @@ function(BUILD_SAI_BENCHMARKS SAI_IMPL_NAME SAI_IMPL_ARG)
     -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
   )
 
+  add_executable(sai_warm_boot_state_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX} /dev/null)
+
+  target_link_libraries(sai_warm_boot_state_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    -Wl,--whole-archive
+    sai_switch_ensemble
+    hw_warm_boot_state_speed
+    route_scale_gen
+    ${SAI_IMPL_ARG}
+    -Wl,--no-whole-archive
+  )
+
+  set_target_properties(sai_warm_boot_state_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    PROPERTIES COMPILE_FLAGS
+    "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+    -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+    -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+  )
+
   add_executable(sai_tx_slow_path_rate-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX} /dev/null)
 
   target_link_libraries(sai_tx_slow_path_rate-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
@@ -278,6 +354,23 @@ function(BUILD_SAI_BENCHMARKS SAI_IMPL_NAME SAI_IMPL_ARG)
     -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
   )
 
+  add_executable(sai_rib_pipelined_route_update_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX} /dev/null)
+
+  target_link_libraries(sai_rib_pipelined_route_update_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    -Wl,--whole-archive
+    sai_switch_ensemble
+    hw_rib_pipelined_route_update_speed
+    ${SAI_IMPL_ARG}
+    -Wl,--no-whole-archive
+  )
+
+  set_target_properties(sai_rib_pipelined_route_update_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    PROPERTIES COMPILE_FLAGS
+    "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+    -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+    -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+  )
+
   add_executable(sai_rx_slow_path_rate-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX} /dev/null)
 
   target_link_libraries(sai_rx_slow_path_rate-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
@@ -424,6 +517,57 @@ function(BUILD_SAI_BENCHMARKS SAI_IMPL_NAME SAI_IMPL_ARG)
     -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
   )
 
+  add_executable(sai_rx_packet_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX} /dev/null)
+
+  target_link_libraries(sai_rx_packet_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    -Wl,--whole-archive
+    sai_switch_ensemble
+    sai_rx_packet_speed
+    ${SAI_IMPL_ARG}
+    -Wl,--no-whole-archive
+  )
+
+  set_target_properties(sai_rx_packet_speed-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    PROPERTIES COMPILE_FLAGS
+    "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+    -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+    -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+  )
+
+  add_executable(sai_store_memory-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX} /dev/null)
+
+  target_link_libraries(sai_store_memory-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    -Wl,--whole-archive
+    sai_switch_ensemble
+    sai_store_memory
+    ${SAI_IMPL_ARG}
+    -Wl,--no-whole-archive
+  )
+
+  set_target_properties(sai_store_memory-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    PROPERTIES COMPILE_FLAGS
+    "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+    -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+    -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+  )
+
+  add_executable(sai_tracer_route_programming-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX} /dev/null)
+
+  target_link_libraries(sai_tracer_route_programming-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    -Wl,--whole-archive
+    sai_switch_ensemble
+    sai_tracer_route_programming
+    ${SAI_IMPL_ARG}
+    -Wl,--no-whole-archive
+  )
+
+  set_target_properties(sai_tracer_route_programming-${SAI_IMPL_NAME}-${SAI_VER_SUFFIX}
+    PROPERTIES COMPILE_FLAGS
+    "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+    -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+    -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+  )
+
 endfunction()
 
 if(BUILD_SAI_FAKE_BENCHMARKS)
@@ -455,6 +599,9 @@ if(SAI_IMPL AND BENCHMARK_INSTALL)
   install(
     TARGETS
     sai_ecmp_shrink_with_competing_route_updates_speed-sai_impl-${SAI_VER_SUFFIX})
+  install(
+    TARGETS
+    sai_rib_pipelined_route_update_speed-sai_impl-${SAI_VER_SUFFIX})
   install(
     TARGETS
     sai_th_alpm_scale_route_del_speed-sai_impl-${SAI_VER_SUFFIX})
@@ -473,6 +620,9 @@ if(SAI_IMPL AND BENCHMARK_INSTALL)
   install(
     TARGETS
     sai_warm_boot_exit_speed-sai_impl-${SAI_VER_SUFFIX})
+  install(
+    TARGETS
+    sai_warm_boot_state_speed-sai_impl-${SAI_VER_SUFFIX})
   install(
     TARGETS
     sai_tx_slow_path_rate-sai_impl-${SAI_VER_SUFFIX})
@@ -497,4 +647,13 @@ if(SAI_IMPL AND BENCHMARK_INSTALL)
   install(
     TARGETS
     sai_rib_resolution_speed-sai_impl-${SAI_VER_SUFFIX})
+  install(
+    TARGETS
+    sai_rx_packet_speed-sai_impl-${SAI_VER_SUFFIX})
+  install(
+    TARGETS
+    sai_store_memory-sai_impl-${SAI_VER_SUFFIX})
+  install(
+    TARGETS
+    sai_tracer_route_programming-sai_impl-${SAI_VER_SUFFIX})
 endif()
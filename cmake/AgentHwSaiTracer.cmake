@@ -23,6 +23,7 @@ add_library(sai_tracer
   fboss/agent/hw/sai/tracer/QueueApiTracer.cpp
   fboss/agent/hw/sai/tracer/RouteApiTracer.cpp
   fboss/agent/hw/sai/tracer/RouterInterfaceApiTracer.cpp
+  fboss/agent/hw/sai/tracer/SaiTraceRecord.cpp
   fboss/agent/hw/sai/tracer/SaiTracer.cpp
   fboss/agent/hw/sai/tracer/SamplePacketApiTracer.cpp
   fboss/agent/hw/sai/tracer/SchedulerApiTracer.cpp
@@ -57,3 +58,20 @@ target_link_options(sai_tracer
   "LINKER:-wrap,sai_api_initialize"
   "LINKER:-wrap,sai_get_object_key"
 )
+
+# Generates the replayer source out of a binary trace, no SAI calls are made
+add_executable(sai_trace_to_c
+  fboss/agent/hw/sai/tracer/SaiTraceToC.cpp
+)
+
+target_link_libraries(sai_trace_to_c
+  sai_tracer
+  fake_sai
+  Folly::folly
+)
+
+set_target_properties(sai_trace_to_c PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
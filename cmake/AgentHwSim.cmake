@@ -0,0 +1,20 @@
+# CMake to build libraries and binaries in fboss/agent/hw/sim
+
+# In general, libraries and binaries in fboss/foo/bar are built by
+# cmake/FooBar.cmake
+
+add_library(hw_sim
+  fboss/agent/hw/sim/SimPlatform.cpp
+  fboss/agent/hw/sim/SimPlatformMapping.cpp
+  fboss/agent/hw/sim/SimPlatformPort.cpp
+  fboss/agent/hw/sim/SimSwitch.cpp
+)
+
+target_link_libraries(hw_sim
+  core
+  handler
+  platform_mapping
+  product_info
+  pkt
+  Folly::folly
+)
@@ -5,6 +5,8 @@
 
 add_library(standalone_rib
   fboss/agent/rib/ConfigApplier.cpp
+  fboss/agent/rib/LpmSnapshot.cpp
+  fboss/agent/rib/RouteDependencyIndex.cpp
   fboss/agent/rib/RouteUpdater.cpp
   fboss/agent/rib/RoutingInformationBase.cpp
 )
@@ -0,0 +1,29 @@
+# CMake to build libraries and binaries in fboss/agent/rib/test
+
+# In general, libraries and binaries in fboss/foo/bar are built by
+# cmake/FooBar.cmake
+
+add_executable(rib_lpm_test
+  fboss/agent/test/oss/Main.cpp
+  fboss/agent/rib/test/RibLpmTests.cpp
+)
+
+target_link_libraries(rib_lpm_test
+  fib_updater
+  standalone_rib
+  utils
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+gtest_discover_tests(rib_lpm_test)
+
+add_executable(lpm_snapshot_benchmark
+  fboss/agent/rib/test/LpmSnapshotBenchmark.cpp
+)
+
+target_link_libraries(lpm_snapshot_benchmark
+  standalone_rib
+  Folly::folly
+  Folly::follybenchmark
+)
@@ -36,6 +36,7 @@ add_library(state
   fboss/agent/state/NdpTable.cpp
   fboss/agent/state/NeighborResponseTable.cpp
   fboss/agent/state/NodeBase.cpp
+  fboss/agent/state/NodeJsonPath.cpp
   fboss/agent/state/Port.cpp
   fboss/agent/state/PortMap.cpp
   fboss/agent/state/PortQueue.cpp
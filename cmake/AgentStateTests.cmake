@@ -0,0 +1,31 @@
+# CMake to build libraries and binaries in fboss/agent/state/tests
+
+# In general, libraries and binaries in fboss/foo/bar are built by
+# cmake/FooBar.cmake
+
+add_executable(persistent_map_test
+  fboss/agent/test/oss/Main.cpp
+  fboss/agent/state/tests/PersistentMapTests.cpp
+)
+
+target_link_libraries(persistent_map_test
+  Folly::folly
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+gtest_discover_tests(persistent_map_test)
+
+add_executable(node_json_path_test
+  fboss/agent/test/oss/Main.cpp
+  fboss/agent/state/tests/NodeJsonPathTests.cpp
+)
+
+target_link_libraries(node_json_path_test
+  agent_test_utils
+  state
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+gtest_discover_tests(node_json_path_test)
@@ -83,6 +83,37 @@ target_link_libraries(async_logger_test
 
 gtest_discover_tests(async_logger_test)
 
+add_executable(node_map_container_benchmark
+  fboss/agent/test/NodeMapContainerBenchmark.cpp
+)
+
+target_link_libraries(node_map_container_benchmark
+  Folly::folly
+  Folly::follybenchmark
+)
+
+add_executable(fib_delta_benchmark
+  fboss/agent/test/FibDeltaBenchmark.cpp
+)
+
+target_link_libraries(fib_delta_benchmark
+  state
+  Folly::folly
+  Folly::follybenchmark
+)
+
+add_executable(tun_intf_benchmark
+  fboss/agent/test/TunIntfBenchmark.cpp
+)
+
+target_link_libraries(tun_intf_benchmark
+  core
+  hw_sim
+  pkt
+  Folly::folly
+  Folly::follybenchmark
+)
+
 add_library(agent_test_lib
   fboss/agent/test/AgentTest.cpp
 )
@@ -8,6 +8,8 @@
  *
  */
 
+#include <sys/uio.h>
+#include <array>
 #include <cstdlib>
 #include <exception>
 #include <fstream>
@@ -26,13 +28,56 @@ DEFINE_bool(
     false,
     "Flag to indicate whether to disable async logging and directly write into the file");
 
-enum BufferToWrite { BUFFER0, BUFFER1 };
+DEFINE_bool(
+    async_logger_drop_on_overflow,
+    false,
+    "Drop logs rather than waiting for them to be written out when the async "
+    "logger buffer is full");
+
+namespace {
+
+/*
+ * Segment state packs, in one word so that it is updated with a single CAS:
+ *  - the number of bytes reserved in the segment,
+ *  - whether the segment is sealed, i.e. full and to be written out,
+ *  - the lap of the ring the segment is used for, so that a logger racing
+ *    with the segment being written out and reused does not append to it.
+ */
+constexpr uint64_t kSealed = 1ULL << 32;
+constexpr auto kLapShift = 33;
+
+uint64_t segmentOffset(uint64_t state) {
+  return state & (kSealed - 1);
+}
+
+bool segmentSealed(uint64_t state) {
+  return state & kSealed;
+}
+
+uint64_t segmentLap(uint64_t state) {
+  return state >> kLapShift;
+}
+
+uint64_t lapOf(uint64_t segment) {
+  return (segment / facebook::fboss::AsyncLogger::kNumSegments) &
+      ((1ULL << (64 - kLapShift)) - 1);
+}
+
+struct Segment {
+  std::atomic<uint64_t> state{0};
+  // Bytes copied into the segment
+  std::atomic<uint64_t> committed{0};
+  std::array<char, facebook::fboss::AsyncLogger::kBufferSize> data;
+};
+
+} // namespace
 
 static std::string exitFilePath;
-static uint32_t offset = 0;
-static BufferToWrite currentBuffer = BUFFER0;
-static std::array<char, facebook::fboss::AsyncLogger::kBufferSize> buffer0;
-static std::array<char, facebook::fboss::AsyncLogger::kBufferSize> buffer1;
+static std::array<Segment, facebook::fboss::AsyncLogger::kNumSegments> segments;
+// Segment being logged to
+static std::atomic<uint64_t> headSegment{0};
+// Next segment to write out
+static std::atomic<uint64_t> tailSegment{0};
 
 static std::mutex bootTypeLatch_;
 
@@ -41,20 +86,29 @@ namespace {
 constexpr auto kBuildRevision = "build_revision";
 constexpr auto kSdkVersion = "SDK Version";
 
+Segment& segmentAt(uint64_t segment) {
+  return segments[segment % facebook::fboss::AsyncLogger::kNumSegments];
+}
+
 void terminateHandler() {
-  if (offset > 0) {
-    // Use standard library instead of folly because in unclean exit, folly
-    // library could be inaccessible so there's a higher chance of writing into
-    // file using standard library.
-    std::ofstream logfile;
-    logfile.open(exitFilePath, std::ofstream::app);
-
-    if (currentBuffer == BUFFER0) {
-      logfile.write(buffer0.data(), offset);
-    } else {
-      logfile.write(buffer1.data(), offset);
+  // Use standard library instead of folly because in unclean exit, folly
+  // library could be inaccessible so there's a higher chance of writing into
+  // file using standard library.
+  std::ofstream logfile;
+  uint64_t bytesWritten = 0;
+  for (auto segment = tailSegment.load(); segment <= headSegment.load();
+       ++segment) {
+    auto size = segmentAt(segment).committed.load();
+    if (size > 0) {
+      if (!logfile.is_open()) {
+        logfile.open(exitFilePath, std::ofstream::app);
+      }
+      logfile.write(segmentAt(segment).data.data(), size);
+      bytesWritten += size;
     }
-    std::cerr << "Async logger exit with " << offset
+  }
+  if (bytesWritten > 0) {
+    std::cerr << "Async logger exit with " << bytesWritten
               << " bytes written to file " << std::endl;
   }
 
@@ -79,13 +133,10 @@ AsyncLogger::AsyncLogger(
     std::string filePath,
     uint32_t logTimeout,
     LoggerSrcType srcType)
-    : bufferSize_(AsyncLogger::kBufferSize), srcType_(srcType) {
+    : srcType_(srcType) {
   openLogFile(filePath);
 
   if (!FLAGS_disable_async_logger) {
-    logBuffer_ = buffer0.data();
-    flushBuffer_ = buffer1.data();
-
     exitFilePath = filePath;
 
     logTimeout_ = std::chrono::milliseconds(logTimeout);
@@ -104,51 +155,138 @@ void AsyncLogger::setBootType(bool canWarmBoot) {
 }
 
 void AsyncLogger::worker_thread() {
-  while (enableLogging_) {
+  while (true) {
     std::unique_lock<std::mutex> lock(latch_);
 
-    // Wait for either 1. Timeout 2. Force flush or full flush
-    cv_.wait_for(lock, logTimeout_, [this] {
-      return this->forceFlush_ || this->fullFlush_;
+    // Wait for either 1. Timeout 2. Force flush or full segment 3. Stop
+    bool timedOut = !cv_.wait_for(lock, logTimeout_, [this] {
+      return this->flushRequested_ != this->flushDone_ ||
+          !this->enableLogging_ ||
+          segmentSealed(segmentAt(tailSegment).state.load());
     });
+    auto flushRequested = flushRequested_;
+    bool stopping = !enableLogging_;
+    bool flushAll = timedOut || stopping || flushRequested != flushDone_;
+    lock.unlock();
 
-    // Swap log buffer and flush buffer
-    char* writeBuffer = logBuffer_;
-    uint32_t currSize = offset;
-    offset = 0;
-    currentBuffer = ((currentBuffer == BUFFER0) ? BUFFER1 : BUFFER0);
-    logBuffer_ = flushBuffer_;
-
-    if (fullFlush_) {
-      fullFlush_ = false;
+    // Write content in full segments to file, along with the current one if
+    // not waiting for it to fill up
+    auto lastSegment = flushAll ? headSegment.load() : tailSegment.load();
+    while (true) {
+      if (flushAll) {
+        sealSegment(lastSegment);
+      }
+      if (writeSegments() == 0 || tailSegment > lastSegment) {
+        break;
+      }
     }
 
+    // Notify force flush that write completes
+    lock.lock();
+    flushDone_ = flushRequested;
     lock.unlock();
-    cv_.notify_one();
-
-    // Write content in swap buffer to file
-    if (currSize > 0) {
-      flushCount_++;
-      auto bytesWritten = logFile_.withWLock([&](auto& lockedFile) {
-        return folly::writeFull(lockedFile.fd(), writeBuffer, currSize);
-      });
-
-      if (bytesWritten < 0) {
-        throw SysError(
-            errno, "error writing ", currSize, " bytes to log file.");
-      }
+    cv_.notify_all();
+
+    if (stopping) {
+      break;
     }
+  }
+}
 
-    memset(writeBuffer, 0, bufferSize_);
-    flushBuffer_ = writeBuffer;
+void AsyncLogger::sealSegment(uint64_t segment) {
+  auto& seg = segmentAt(segment);
+  auto state = seg.state.load();
+  while (segmentLap(state) == lapOf(segment) && !segmentSealed(state) &&
+         segmentOffset(state) > 0) {
+    if (seg.state.compare_exchange_weak(state, state | kSealed)) {
+      advanceHead(segment);
+      return;
+    }
+  }
+}
 
-    // Notify force flush that write completes
-    if (forceFlush_) {
-      forceFlush_ = false;
-      promise_.set_value(0);
-      promise_ = std::promise<int>();
+bool AsyncLogger::advanceHead(uint64_t head) {
+  // The next segment is still to be written out
+  if (head + 1 - tailSegment >= kNumSegments) {
+    return false;
+  }
+  if (headSegment.compare_exchange_strong(head, head + 1)) {
+    // Wake up the flush thread and loggers waiting for a segment
+    { std::lock_guard<std::mutex> lock(latch_); }
+    cv_.notify_all();
+  }
+  return true;
+}
+
+bool AsyncLogger::waitForSegment(uint64_t head) {
+  if (FLAGS_async_logger_drop_on_overflow &&
+      head + 1 - tailSegment >= kNumSegments && headSegment == head) {
+    return false;
+  }
+  std::unique_lock<std::mutex> lock(latch_);
+  cv_.wait(lock, [this, head] {
+    return headSegment != head || !this->enableLogging_;
+  });
+  return enableLogging_;
+}
+
+size_t AsyncLogger::writeSegments() {
+  std::array<iovec, kNumSegments> iov;
+  auto tail = tailSegment.load();
+  size_t numSegments = 0;
+  uint64_t totalSize = 0;
+  for (; numSegments < kNumSegments; ++numSegments) {
+    auto segment = tail + numSegments;
+    auto& seg = segmentAt(segment);
+    auto state = seg.state.load();
+    if (!segmentSealed(state) || segmentLap(state) != lapOf(segment)) {
+      break;
+    }
+    // Loggers may still be copying their logs into the segment
+    auto size = segmentOffset(state);
+    while (seg.committed.load(std::memory_order_acquire) < size) {
+      std::this_thread::yield();
+    }
+    iov[numSegments].iov_base = seg.data.data();
+    iov[numSegments].iov_len = size;
+    totalSize += size;
+  }
+  if (numSegments == 0) {
+    return 0;
+  }
+
+  auto bytesWritten = logFile_.withWLock([&](auto& lockedFile) {
+    return folly::writevFull(lockedFile.fd(), iov.data(), numSegments);
+  });
+  if (bytesWritten < 0) {
+    throw SysError(errno, "error writing ", totalSize, " bytes to log file.");
+  }
+  flushCount_ += numSegments;
+
+  // Hand the segments over to the next lap of the ring
+  for (size_t i = 0; i < numSegments; ++i) {
+    auto segment = tail + i;
+    auto& seg = segmentAt(segment);
+    seg.committed = 0;
+    seg.state = lapOf(segment + kNumSegments) << kLapShift;
+  }
+  auto newTail = tail + numSegments;
+  tailSegment = newTail;
+
+  auto head = headSegment.load();
+  if (head < newTail) {
+    // The current segment filled up while the ring was full and has just been
+    // written out along with the others, move loggers on to the new tail
+    while (head < newTail &&
+           !headSegment.compare_exchange_weak(head, newTail)) {
     }
+    { std::lock_guard<std::mutex> lock(latch_); }
+    cv_.notify_all();
+  } else if (segmentSealed(segmentAt(head).state.load())) {
+    // The current segment may have filled up while the ring was full
+    advanceHead(head);
   }
+  return numSegments;
 }
 
 void AsyncLogger::startFlushThread() {
@@ -158,12 +296,18 @@ void AsyncLogger::startFlushThread() {
   }
   // Write new boot header and the current time whenever a cold/warm boot
   // happens
-  writeNewBootHeader();
+  if (srcType_ != SAI_REPLAYER_BINARY) {
+    writeNewBootHeader();
+  }
 }
 
 void AsyncLogger::stopFlushThread() {
   if (!FLAGS_disable_async_logger && enableLogging_) {
-    enableLogging_ = false;
+    {
+      std::lock_guard<std::mutex> lock(latch_);
+      enableLogging_ = false;
+    }
+    cv_.notify_all();
     flushThread_->join();
     delete flushThread_;
   }
@@ -171,58 +315,66 @@ void AsyncLogger::stopFlushThread() {
 
 void AsyncLogger::forceFlush() {
   if (!FLAGS_disable_async_logger) {
-    future_ = promise_.get_future();
-
-    forceFlush_ = true;
-    cv_.notify_one();
+    std::unique_lock<std::mutex> lock(latch_);
+    auto request = ++flushRequested_;
+    cv_.notify_all();
 
     // Wait for flush to complete
-    future_.get();
+    cv_.wait(lock, [this, request] {
+      return this->flushDone_ >= request || !this->enableLogging_;
+    });
+  }
+}
+
+void AsyncLogger::writeToFile(const char* logRecord, size_t logSize) {
+  auto bytesWritten = logFile_.withWLock([&](auto& lockedFile) {
+    return folly::writeFull(lockedFile.fd(), logRecord, logSize);
+  });
+
+  if (bytesWritten < 0) {
+    throw SysError(errno, "error writing ", logSize, " bytes to log file.");
   }
 }
 
 void AsyncLogger::appendLog(const char* logRecord, size_t logSize) {
-  if (!enableLogging_) {
+  if (!enableLogging_ || logSize == 0) {
     return;
   }
 
-  if (FLAGS_disable_async_logger && logSize > 0) {
-    auto bytesWritten = logFile_.withWLock([&](auto& lockedFile) {
-      return folly::writeFull(lockedFile.fd(), logRecord, logSize);
-    });
-
-    if (bytesWritten < 0) {
-      throw SysError(errno, "error writing ", logSize, " bytes to log file.");
-    }
+  if (FLAGS_disable_async_logger) {
+    writeToFile(logRecord, logSize);
     return;
   }
 
-  // Acquire the lock and check if there's enough space in the buffer
-  latch_.lock();
-
-  if (logSize + offset >= bufferSize_) {
-    // Release the lock and notify worker thread to flush logs
-    fullFlush_ = true;
-    latch_.unlock();
-    cv_.notify_one();
-
-    // Wait for worker to finish
-    std::unique_lock<std::mutex> lock(latch_);
-    cv_.wait(lock, [logSize] {
-      return logSize + offset < AsyncLogger::kBufferSize;
-    });
-
-    // Write to buffer
-    memcpy(logBuffer_ + offset, logRecord, logSize);
-    offset += logSize;
-
-    lock.unlock();
-  } else {
-    // Directly write to buffer
-    memcpy(logBuffer_ + offset, logRecord, logSize);
-    offset += logSize;
+  if (logSize > kBufferSize) {
+    // Too large for a segment, write it out after the logs before it
+    forceFlush();
+    writeToFile(logRecord, logSize);
+    return;
+  }
 
-    latch_.unlock();
+  while (true) {
+    auto head = headSegment.load();
+    auto& seg = segmentAt(head);
+    auto state = seg.state.load();
+    // Reserve space in the segment, or seal it if the log does not fit
+    while (segmentLap(state) == lapOf(head) && !segmentSealed(state)) {
+      auto offset = segmentOffset(state);
+      if (offset + logSize > kBufferSize) {
+        if (seg.state.compare_exchange_weak(state, state | kSealed)) {
+          advanceHead(head);
+          break;
+        }
+      } else if (seg.state.compare_exchange_weak(state, state + logSize)) {
+        memcpy(seg.data.data() + offset, logRecord, logSize);
+        seg.committed.fetch_add(logSize, std::memory_order_release);
+        return;
+      }
+    }
+    if (!waitForSegment(head)) {
+      droppedCount_++;
+      return;
+    }
   }
 }
 
@@ -239,6 +391,9 @@ void AsyncLogger::openLogFile(std::string& filePath) {
     case (SAI_REPLAYER):
       srcTypeStr = "Sai Replayer";
       break;
+    case (SAI_REPLAYER_BINARY):
+      srcTypeStr = "Sai Replayer binary";
+      break;
   }
   try {
     if (filePath.find("/var/facebook/logs/fboss/sdk/") == 0) {
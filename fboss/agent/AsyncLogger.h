@@ -10,10 +10,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
-#include <future>
 #include <mutex>
+#include <thread>
 
 #include <folly/File.h>
 #include <folly/Synchronized.h>
@@ -22,7 +23,8 @@ namespace facebook::fboss {
 
 class AsyncLogger {
  public:
-  enum LoggerSrcType { BCM_CINTER, SAI_REPLAYER };
+  // SAI_REPLAYER_BINARY logs are not text, they get no boot header
+  enum LoggerSrcType { BCM_CINTER, SAI_REPLAYER, SAI_REPLAYER_BINARY };
   explicit AsyncLogger(
       std::string filePath,
       uint32_t logTimeout,
@@ -44,8 +46,16 @@ class AsyncLogger {
    * number that's not introducing too much memory overhead (roughly 0.035% of
    * current prod usage), but still perform well in frequent updates and
    * benchmark tests.
+   *
+   * The buffer is a ring of kNumSegments segments of kBufferSize bytes.
+   * Loggers reserve space in the current segment without taking any lock and
+   * move on to the next segment once it is full, while the flush thread
+   * writes full segments out. Loggers only wait for the flush thread when
+   * all segments are full, or drop their log with
+   * --async_logger_drop_on_overflow.
    */
   static auto constexpr kBufferSize = 409600;
+  static auto constexpr kNumSegments = 4;
 
   void startFlushThread();
   void stopFlushThread();
@@ -56,29 +66,38 @@ class AsyncLogger {
   static void setBootType(bool canWarmBoot);
 
   // Expose these variables for testing purpose
+  // Number of segments written out
   uint32_t getFlushCount() {
     return flushCount_;
   }
 
+  uint32_t getDroppedCount() {
+    return droppedCount_;
+  }
+
  private:
   std::atomic_uint32_t flushCount_{0};
+  std::atomic_uint32_t droppedCount_{0};
   void worker_thread();
   void openLogFile(std::string& file_path);
   void writeNewBootHeader();
+  void writeToFile(const char* logRecord, size_t logSize);
 
-  std::atomic_bool forceFlush_{false};
-  bool fullFlush_{false};
-  std::atomic_bool enableLogging_{false};
-
-  uint32_t bufferSize_;
+  // Segment ring helpers, segments are numbered from the start of the ring
+  void sealSegment(uint64_t segment);
+  bool advanceHead(uint64_t head);
+  bool waitForSegment(uint64_t head);
+  size_t writeSegments();
 
-  char* logBuffer_;
-  char* flushBuffer_;
+  std::atomic_bool enableLogging_{false};
 
   LoggerSrcType srcType_;
 
-  std::promise<int> promise_;
-  std::future<int> future_;
+  // Flushes requested by forceFlush() and completed by the flush thread
+  uint64_t flushRequested_{0};
+  uint64_t flushDone_{0};
+
+  // Only taken to wait for the flush thread, or to wake it or its waiters up
   std::mutex latch_;
   std::thread* flushThread_;
   std::condition_variable cv_;
@@ -870,8 +870,8 @@ void LookupClassRouteUpdater::processRouteChanged(
      * processRouteRemoved does not schedule state update, so the only
      * additional overhead of this approach is some local computation.
      */
-    if ((oldRoute->getForwardInfo().getNextHopSet() !=
-         newRoute->getForwardInfo().getNextHopSet()) ||
+    if ((oldRoute->getForwardInfo().getNextHopSetPtr() !=
+         newRoute->getForwardInfo().getNextHopSetPtr()) ||
         (oldRoute->getClassID() != newRoute->getClassID())) {
       processRouteRemoved(stateDelta, rid, oldRoute);
       processRouteAdded(stateDelta, rid, newRoute);
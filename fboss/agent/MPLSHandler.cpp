@@ -82,6 +82,8 @@ void MPLSHandler::popLabelAndLookup(
         << "MPLS packet did not contain v4 or v6 IP packet";
     return;
   }
+  // the ethertype changed underneath the cached header
+  pkt->invalidateL2Header();
   // schedule v4 or v6 packet to be handled as usual
   sw_->packetReceived(std::move(pkt));
 }
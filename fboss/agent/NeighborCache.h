@@ -17,12 +17,19 @@
 #include <folly/IPAddress.h>
 #include <folly/MacAddress.h>
 #include <folly/Memory.h>
+#include <folly/TokenBucket.h>
 #include <folly/io/async/EventBase.h>
+#include <folly/io/async/HHWheelTimer.h>
 #include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
 #include <chrono>
 #include <list>
+#include <optional>
 #include <string>
 
+DECLARE_int32(neighbor_timer_tick_ms);
+DECLARE_int32(neighbor_stale_probe_rate);
+
 namespace facebook::fboss {
 
 /*
@@ -103,6 +110,11 @@ class NeighborCache {
     impl_->updateEntryClassID(ip, classID);
   }
 
+  void flushBatchedUpdates() {
+    std::lock_guard<std::mutex> g(cacheLock_);
+    impl_->flushBatchedUpdates();
+  }
+
  protected:
   // protected constructor since this is only meant to be inherited from
   NeighborCache(
@@ -117,12 +129,20 @@ class NeighborCache {
         timeout_(timeout),
         maxNeighborProbes_(maxNeighborProbes),
         staleEntryInterval_(staleEntryInterval),
+        timer_(folly::HHWheelTimer::newTimer(
+            sw->getNeighborCacheEvb(),
+            std::chrono::milliseconds(FLAGS_neighbor_timer_tick_ms))),
         impl_(std::make_unique<NeighborCacheImpl<NTable>>(
             this,
             sw,
             vlanID,
             vlanName,
-            intfID)) {}
+            intfID)) {
+    if (FLAGS_neighbor_stale_probe_rate > 0) {
+      staleProbeBucket_.emplace(
+          FLAGS_neighbor_stale_probe_rate, FLAGS_neighbor_stale_probe_rate);
+    }
+  }
 
   // Methods useful for subclasses
   void setPendingEntry(AddressType ip) {
@@ -220,6 +240,22 @@ class NeighborCache {
     return sw_->getAndClearNeighborHit(RouterID(0), ip);
   }
 
+  /*
+   * Timer wheel shared by all entries of this cache. Entries only need
+   * coarse timeouts, so rather than each entry being an EventBase timeout
+   * they are bucketed into FLAGS_neighbor_timer_tick_ms slots and expire
+   * in batches.
+   */
+  folly::HHWheelTimer& getTimer() {
+    return *timer_;
+  }
+
+  // Returns false if a unicast probe for a stale entry should be held back
+  // to stay within FLAGS_neighbor_stale_probe_rate
+  bool consumeStaleProbeToken() {
+    return !staleProbeBucket_ || staleProbeBucket_->consume(1);
+  }
+
   // Forbidden copy constructor and assignment operator
   NeighborCache(NeighborCache const&) = delete;
   NeighborCache& operator=(NeighborCache const&) = delete;
@@ -228,6 +264,9 @@ class NeighborCache {
   std::chrono::seconds timeout_;
   uint32_t maxNeighborProbes_{0};
   std::chrono::seconds staleEntryInterval_;
+  std::optional<folly::TokenBucket> staleProbeBucket_;
+  // Must outlive the entries scheduled on it, which are owned by impl_
+  folly::HHWheelTimer::UniquePtr timer_;
   std::unique_ptr<NeighborCacheImpl<NTable>> impl_;
   std::mutex cacheLock_;
 };
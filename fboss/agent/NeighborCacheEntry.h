@@ -19,6 +19,7 @@
 #include <folly/IPAddress.h>
 #include <folly/MacAddress.h>
 #include <folly/Random.h>
+#include <folly/io/async/HHWheelTimer.h>
 #include <chrono>
 
 /**
@@ -52,9 +53,10 @@
  * UNINITIALIZED - Placeholder on startup.
  *
  * Once an entry is created, it is responsible for scheduling the timeout for
- * its next update. When that timeout expires, the state machine is run and the
- * next update is scheduled. If the entry ever transitions to the EXPIRED state,
- * we do not schedule another update and the cache will flush the entry.
+ * its next update on the timer wheel of its cache. When that timeout expires,
+ * the state machine is run and the next update is scheduled. If the entry
+ * ever transitions to the EXPIRED state, we do not schedule another update
+ * and the cache will flush the entry.
  *
  * There is no locking in this class. Instead, the class relies on the
  * synchronization provided by NeighborCache, which should lock around all calls
@@ -78,7 +80,7 @@ template <typename NTable>
 class NeighborCache;
 
 template <typename NTable>
-class NeighborCacheEntry : private folly::AsyncTimeout {
+class NeighborCacheEntry : private folly::HHWheelTimer::Callback {
  public:
   typedef typename NTable::Entry::AddressType AddressType;
   typedef NeighborCache<NTable> Cache;
@@ -89,8 +91,7 @@ class NeighborCacheEntry : private folly::AsyncTimeout {
       folly::EventBase* evb,
       Cache* cache,
       NeighborEntryState state)
-      : AsyncTimeout(evb),
-        fields_(fields),
+      : fields_(fields),
         cache_(cache),
         evb_(evb),
         probesLeft_(cache_->getMaxNeighborProbes()) {
@@ -233,6 +234,14 @@ class NeighborCacheEntry : private folly::AsyncTimeout {
     cache_->processEntry(getIP());
   }
 
+  // Only called when the timer itself goes away, which happens after all
+  // of its entries are destroyed
+  void callbackCanceled() noexcept override {}
+
+  void scheduleTimeout(std::chrono::milliseconds timeout) {
+    cache_->getTimer().scheduleTimeout(this, timeout);
+  }
+
   /*
    * Schedules an update on the evb_. This is done synchronously so that we
    * can have a destructor guard around both running the state machine and
@@ -327,6 +336,11 @@ class NeighborCacheEntry : private folly::AsyncTimeout {
         cache_->probeFor(getIP());
       } else {
         /* entry is PROBE, issue unicast probe */
+        if (!cache_->consumeStaleProbeToken()) {
+          // Too many stale entries are being probed at once, try again on
+          // the next update without using up a probe
+          return;
+        }
         cache_->checkReachability(getIP(), getMac(), getPort());
       }
       --probesLeft_;
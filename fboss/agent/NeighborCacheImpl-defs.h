@@ -58,90 +58,164 @@ bool checkVlanAndIntf(
   return true;
 }
 
+/*
+ * Add or update a resolved entry in the neighbor table of the vlan.
+ * Returns false if the state was left unchanged.
+ */
+template <typename NTable>
+bool programEntryInState(
+    std::shared_ptr<SwitchState>* state,
+    const typename NeighborCacheEntry<NTable>::EntryFields& fields,
+    VlanID vlanID) {
+  if (!checkVlanAndIntf<NTable>(*state, fields, vlanID)) {
+    // Either the vlan or intf is no longer valid.
+    return false;
+  }
+
+  auto vlan = (*state)->getVlans()->getVlanIf(vlanID).get();
+  auto* table = vlan->template getNeighborTable<NTable>().get();
+  auto node = table->getNodeIf(fields.ip);
+
+  if (!node) {
+    table = table->modify(&vlan, state);
+    table->addEntry(fields);
+    XLOG(DBG2) << "Adding entry for " << fields.ip << " --> " << fields.mac
+               << " on interface " << fields.interfaceID << " for vlan "
+               << vlanID;
+  } else {
+    if (node->getMac() == fields.mac && node->getPort() == fields.port &&
+        node->getIntfID() == fields.interfaceID &&
+        node->getState() == fields.state && !node->isPending()) {
+      // This entry was already updated while we were waiting on the lock.
+      return false;
+    }
+    table = table->modify(&vlan, state);
+    table->updateEntry(fields);
+    XLOG(DBG2) << "Converting pending entry for " << fields.ip << " --> "
+               << fields.mac << " on interface " << fields.interfaceID
+               << " for vlan " << vlanID;
+  }
+  return true;
+}
+
+/*
+ * Add a pending entry to the neighbor table of the vlan, replacing an
+ * existing entry only if force is set. Returns false if the state was left
+ * unchanged.
+ */
+template <typename NTable>
+bool programPendingEntryInState(
+    std::shared_ptr<SwitchState>* state,
+    const typename NeighborCacheEntry<NTable>::EntryFields& fields,
+    VlanID vlanID,
+    bool force) {
+  if (!checkVlanAndIntf<NTable>(*state, fields, vlanID)) {
+    // Either the vlan or intf is no longer valid.
+    return false;
+  }
+
+  auto vlan = (*state)->getVlans()->getVlanIf(vlanID).get();
+  auto* table = vlan->template getNeighborTable<NTable>().get();
+  auto node = table->getNodeIf(fields.ip);
+  if (node && !force) {
+    // don't replace an existing entry with a pending one unless
+    // explicitly allowed
+    return false;
+  }
+
+  table = table->modify(&vlan, state);
+  if (node) {
+    table->removeEntry(fields.ip);
+  }
+  table->addPendingEntry(fields.ip, fields.interfaceID);
+
+  XLOG(DBG4) << "Adding pending entry for " << fields.ip << " on interface "
+             << fields.interfaceID << " for vlan " << vlanID;
+  return true;
+}
+
 } // namespace ncachehelpers
 
 template <typename NTable>
 void NeighborCacheImpl<NTable>::programEntry(Entry* entry) {
   CHECK(!entry->isPending());
+  queueUpdate(entry->getFields(), false);
+}
 
-  auto fields = entry->getFields();
-  auto vlanID = vlanID_;
-  auto updateFn = [fields, vlanID](const std::shared_ptr<SwitchState>& state)
-      -> std::shared_ptr<SwitchState> {
-    if (!ncachehelpers::checkVlanAndIntf<NTable>(state, fields, vlanID)) {
-      // Either the vlan or intf is no longer valid.
-      return nullptr;
-    }
+template <typename NTable>
+void NeighborCacheImpl<NTable>::programPendingEntry(Entry* entry, bool force) {
+  CHECK(entry->isPending());
+  queueUpdate(entry->getFields(), force);
+}
 
-    auto vlan = state->getVlans()->getVlanIf(vlanID).get();
-    std::shared_ptr<SwitchState> newState{state};
-    auto* table = vlan->template getNeighborTable<NTable>().get();
-    auto node = table->getNodeIf(fields.ip);
-
-    if (!node) {
-      table = table->modify(&vlan, &newState);
-      table->addEntry(fields);
-      XLOG(DBG2) << "Adding entry for " << fields.ip << " --> " << fields.mac
-                 << " on interface " << fields.interfaceID << " for vlan "
-                 << vlanID;
-    } else {
-      if (node->getMac() == fields.mac && node->getPort() == fields.port &&
-          node->getIntfID() == fields.interfaceID &&
-          node->getState() == fields.state && !node->isPending()) {
-        // This entry was already updated while we were waiting on the lock.
-        return nullptr;
-      }
-      table = table->modify(&vlan, &newState);
-      table->updateEntry(fields);
-      XLOG(DBG2) << "Converting pending entry for " << fields.ip << " --> "
-                 << fields.mac << " on interface " << fields.interfaceID
-                 << " for vlan " << vlanID;
-    }
-    return newState;
-  };
+template <typename NTable>
+void NeighborCacheImpl<NTable>::queueUpdate(
+    const EntryFields& fields,
+    bool force) {
+  auto pending = fields.state == NeighborState::PENDING;
+  if (!pending && batchedPendingIps_.count(fields.ip)) {
+    // The pending entry has to reach the HwSwitch in an update of its own
+    // before the resolved one, e.g. so that ECMP groups expand again once
+    // the neighbor is resolved.
+    flushBatchedUpdates();
+  }
+  batch_.push_back(BatchedUpdate{fields, force});
+  if (pending) {
+    batchedPendingIps_.insert(fields.ip);
+  }
 
-  sw_->updateState(
-      folly::to<std::string>("add neighbor ", fields.ip), std::move(updateFn));
+  if (batch_.size() >=
+      static_cast<size_t>(FLAGS_neighbor_update_batch_size)) {
+    flushBatchedUpdates();
+  } else if (FLAGS_neighbor_update_batch_window_ms > 0) {
+    if (!batchFlusher_.isScheduled()) {
+      evb_->timer().scheduleTimeout(
+          &batchFlusher_,
+          std::chrono::milliseconds(FLAGS_neighbor_update_batch_window_ms));
+    }
+  } else if (!batchFlusher_.isLoopCallbackScheduled()) {
+    evb_->runInLoop(&batchFlusher_);
+  }
 }
 
 template <typename NTable>
-void NeighborCacheImpl<NTable>::programPendingEntry(Entry* entry, bool force) {
-  CHECK(entry->isPending());
+void NeighborCacheImpl<NTable>::flushBatchedUpdates() {
+  batchFlusher_.cancelTimeout();
+  batchFlusher_.cancelLoopCallback();
+  if (batch_.empty()) {
+    return;
+  }
 
-  auto fields = entry->getFields();
+  auto hasPending = !batchedPendingIps_.empty();
+  auto name = folly::to<std::string>(
+      "program ", batch_.size(), " neighbor entries for vlan ", vlanID_);
   auto vlanID = vlanID_;
-  auto updateFn =
-      [fields, vlanID, force](const std::shared_ptr<SwitchState>& state)
+  auto updateFn = [batch = std::move(batch_),
+                   vlanID](const std::shared_ptr<SwitchState>& state)
       -> std::shared_ptr<SwitchState> {
-    if (!ncachehelpers::checkVlanAndIntf<NTable>(state, fields, vlanID)) {
-      // Either the vlan or intf is no longer valid.
-      return nullptr;
-    }
-
-    auto vlan = state->getVlans()->getVlanIf(vlanID).get();
     std::shared_ptr<SwitchState> newState{state};
-    auto* table = vlan->template getNeighborTable<NTable>().get();
-    auto node = table->getNodeIf(fields.ip);
-    table = table->modify(&vlan, &newState);
-
-    if (node) {
-      if (!force) {
-        // don't replace an existing entry with a pending one unless
-        // explicitly allowed
-        return nullptr;
+    bool changed = false;
+    for (const auto& update : batch) {
+      if (update.fields.state == NeighborState::PENDING) {
+        changed |= ncachehelpers::programPendingEntryInState<NTable>(
+            &newState, update.fields, vlanID, update.force);
+      } else {
+        changed |= ncachehelpers::programEntryInState<NTable>(
+            &newState, update.fields, vlanID);
       }
-      table->removeEntry(fields.ip);
     }
-    table->addPendingEntry(fields.ip, fields.interfaceID);
-
-    XLOG(DBG4) << "Adding pending entry for " << fields.ip << " on interface "
-               << fields.interfaceID << " for vlan " << vlanID;
-    return newState;
+    return changed ? newState : nullptr;
   };
+  batch_.clear();
+  batchedPendingIps_.clear();
 
-  sw_->updateStateNoCoalescing(
-      folly::to<std::string>("add pending entry ", fields.ip),
-      std::move(updateFn));
+  if (hasPending) {
+    // Pending entries are not coalesced with later updates, so that they
+    // are programmed before the neighbor gets resolved
+    sw_->updateStateNoCoalescing(name, std::move(updateFn));
+  } else {
+    sw_->updateState(name, std::move(updateFn));
+  }
 }
 
 template <typename NTable>
@@ -224,6 +298,8 @@ void NeighborCacheImpl<NTable>::updateEntryClassID(
           return newState;
         };
 
+    // Keep the update behind the programming of the entry itself
+    flushBatchedUpdates();
     auto classIDStr = classID.has_value()
         ? folly::to<std::string>(static_cast<int>(classID.value()))
         : "None";
@@ -344,6 +420,9 @@ void NeighborCacheImpl<NTable>::flushEntry(AddressType ip, bool* flushed) {
     return;
   }
 
+  // Entries queued for programming, possibly this one, go first
+  flushBatchedUpdates();
+
   // flush from SwitchState
   auto updateFn = [this, ip, flushed](const std::shared_ptr<SwitchState>& state)
       -> std::shared_ptr<SwitchState> {
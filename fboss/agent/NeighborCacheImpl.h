@@ -18,9 +18,17 @@
 
 #include <folly/IPAddress.h>
 #include <folly/Random.h>
+#include <folly/io/async/EventBase.h>
+#include <folly/io/async/HHWheelTimer.h>
+#include <gflags/gflags.h>
 #include <list>
 #include <optional>
 #include <string>
+#include <unordered_set>
+#include <vector>
+
+DECLARE_int32(neighbor_update_batch_size);
+DECLARE_int32(neighbor_update_batch_window_ms);
 
 namespace facebook::fboss {
 
@@ -35,6 +43,13 @@ class NeighborCache;
  * information and manage the logic for NDP-like expiration and unreachable
  * neighbor detection.
  *
+ * Entries to program into the SwitchState are not applied one state update
+ * at a time. They are queued and applied together once
+ * FLAGS_neighbor_update_batch_size of them are queued, or after
+ * FLAGS_neighbor_update_batch_window_ms (at the end of the current
+ * EventBase loop iteration if 0), so that a burst of resolutions after a
+ * link flap does not turn into thousands of serialized state updates.
+ *
  * All calls into this should have acquired a cache level lock through
  * NeighborCache so only one thread should ever be operating on the
  * cache at a given time.
@@ -64,7 +79,8 @@ class NeighborCacheImpl {
         vlanID_(vlanID),
         vlanName_(vlanName),
         intfID_(intfID),
-        evb_(sw->getNeighborCacheEvb()) {}
+        evb_(sw->getNeighborCacheEvb()),
+        batchFlusher_(cache) {}
 
   // Methods useful for subclasses
   void setPendingEntry(AddressType ip, bool force = false);
@@ -93,6 +109,9 @@ class NeighborCacheImpl {
 
   void portFlushEntries(PortDescriptor port);
 
+  // Apply the entries queued for programming right away
+  void flushBatchedUpdates();
+
   SwSwitch* getSw() const {
     return sw_;
   }
@@ -127,9 +146,35 @@ class NeighborCacheImpl {
   std::optional<NeighborEntryThrift> getCacheData(AddressType ip) const;
 
  private:
+  struct BatchedUpdate {
+    EntryFields fields;
+    // Replace an existing entry, only used for pending entries
+    bool force;
+  };
+
+  // Flushes the batch from the EventBase, either after the batch window or
+  // at the end of the loop iteration
+  class BatchFlusher : public folly::HHWheelTimer::Callback,
+                       public folly::EventBase::LoopCallback {
+   public:
+    explicit BatchFlusher(NeighborCache<NTable>* cache) : cache_(cache) {}
+
+    void timeoutExpired() noexcept override {
+      cache_->flushBatchedUpdates();
+    }
+    void callbackCanceled() noexcept override {}
+    void runLoopCallback() noexcept override {
+      cache_->flushBatchedUpdates();
+    }
+
+   private:
+    NeighborCache<NTable>* cache_;
+  };
+
   // These are used to program entries into the SwitchState
   void programEntry(Entry* entry);
   void programPendingEntry(Entry* entry, bool force = false);
+  void queueUpdate(const EntryFields& fields, bool force);
 
   void processEntry(AddressType ip);
 
@@ -163,6 +208,12 @@ class NeighborCacheImpl {
 
   // Map of all entries
   std::unordered_map<AddressType, std::shared_ptr<Entry>> entries_;
+
+  // Entries waiting to be programmed, in the order they were queued
+  std::vector<BatchedUpdate> batch_;
+  // IPs of the pending entries in batch_
+  std::unordered_set<AddressType> batchedPendingIps_;
+  BatchFlusher batchFlusher_;
 };
 
 } // namespace facebook::fboss
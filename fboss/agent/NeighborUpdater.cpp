@@ -38,6 +38,28 @@ using folly::IPAddressV6;
 using folly::MacAddress;
 using std::shared_ptr;
 
+DEFINE_int32(
+    neighbor_timer_tick_ms,
+    100,
+    "Granularity of the timer wheel each neighbor cache ages its entries "
+    "with. Entries due within the same tick are processed together");
+DEFINE_int32(
+    neighbor_stale_probe_rate,
+    1000,
+    "Maximum unicast probes per second each neighbor cache sends to confirm "
+    "stale entries still in use, 0 for no limit");
+DEFINE_int32(
+    neighbor_update_batch_size,
+    512,
+    "Maximum number of neighbor entries each neighbor cache programs in a "
+    "single state update");
+DEFINE_int32(
+    neighbor_update_batch_window_ms,
+    0,
+    "How long neighbor caches wait for more entries before programming a "
+    "partial batch. With 0 the batch is programmed at the end of the "
+    "neighbor thread event loop iteration");
+
 namespace facebook::fboss {
 
 using facebook::fboss::DeltaFunctions::forEachChanged;
@@ -56,7 +78,11 @@ NeighborUpdater::~NeighborUpdater() {
 }
 
 void NeighborUpdater::waitForPendingUpdates() {
-  folly::via(sw_->getNeighborCacheEvb(), [impl = this->impl_]() {}).get();
+  // Entries programmed by the updates still have to be applied, don't wait
+  // for their batches to fill up
+  folly::via(sw_->getNeighborCacheEvb(), [impl = this->impl_]() {
+    impl->flushBatchedUpdates();
+  }).get();
 }
 
 void NeighborUpdater::stateUpdated(const StateDelta& delta) {
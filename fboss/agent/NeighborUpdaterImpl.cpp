@@ -154,7 +154,7 @@ void NeighborUpdaterImpl::receivedArpNotMine(
 }
 
 void NeighborUpdaterImpl::portDown(PortDescriptor port) {
-  for (auto vlanCaches : caches_) {
+  for (const auto& vlanCaches : caches_) {
     auto arpCache = vlanCaches.second->arpCache;
     arpCache->portDown(port);
 
@@ -164,7 +164,7 @@ void NeighborUpdaterImpl::portDown(PortDescriptor port) {
 }
 
 void NeighborUpdaterImpl::portFlushEntries(PortDescriptor port) {
-  for (auto vlanCaches : caches_) {
+  for (const auto& vlanCaches : caches_) {
     auto arpCache = vlanCaches.second->arpCache;
     arpCache->portFlushEntries(port);
 
@@ -173,6 +173,13 @@ void NeighborUpdaterImpl::portFlushEntries(PortDescriptor port) {
   }
 }
 
+void NeighborUpdaterImpl::flushBatchedUpdates() {
+  for (const auto& vlanCaches : caches_) {
+    vlanCaches.second->arpCache->flushBatchedUpdates();
+    vlanCaches.second->ndpCache->flushBatchedUpdates();
+  }
+}
+
 bool NeighborUpdaterImpl::flushEntryImpl(VlanID vlan, IPAddress ip) {
   if (ip.isV4()) {
     auto cache = getArpCacheInternal(vlan);
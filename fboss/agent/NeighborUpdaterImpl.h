@@ -93,6 +93,9 @@ class NeighborUpdaterImpl {
 
   bool flushEntryImpl(VlanID vlan, folly::IPAddress ip);
 
+  // Program the entries every cache has queued up
+  void flushBatchedUpdates();
+
   // Forbidden copy constructor and assignment operator
   NeighborUpdaterImpl(NeighborUpdaterImpl const&) = delete;
   NeighborUpdaterImpl& operator=(NeighborUpdaterImpl const&) = delete;
@@ -68,12 +68,19 @@ RouteUpdateLogger::RouteUpdateLogger(
     std::unique_ptr<RouteLogger<folly::IPAddressV4>> routeLoggerV4,
     std::unique_ptr<RouteLogger<folly::IPAddressV6>> routeLoggerV6,
     std::unique_ptr<MplsRouteLogger> mplsRouteLogger)
-    : AutoRegisterStateObserver(sw, "RouteUpdateLogger"),
+    : AutoRegisterStateObserver(
+          sw,
+          "RouteUpdateLogger",
+          StateObserverNotifier::Mode::ASYNC),
       swSwitch_(sw),
       routeLoggerV4_(std::move(routeLoggerV4)),
       routeLoggerV6_(std::move(routeLoggerV6)),
       mplsRouteLogger_(std::move(mplsRouteLogger)) {}
 
+RouteUpdateLogger::~RouteUpdateLogger() {
+  unregister();
+}
+
 void RouteUpdateLogger::stateUpdated(const StateDelta& delta) {
   forEachChangedRoute<folly::IPAddressV4>(
       delta,
@@ -12,6 +12,10 @@
 #include "fboss/agent/Packet.h"
 #include "fboss/agent/types.h"
 
+#include <folly/MacAddress.h>
+#include <folly/io/Cursor.h>
+
+#include <optional>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -61,6 +65,53 @@ class RxPacket : public Packet {
     return RouterID(0);
   }
 
+  /*
+   * Ethernet header fields, parsed from the packet data on first use.
+   */
+  struct L2Header {
+    folly::MacAddress dstMac;
+    folly::MacAddress srcMac;
+    // Ethertype following the (optional) 802.1Q tag
+    uint16_t ethertype{0};
+    // Offset of the L3 header from the start of the packet
+    uint32_t l3Offset{0};
+  };
+  /*
+   * Get the parsed ethernet header. The header is parsed once and cached, so
+   * the rx dispatch path and the protocol handlers don't each walk it again.
+   *
+   * Throws std::out_of_range if the packet is too short.
+   */
+  const L2Header& getL2Header() const {
+    if (!l2Header_) {
+      folly::io::Cursor c(buf());
+      L2Header hdr;
+      uint8_t mac[folly::MacAddress::SIZE];
+      c.pull(mac, sizeof(mac));
+      hdr.dstMac = folly::MacAddress::fromBinary(
+          folly::ByteRange(mac, sizeof(mac)));
+      c.pull(mac, sizeof(mac));
+      hdr.srcMac = folly::MacAddress::fromBinary(
+          folly::ByteRange(mac, sizeof(mac)));
+      hdr.ethertype = c.readBE<uint16_t>();
+      if (hdr.ethertype == kEthertypeVlan) {
+        // 802.1Q, skip over the VLAN tag. We ignore it for now
+        c.skip(sizeof(uint16_t));
+        hdr.ethertype = c.readBE<uint16_t>();
+      }
+      hdr.l3Offset = c - folly::io::Cursor(buf());
+      l2Header_ = hdr;
+    }
+    return *l2Header_;
+  }
+  /*
+   * Drop the cached ethernet header, must be called after modifying the
+   * packet data in place (e.g. decapsulation).
+   */
+  void invalidateL2Header() {
+    l2Header_.reset();
+  }
+
   /*
    * Return a human-readable string describing additional detailed information
    * about the packet.
@@ -100,6 +151,11 @@ class RxPacket : public Packet {
   AggregatePortID srcAggregatePort_{0};
   VlanID srcVlan_{0};
   uint32_t len_{0};
+
+ private:
+  static constexpr uint16_t kEthertypeVlan = 0x8100;
+
+  mutable std::optional<L2Header> l2Header_;
 };
 
 } // namespace facebook::fboss
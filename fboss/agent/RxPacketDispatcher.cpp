@@ -0,0 +1,234 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RxPacketDispatcher.h"
+
+#include "fboss/agent/RxPacket.h"
+#include "fboss/agent/packet/Ethertype.h"
+#include "fboss/agent/packet/ICMPHdr.h"
+#include "fboss/agent/packet/IPProto.h"
+
+#include <fb303/ThreadCachedServiceData.h>
+#include <folly/Conv.h>
+#include <folly/ExceptionString.h>
+#include <folly/MacAddress.h>
+#include <folly/io/Cursor.h>
+#include <folly/logging/xlog.h>
+#include <folly/system/ThreadName.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+using facebook::fb303::AVG;
+using facebook::fb303::SUM;
+using folly::io::Cursor;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+namespace {
+// Offset of the next header field and size of the fixed IPv6 header
+constexpr auto kIPv6NextHeaderOffset = 6;
+constexpr auto kIPv6HeaderSize = 40;
+
+bool isNdp(Cursor cursor) {
+  using facebook::fboss::ICMPv6Type;
+  using facebook::fboss::IP_PROTO;
+  if (!cursor.canAdvance(kIPv6HeaderSize + 1)) {
+    return false;
+  }
+  cursor.skip(kIPv6NextHeaderOffset);
+  if (cursor.read<uint8_t>() !=
+      static_cast<uint8_t>(IP_PROTO::IP_PROTO_IPV6_ICMP)) {
+    return false;
+  }
+  cursor.skip(kIPv6HeaderSize - kIPv6NextHeaderOffset - 1);
+  // Router/neighbor solicitations and advertisements, and redirects
+  auto type = static_cast<ICMPv6Type>(cursor.read<uint8_t>());
+  return type >= ICMPv6Type::ICMPV6_TYPE_NDP_ROUTER_SOLICITATION &&
+      type <= ICMPv6Type::ICMPV6_TYPE_NDP_REDIRECT_MESSAGE;
+}
+} // namespace
+
+namespace facebook::fboss {
+
+RxPacketDispatcher::ClassQueue::ClassQueue(
+    PacketClass packetClass,
+    uint32_t numWorkers,
+    uint32_t capacity)
+    : dropsKey(folly::to<std::string>(
+          "rx_dispatch.", className(packetClass), ".drops")),
+      queueDelayKey(folly::to<std::string>(
+          "rx_dispatch.", className(packetClass), ".queue_delay_us")) {
+  numWorkers = std::max<uint32_t>(numWorkers, 1);
+  auto shardCapacity = std::max<uint32_t>(
+      (capacity + numWorkers - 1) / numWorkers, 1);
+  for (uint32_t i = 0; i < numWorkers; ++i) {
+    shards.push_back(std::make_unique<WorkerQueue>(shardCapacity));
+  }
+}
+
+RxPacketDispatcher::RxPacketDispatcher(Handler handler, Options options)
+    : handler_(std::move(handler)), controlCpuQueue_(options.controlCpuQueue) {
+  for (size_t i = 0; i < kNumClasses; ++i) {
+    queues_[i] = std::make_unique<ClassQueue>(
+        static_cast<PacketClass>(i),
+        options.numWorkers[i],
+        options.queueCapacity[i]);
+  }
+  for (size_t i = 0; i < kNumClasses; ++i) {
+    for (size_t worker = 0; worker < queues_[i]->shards.size(); ++worker) {
+      workers_.emplace_back([this, i, worker]() {
+        folly::setThreadName(folly::to<std::string>(
+            "fbossRx", className(static_cast<PacketClass>(i)), worker));
+        workerLoop(i, worker);
+      });
+    }
+  }
+}
+
+RxPacketDispatcher::~RxPacketDispatcher() {
+  stop();
+}
+
+void RxPacketDispatcher::stop() {
+  if (stopped_.exchange(true)) {
+    return;
+  }
+  for (auto& classQueue : queues_) {
+    for (auto& shard : classQueue->shards) {
+      shard->pending.shutdown();
+    }
+  }
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+  for (auto& classQueue : queues_) {
+    for (auto& shard : classQueue->shards) {
+      QueueEntry entry;
+      while (shard->queue.read(entry)) {
+        classQueue->counters.dropped++;
+      }
+    }
+  }
+}
+
+bool RxPacketDispatcher::dispatch(std::unique_ptr<RxPacket> pkt) {
+  auto packetClass = classify(pkt.get());
+  auto& classQueue = *queues_[static_cast<size_t>(packetClass)];
+  auto& shard =
+      *classQueue.shards[pkt->getSrcPort() % classQueue.shards.size()];
+  if (stopped_.load(std::memory_order_relaxed) ||
+      !shard.queue.write(QueueEntry{std::move(pkt), steady_clock::now()})) {
+    classQueue.counters.dropped++;
+    tcData().addStatValue(classQueue.dropsKey, 1, SUM);
+    return false;
+  }
+  classQueue.counters.enqueued++;
+  shard.pending.post();
+  return true;
+}
+
+RxPacketDispatcher::PacketClass RxPacketDispatcher::classify(
+    const RxPacket* pkt) const {
+  if (controlCpuQueue_.has_value() && pkt->cosQueue() == *controlCpuQueue_) {
+    return PacketClass::CONTROL;
+  }
+  // Parsed once here, the packet handlers then use the cached header
+  const RxPacket::L2Header* l2Header;
+  try {
+    l2Header = &pkt->getL2Header();
+  } catch (const std::out_of_range&) {
+    // Too short, left to the data path to count as bogus
+    return PacketClass::DATA;
+  }
+  Cursor c(pkt->buf());
+  c += l2Header->l3Offset;
+  switch (static_cast<ETHERTYPE>(l2Header->ethertype)) {
+    case ETHERTYPE::ETHERTYPE_SLOW_PROTOCOLS:
+    case ETHERTYPE::ETHERTYPE_LLDP:
+    case ETHERTYPE::ETHERRTPE_EAPOL:
+      return PacketClass::CONTROL;
+    case ETHERTYPE::ETHERTYPE_ARP:
+      return PacketClass::NEIGHBOR;
+    case ETHERTYPE::ETHERTYPE_IPV6:
+      return isNdp(c) ? PacketClass::NEIGHBOR : PacketClass::DATA;
+    default:
+      return PacketClass::DATA;
+  }
+}
+
+RxPacketDispatcher::ClassStats RxPacketDispatcher::getStats(
+    PacketClass packetClass) const {
+  const auto& counters = queues_[static_cast<size_t>(packetClass)]->counters;
+  ClassStats stats;
+  stats.enqueued = counters.enqueued.load();
+  stats.dropped = counters.dropped.load();
+  stats.handled = counters.handled.load();
+  stats.totalQueueDelayUsecs = counters.totalQueueDelayUsecs.load();
+  stats.maxQueueDelayUsecs = counters.maxQueueDelayUsecs.load();
+  return stats;
+}
+
+std::string RxPacketDispatcher::className(PacketClass packetClass) {
+  switch (packetClass) {
+    case PacketClass::CONTROL:
+      return "control";
+    case PacketClass::NEIGHBOR:
+      return "neighbor";
+    case PacketClass::DATA:
+      return "data";
+  }
+  return "unknown";
+}
+
+void RxPacketDispatcher::workerLoop(size_t classIdx, size_t shardIdx) {
+  auto& pending = queues_[classIdx]->shards[shardIdx]->pending;
+  while (true) {
+    try {
+      pending.wait();
+    } catch (const folly::ShutdownSemError&) {
+      return;
+    }
+    handleOne(classIdx, shardIdx);
+  }
+}
+
+bool RxPacketDispatcher::handleOne(size_t classIdx, size_t shardIdx) {
+  auto& classQueue = *queues_[classIdx];
+  QueueEntry entry;
+  if (stopped_.load(std::memory_order_relaxed) ||
+      !classQueue.shards[shardIdx]->queue.read(entry)) {
+    return false;
+  }
+  auto delay = static_cast<uint64_t>(
+      duration_cast<microseconds>(steady_clock::now() - entry.enqueued)
+          .count());
+  auto& counters = classQueue.counters;
+  counters.totalQueueDelayUsecs += delay;
+  auto maxDelay = counters.maxQueueDelayUsecs.load(std::memory_order_relaxed);
+  while (delay > maxDelay &&
+         !counters.maxQueueDelayUsecs.compare_exchange_weak(maxDelay, delay)) {
+  }
+  tcData().addStatValue(classQueue.queueDelayKey, delay, AVG);
+  // The handler is expected to swallow its own errors, as
+  // SwSwitch::packetReceived() does, but never let one kill a worker
+  try {
+    handler_(std::move(entry.pkt));
+  } catch (const std::exception& ex) {
+    XLOG(ERR) << "error handling "
+              << className(static_cast<PacketClass>(classIdx))
+              << " packet: " << folly::exceptionStr(ex);
+  }
+  counters.handled++;
+  return true;
+}
+
+} // namespace facebook::fboss
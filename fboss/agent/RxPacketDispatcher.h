@@ -0,0 +1,146 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/MPMCQueue.h>
+#include <folly/synchronization/LifoSem.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace facebook::fboss {
+
+class RxPacket;
+
+/*
+ * RxPacketDispatcher decouples packet handling from the thread the HwSwitch
+ * delivers trapped packets on. Packets are classified by ethertype (and
+ * optionally CPU queue) and handed to bounded per class queues, each with
+ * its own worker threads.
+ *
+ * Workers only ever serve their own class. An ARP/NDP storm therefore fills
+ * (and overflows) the NEIGHBOR queue without delaying LACP or LLDP
+ * processing. Packets arriving at a full queue are dropped and accounted per
+ * class.
+ *
+ * The queue of a class is sharded by ingress port, one shard per worker, so
+ * that the packets of a port are handled one at a time and in order, as
+ * protocol handlers such as LinkAggregationManager expect.
+ */
+class RxPacketDispatcher {
+ public:
+  enum class PacketClass : uint8_t {
+    // LACP, LLDP, EAPOL (MKA) and anything trapped to the control CPU queue
+    CONTROL,
+    // ARP and IPv6 neighbor discovery
+    NEIGHBOR,
+    // Everything else, mostly IPv4/IPv6 packets destined to us
+    DATA,
+  };
+  static constexpr auto kNumClasses = 3;
+
+  struct Options {
+    // Worker threads dedicated to each class, at least one
+    std::array<uint32_t, kNumClasses> numWorkers{1, 1, 1};
+    // Maximum number of packets queued for each class, split evenly between
+    // its workers
+    std::array<uint32_t, kNumClasses> queueCapacity{1024, 4096, 4096};
+    // Packets trapped to this CPU queue are CONTROL regardless of ethertype
+    std::optional<int> controlCpuQueue;
+  };
+
+  struct ClassStats {
+    uint64_t enqueued{0};
+    uint64_t dropped{0};
+    uint64_t handled{0};
+    // Time spent in the queue, from dispatch() until a worker picks it up
+    uint64_t totalQueueDelayUsecs{0};
+    uint64_t maxQueueDelayUsecs{0};
+  };
+
+  using Handler = std::function<void(std::unique_ptr<RxPacket>)>;
+
+  RxPacketDispatcher(Handler handler, Options options);
+  ~RxPacketDispatcher();
+
+  /*
+   * Queue the packet for handling by the workers of its class. Never blocks,
+   * returns false if the class queue was full and the packet was dropped.
+   */
+  bool dispatch(std::unique_ptr<RxPacket> pkt);
+
+  /*
+   * Stop the workers. Packets still queued are dropped without being
+   * handled. Called by the destructor if not done before.
+   */
+  void stop();
+
+  PacketClass classify(const RxPacket* pkt) const;
+
+  ClassStats getStats(PacketClass packetClass) const;
+
+  static std::string className(PacketClass packetClass);
+
+ private:
+  struct QueueEntry {
+    std::unique_ptr<RxPacket> pkt;
+    std::chrono::steady_clock::time_point enqueued;
+  };
+
+  struct ClassCounters {
+    std::atomic<uint64_t> enqueued{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> handled{0};
+    std::atomic<uint64_t> totalQueueDelayUsecs{0};
+    std::atomic<uint64_t> maxQueueDelayUsecs{0};
+  };
+
+  // The packets of the ports served by one worker
+  struct WorkerQueue {
+    explicit WorkerQueue(uint32_t capacity) : queue(capacity) {}
+
+    folly::MPMCQueue<QueueEntry> queue;
+    folly::LifoSem pending;
+  };
+
+  struct ClassQueue {
+    ClassQueue(PacketClass packetClass, uint32_t numWorkers, uint32_t capacity);
+
+    std::vector<std::unique_ptr<WorkerQueue>> shards;
+    ClassCounters counters;
+    // fb303 counter names, built once rather than per packet
+    const std::string dropsKey;
+    const std::string queueDelayKey;
+  };
+
+  // Forbidden copy constructor and assignment operator
+  RxPacketDispatcher(RxPacketDispatcher const&) = delete;
+  RxPacketDispatcher& operator=(RxPacketDispatcher const&) = delete;
+
+  void workerLoop(size_t classIdx, size_t shardIdx);
+  // Handle at most one packet of the given shard, returns false if it was
+  // empty
+  bool handleOne(size_t classIdx, size_t shardIdx);
+
+  Handler handler_;
+  std::optional<int> controlCpuQueue_;
+  std::array<std::unique_ptr<ClassQueue>, kNumClasses> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<bool> stopped_{false};
+};
+
+} // namespace facebook::fboss
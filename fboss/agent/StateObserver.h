@@ -12,6 +12,7 @@
 #include <boost/core/noncopyable.hpp>
 
 #include <folly/synchronization/SanitizeThread.h>
+#include "fboss/agent/StateObserverNotifier.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/state/StateDelta.h"
 
@@ -25,11 +26,15 @@ class StateObserver : public boost::noncopyable {
 
 class AutoRegisterStateObserver : public StateObserver {
  public:
-  AutoRegisterStateObserver(SwSwitch* sw, const std::string& name) : sw_(sw) {
-    sw_->registerStateObserver(this, name);
+  AutoRegisterStateObserver(
+      SwSwitch* sw,
+      const std::string& name,
+      StateObserverNotifier::Mode mode = StateObserverNotifier::Mode::SYNC)
+      : sw_(sw) {
+    sw_->registerStateObserver(this, name, mode);
   }
   ~AutoRegisterStateObserver() override {
-    sw_->unregisterStateObserver(this);
+    unregister();
   }
 
   // This empty implementation should be overridden by subclasses, but it is
@@ -39,8 +44,21 @@ class AutoRegisterStateObserver : public StateObserver {
   // during that time if this didn't exist.
   void stateUpdated(const StateDelta& /*delta*/) override {}
 
+ protected:
+  // Stop notifying the observer and wait for the notifications already
+  // queued for it. ASYNC observers must call this first thing in their
+  // destructor: their notifications run on other threads, and could
+  // otherwise still run against members being destroyed. Idempotent.
+  void unregister() {
+    if (registered_) {
+      sw_->unregisterStateObserver(this);
+      registered_ = false;
+    }
+  }
+
  private:
   SwSwitch* sw_{nullptr};
+  bool registered_{true};
 
  protected:
   // Used to suppress TSAN data race on vptr between observer->stateUpdated() in
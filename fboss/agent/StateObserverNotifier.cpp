@@ -0,0 +1,182 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/StateObserverNotifier.h"
+
+#include "fboss/agent/StateObserver.h"
+#include "fboss/agent/state/StateDelta.h"
+
+#include <fb303/ServiceData.h>
+#include <fb303/ThreadCachedServiceData.h>
+#include <folly/Conv.h>
+#include <folly/ExceptionString.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/SerialExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/logging/xlog.h>
+
+#include <algorithm>
+
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+namespace {
+// Processing time histogram: 1ms buckets up to 1s
+constexpr auto kProcessingTimeBucketUsecs = 1000;
+constexpr auto kProcessingTimeMaxUsecs = 1000000;
+} // namespace
+
+namespace facebook::fboss {
+
+StateObserverNotifier::ObserverEntry::ObserverEntry(
+    StateObserver* observer,
+    const std::string& name,
+    Mode mode)
+    : observer(observer),
+      name(name),
+      mode(mode),
+      processingTimeKey(folly::to<std::string>(
+          "state_observer.", name, ".processing_time_us")),
+      backlogKey(folly::to<std::string>("state_observer.", name, ".backlog")) {
+  fb303::fbData->addHistogram(
+      processingTimeKey,
+      kProcessingTimeBucketUsecs,
+      0,
+      kProcessingTimeMaxUsecs);
+  fb303::fbData->exportHistogramPercentile(processingTimeKey, 50, 99);
+  if (mode == Mode::ASYNC) {
+    fb303::fbData->setCounter(backlogKey, 0);
+  }
+}
+
+void StateObserverNotifier::ObserverEntry::processed() {
+  // Notify under the lock, remove() frees the entry as soon as it sees the
+  // backlog drained
+  std::lock_guard<std::mutex> guard(backlogLock);
+  --backlog;
+  fb303::fbData->setCounter(backlogKey, backlog);
+  backlogDrained.notify_all();
+}
+
+void StateObserverNotifier::ObserverEntry::waitForBacklogBelow(
+    uint32_t limit) {
+  std::unique_lock<std::mutex> guard(backlogLock);
+  backlogDrained.wait(guard, [this, limit]() { return backlog < limit; });
+}
+
+StateObserverNotifier::StateObserverNotifier(
+    uint32_t numThreads,
+    uint32_t maxBacklog)
+    : numThreads_(std::max<uint32_t>(numThreads, 1)),
+      maxBacklog_(std::max<uint32_t>(maxBacklog, 1)) {}
+
+StateObserverNotifier::~StateObserverNotifier() {
+  waitForAsyncObservers();
+  // Release the serial executors before joining the pool
+  observers_.clear();
+  pool_.reset();
+}
+
+bool StateObserverNotifier::isRegistered(StateObserver* observer) const {
+  return observers_.find(observer) != observers_.end();
+}
+
+void StateObserverNotifier::add(
+    StateObserver* observer,
+    const std::string& name,
+    Mode mode) {
+  auto entry = std::make_unique<ObserverEntry>(observer, name, mode);
+  if (mode == Mode::ASYNC) {
+    if (!pool_) {
+      pool_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          numThreads_,
+          std::make_shared<folly::NamedThreadFactory>("StateObserver"));
+    }
+    entry->executor = folly::SerialExecutor::create(
+        folly::getKeepAliveToken(pool_.get()));
+  }
+  observers_.emplace(observer, std::move(entry));
+}
+
+void StateObserverNotifier::remove(StateObserver* observer) {
+  auto it = observers_.find(observer);
+  if (it == observers_.end()) {
+    return;
+  }
+  // The observer may go away as soon as we return
+  it->second->waitForBacklogBelow(1);
+  observers_.erase(it);
+}
+
+void StateObserverNotifier::notify(const StateDelta& delta) {
+  // Queue up the ASYNC notifications first, so that they run alongside the
+  // SYNC ones
+  std::shared_ptr<const StateDelta> asyncDelta;
+  for (const auto& observerAndEntry : observers_) {
+    auto entry = observerAndEntry.second.get();
+    if (entry->mode != Mode::ASYNC) {
+      continue;
+    }
+    if (!asyncDelta) {
+      asyncDelta =
+          std::make_shared<StateDelta>(delta.oldState(), delta.newState());
+    }
+    entry->waitForBacklogBelow(maxBacklog_);
+    {
+      std::lock_guard<std::mutex> guard(entry->backlogLock);
+      ++entry->backlog;
+      fb303::fbData->setCounter(entry->backlogKey, entry->backlog);
+    }
+    entry->executor->add([this, entry, asyncDelta]() {
+      notifyOne(entry, *asyncDelta);
+      entry->processed();
+    });
+  }
+  for (const auto& observerAndEntry : observers_) {
+    auto entry = observerAndEntry.second.get();
+    if (entry->mode == Mode::SYNC) {
+      notifyOne(entry, delta);
+    }
+  }
+}
+
+void StateObserverNotifier::notifyOne(
+    ObserverEntry* entry,
+    const StateDelta& delta) {
+  auto start = steady_clock::now();
+  try {
+    entry->observer->stateUpdated(delta);
+  } catch (const std::exception& ex) {
+    // TODO: Figure out the best way to handle errors here.
+    XLOG(FATAL) << "error notifying " << entry->name
+                << " of update: " << folly::exceptionStr(ex);
+  }
+  auto processingTime =
+      duration_cast<microseconds>(steady_clock::now() - start).count();
+  fb303::ThreadCachedServiceData::get()->addHistogramValue(
+      entry->processingTimeKey, processingTime);
+}
+
+void StateObserverNotifier::waitForAsyncObservers() {
+  for (const auto& observerAndEntry : observers_) {
+    observerAndEntry.second->waitForBacklogBelow(1);
+  }
+}
+
+uint32_t StateObserverNotifier::getBacklog(StateObserver* observer) const {
+  auto it = observers_.find(observer);
+  if (it == observers_.end()) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> guard(it->second->backlogLock);
+  return it->second->backlog;
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/Executor.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace folly {
+class CPUThreadPoolExecutor;
+}
+
+namespace facebook::fboss {
+
+class StateDelta;
+class StateObserver;
+
+/*
+ * StateObserverNotifier hands every applied StateDelta to the registered
+ * StateObservers.
+ *
+ * SYNC observers are called inline on the update thread, as they always
+ * were: they are done with a delta before the next update is applied. ASYNC
+ * observers are called on a shared worker pool instead. Each of them sees
+ * the deltas one at a time and in order, but concurrently with the other
+ * observers and with the following updates. An ASYNC observer may thus
+ * only look at the delta it is given (and its own, thread safe, state).
+ *
+ * The number of deltas queued for an ASYNC observer is bounded, the update
+ * thread blocks once an observer falls that far behind.
+ */
+class StateObserverNotifier {
+ public:
+  enum class Mode {
+    SYNC,
+    ASYNC,
+  };
+
+  StateObserverNotifier(uint32_t numThreads, uint32_t maxBacklog);
+  ~StateObserverNotifier();
+
+  /*
+   * Registration and notification only ever happen on the update thread,
+   * so none of these need locking.
+   */
+  bool isRegistered(StateObserver* observer) const;
+  void add(StateObserver* observer, const std::string& name, Mode mode);
+  // Waits for the deltas still queued for the observer to be processed
+  void remove(StateObserver* observer);
+  void notify(const StateDelta& delta);
+
+  // Wait until every ASYNC observer has processed the deltas queued so far
+  void waitForAsyncObservers();
+
+  // Deltas queued for, or being processed by, an ASYNC observer
+  uint32_t getBacklog(StateObserver* observer) const;
+
+ private:
+  struct ObserverEntry {
+    ObserverEntry(StateObserver* observer, const std::string& name, Mode mode);
+
+    void processed();
+    void waitForBacklogBelow(uint32_t limit);
+
+    StateObserver* const observer;
+    const std::string name;
+    const Mode mode;
+    // ASYNC only, runs the observer's notifications one after the other
+    folly::Executor::KeepAlive<> executor;
+
+    mutable std::mutex backlogLock;
+    std::condition_variable backlogDrained;
+    uint32_t backlog{0};
+
+    // fb303 counter names, built once rather than per update
+    const std::string processingTimeKey;
+    const std::string backlogKey;
+  };
+
+  // Forbidden copy constructor and assignment operator
+  StateObserverNotifier(StateObserverNotifier const&) = delete;
+  StateObserverNotifier& operator=(StateObserverNotifier const&) = delete;
+
+  void notifyOne(ObserverEntry* entry, const StateDelta& delta);
+
+  const uint32_t numThreads_;
+  const uint32_t maxBacklog_;
+  // Created along with the first ASYNC observer
+  std::unique_ptr<folly::CPUThreadPoolExecutor> pool_;
+  std::map<StateObserver*, std::unique_ptr<ObserverEntry>> observers_;
+};
+
+} // namespace facebook::fboss
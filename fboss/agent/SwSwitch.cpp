@@ -44,6 +44,7 @@
 #include "fboss/agent/RestartTimeTracker.h"
 #include "fboss/agent/RouteUpdateLogger.h"
 #include "fboss/agent/RxPacket.h"
+#include "fboss/agent/RxPacketDispatcher.h"
 #include "fboss/agent/StaticL2ForNeighborObserver.h"
 #include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
 #include "fboss/agent/SwitchStats.h"
@@ -127,6 +128,31 @@ DEFINE_int32(
     64,
     "Expected minimum ethernet packet length");
 
+DEFINE_bool(
+    rx_packet_dispatch,
+    false,
+    "Handle trapped packets on per class worker threads, with control "
+    "protocols prioritized over ARP/NDP and IP, instead of on the HwSwitch "
+    "rx thread");
+
+DEFINE_int32(
+    rx_control_cpu_queue,
+    -1,
+    "With rx_packet_dispatch, treat packets trapped to this CPU queue as "
+    "control traffic regardless of ethertype. -1 to classify by ethertype "
+    "only");
+
+DEFINE_int32(
+    state_observer_threads,
+    2,
+    "Worker threads shared by the state observers notified asynchronously");
+
+DEFINE_int32(
+    state_observer_max_backlog,
+    64,
+    "Maximum number of state updates queued for an asynchronous state "
+    "observer, the update thread waits for it beyond that");
+
 namespace {
 
 /**
@@ -178,6 +204,9 @@ namespace facebook::fboss {
 SwSwitch::SwSwitch(std::unique_ptr<Platform> platform)
     : hw_(platform->getHwSwitch()),
       platform_(std::move(platform)),
+      stateObservers_(
+          FLAGS_state_observer_threads,
+          FLAGS_state_observer_max_backlog),
       arp_(new ArpHandler(this)),
       ipv4_(new IPv4Handler(this)),
       ipv6_(new IPv6Handler(this)),
@@ -219,6 +248,11 @@ void SwSwitch::stop(bool revertToMinAlpmState) {
   // After this we should no longer receive packets or link state changed events
   // while we are destroying ourselves
   hw_->unregisterCallbacks();
+  // Packets may still be in flight on the dispatcher workers, wait for them
+  // before tearing down the packet handlers
+  if (rxPacketDispatcher_) {
+    rxPacketDispatcher_->stop();
+  }
 
   // Stop tunMgr so we don't get any packets to process
   // in software that were sent to the switch ip or were
@@ -479,6 +513,18 @@ void SwSwitch::publishTxPacket(TxPacket* pkt, uint16_t ethertype) {
 void SwSwitch::init(std::unique_ptr<TunManager> tunMgr, SwitchFlags flags) {
   auto begin = steady_clock::now();
   flags_ = flags;
+  if (FLAGS_rx_packet_dispatch) {
+    // Must be in place before the HwSwitch starts delivering packets
+    RxPacketDispatcher::Options options;
+    if (FLAGS_rx_control_cpu_queue >= 0) {
+      options.controlCpuQueue = FLAGS_rx_control_cpu_queue;
+    }
+    rxPacketDispatcher_ = std::make_unique<RxPacketDispatcher>(
+        [this](std::unique_ptr<RxPacket> pkt) {
+          handlePacketNoThrow(std::move(pkt));
+        },
+        options);
+  }
   auto hwInitRet = hw_->init(this, false /*failHwCallsOnWarmboot*/);
   auto initialState = hwInitRet.switchState;
   bootType_ = hwInitRet.bootType;
@@ -665,10 +711,11 @@ void SwSwitch::stopLoggingRouteUpdates(const std::string& identifier) {
 
 void SwSwitch::registerStateObserver(
     StateObserver* observer,
-    const string name) {
+    const string name,
+    StateObserverNotifier::Mode mode) {
   XLOG(DBG2) << "Registering state observer: " << name;
   updateEventBase_.runImmediatelyOrRunInEventBaseThreadAndWait(
-      [=]() { addStateObserver(observer, name); });
+      [=]() { addStateObserver(observer, name, mode); });
 }
 
 void SwSwitch::unregisterStateObserver(StateObserver* observer) {
@@ -676,25 +723,33 @@ void SwSwitch::unregisterStateObserver(StateObserver* observer) {
       [=]() { removeStateObserver(observer); });
 }
 
+void SwSwitch::waitForAsyncStateObservers() {
+  updateEventBase_.runImmediatelyOrRunInEventBaseThreadAndWait(
+      [=]() { stateObservers_.waitForAsyncObservers(); });
+}
+
 bool SwSwitch::stateObserverRegistered(StateObserver* observer) {
   DCHECK(updateEventBase_.isInEventBaseThread());
-  return stateObservers_.find(observer) != stateObservers_.end();
+  return stateObservers_.isRegistered(observer);
 }
 
 void SwSwitch::removeStateObserver(StateObserver* observer) {
   DCHECK(updateEventBase_.isInEventBaseThread());
-  auto nErased = stateObservers_.erase(observer);
-  if (!nErased) {
+  if (!stateObserverRegistered(observer)) {
     throw FbossError("State observer remove failed: observer does not exist");
   }
+  stateObservers_.remove(observer);
 }
 
-void SwSwitch::addStateObserver(StateObserver* observer, const string& name) {
+void SwSwitch::addStateObserver(
+    StateObserver* observer,
+    const string& name,
+    StateObserverNotifier::Mode mode) {
   DCHECK(updateEventBase_.isInEventBaseThread());
   if (stateObserverRegistered(observer)) {
     throw FbossError("State observer add failed: ", name, " already exists");
   }
-  stateObservers_.emplace(observer, name);
+  stateObservers_.add(observer, name, mode);
 }
 
 void SwSwitch::notifyStateObservers(const StateDelta& delta) {
@@ -703,16 +758,7 @@ void SwSwitch::notifyStateObservers(const StateDelta& delta) {
     // Make sure the SwSwitch is not already being destroyed
     return;
   }
-  for (auto observerName : stateObservers_) {
-    try {
-      auto observer = observerName.first;
-      observer->stateUpdated(delta);
-    } catch (const std::exception& ex) {
-      // TODO: Figure out the best way to handle errors here.
-      XLOG(FATAL) << "error notifying " << observerName.second
-                  << " of update: " << folly::exceptionStr(ex);
-    }
-  }
+  stateObservers_.notify(delta);
 }
 
 bool SwSwitch::updateState(unique_ptr<StateUpdate> update) {
@@ -1075,6 +1121,17 @@ void SwSwitch::setPortStatusCounter(PortID port, bool up) {
 }
 
 void SwSwitch::packetReceived(std::unique_ptr<RxPacket> pkt) noexcept {
+  if (rxPacketDispatcher_) {
+    PortID port = pkt->getSrcPort();
+    if (!rxPacketDispatcher_->dispatch(std::move(pkt))) {
+      portStats(port)->pktDropped();
+    }
+    return;
+  }
+  handlePacketNoThrow(std::move(pkt));
+}
+
+void SwSwitch::handlePacketNoThrow(std::unique_ptr<RxPacket> pkt) noexcept {
   PortID port = pkt->getSrcPort();
   try {
     handlePacket(std::move(pkt));
@@ -1123,26 +1180,28 @@ void SwSwitch::handlePacket(std::unique_ptr<RxPacket> pkt) {
   }
 
   // Parse the source and destination MAC, as well as the ethertype.
+  const auto& l2Header = pkt->getL2Header();
+  auto dstMac = l2Header.dstMac;
+  auto srcMac = l2Header.srcMac;
+  auto ethertype = l2Header.ethertype;
   Cursor c(pkt->buf());
-  auto dstMac = PktUtil::readMac(&c);
-  auto srcMac = PktUtil::readMac(&c);
-  auto ethertype = c.readBE<uint16_t>();
-  if (ethertype == 0x8100) {
-    // 802.1Q
-    c += 2; // Advance over the VLAN tag.  We ignore it for now
-    ethertype = c.readBE<uint16_t>();
-  }
-
-  std::stringstream ss;
-  ss << "trapped packet: src_port=" << pkt->getSrcPort() << " srcAggPort="
-     << (pkt->isFromAggregatePort()
-             ? folly::to<string>(pkt->getSrcAggregatePort())
-             : "None")
-     << " vlan=" << pkt->getSrcVlan() << " length=" << len << " src=" << srcMac
-     << " dst=" << dstMac << " ethertype=0x" << std::hex << ethertype
-     << " :: " << pkt->describeDetails();
-  XLOG(DBG5) << ss.str();
-  XLOG_EVERY_N(DBG2, 10000) << "sampled " << ss.str();
+  c += l2Header.l3Offset;
+
+  // Only formatted when the log message is actually emitted, XLOG does not
+  // evaluate its stream arguments for disabled levels
+  auto describe = [&]() {
+    std::stringstream ss;
+    ss << "trapped packet: src_port=" << pkt->getSrcPort() << " srcAggPort="
+       << (pkt->isFromAggregatePort()
+               ? folly::to<string>(pkt->getSrcAggregatePort())
+               : "None")
+       << " vlan=" << pkt->getSrcVlan() << " length=" << len
+       << " src=" << srcMac << " dst=" << dstMac << " ethertype=0x"
+       << std::hex << ethertype << " :: " << pkt->describeDetails();
+    return ss.str();
+  };
+  XLOG(DBG5) << describe();
+  XLOG_EVERY_N(DBG2, 10000) << "sampled " << describe();
 
   switch (ethertype) {
     case ArpHandler::ETHERTYPE_ARP:
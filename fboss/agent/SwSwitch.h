@@ -11,6 +11,7 @@
 
 #include "fboss/agent/HwSwitch.h"
 #include "fboss/agent/RestartTimeTracker.h"
+#include "fboss/agent/StateObserverNotifier.h"
 #include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
 #include "fboss/agent/ThreadHeartbeat.h"
 #include "fboss/agent/Utils.h"
@@ -51,6 +52,7 @@ class PortDescriptor;
 class PortStats;
 class PortUpdateHandler;
 class RxPacket;
+class RxPacketDispatcher;
 class SwitchState;
 class SwitchStats;
 class StateDelta;
@@ -316,12 +318,23 @@ class SwSwitch : public HwSwitch::Callback {
    * all state updates that occur and all classes that care about state updates
    * should register using this api.
    *
-   * The only required method for observers is stateUpdated and observers can
-   * count on this always being called from the update thread.
+   * The only required method for observers is stateUpdated. SYNC observers
+   * can count on this always being called from the update thread, before the
+   * next update is applied. ASYNC observers are called in order on a worker
+   * thread, and must not rely on anything but the delta they are given.
    */
-  void registerStateObserver(StateObserver* observer, const std::string name);
+  void registerStateObserver(
+      StateObserver* observer,
+      const std::string name,
+      StateObserverNotifier::Mode mode = StateObserverNotifier::Mode::SYNC);
   void unregisterStateObserver(StateObserver* observer);
 
+  /*
+   * Wait for the ASYNC state observers to be done with the updates applied
+   * so far.
+   */
+  void waitForAsyncStateObservers();
+
   /*
    * Signal to the switch that initial config is applied.
    * The switch may then use this to start certain functions
@@ -781,6 +794,7 @@ class SwSwitch : public HwSwitch::Callback {
   void setSwitchRunState(SwitchRunState desiredState);
   SwitchStats* createSwitchStats();
   void handlePacket(std::unique_ptr<RxPacket> pkt);
+  void handlePacketNoThrow(std::unique_ptr<RxPacket> pkt) noexcept;
 
   static void handlePendingUpdatesHelper(SwSwitch* sw);
   void handlePendingUpdates();
@@ -800,7 +814,10 @@ class SwSwitch : public HwSwitch::Callback {
    * called from the update thread, if the update thread is running.
    */
   bool stateObserverRegistered(StateObserver* observer);
-  void addStateObserver(StateObserver* observer, const std::string& name);
+  void addStateObserver(
+      StateObserver* observer,
+      const std::string& name,
+      StateObserverNotifier::Mode mode);
   void removeStateObserver(StateObserver* observer);
 
   /*
@@ -924,17 +941,19 @@ class SwSwitch : public HwSwitch::Callback {
       neighborListener_{nullptr};
 
   /*
-   * The list of classes to notify on a state update. This container should only
-   * be accessed/modified from the update thread. This removes the need for
-   * locking when we access the container during a state update.
+   * The classes to notify on a state update. Observers should only be
+   * added/removed from the update thread. This removes the need for
+   * locking when we access them during a state update.
    */
-  std::map<StateObserver*, std::string> stateObservers_;
+  StateObserverNotifier stateObservers_;
 
   std::unique_ptr<ArpHandler> arp_;
   std::unique_ptr<IPv4Handler> ipv4_;
   std::unique_ptr<IPv6Handler> ipv6_;
   std::unique_ptr<NeighborUpdater> nUpdater_;
   std::unique_ptr<PktCaptureManager> pcapMgr_;
+  // Set if trapped packets are handled off the HwSwitch rx thread
+  std::unique_ptr<RxPacketDispatcher> rxPacketDispatcher_;
   std::unique_ptr<MirrorManager> mirrorManager_;
   std::unique_ptr<MPLSHandler> mplsHandler_;
   std::unique_ptr<PacketLogger> packetLogger_;
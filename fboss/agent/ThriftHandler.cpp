@@ -43,6 +43,7 @@
 #include "fboss/agent/state/LabelForwardingEntry.h"
 #include "fboss/agent/state/NdpEntry.h"
 #include "fboss/agent/state/NdpTable.h"
+#include "fboss/agent/state/NodeJsonPath.h"
 #include "fboss/agent/state/Port.h"
 #include "fboss/agent/state/PortQueue.h"
 #include "fboss/agent/state/Route.h"
@@ -1059,9 +1060,10 @@ void ThriftHandler::getCurrentStateJSON(
   if (!jsonPtr) {
     throw FbossError("Malformed JSON Pointer");
   }
-  auto swState = sw_->getState()->toFollyDynamic();
-  auto dyn = swState.get_ptr(jsonPtr.value());
-  ret = folly::json::serialize(*dyn, folly::json::serialization_opts{});
+  // Only serializes the part of the state the pointer goes to
+  auto dyn =
+      NodeJsonPath<SwitchState>::get(*sw_->getState(), jsonPtr->tokens(), 0);
+  ret = folly::json::serialize(dyn, folly::json::serialization_opts{});
 }
 
 void ThriftHandler::patchCurrentStateJSON(
@@ -1076,16 +1078,12 @@ void ThriftHandler::patchCurrentStateJSON(
   if (!jsonPtr) {
     throw FbossError("Malformed JSON Pointer");
   }
+  auto patch = folly::parseJson(*jsonPatchStr);
   // OK to capture by reference because the update call below is blocking
   auto updateFn = [&](const shared_ptr<SwitchState>& oldState) {
-    auto fullDynamic = oldState->toFollyDynamic();
-    auto* partialDynamic = fullDynamic.get_ptr(jsonPtr.value());
-    if (!partialDynamic) {
-      throw FbossError("JSON Pointer does not address proper object");
-    }
-    // mutates in place, i.e. modifies fullDynamic too
-    partialDynamic->merge_patch(folly::parseJson(*jsonPatchStr));
-    return SwitchState::fromFollyDynamic(fullDynamic);
+    // Rebuilds the patched node only, the rest of the state is shared
+    return NodeJsonPath<SwitchState>::mergePatch(
+        *oldState, jsonPtr->tokens(), 0, patch);
   };
   sw_->updateStateBlocking("JSON patch", std::move(updateFn));
 }
@@ -32,6 +32,18 @@ extern "C" {
 #include "fboss/agent/TxPacket.h"
 #include "fboss/agent/packet/EthHdr.h"
 
+#include <cstring>
+#include <functional>
+#include <thread>
+
+DEFINE_int32(
+    tun_intf_queues,
+    1,
+    "Number of queues of the tun interfaces, each with its own fd. Packets "
+    "the host sends are spread over the queues by the kernel, packets sent to "
+    "the host by each thread go through one of them. Existing interfaces "
+    "keep the queue mode they were created with.");
+
 namespace facebook::fboss {
 
 namespace {
@@ -176,6 +188,9 @@ TunIntf::~TunIntf() {
 
 void TunIntf::stop() {
   unregisterHandler();
+  for (auto& queue : queues_) {
+    queue->stop();
+  }
 }
 
 void TunIntf::start() {
@@ -183,47 +198,82 @@ void TunIntf::start() {
     changeHandlerFD(folly::NetworkSocket::fromFd(fd_));
     registerHandler(folly::EventHandler::READ | folly::EventHandler::PERSIST);
   }
+  for (auto& queue : queues_) {
+    queue->start();
+  }
 }
 
 void TunIntf::openFD() {
-  fd_ = open(kTunDev.c_str(), O_RDWR);
-  sysCheckError(fd_, "Cannot open ", kTunDev.c_str());
+  fd_ = openQueueFD();
   SCOPE_FAIL {
     closeFD();
   };
 
+  // Set configured MTU
+  setMtu(mtu_);
+
+  // Attach the other queues of a multi-queue interface
+  if (multiQueue_) {
+    for (int i = 1; i < FLAGS_tun_intf_queues; ++i) {
+      queues_.push_back(
+          std::make_unique<Queue>(this, getEventBase(), openQueueFD()));
+    }
+  }
+
+  XLOG(INFO) << "Create/attach to tun interface " << name_ << " @ fd " << fd_
+             << " with " << getNumQueues() << " queues";
+}
+
+int TunIntf::openQueueFD() {
+  int fd = open(kTunDev.c_str(), O_RDWR);
+  sysCheckError(fd, "Cannot open ", kTunDev.c_str());
+  SCOPE_FAIL {
+    close(fd);
+  };
+
+  // The first fd decides of the queue mode, others attach with the same
+  bool multiQueue = fd_ == -1 ? FLAGS_tun_intf_queues > 1 : multiQueue_;
+
   struct ifreq ifr;
   memset(&ifr, 0, sizeof(ifr));
   // Flags: IFF_TUN   - TUN device (no Ethernet headers)
   //        IFF_NO_PI - Do not provide packet information
-  ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
+  //        IFF_MULTI_QUEUE - One fd per queue
+  ifr.ifr_flags = IFF_TUN | IFF_NO_PI | (multiQueue ? IFF_MULTI_QUEUE : 0);
   bzero(ifr.ifr_name, sizeof(ifr.ifr_name));
   size_t len = std::min(name_.size(), sizeof(ifr.ifr_name));
   memmove(ifr.ifr_name, name_.c_str(), len);
-  auto ret = ioctl(fd_, TUNSETIFF, (void*)&ifr);
+  auto ret = ioctl(fd, TUNSETIFF, (void*)&ifr);
+  if (ret < 0 && errno == EINVAL && fd_ == -1) {
+    // An existing interface can only be attached to in the queue mode it was
+    // created with, e.g. when --tun_intf_queues changed across restarts
+    XLOG(WARN) << "Interface " << name_ << " exists with"
+               << (multiQueue ? "out" : "") << " multiple queues, using "
+               << (multiQueue ? "one" : "one of them");
+    multiQueue = !multiQueue;
+    ifr.ifr_flags ^= IFF_MULTI_QUEUE;
+    ret = ioctl(fd, TUNSETIFF, (void*)&ifr);
+  }
   sysCheckError(ret, "Failed to create/attach interface ", name_);
-
-  // Set configured MTU
-  setMtu(mtu_);
+  multiQueue_ = multiQueue;
 
   // make fd non-blocking
-  auto flags = fcntl(fd_, F_GETFL);
-  sysCheckError(flags, "Failed to get flags from fd ", fd_);
+  auto flags = fcntl(fd, F_GETFL);
+  sysCheckError(flags, "Failed to get flags from fd ", fd);
   flags |= O_NONBLOCK;
-  ret = fcntl(fd_, F_SETFL, flags);
-  sysCheckError(
-      ret, "Failed to set non-blocking flags ", flags, " to fd ", fd_);
-  flags = fcntl(fd_, F_GETFD);
-  sysCheckError(flags, "Failed to get flags from fd ", fd_);
+  ret = fcntl(fd, F_SETFL, flags);
+  sysCheckError(ret, "Failed to set non-blocking flags ", flags, " to fd ", fd);
+  flags = fcntl(fd, F_GETFD);
+  sysCheckError(flags, "Failed to get flags from fd ", fd);
   flags |= FD_CLOEXEC;
-  ret = fcntl(fd_, F_SETFD, flags);
+  ret = fcntl(fd, F_SETFD, flags);
   sysCheckError(
-      ret, "Failed to set close-on-exec flags ", flags, " to fd ", fd_);
-
-  XLOG(INFO) << "Create/attach to tun interface " << name_ << " @ fd " << fd_;
+      ret, "Failed to set close-on-exec flags ", flags, " to fd ", fd);
+  return fd;
 }
 
 void TunIntf::closeFD() noexcept {
+  queues_.clear();
   auto ret = close(fd_);
   sysLogError(ret, "Failed to close fd ", fd_, " for interface ", name_);
   if (ret == 0) {
@@ -314,7 +364,13 @@ void TunIntf::disableIPv6AddrGenMode(int ifIndex) {
 }
 
 void TunIntf::handlerReady(uint16_t /*events*/) noexcept {
-  CHECK(fd_ != -1);
+  if (!readPackets(fd_)) {
+    unregisterHandler();
+  }
+}
+
+bool TunIntf::readPackets(int fd) noexcept {
+  CHECK(fd != -1);
 
   // Since this is L3 packet size, we should also reserve some space for L2
   // header, which is 18 bytes (including one vlan tag)
@@ -329,11 +385,11 @@ void TunIntf::handlerReady(uint16_t /*events*/) noexcept {
       auto buf = pkt->buf();
       int ret = 0;
       do {
-        ret = read(fd_, buf->writableTail(), buf->tailroom());
+        ret = read(fd, buf->writableTail(), buf->tailroom());
       } while (ret == -1 && errno == EINTR);
       if (ret < 0) {
         if (errno != EAGAIN) {
-          sysLogError(ret, "Failed to read on ", fd_);
+          sysLogError(ret, "Failed to read on ", fd);
           // Cannot continue read on this fd
           fdFail = true;
         }
@@ -362,16 +418,13 @@ void TunIntf::handlerReady(uint16_t /*events*/) noexcept {
                              << folly::exceptionStr(ex);
   }
 
-  if (fdFail) {
-    unregisterHandler();
-  }
-
   XLOG(DBG4) << "Forwarded " << sent << " packets (" << bytes
-             << " bytes) from host @ fd " << fd_ << " for interface " << name_;
+             << " bytes) from host @ fd " << fd << " for interface " << name_;
   if (dropped) {
-    XLOG(DBG3) << "Dropped " << dropped << " packets from host @ fd " << fd_
+    XLOG(DBG3) << "Dropped " << dropped << " packets from host @ fd " << fd
                << " for interface " << name_;
   }
+  return !fdFail;
 }
 
 bool TunIntf::sendPacketToHost(std::unique_ptr<RxPacket> pkt) {
@@ -387,9 +440,19 @@ bool TunIntf::sendPacketToHost(std::unique_ptr<RxPacket> pkt) {
   // skip L2 header
   buf->trimStart(l2Len);
 
+  // Each thread sends through one queue, keeping its packets in order
+  int fd = fd_;
+  if (!queues_.empty()) {
+    auto queue = std::hash<std::thread::id>()(std::this_thread::get_id()) %
+        getNumQueues();
+    if (queue > 0) {
+      fd = queues_[queue - 1]->fd();
+    }
+  }
+
   int ret = 0;
   do {
-    ret = write(fd_, buf->data(), buf->length());
+    ret = write(fd, buf->data(), buf->length());
   } while (ret == -1 && errno == EINTR);
   if (ret < 0) {
     sysLogError(ret, "Failed to send packet to host from Interface ", ifID_);
@@ -405,4 +468,31 @@ bool TunIntf::sendPacketToHost(std::unique_ptr<RxPacket> pkt) {
   return true;
 }
 
+TunIntf::Queue::Queue(TunIntf* intf, folly::EventBase* evb, int fd)
+    : folly::EventHandler(evb), intf_(intf), fd_(fd) {}
+
+TunIntf::Queue::~Queue() {
+  stop();
+  auto ret = close(fd_);
+  sysLogError(
+      ret, "Failed to close fd ", fd_, " for interface ", intf_->getName());
+}
+
+void TunIntf::Queue::start() {
+  if (!isHandlerRegistered()) {
+    changeHandlerFD(folly::NetworkSocket::fromFd(fd_));
+    registerHandler(folly::EventHandler::READ | folly::EventHandler::PERSIST);
+  }
+}
+
+void TunIntf::Queue::stop() {
+  unregisterHandler();
+}
+
+void TunIntf::Queue::handlerReady(uint16_t /*events*/) noexcept {
+  if (!intf_->readPackets(fd_)) {
+    unregisterHandler();
+  }
+}
+
 } // namespace facebook::fboss
@@ -11,14 +11,20 @@
 
 #include <folly/io/async/EventBase.h>
 #include <folly/io/async/EventHandler.h>
+#include <gflags/gflags.h>
 #include "fboss/agent/state/Interface.h"
 #include "fboss/agent/state/StateUtils.h"
 #include "fboss/agent/types.h"
 
+#include <vector>
+
+DECLARE_int32(tun_intf_queues);
+
 namespace facebook::fboss {
 
 class SwSwitch;
 class RxPacket;
+class TxPacket;
 
 class TunIntf : private folly::EventHandler {
  public:
@@ -87,7 +93,9 @@ class TunIntf : private folly::EventHandler {
   /**
    * Send a packet to the interface on host.
    * Unlike other methods, which are called on thread that serves the evb,
-   * this function can be called from any thread.
+   * this function can be called from any thread, by a holder of a reference
+   * to the interface. With several queues, each thread sends through its own
+   * queue.
    *
    * @return true The packet is sent to host
    *         false The packet is dropped due to errors
@@ -123,20 +131,62 @@ class TunIntf : private folly::EventHandler {
     return status_;
   }
 
+  int getNumQueues() const {
+    return queues_.size() + 1;
+  }
+
  private:
+  /**
+   * Additional queue of a multi-queue Tun interface, read from on the same
+   * evb as the first one (fd_).
+   */
+  class Queue : private folly::EventHandler {
+   public:
+    Queue(TunIntf* intf, folly::EventBase* evb, int fd);
+    ~Queue() override;
+
+    void start();
+    void stop();
+
+    int fd() const {
+      return fd_;
+    }
+
+   private:
+    void handlerReady(uint16_t events) noexcept override;
+
+    TunIntf* intf_;
+    int fd_;
+  };
+
   /**
    * Callback for event on Tun interface's read socket-fd
    * Override's folly::EventHandler handlerReady callback.
    */
   void handlerReady(uint16_t events) noexcept override;
 
+  /**
+   * Read packets sent by the host on one queue of the interface and forward
+   * them.
+   *
+   * @return false The fd cannot be read anymore
+   */
+  bool readPackets(int fd) noexcept;
+
   /**
    * Open/Close a new socket-fd to read/write data from Tun interface.
-   * fd_ is mutated.
+   * fd_ and queues_ are mutated, only ever from the constructor and the
+   * destructor: senders read them without locking.
    */
   void openFD();
   void closeFD() noexcept;
 
+  /**
+   * Open an fd to the Tun interface, creating it if need be. Sets multiQueue_
+   * according to whether the interface has multiple queues.
+   */
+  int openQueueFD();
+
   /**
    * In newer kernel an interface is automatically gets link-local IPv6 address
    * because of IPv6 autoconf and FBOSS (we) assign one more.
@@ -163,6 +213,13 @@ class TunIntf : private folly::EventHandler {
    */
   int fd_{-1};
   int mtu_{-1};
+
+  // Whether the interface was created with IFF_MULTI_QUEUE
+  bool multiQueue_{false};
+  // Queues other than fd_'s, with --tun_intf_queues > 1. Like fd_, fixed for
+  // the lifetime of the interface, which senders hold a reference to (see
+  // TunManager::intfs_), as they read it without locking.
+  std::vector<std::unique_ptr<Queue>> queues_;
 };
 
 } // namespace facebook::fboss
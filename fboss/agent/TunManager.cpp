@@ -33,6 +33,8 @@ extern "C" {
 
 #include <boost/container/flat_set.hpp>
 
+#include <shared_mutex>
+
 namespace {
 const int kDefaultMtu = 1500;
 }
@@ -59,7 +61,7 @@ TunManager::~TunManager() {
     sw_->unregisterStateObserver(this);
   }
 
-  std::lock_guard<std::mutex> lock(mutex_);
+  std::lock_guard<folly::SharedMutex> lock(mutex_);
   stop();
   nl_close(sock_);
   nl_socket_free(sock_);
@@ -89,14 +91,18 @@ void TunManager::stateUpdated(const StateDelta& delta) {
 bool TunManager::sendPacketToHost(
     InterfaceID dstIfID,
     std::unique_ptr<RxPacket> pkt) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  auto iter = intfs_.find(dstIfID);
-  if (iter == intfs_.end()) {
-    // the Interface ID has been deleted, make a log, and skip the pkt
-    XLOG(DBG4) << "Dropping a packet for unknown interface " << dstIfID;
-    return false;
+  std::shared_ptr<TunIntf> intf;
+  {
+    std::shared_lock<folly::SharedMutex> lock(mutex_);
+    auto iter = intfs_.find(dstIfID);
+    if (iter == intfs_.end()) {
+      // the Interface ID has been deleted, make a log, and skip the pkt
+      XLOG(DBG4) << "Dropping a packet for unknown interface " << dstIfID;
+      return false;
+    }
+    intf = iter->second;
   }
-  return iter->second->sendPacketToHost(std::move(pkt));
+  return intf->sendPacketToHost(std::move(pkt));
 }
 
 void TunManager::addExistingIntf(const std::string& ifName, int ifIndex) {
@@ -109,8 +115,8 @@ void TunManager::addExistingIntf(const std::string& ifName, int ifIndex) {
   SCOPE_FAIL {
     intfs_.erase(ret.first);
   };
-  ret.first->second.reset(
-      new TunIntf(sw_, evb_, ifID, ifIndex, getInterfaceMtu(ifID)));
+  ret.first->second = std::make_shared<TunIntf>(
+      sw_, evb_, ifID, ifIndex, getInterfaceMtu(ifID));
 }
 
 void TunManager::addNewIntf(
@@ -125,7 +131,7 @@ void TunManager::addNewIntf(
   SCOPE_FAIL {
     intfs_.erase(ret.first);
   };
-  auto intf = std::make_unique<TunIntf>(
+  auto intf = std::make_shared<TunIntf>(
       sw_, evb_, ifID, isUp, addrs, getInterfaceMtu(ifID));
 
   SCOPE_FAIL {
@@ -165,6 +171,8 @@ void TunManager::removeIntf(InterfaceID ifID) {
   // Remove the route table and associated rule
   removeRouteTable(ifID, intf->getIfIndex());
   intf->setDelete();
+  // A sender may still hold the interface, stop reading from it here
+  intf->stop();
   intfs_.erase(iter);
 }
 
@@ -554,11 +562,11 @@ void TunManager::addressProcessor(struct nl_object* obj, void* data) {
 }
 
 void TunManager::probe() {
-  std::lock_guard<std::mutex> lock(mutex_);
+  std::lock_guard<folly::SharedMutex> lock(mutex_);
   doProbe(lock);
 }
 
-void TunManager::doProbe(std::lock_guard<std::mutex>& /* lock */) {
+void TunManager::doProbe(std::lock_guard<folly::SharedMutex>& /* lock */) {
   const auto startTs = std::chrono::steady_clock::now();
   SCOPE_EXIT {
     const auto endTs = std::chrono::steady_clock::now();
@@ -664,7 +672,7 @@ void TunManager::sync(std::shared_ptr<SwitchState> state) {
   }
 
   // Hold mutex while changing interfaces
-  std::lock_guard<std::mutex> lock(mutex_);
+  std::lock_guard<folly::SharedMutex> lock(mutex_);
   if (!probeDone_) {
     doProbe(lock);
   }
@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <folly/SharedMutex.h>
 #include <folly/io/async/EventBase.h>
 #include "fboss/agent/StateObserver.h"
 #include "fboss/agent/state/Interface.h"
@@ -183,7 +184,7 @@ class TunManager : public StateObserver {
   /**
    * Lookup host for existing Tun interfaces and their addresses.
    */
-  virtual void doProbe(std::lock_guard<std::mutex>& mutex);
+  virtual void doProbe(std::lock_guard<folly::SharedMutex>& mutex);
 
   /**
    * Add an address to a TUN interface during probe process.
@@ -224,10 +225,14 @@ class TunManager : public StateObserver {
   /**
    * The mutex used to protect `intfs_` which can be used by
    * sync() could manipulate intfs_. Called on the thread that serves evb_.
-   * sendPacketToHost() uses intfs_, it can be called from any thread.
+   * sendPacketToHost() uses intfs_, it can be called from any thread. It
+   * only holds the mutex, shared, to look the interface up and then sends
+   * through its own reference, so senders don't serialize on each other nor
+   * on sync(). An interface removed meanwhile goes away with the last
+   * reference.
    */
-  boost::container::flat_map<InterfaceID, std::unique_ptr<TunIntf>> intfs_;
-  std::mutex mutex_;
+  boost::container::flat_map<InterfaceID, std::shared_ptr<TunIntf>> intfs_;
+  folly::SharedMutex mutex_;
 
   // Whether the manager has registered itself to listen for state updates
   // from sw_
@@ -67,6 +67,12 @@ void HwFb303Stats::removeStat(const std::string& statName) {
   counters_.erase(stat->getName());
 }
 
+stats::MonotonicCounter* HwFb303Stats::getCounter(const std::string& statName) {
+  auto stat = getCounterIf(statName);
+  CHECK(stat) << "Missing stat: " << statName;
+  return stat;
+}
+
 void HwFb303Stats::updateStat(
     const std::chrono::seconds& now,
     const std::string& statName,
@@ -35,6 +35,12 @@ class HwFb303Stats {
       const std::string& statName,
       int64_t val);
   void removeStat(const std::string& statName);
+  /*
+   * Resolve a stat once so that hot update paths can skip the name
+   * lookup. The returned counter stays valid until the stat is reinited
+   * under a different name or removed.
+   */
+  stats::MonotonicCounter* getCounter(const std::string& statName);
 
  private:
   /*
@@ -44,6 +50,7 @@ class HwFb303Stats {
   const stats::MonotonicCounter* getCounterIf(
       const std::string& statName) const;
 
-  folly::F14FastMap<std::string, stats::MonotonicCounter> counters_;
+  // Node map, since getCounter() hands out pointers into it
+  folly::F14NodeMap<std::string, stats::MonotonicCounter> counters_;
 };
 } // namespace facebook::fboss
@@ -126,6 +126,7 @@ void HwPortFb303Stats::reinitStats(std::optional<std::string> oldPortName) {
   if (macsecStatsInited_) {
     reinitMacsecStats(oldPortName);
   }
+  resolveCounters();
 }
 
 /*
@@ -142,6 +143,7 @@ void HwPortFb303Stats::reinitMacsecStats(
   reinitStats(kOutMacsecPortStatKeys());
 
   macsecStatsInited_ = true;
+  resolveCounters();
 }
 /*
  * Reinit port stat
@@ -179,6 +181,7 @@ void HwPortFb303Stats::queueChanged(int queueId, const std::string& queueName) {
   for (auto statKey : kQueueStatKeys()) {
     reinitStat(statKey, queueId, oldQueueName);
   }
+  resolveCounters();
 }
 
 void HwPortFb303Stats::queueRemoved(int queueId) {
@@ -188,90 +191,84 @@ void HwPortFb303Stats::queueRemoved(int queueId) {
         statName(statKey, portName_, queueId, queueId2Name_[queueId]));
   }
   queueId2Name_.erase(queueId);
+  resolveCounters();
+}
+
+template <size_t N>
+void HwPortFb303Stats::updateCounters(
+    const std::chrono::seconds& now,
+    const std::array<stats::MonotonicCounter*, N>& counters,
+    const std::array<int64_t, N>& values) {
+  for (size_t i = 0; i < N; ++i) {
+    counters[i]->updateValue(now, values[i]);
+  }
 }
 
 void HwPortFb303Stats::updateStats(
     const HwPortStats& curPortStats,
     const std::chrono::seconds& retrievedAt) {
   timeRetrieved_ = retrievedAt;
-  updateStat(timeRetrieved_, kInBytes(), *curPortStats.inBytes__ref());
-  updateStat(
-      timeRetrieved_, kInUnicastPkts(), *curPortStats.inUnicastPkts__ref());
-  updateStat(
-      timeRetrieved_, kInMulticastPkts(), *curPortStats.inMulticastPkts__ref());
-  updateStat(
-      timeRetrieved_, kInBroadcastPkts(), *curPortStats.inBroadcastPkts__ref());
-  updateStat(
-      timeRetrieved_, kInDiscardsRaw(), *curPortStats.inDiscardsRaw__ref());
-  updateStat(timeRetrieved_, kInDiscards(), *curPortStats.inDiscards__ref());
-  updateStat(timeRetrieved_, kInErrors(), *curPortStats.inErrors__ref());
-  updateStat(timeRetrieved_, kInPause(), *curPortStats.inPause__ref());
-  updateStat(
-      timeRetrieved_, kInIpv4HdrErrors(), *curPortStats.inIpv4HdrErrors__ref());
-  updateStat(
-      timeRetrieved_, kInIpv6HdrErrors(), *curPortStats.inIpv6HdrErrors__ref());
-  updateStat(
-      timeRetrieved_,
-      kInDstNullDiscards(),
-      *curPortStats.inDstNullDiscards__ref());
-  // Egress Stats
-  updateStat(timeRetrieved_, kOutBytes(), *curPortStats.outBytes__ref());
-  updateStat(
-      timeRetrieved_, kOutUnicastPkts(), *curPortStats.outUnicastPkts__ref());
-  updateStat(
-      timeRetrieved_,
-      kOutMulticastPkts(),
-      *curPortStats.outMulticastPkts__ref());
-  updateStat(
-      timeRetrieved_,
-      kOutBroadcastPkts(),
-      *curPortStats.outBroadcastPkts__ref());
-  updateStat(timeRetrieved_, kOutDiscards(), *curPortStats.outDiscards__ref());
-  updateStat(timeRetrieved_, kOutErrors(), *curPortStats.outErrors__ref());
-  updateStat(timeRetrieved_, kOutPause(), *curPortStats.outPause__ref());
-  updateStat(
-      timeRetrieved_,
-      kOutCongestionDiscards(),
-      *curPortStats.outCongestionDiscardPkts__ref());
-  updateStat(
-      timeRetrieved_,
-      kWredDroppedPackets(),
-      *curPortStats.wredDroppedPackets__ref());
-  updateStat(
-      timeRetrieved_, kOutEcnCounter(), *curPortStats.outEcnCounter__ref());
-  updateStat(
-      timeRetrieved_,
-      kFecCorrectable(),
-      *curPortStats.fecCorrectableErrors_ref());
-  updateStat(
+  // Values in kPortStatKeys() order
+  updateCounters(
       timeRetrieved_,
-      kFecUncorrectable(),
-      *curPortStats.fecUncorrectableErrors_ref());
+      portStatCounters_,
+      {
+          *curPortStats.inBytes__ref(),
+          *curPortStats.inUnicastPkts__ref(),
+          *curPortStats.inMulticastPkts__ref(),
+          *curPortStats.inBroadcastPkts__ref(),
+          *curPortStats.inDiscards__ref(),
+          *curPortStats.inErrors__ref(),
+          *curPortStats.inPause__ref(),
+          *curPortStats.inIpv4HdrErrors__ref(),
+          *curPortStats.inIpv6HdrErrors__ref(),
+          *curPortStats.inDstNullDiscards__ref(),
+          *curPortStats.inDiscardsRaw__ref(),
+          // Egress Stats
+          *curPortStats.outBytes__ref(),
+          *curPortStats.outUnicastPkts__ref(),
+          *curPortStats.outMulticastPkts__ref(),
+          *curPortStats.outBroadcastPkts__ref(),
+          *curPortStats.outDiscards__ref(),
+          *curPortStats.outErrors__ref(),
+          *curPortStats.outPause__ref(),
+          *curPortStats.outCongestionDiscardPkts__ref(),
+          *curPortStats.wredDroppedPackets__ref(),
+          *curPortStats.outEcnCounter__ref(),
+          *curPortStats.fecCorrectableErrors_ref(),
+          *curPortStats.fecUncorrectableErrors_ref(),
+      });
 
   // Update queue stats
-  auto updateQueueStat = [this](
-                             folly::StringPiece statKey,
-                             int queueId,
-                             const std::map<int16_t, int64_t>& queueStats) {
+  auto queueStat = [this](
+                       folly::StringPiece statKey,
+                       int queueId,
+                       const std::map<int16_t, int64_t>& queueStats) {
     auto qitr = queueStats.find(queueId);
     CHECK(qitr != queueStats.end())
         << "Missing stat: " << statKey
         << " for queue: :" << queueId2Name_[queueId];
-    updateStat(timeRetrieved_, statKey, queueId, qitr->second);
+    return qitr->second;
   };
   for (const auto& queueIdAndName : queueId2Name_) {
-    updateQueueStat(
-        kOutCongestionDiscardsBytes(),
-        queueIdAndName.first,
-        *curPortStats.queueOutDiscardBytes__ref());
-    updateQueueStat(
-        kOutCongestionDiscards(),
-        queueIdAndName.first,
-        *curPortStats.queueOutDiscardPackets__ref());
-    updateQueueStat(
-        kOutBytes(), queueIdAndName.first, *curPortStats.queueOutBytes__ref());
-    updateQueueStat(
-        kOutPkts(), queueIdAndName.first, *curPortStats.queueOutPackets__ref());
+    auto queueId = queueIdAndName.first;
+    // Values in kQueueStatKeys() order
+    updateCounters(
+        timeRetrieved_,
+        queueStatCounters_[queueId],
+        {
+            queueStat(
+                kOutCongestionDiscardsBytes(),
+                queueId,
+                *curPortStats.queueOutDiscardBytes__ref()),
+            queueStat(
+                kOutCongestionDiscards(),
+                queueId,
+                *curPortStats.queueOutDiscardPackets__ref()),
+            queueStat(kOutBytes(), queueId, *curPortStats.queueOutBytes__ref()),
+            queueStat(
+                kOutPkts(), queueId, *curPortStats.queueOutPackets__ref()),
+        });
   }
   if (curPortStats.queueWatermarkBytes__ref()->size()) {
     updateQueueWatermarkStats(*curPortStats.queueWatermarkBytes__ref());
@@ -281,100 +278,69 @@ void HwPortFb303Stats::updateStats(
     if (!macsecStatsInited_) {
       reinitMacsecStats(std::nullopt);
     }
-    auto updateMacsecPortStats = [this](auto& macsecPortStats, bool ingress) {
-      updateStat(
-          timeRetrieved_,
-          ingress ? kInPreMacsecDropPkts() : kOutPreMacsecDropPkts(),
-          *macsecPortStats.preMacsecDropPkts_ref());
-      updateStat(
-          timeRetrieved_,
-          ingress ? kInMacsecDataPkts() : kOutMacsecDataPkts(),
-          *macsecPortStats.dataPkts_ref());
-      updateStat(
-          timeRetrieved_,
-          ingress ? kInMacsecControlPkts() : kOutMacsecControlPkts(),
-          *macsecPortStats.controlPkts_ref());
-      updateStat(
-          timeRetrieved_,
-          ingress ? kInMacsecDecryptedBytes() : kOutMacsecEncryptedBytes(),
-          *macsecPortStats.octetsEncrypted_ref());
-      if (ingress) {
-        updateStat(
-            timeRetrieved_,
-            kInMacsecBadOrNoTagDroppedPkts(),
-            *macsecPortStats.inBadOrNoMacsecTagDroppedPkts_ref());
-        updateStat(
-            timeRetrieved_,
-            kInMacsecNoSciDroppedPkts(),
-            *macsecPortStats.inNoSciDroppedPkts_ref());
-        updateStat(
-            timeRetrieved_,
-            kInMacsecUnknownSciPkts(),
-            *macsecPortStats.inUnknownSciPkts_ref());
-        updateStat(
-            timeRetrieved_,
-            kInMacsecOverrunDroppedPkts(),
-            *macsecPortStats.inOverrunDroppedPkts_ref());
-        updateStat(
-            timeRetrieved_,
-            kInMacsecDelayedPkts(),
-            *macsecPortStats.inDelayedPkts_ref());
-        updateStat(
-            timeRetrieved_,
-            kInMacsecLateDroppedPkts(),
-            *macsecPortStats.inLateDroppedPkts_ref());
-        updateStat(
-            timeRetrieved_,
-            kInMacsecNotValidDroppedPkts(),
-            *macsecPortStats.inNotValidDroppedPkts_ref());
-        updateStat(
-            timeRetrieved_,
-            kInMacsecInvalidPkts(),
-            *macsecPortStats.inInvalidPkts_ref());
-        updateStat(
-            timeRetrieved_,
-            kInMacsecNoSADroppedPkts(),
-            *macsecPortStats.inNoSaDroppedPkts_ref());
-        updateStat(
-            timeRetrieved_,
-            kInMacsecUnusedSAPkts(),
-            *macsecPortStats.inUnusedSaPkts_ref());
-        updateStat(
-            timeRetrieved_,
-            kInMacsecUntaggedPkts(),
-            *macsecPortStats.noMacsecTagPkts_ref());
-      } else {
-        updateStat(
-            timeRetrieved_,
-            kOutMacsecUntaggedPkts(),
-            *macsecPortStats.noMacsecTagPkts_ref());
-        updateStat(
-            timeRetrieved_,
-            kOutMacsecTooLongDroppedPkts(),
-            *macsecPortStats.outTooLongDroppedPkts_ref());
-      }
-    };
-    updateMacsecPortStats(
-        *curPortStats.macsecStats_ref()->ingressPortStats_ref(), true);
-    updateMacsecPortStats(
-        *curPortStats.macsecStats_ref()->egressPortStats_ref(), false);
+    const auto& ingressStats =
+        *curPortStats.macsecStats_ref()->ingressPortStats_ref();
+    // Values in kInMacsecPortStatKeys() order
+    updateCounters(
+        timeRetrieved_,
+        inMacsecStatCounters_,
+        {
+            *ingressStats.preMacsecDropPkts_ref(),
+            *ingressStats.controlPkts_ref(),
+            *ingressStats.dataPkts_ref(),
+            *ingressStats.octetsEncrypted_ref(),
+            *ingressStats.inBadOrNoMacsecTagDroppedPkts_ref(),
+            *ingressStats.inNoSciDroppedPkts_ref(),
+            *ingressStats.inUnknownSciPkts_ref(),
+            *ingressStats.inOverrunDroppedPkts_ref(),
+            *ingressStats.inDelayedPkts_ref(),
+            *ingressStats.inLateDroppedPkts_ref(),
+            *ingressStats.inNotValidDroppedPkts_ref(),
+            *ingressStats.inInvalidPkts_ref(),
+            *ingressStats.inNoSaDroppedPkts_ref(),
+            *ingressStats.inUnusedSaPkts_ref(),
+            *ingressStats.noMacsecTagPkts_ref(),
+        });
+    const auto& egressStats =
+        *curPortStats.macsecStats_ref()->egressPortStats_ref();
+    // Values in kOutMacsecPortStatKeys() order
+    updateCounters(
+        timeRetrieved_,
+        outMacsecStatCounters_,
+        {
+            *egressStats.preMacsecDropPkts_ref(),
+            *egressStats.controlPkts_ref(),
+            *egressStats.dataPkts_ref(),
+            *egressStats.octetsEncrypted_ref(),
+            *egressStats.outTooLongDroppedPkts_ref(),
+            *egressStats.noMacsecTagPkts_ref(),
+        });
   }
   portStats_ = curPortStats;
 }
 
-void HwPortFb303Stats::updateStat(
-    const std::chrono::seconds& now,
-    folly::StringPiece statKey,
-    int queueId,
-    int64_t val) {
-  portCounters_.updateStat(
-      now, statName(statKey, portName_, queueId, queueId2Name_[queueId]), val);
-}
-
-void HwPortFb303Stats::updateStat(
-    const std::chrono::seconds& now,
-    folly::StringPiece statKey,
-    int64_t val) {
-  portCounters_.updateStat(now, statName(statKey, portName_), val);
+void HwPortFb303Stats::resolveCounters() {
+  auto resolve = [this](const auto& keys, auto& counters) {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      counters[i] = portCounters_.getCounter(statName(keys[i], portName_));
+    }
+  };
+  resolve(kPortStatKeys(), portStatCounters_);
+  if (macsecStatsInited_) {
+    resolve(kInMacsecPortStatKeys(), inMacsecStatCounters_);
+    resolve(kOutMacsecPortStatKeys(), outMacsecStatCounters_);
+  }
+  queueStatCounters_.clear();
+  for (const auto& queueIdAndName : queueId2Name_) {
+    auto queueId = queueIdAndName.first;
+    if (queueId >= static_cast<int>(queueStatCounters_.size())) {
+      queueStatCounters_.resize(queueId + 1);
+    }
+    auto queueKeys = kQueueStatKeys();
+    for (size_t i = 0; i < queueKeys.size(); ++i) {
+      queueStatCounters_[queueId][i] = portCounters_.getCounter(statName(
+          queueKeys[i], portName_, queueId, queueIdAndName.second));
+    }
+  }
 }
 } // namespace facebook::fboss
@@ -15,8 +15,10 @@
 
 #include "folly/container/F14Map.h"
 
+#include <array>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -101,20 +103,16 @@ class HwPortFb303Stats {
       const std::string& statName,
       std::optional<std::string> oldStatName);
   /*
-   * update port stat
+   * Resolve counters for all port, queue and macsec stats, so that
+   * updateStats doesn't need to build stat names or look them up. Must
+   * be redone whenever a stat is reinited, added or removed.
    */
-  void updateStat(
+  void resolveCounters();
+  template <size_t N>
+  void updateCounters(
       const std::chrono::seconds& now,
-      folly::StringPiece statKey,
-      int64_t val);
-  /*
-   * update port queue stat
-   */
-  void updateStat(
-      const std::chrono::seconds& now,
-      folly::StringPiece statKey,
-      int queueId,
-      int64_t val);
+      const std::array<stats::MonotonicCounter*, N>& counters,
+      const std::array<int64_t, N>& values);
 
   void updateQueueWatermarkStats(
       const std::map<int16_t, int64_t>& queueWatermarkBytes) const;
@@ -124,6 +122,12 @@ class HwPortFb303Stats {
   QueueId2Name queueId2Name_;
   HwPortStats portStats_;
   bool macsecStatsInited_{false};
+  // Resolved counters, indexed in k*StatKeys() order. Queue counters are
+  // additionally indexed by queue id.
+  std::array<stats::MonotonicCounter*, 23> portStatCounters_{};
+  std::vector<std::array<stats::MonotonicCounter*, 4>> queueStatCounters_;
+  std::array<stats::MonotonicCounter*, 15> inMacsecStatCounters_{};
+  std::array<stats::MonotonicCounter*, 6> outMacsecStatCounters_{};
 };
 
 } // namespace facebook::fboss
@@ -11,20 +11,33 @@
 #include "fboss/agent/hw/HwSwitchWarmBootHelper.h"
 
 #include "fboss/agent/AsyncLogger.h"
+#include "fboss/agent/FbossError.h"
 #include "fboss/agent/SysError.h"
 #include "fboss/agent/Utils.h"
 
 #include "fboss/lib/CommonFileUtils.h"
 
+#include <folly/File.h>
 #include <folly/FileUtil.h>
+#include <folly/experimental/bser/Bser.h>
 #include <folly/json.h>
+#include <folly/lang/Bits.h>
 #include <folly/logging/xlog.h>
+#include <folly/system/MemoryMapping.h>
+
+#include <cstring>
 
 DEFINE_bool(can_warm_boot, true, "Enable/disable warm boot functionality");
 DEFINE_string(
     switch_state_file,
     "switch_state",
     "File for dumping switch state JSON in on exit");
+DEFINE_bool(
+    binary_warm_boot_state,
+    false,
+    "Store warm boot switch state in binary rather than JSON form. Agents "
+    "read either form, so this is safe to turn off again, but agents that "
+    "predate the binary format can't warm boot from it");
 
 namespace {
 constexpr auto wbFlagPrefix = "can_warm_boot_";
@@ -32,6 +45,15 @@ constexpr auto forceColdBootPrefix = "cold_boot_once_";
 constexpr auto shutdownDumpPrefix = "sdk_shutdown_dump_";
 constexpr auto startupDumpPrefix = "sdk_startup_dump_";
 
+// Bump on incompatible changes to the binary warm boot state layout
+constexpr uint32_t kWarmBootStateVersion = 1;
+constexpr char kWarmBootStateMagic[4] = {'F', 'B', 'W', 'B'};
+struct WarmBootStateHeader {
+  char magic[4];
+  // Little endian
+  uint32_t version;
+};
+
 } // namespace
 
 namespace facebook::fboss {
@@ -122,17 +144,60 @@ bool HwSwitchWarmBootHelper::checkAndClearWarmBootFlags() {
 
 bool HwSwitchWarmBootHelper::storeWarmBootState(
     const folly::dynamic& switchState) {
-  warmBootStateWritten_ =
-      dumpStateToFile(warmBootSwitchStateFile(), switchState);
+  auto format = FLAGS_binary_warm_boot_state ? StateFormat::BINARY
+                                             : StateFormat::JSON;
+  warmBootStateWritten_ = folly::writeFile(
+      serializeWarmBootState(switchState, format),
+      warmBootSwitchStateFile().c_str());
   return warmBootStateWritten_;
 }
 
 folly::dynamic HwSwitchWarmBootHelper::getWarmBootState() const {
-  std::string warmBootJson;
-  auto ret = folly::readFile(warmBootSwitchStateFile().c_str(), warmBootJson);
-  sysCheckError(
-      ret, "Unable to read switch state from : ", warmBootSwitchStateFile());
-  return folly::parseJson(warmBootJson);
+  auto fd = open(warmBootSwitchStateFile().c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw SysError(
+        errno, "Unable to read switch state from : ", warmBootSwitchStateFile());
+  }
+  // Parse straight out of the page cache rather than copying the file
+  folly::MemoryMapping mapping(folly::File(fd, true /* ownsFd */));
+  return deserializeWarmBootState(mapping.range());
+}
+
+std::string HwSwitchWarmBootHelper::serializeWarmBootState(
+    const folly::dynamic& switchState,
+    StateFormat format) {
+  if (format == StateFormat::JSON) {
+    return folly::toPrettyJson(switchState);
+  }
+  WarmBootStateHeader header;
+  std::memcpy(header.magic, kWarmBootStateMagic, sizeof(header.magic));
+  header.version = folly::Endian::little(kWarmBootStateVersion);
+  std::string serialized(
+      reinterpret_cast<const char*>(&header), sizeof(header));
+  serialized.append(
+      folly::bser::toBser(switchState, folly::bser::serialization_opts())
+          .toStdString());
+  return serialized;
+}
+
+folly::dynamic HwSwitchWarmBootHelper::deserializeWarmBootState(
+    folly::ByteRange data) {
+  WarmBootStateHeader header;
+  if (data.size() < sizeof(header) ||
+      std::memcmp(data.data(), kWarmBootStateMagic, sizeof(header.magic))) {
+    return folly::parseJson(folly::StringPiece(data));
+  }
+  std::memcpy(&header, data.data(), sizeof(header));
+  auto version = folly::Endian::little(header.version);
+  if (version > kWarmBootStateVersion) {
+    throw FbossError(
+        "Unsupported warm boot state version: ",
+        version,
+        ", max supported version: ",
+        kWarmBootStateVersion);
+  }
+  data.advance(sizeof(header));
+  return folly::bser::parseBser(data);
 }
 
 void HwSwitchWarmBootHelper::setupWarmBootFile() {
@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <folly/Range.h>
 #include <folly/dynamic.h>
 
 #include <string>
@@ -43,6 +44,18 @@ class HwSwitchWarmBootHelper {
   bool storeWarmBootState(const folly::dynamic& switchState);
   folly::dynamic getWarmBootState() const;
 
+  enum class StateFormat { JSON, BINARY };
+  /*
+   * Binary warm boot state is a magic and version header followed by the
+   * state encoded as BSER. Deserialization accepts either format, anything
+   * without the binary header is parsed as JSON, which allows warm booting
+   * from state written by older agents.
+   */
+  static std::string serializeWarmBootState(
+      const folly::dynamic& switchState,
+      StateFormat format);
+  static folly::dynamic deserializeWarmBootState(folly::ByteRange data);
+
   std::string startupSdkDumpFile() const;
   std::string shutdownSdkDumpFile() const;
   bool warmBootStateWritten() const {
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/hw/test/HwSwitchEnsemble.h"
+#include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
+#include "fboss/agent/hw/test/HwSwitchEnsembleRouteUpdateWrapper.h"
+#include "fboss/agent/test/RouteDistributionGenerator.h"
+
+#include <folly/Benchmark.h>
+#include <gflags/gflags.h>
+
+#include <thread>
+
+DECLARE_bool(rib_pipelined_fib_updates);
+
+namespace facebook::fboss {
+
+namespace {
+constexpr auto kEcmpWidth = 4;
+constexpr auto kChunkSize = 1000;
+
+/*
+ * BGP (v6 routes) and OpenR (v4 routes) program their routes concurrently,
+ * chunk by chunk, as they would on a busy box. Measures the time for both to
+ * be done, with or without the RIB resolving an update while the previous
+ * one is being programmed.
+ */
+void competingRouteUpdates(bool pipelined) {
+  folly::BenchmarkSuspender suspender;
+  FLAGS_rib_pipelined_fib_updates = pipelined;
+  auto ensemble = createHwEnsemble({HwSwitchEnsemble::LINKSCAN});
+  auto config = utility::onePortPerVlanConfig(
+      ensemble->getHwSwitch(), ensemble->masterLogicalPortIds());
+  ensemble->applyInitialConfig(config);
+
+  utility::RouteDistributionGenerator v6Gen(
+      ensemble->getProgrammedState(),
+      {{64, 20'000}},
+      {},
+      kChunkSize,
+      kEcmpWidth,
+      RouterID(0));
+  utility::RouteDistributionGenerator v4Gen(
+      ensemble->getProgrammedState(),
+      {},
+      {{24, 20'000}},
+      kChunkSize,
+      kEcmpWidth,
+      RouterID(0));
+  ensemble->applyNewState(
+      v6Gen.resolveNextHops(ensemble->getProgrammedState()));
+  const auto& v6Chunks = v6Gen.getThriftRoutes();
+  const auto& v4Chunks = v4Gen.getThriftRoutes();
+
+  auto programRoutes = [&ensemble](
+                           ClientID client,
+                           const utility::RouteDistributionGenerator::
+                               ThriftRouteChunks& routeChunks) {
+    auto updater = ensemble->getRouteUpdater();
+    updater.programRoutes(RouterID(0), client, routeChunks);
+  };
+  suspender.dismiss();
+  std::thread bgpThread(programRoutes, ClientID::BGPD, std::cref(v6Chunks));
+  std::thread openrThread(programRoutes, ClientID::OPENR, std::cref(v4Chunks));
+  bgpThread.join();
+  openrThread.join();
+  suspender.rehire();
+}
+} // namespace
+
+BENCHMARK(HwRibCompetingRouteUpdatesSequential) {
+  competingRouteUpdates(false);
+}
+
+BENCHMARK_RELATIVE(HwRibCompetingRouteUpdatesPipelined) {
+  competingRouteUpdates(true);
+}
+
+} // namespace facebook::fboss
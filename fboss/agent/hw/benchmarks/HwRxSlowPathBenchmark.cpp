@@ -9,6 +9,8 @@
  */
 
 #include "fboss/agent/Platform.h"
+#include "fboss/agent/RxPacketDispatcher.h"
+#include "fboss/agent/hw/mock/MockRxPacket.h"
 #include "fboss/agent/hw/test/ConfigFactory.h"
 #include "fboss/agent/hw/test/HwSwitchEnsemble.h"
 #include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
@@ -20,12 +22,14 @@
 
 #include "fboss/agent/hw/switch_asics/HwAsic.h"
 #include "fboss/agent/hw/test/HwTestPacketTrapEntry.h"
+#include "fboss/agent/packet/Ethertype.h"
 
 #include <folly/IPAddress.h>
 #include <folly/dynamic.h>
 #include <folly/init/Init.h>
 #include <folly/json.h>
 
+#include <atomic>
 #include <iostream>
 #include <thread>
 
@@ -34,11 +38,119 @@ DEFINE_bool(
     setup_for_warmboot,
     false,
     "Set to true will prepare the device for warmboot");
+DEFINE_bool(
+    rx_dispatch_mixed_flood,
+    true,
+    "Also measure per class RxPacketDispatcher latency with the trapped "
+    "packet flood mixed with an ARP storm and LACP/LLDP traffic");
+DEFINE_int32(
+    rx_handler_cost_us,
+    10,
+    "Simulated per packet handling cost for the mixed flood measurement");
 
 namespace facebook::fboss {
 
 const std::string kDstIp = "2620:0:1cfe:face:b00c::4";
 
+namespace {
+/*
+ * Feeds the packets trapped to the CPU into the dispatcher, as
+ * SwSwitch::packetReceived() does with rx_packet_dispatch.
+ */
+class RxDispatchFeeder : public HwSwitchEnsemble::HwSwitchEventObserverIf {
+ public:
+  RxDispatchFeeder(HwSwitchEnsemble* ensemble, RxPacketDispatcher* dispatcher)
+      : ensemble_(ensemble), dispatcher_(dispatcher) {
+    ensemble_->addHwEventObserver(this);
+  }
+  ~RxDispatchFeeder() override {
+    ensemble_->removeHwEventObserver(this);
+  }
+
+ private:
+  void packetReceived(RxPacket* pkt) noexcept override {
+    dispatcher_->dispatch(std::make_unique<MockRxPacket>(pkt->buf()->clone()));
+  }
+  void linkStateChanged(PortID /*port*/, bool /*up*/) override {}
+  void l2LearningUpdateReceived(
+      L2Entry /*l2Entry*/,
+      L2EntryUpdateType /*l2EntryUpdateType*/) override {}
+
+  HwSwitchEnsemble* ensemble_;
+  RxPacketDispatcher* dispatcher_;
+};
+
+std::unique_ptr<MockRxPacket> makeFrame(ETHERTYPE ethertype) {
+  // Minimum size frame, only the ethertype matters for classification
+  std::vector<uint8_t> frame(64, 0);
+  frame[12] = static_cast<uint16_t>(ethertype) >> 8;
+  frame[13] = static_cast<uint16_t>(ethertype) & 0xff;
+  return std::make_unique<MockRxPacket>(
+      folly::IOBuf::copyBuffer(frame.data(), frame.size()));
+}
+
+/*
+ * Run the dispatcher for the given interval with three sources competing
+ * for it: the trapped packet flood (DATA), a software generated ARP storm
+ * sending as fast as it can (NEIGHBOR) and LACP/LLDP frames every
+ * millisecond (CONTROL). Returns per class handled/dropped packets and
+ * queueing delays.
+ */
+folly::dynamic runMixedFloodDispatch(
+    HwSwitchEnsemble* ensemble,
+    std::chrono::seconds interval) {
+  RxPacketDispatcher dispatcher(
+      [](std::unique_ptr<RxPacket> /*pkt*/) {
+        // Stand in for SwSwitch::handlePacket()
+        auto end = std::chrono::steady_clock::now() +
+            std::chrono::microseconds(FLAGS_rx_handler_cost_us);
+        while (std::chrono::steady_clock::now() < end) {
+        }
+      },
+      RxPacketDispatcher::Options());
+  std::atomic<bool> done{false};
+  std::thread arpStorm([&dispatcher, &done]() {
+    auto arp = makeFrame(ETHERTYPE::ETHERTYPE_ARP);
+    while (!done.load()) {
+      dispatcher.dispatch(arp->clone());
+    }
+  });
+  std::thread controlTraffic([&dispatcher, &done]() {
+    auto lacp = makeFrame(ETHERTYPE::ETHERTYPE_SLOW_PROTOCOLS);
+    auto lldp = makeFrame(ETHERTYPE::ETHERTYPE_LLDP);
+    while (!done.load()) {
+      dispatcher.dispatch(lacp->clone());
+      dispatcher.dispatch(lldp->clone());
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+  {
+    RxDispatchFeeder feeder(ensemble, &dispatcher);
+    std::this_thread::sleep_for(interval);
+    done = true;
+    arpStorm.join();
+    controlTraffic.join();
+  }
+  dispatcher.stop();
+
+  folly::dynamic classStats = folly::dynamic::object;
+  for (auto packetClass :
+       {RxPacketDispatcher::PacketClass::CONTROL,
+        RxPacketDispatcher::PacketClass::NEIGHBOR,
+        RxPacketDispatcher::PacketClass::DATA}) {
+    auto stats = dispatcher.getStats(packetClass);
+    folly::dynamic json = folly::dynamic::object;
+    json["handled"] = static_cast<int64_t>(stats.handled);
+    json["dropped"] = static_cast<int64_t>(stats.dropped);
+    json["avg_queue_delay_us"] = static_cast<int64_t>(
+        stats.handled ? stats.totalQueueDelayUsecs / stats.handled : 0);
+    json["max_queue_delay_us"] = static_cast<int64_t>(stats.maxQueueDelayUsecs);
+    classStats[RxPacketDispatcher::className(packetClass)] = json;
+  }
+  return classStats;
+}
+} // namespace
+
 void runRxSlowPathBenchmark() {
   constexpr int kEcmpWidth = 1;
   auto ensemble = createHwEnsemble(HwSwitchEnsemble::getAllFeatures());
@@ -100,15 +212,27 @@ void runRxSlowPathBenchmark() {
                           durationMillseconds.count()) *
       1000;
 
+  folly::dynamic dispatchJson;
+  if (FLAGS_rx_dispatch_mixed_flood) {
+    dispatchJson = runMixedFloodDispatch(
+        ensemble.get(), std::chrono::seconds(kBurnIntevalInSeconds));
+  }
+
   if (FLAGS_json) {
     folly::dynamic cpuRxRateJson = folly::dynamic::object;
     cpuRxRateJson["cpu_rx_pps"] = pps;
     cpuRxRateJson["cpu_rx_bytes_per_sec"] = bytesPerSec;
+    if (FLAGS_rx_dispatch_mixed_flood) {
+      cpuRxRateJson["rx_dispatch_mixed_flood"] = dispatchJson;
+    }
     std::cout << toPrettyJson(cpuRxRateJson) << std::endl;
   } else {
     XLOG(INFO) << " Pkts before: " << pktsBefore << " Pkts after: " << pktsAfter
                << " interval ms: " << durationMillseconds.count()
                << " pps: " << pps << " bytes per sec: " << bytesPerSec;
+    if (FLAGS_rx_dispatch_mixed_flood) {
+      XLOG(INFO) << " Rx dispatch under mixed flood: " << toJson(dispatchJson);
+    }
   }
 }
 } // namespace facebook::fboss
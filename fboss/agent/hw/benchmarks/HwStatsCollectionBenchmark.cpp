@@ -10,6 +10,7 @@
 
 #include "fboss/agent/Platform.h"
 #include "fboss/agent/SwitchStats.h"
+#include "fboss/agent/hw/HwPortFb303Stats.h"
 #include "fboss/agent/hw/test/ConfigFactory.h"
 #include "fboss/agent/hw/test/HwSwitchEnsemble.h"
 #include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
@@ -77,4 +78,41 @@ BENCHMARK(HwStatsCollection) {
   suspender.rehire();
 }
 
+/*
+ * Isolate the fb303 publishing part of stats collection: push 10K
+ * rounds of port stats for 128 ports with 8 queues each through
+ * HwPortFb303Stats, without going to HW.
+ */
+BENCHMARK(HwPortFb303StatsUpdate) {
+  folly::BenchmarkSuspender suspender;
+  constexpr auto kNumPorts = 128;
+  constexpr auto kNumQueues = 8;
+  HwPortFb303Stats::QueueId2Name queueId2Name;
+  std::map<int16_t, int64_t> queueStats;
+  for (auto queueId = 0; queueId < kNumQueues; ++queueId) {
+    queueId2Name.emplace(queueId, folly::to<std::string>("queue", queueId));
+    queueStats.emplace(queueId, 0);
+  }
+  std::vector<std::unique_ptr<HwPortFb303Stats>> portsStats;
+  for (auto port = 0; port < kNumPorts; ++port) {
+    portsStats.push_back(std::make_unique<HwPortFb303Stats>(
+        folly::to<std::string>("eth1/", port + 1, "/1"), queueId2Name));
+  }
+  HwPortStats portStats;
+  *portStats.queueOutDiscardBytes__ref() =
+      *portStats.queueOutDiscardPackets__ref() =
+          *portStats.queueOutBytes__ref() =
+              *portStats.queueOutPackets__ref() = queueStats;
+  suspender.dismiss();
+  for (auto i = 0; i < 10'000; ++i) {
+    auto now = std::chrono::seconds(i);
+    *portStats.inBytes__ref() = i;
+    *portStats.outBytes__ref() = i;
+    for (auto& stats : portsStats) {
+      stats->updateStats(portStats, now);
+    }
+  }
+  suspender.rehire();
+}
+
 } // namespace facebook::fboss
@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/Constants.h"
+#include "fboss/agent/Platform.h"
+#include "fboss/agent/hw/HwSwitchWarmBootHelper.h"
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/hw/test/HwSwitchEnsemble.h"
+#include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
+#include "fboss/agent/hw/test/HwSwitchEnsembleRouteUpdateWrapper.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/RouteScaleGenerators.h"
+
+#include <folly/Benchmark.h>
+#include <folly/dynamic.h>
+
+namespace facebook::fboss {
+
+namespace {
+/*
+ * Build the warm boot state the way HwSwitch gracefulExit does, for a
+ * switch with FSW scale routes programmed.
+ */
+folly::dynamic fswScaleWarmBootState() {
+  auto ensemble = createHwEnsemble(HwSwitchEnsemble::getAllFeatures());
+  auto hwSwitch = ensemble->getHwSwitch();
+  auto config =
+      utility::onePortPerVlanConfig(hwSwitch, ensemble->masterLogicalPortIds());
+  ensemble->applyInitialConfig(config);
+  auto routeChunks =
+      utility::FSWRouteScaleGenerator(ensemble->getProgrammedState())
+          .getThriftRoutes();
+  auto updater = ensemble->getRouteUpdater();
+  updater.programRoutes(RouterID(0), ClientID::BGPD, routeChunks);
+  folly::dynamic state = folly::dynamic::object;
+  state[kSwSwitch] = ensemble->getProgrammedState()->toFollyDynamic();
+  state[kHwSwitch] = hwSwitch->toFollyDynamic();
+  return state;
+}
+
+/*
+ * Time the serialization done on warm boot exit and the parsing done on
+ * warm boot init. Disk IO is left out, both formats go through the page
+ * cache the same way.
+ */
+void warmBootStateSerDes(HwSwitchWarmBootHelper::StateFormat format) {
+  folly::BenchmarkSuspender suspender;
+  auto state = fswScaleWarmBootState();
+  suspender.dismiss();
+  auto serialized =
+      HwSwitchWarmBootHelper::serializeWarmBootState(state, format);
+  auto restored = HwSwitchWarmBootHelper::deserializeWarmBootState(
+      folly::StringPiece(serialized));
+  folly::doNotOptimizeAway(restored);
+  suspender.rehire();
+}
+} // namespace
+
+BENCHMARK(HwWarmbootStateJson) {
+  warmBootStateSerDes(HwSwitchWarmBootHelper::StateFormat::JSON);
+}
+
+BENCHMARK_RELATIVE(HwWarmbootStateBinary) {
+  warmBootStateSerDes(HwSwitchWarmBootHelper::StateFormat::BINARY);
+}
+
+} // namespace facebook::fboss
@@ -112,6 +112,36 @@ class NextHopGroupApi : public SaiApi<NextHopGroupApi> {
     return api_->create_next_hop_group_member(
         rawSaiId(id), switch_id, count, attr_list);
   }
+  sai_status_t _bulkCreate(
+      std::vector<NextHopGroupMemberSaiId>* ids,
+      sai_object_id_t switch_id,
+      const uint32_t* attrCounts,
+      const sai_attribute_t** attrLists,
+      sai_status_t* statuses) const {
+    std::vector<sai_object_id_t> rawIds(ids->size(), SAI_NULL_OBJECT_ID);
+    auto status = api_->create_next_hop_group_members(
+        switch_id,
+        rawIds.size(),
+        attrCounts,
+        attrLists,
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        rawIds.data(),
+        statuses);
+    for (size_t i = 0; i < rawIds.size(); ++i) {
+      (*ids)[i] = NextHopGroupMemberSaiId{rawIds[i]};
+    }
+    return status;
+  }
+  sai_status_t _bulkRemove(
+      const std::vector<NextHopGroupMemberSaiId>& ids,
+      sai_status_t* statuses) const {
+    std::vector<sai_object_id_t> rawIds(ids.begin(), ids.end());
+    return api_->remove_next_hop_group_members(
+        rawIds.size(),
+        rawIds.data(),
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        statuses);
+  }
   sai_status_t _remove(NextHopGroupSaiId next_hop_group_id) const {
     return api_->remove_next_hop_group(next_hop_group_id);
   }
@@ -129,6 +129,51 @@ class RouteApi : public SaiApi<RouteApi> {
       const sai_attribute_t* attr) const {
     return api_->set_route_entry_attribute(routeEntry.entry(), attr);
   }
+  sai_status_t _bulkCreate(
+      const std::vector<SaiRouteTraits::RouteEntry>& routeEntries,
+      const uint32_t* attrCounts,
+      const sai_attribute_t** attrLists,
+      sai_status_t* statuses) const {
+    auto entries = saiRouteEntries(routeEntries);
+    return api_->create_route_entries(
+        entries.size(),
+        entries.data(),
+        attrCounts,
+        attrLists,
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        statuses);
+  }
+  sai_status_t _bulkRemove(
+      const std::vector<SaiRouteTraits::RouteEntry>& routeEntries,
+      sai_status_t* statuses) const {
+    auto entries = saiRouteEntries(routeEntries);
+    return api_->remove_route_entries(
+        entries.size(),
+        entries.data(),
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        statuses);
+  }
+  sai_status_t _bulkSetAttribute(
+      const std::vector<SaiRouteTraits::RouteEntry>& routeEntries,
+      const sai_attribute_t* attrs,
+      sai_status_t* statuses) const {
+    auto entries = saiRouteEntries(routeEntries);
+    return api_->set_route_entries_attribute(
+        entries.size(),
+        entries.data(),
+        attrs,
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        statuses);
+  }
+  static std::vector<sai_route_entry_t> saiRouteEntries(
+      const std::vector<SaiRouteTraits::RouteEntry>& routeEntries) {
+    std::vector<sai_route_entry_t> entries;
+    entries.reserve(routeEntries.size());
+    for (const auto& routeEntry : routeEntries) {
+      entries.push_back(*routeEntry.entry());
+    }
+    return entries;
+  }
 
   sai_route_api_t* api_;
   friend class SaiApi<RouteApi>;
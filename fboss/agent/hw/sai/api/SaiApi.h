@@ -79,7 +79,7 @@ class SaiApi {
           "Attempting create SAI obj with {}, while hw writes are blocked",
           createAttributes);
     }
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
     sai_status_t status;
     {
       TIME_CALL;
@@ -115,7 +115,7 @@ class SaiApi {
           "Attempting create SAI obj with {}, while hw writes are blocked",
           createAttributes);
     }
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
     sai_status_t status;
     {
       TIME_CALL;
@@ -141,7 +141,7 @@ class SaiApi {
           "Attempting to remove SAI obj {} while hw writes are blocked",
           key);
     }
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
     sai_status_t status;
     {
       TIME_CALL;
@@ -154,6 +154,150 @@ class SaiApi {
     XLOGF(DBG5, "removed SAI object: {}", key);
   }
 
+  /*
+   * Bulk variants of create, remove and setAttribute. All objects are
+   * programmed under a single acquisition of the SaiApiLock and, for the apis
+   * which implement the SAI bulk functions (_bulkCreate, _bulkRemove and
+   * _bulkSetAttribute), in a single call to the adapter. Other apis fall back
+   * to calling the adapter once per object.
+   *
+   * bulkCreate either creates all objects or none: if the adapter fails
+   * to create one of them, the ones created before it are removed again
+   * before the error is thrown.
+   */
+
+  // sai_object_id_t case
+  template <typename SaiObjectTraits>
+  std::enable_if_t<
+      AdapterKeyIsObjectId<SaiObjectTraits>::value,
+      std::vector<typename SaiObjectTraits::AdapterKey>>
+  bulkCreate(
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          createAttributes,
+      sai_object_id_t switch_id) const {
+    static_assert(
+        std::is_same_v<typename SaiObjectTraits::SaiApiT, ApiT>,
+        "invalid traits for the api");
+    std::vector<typename SaiObjectTraits::AdapterKey> keys(
+        createAttributes.size());
+    if (createAttributes.empty()) {
+      return keys;
+    }
+    if (UNLIKELY(failHwWrites() || skipHwWrites())) {
+      // As for create, keys can't be manufactured when skipping hw writes
+      XLOGF(
+          FATAL,
+          "Attempting bulk create of {} SAI objs, while hw writes are blocked",
+          createAttributes.size());
+    }
+    BulkAttributes attributes(createAttributes);
+    std::vector<sai_status_t> statuses(keys.size(), SAI_STATUS_NOT_EXECUTED);
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
+    sai_status_t status;
+    {
+      TIME_CALL;
+      status = bulkCreateImpl(
+          &keys,
+          switch_id,
+          attributes.counts.data(),
+          attributes.lists.data(),
+          statuses.data(),
+          0);
+    }
+    checkBulkCreate(status, keys, createAttributes, statuses);
+    return keys;
+  }
+
+  // entry struct case
+  template <typename SaiObjectTraits>
+  std::enable_if_t<AdapterKeyIsEntryStruct<SaiObjectTraits>::value, void>
+  bulkCreate(
+      const std::vector<typename SaiObjectTraits::AdapterKey>& entries,
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          createAttributes) const {
+    static_assert(
+        std::is_same_v<typename SaiObjectTraits::SaiApiT, ApiT>,
+        "invalid traits for the api");
+    CHECK_EQ(entries.size(), createAttributes.size());
+    if (UNLIKELY(skipHwWrites()) || entries.empty()) {
+      return;
+    }
+    if (UNLIKELY(failHwWrites())) {
+      XLOGF(
+          FATAL,
+          "Attempting bulk create of {} SAI objs, while hw writes are blocked",
+          entries.size());
+    }
+    BulkAttributes attributes(createAttributes);
+    std::vector<sai_status_t> statuses(entries.size(), SAI_STATUS_NOT_EXECUTED);
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
+    sai_status_t status;
+    {
+      TIME_CALL;
+      status = bulkCreateImpl(
+          entries,
+          attributes.counts.data(),
+          attributes.lists.data(),
+          statuses.data(),
+          0);
+    }
+    checkBulkCreate(status, entries, createAttributes, statuses);
+  }
+
+  template <typename AdapterKeyT>
+  void bulkRemove(const std::vector<AdapterKeyT>& keys) const {
+    if (UNLIKELY(skipHwWrites()) || keys.empty()) {
+      return;
+    }
+    if (UNLIKELY(failHwWrites())) {
+      XLOGF(
+          FATAL,
+          "Attempting bulk remove of {} SAI objs while hw writes are blocked",
+          keys.size());
+    }
+    std::vector<sai_status_t> statuses(keys.size(), SAI_STATUS_NOT_EXECUTED);
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
+    sai_status_t status;
+    {
+      TIME_CALL;
+      status = bulkRemoveImpl(keys, statuses.data(), 0);
+    }
+    checkBulkStatuses(status, keys, statuses, "Failed to remove sai object");
+    XLOGF(DBG5, "removed {} SAI objects", keys.size());
+  }
+
+  template <typename AdapterKeyT, typename AttrT>
+  void bulkSetAttribute(
+      const std::vector<AdapterKeyT>& keys,
+      const std::vector<AttrT>& attrs) const {
+    CHECK_EQ(keys.size(), attrs.size());
+    if (UNLIKELY(skipHwWrites()) || keys.empty()) {
+      return;
+    }
+    if (UNLIKELY(failHwWrites())) {
+      XLOGF(
+          FATAL,
+          "Attempting bulk set of {} SAI attributes, while hw writes are "
+          "blocked",
+          keys.size());
+    }
+    std::vector<sai_attribute_t> saiAttributeTs;
+    saiAttributeTs.reserve(attrs.size());
+    for (const auto& attr : attrs) {
+      saiAttributeTs.push_back(*saiAttr(attr));
+    }
+    std::vector<sai_status_t> statuses(keys.size(), SAI_STATUS_NOT_EXECUTED);
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
+    sai_status_t status;
+    {
+      TIME_CALL;
+      status = bulkSetAttributeImpl(
+          keys, saiAttributeTs.data(), statuses.data(), 0);
+    }
+    checkBulkStatuses(status, keys, statuses, "Failed to set attribute of");
+    XLOGF(DBG5, "set SAI attribute of {} objects", keys.size());
+  }
+
   /*
    * We can do getAttribute on top of more complicated types than just
    * attributes. For example, if we overload on tuples and optionals, we
@@ -175,7 +319,7 @@ class SaiApi {
         IsSaiAttribute<typename std::remove_reference<AttrT>::type>::value,
         "getAttribute must be called on a SaiAttribute or supported "
         "collection of SaiAttributes");
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
     sai_status_t status;
     {
       TIME_CALL;
@@ -314,7 +458,7 @@ class SaiApi {
   }
   template <typename AdapterKeyT, typename AttrT>
   void setAttribute(const AdapterKeyT& key, const AttrT& attr) const {
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
     setAttributeUnlocked(key, attr);
   }
 
@@ -326,7 +470,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "getStats only supported for Sai objects with stats");
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
     return getStatsImpl<SaiObjectTraits>(
         key, counterIds.data(), counterIds.size(), mode);
   }
@@ -337,7 +481,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "getStats only supported for Sai objects with stats");
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
     XLOGF(DBG6, "got SAI stats for {}", key);
     return mode == SAI_STATS_MODE_READ
         ? getStatsImpl<SaiObjectTraits>(
@@ -359,7 +503,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "clearStats only supported for Sai objects with stats");
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
     clearStatsImpl<SaiObjectTraits>(key, counterIds.data(), counterIds.size());
   }
   template <typename SaiObjectTraits>
@@ -367,7 +511,7 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "clearStats only supported for Sai objects with stats");
-    auto g{SaiApiLock::getInstance()->lock()};
+    auto g{SaiApiLock::getInstance()->lock(apiType())};
     clearStatsImpl<SaiObjectTraits>(
         key,
         SaiObjectTraits::CounterIdsToRead.data(),
@@ -432,6 +576,202 @@ class SaiApi {
       saiApiCheckError(status, apiType(), "Failed to clear stats");
     }
   }
+
+  // Per object attribute lists in the layout the SAI bulk functions take
+  struct BulkAttributes {
+    template <typename CreateAttributesT>
+    explicit BulkAttributes(
+        const std::vector<CreateAttributesT>& createAttributes) {
+      attrs.reserve(createAttributes.size());
+      counts.reserve(createAttributes.size());
+      lists.reserve(createAttributes.size());
+      for (const auto& objectAttributes : createAttributes) {
+        attrs.push_back(saiAttrs(objectAttributes));
+        counts.push_back(attrs.back().size());
+        lists.push_back(attrs.back().data());
+      }
+    }
+    std::vector<std::vector<sai_attribute_t>> attrs;
+    std::vector<uint32_t> counts;
+    std::vector<const sai_attribute_t*> lists;
+  };
+
+  /*
+   * The bulk implementations below are picked by overload resolution: the
+   * int overloads only exist if ApiT implements the bulk function, the long
+   * ones loop over the per object functions, stopping on the first error
+   * like SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR does.
+   */
+  template <typename AdapterKeyT, typename Api = ApiT>
+  auto bulkCreateImpl(
+      std::vector<AdapterKeyT>* keys,
+      sai_object_id_t switch_id,
+      const uint32_t* attrCounts,
+      const sai_attribute_t** attrLists,
+      sai_status_t* statuses,
+      int) const
+      -> decltype(std::declval<const Api&>()._bulkCreate(
+          keys,
+          switch_id,
+          attrCounts,
+          attrLists,
+          statuses)) {
+    return impl()._bulkCreate(keys, switch_id, attrCounts, attrLists, statuses);
+  }
+  template <typename AdapterKeyT>
+  sai_status_t bulkCreateImpl(
+      std::vector<AdapterKeyT>* keys,
+      sai_object_id_t switch_id,
+      const uint32_t* attrCounts,
+      const sai_attribute_t** attrLists,
+      sai_status_t* statuses,
+      long) const {
+    for (size_t i = 0; i < keys->size(); ++i) {
+      statuses[i] = impl()._create(
+          &(*keys)[i],
+          switch_id,
+          attrCounts[i],
+          const_cast<sai_attribute_t*>(attrLists[i]));
+      if (statuses[i] != SAI_STATUS_SUCCESS) {
+        return statuses[i];
+      }
+    }
+    return SAI_STATUS_SUCCESS;
+  }
+  template <typename AdapterKeyT, typename Api = ApiT>
+  auto bulkCreateImpl(
+      const std::vector<AdapterKeyT>& entries,
+      const uint32_t* attrCounts,
+      const sai_attribute_t** attrLists,
+      sai_status_t* statuses,
+      int) const
+      -> decltype(std::declval<const Api&>()
+                      ._bulkCreate(entries, attrCounts, attrLists, statuses)) {
+    return impl()._bulkCreate(entries, attrCounts, attrLists, statuses);
+  }
+  template <typename AdapterKeyT>
+  sai_status_t bulkCreateImpl(
+      const std::vector<AdapterKeyT>& entries,
+      const uint32_t* attrCounts,
+      const sai_attribute_t** attrLists,
+      sai_status_t* statuses,
+      long) const {
+    for (size_t i = 0; i < entries.size(); ++i) {
+      statuses[i] = impl()._create(
+          entries[i], attrCounts[i], const_cast<sai_attribute_t*>(attrLists[i]));
+      if (statuses[i] != SAI_STATUS_SUCCESS) {
+        return statuses[i];
+      }
+    }
+    return SAI_STATUS_SUCCESS;
+  }
+  template <typename AdapterKeyT, typename Api = ApiT>
+  auto bulkRemoveImpl(
+      const std::vector<AdapterKeyT>& keys,
+      sai_status_t* statuses,
+      int) const
+      -> decltype(std::declval<const Api&>()._bulkRemove(keys, statuses)) {
+    return impl()._bulkRemove(keys, statuses);
+  }
+  template <typename AdapterKeyT>
+  sai_status_t bulkRemoveImpl(
+      const std::vector<AdapterKeyT>& keys,
+      sai_status_t* statuses,
+      long) const {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      statuses[i] = impl()._remove(keys[i]);
+      if (statuses[i] != SAI_STATUS_SUCCESS) {
+        return statuses[i];
+      }
+    }
+    return SAI_STATUS_SUCCESS;
+  }
+  template <typename AdapterKeyT, typename Api = ApiT>
+  auto bulkSetAttributeImpl(
+      const std::vector<AdapterKeyT>& keys,
+      const sai_attribute_t* attrs,
+      sai_status_t* statuses,
+      int) const
+      -> decltype(std::declval<const Api&>()
+                      ._bulkSetAttribute(keys, attrs, statuses)) {
+    return impl()._bulkSetAttribute(keys, attrs, statuses);
+  }
+  template <typename AdapterKeyT>
+  sai_status_t bulkSetAttributeImpl(
+      const std::vector<AdapterKeyT>& keys,
+      const sai_attribute_t* attrs,
+      sai_status_t* statuses,
+      long) const {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      statuses[i] = impl()._setAttribute(keys[i], &attrs[i]);
+      if (statuses[i] != SAI_STATUS_SUCCESS) {
+        return statuses[i];
+      }
+    }
+    return SAI_STATUS_SUCCESS;
+  }
+
+  // Throw for the first object the adapter failed to program
+  template <typename AdapterKeyT>
+  void checkBulkStatuses(
+      sai_status_t status,
+      const std::vector<AdapterKeyT>& keys,
+      const std::vector<sai_status_t>& statuses,
+      const char* msg) const {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (statuses[i] != SAI_STATUS_SUCCESS &&
+          statuses[i] != SAI_STATUS_NOT_EXECUTED) {
+        saiApiCheckError(
+            statuses[i], apiType(), fmt::format("{} {}", msg, keys[i]));
+      }
+    }
+    saiApiCheckError(
+        status,
+        apiType(),
+        fmt::format("{} {} sai objects in bulk", msg, keys.size()));
+  }
+  template <typename AdapterKeyT, typename CreateAttributesT>
+  void checkBulkCreate(
+      sai_status_t status,
+      const std::vector<AdapterKeyT>& keys,
+      const std::vector<CreateAttributesT>& createAttributes,
+      const std::vector<sai_status_t>& statuses) const {
+    auto failed = std::find_if(
+        statuses.begin(), statuses.end(), [](sai_status_t objectStatus) {
+          return objectStatus != SAI_STATUS_SUCCESS;
+        });
+    if (status == SAI_STATUS_SUCCESS && failed == statuses.end()) {
+      XLOGF(DBG5, "created {} SAI objects", keys.size());
+      return;
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (statuses[i] == SAI_STATUS_SUCCESS) {
+        auto removeStatus = impl()._remove(keys[i]);
+        if (removeStatus != SAI_STATUS_SUCCESS) {
+          XLOGF(
+              ERR,
+              "Failed to remove {} after failed bulk create: {}",
+              keys[i],
+              removeStatus);
+        }
+      }
+    }
+    if (failed != statuses.end() && *failed != SAI_STATUS_NOT_EXECUTED) {
+      auto index = failed - statuses.begin();
+      saiApiCheckError(
+          *failed,
+          apiType(),
+          fmt::format(
+              "Failed to create sai entity {}: {}",
+              index,
+              createAttributes[index]));
+    }
+    saiApiCheckError(
+        status,
+        apiType(),
+        fmt::format("Failed to create {} sai objects in bulk", keys.size()));
+  }
+
   ApiT& impl() {
     return static_cast<ApiT&>(*this);
   }
@@ -9,38 +9,80 @@
  */
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 
+extern "C" {
+#include <sai.h>
+}
+
 namespace facebook::fboss {
 
+/*
+ * Serializes calls into the SAI adapter. How much is serialized depends on
+ * what the adapter declares it can handle (see SaiPlatform):
+ *  - GLOBAL: one call at a time, across all apis. Safe for any adapter.
+ *  - PER_API: calls to different apis (e.g. reading port counters and
+ *    programming routes) may run concurrently, calls to the same api are
+ *    serialized.
+ *  - NONE: the adapter is fully thread safe, no locking at all.
+ */
 class SaiApiLock {
+ public:
+  enum class Granularity { GLOBAL, PER_API, NONE };
+
+ private:
   struct ScopedApiLock {
-    ScopedApiLock(std::mutex& m, bool noopLock) : mutex(m), noopLock(noopLock) {
-      if (!noopLock) {
-        mutex.lock();
+    explicit ScopedApiLock(std::mutex* m) : mutex(m) {
+      if (mutex) {
+        mutex->lock();
       }
     }
+    ScopedApiLock(ScopedApiLock&& other) noexcept : mutex(other.mutex) {
+      other.mutex = nullptr;
+    }
+    ScopedApiLock(const ScopedApiLock&) = delete;
+    ScopedApiLock& operator=(const ScopedApiLock&) = delete;
+    ScopedApiLock& operator=(ScopedApiLock&&) = delete;
     ~ScopedApiLock() {
-      if (!noopLock) {
-        mutex.unlock();
+      if (mutex) {
+        mutex->unlock();
       }
     }
-    std::mutex& mutex;
-    bool noopLock{false};
+    std::mutex* mutex{nullptr};
   };
 
  public:
   static std::shared_ptr<SaiApiLock> getInstance();
   void setAdaptorIsThreadSafe(bool isThreadSafe) {
-    adaptorIsThreadSafe_ = isThreadSafe;
+    setGranularity(isThreadSafe ? Granularity::NONE : Granularity::GLOBAL);
+  }
+  void setGranularity(Granularity granularity) {
+    granularity_.store(granularity, std::memory_order_relaxed);
   }
-  ScopedApiLock lock() const {
-    return {mutex_, adaptorIsThreadSafe_};
+  Granularity getGranularity() const {
+    return granularity_.load(std::memory_order_relaxed);
+  }
+  ScopedApiLock lock(sai_api_t api) const {
+    switch (getGranularity()) {
+      case Granularity::GLOBAL:
+        break;
+      case Granularity::PER_API:
+        if (api < apiMutexes_.size()) {
+          return ScopedApiLock(&apiMutexes_[api]);
+        }
+        break;
+      case Granularity::NONE:
+        return ScopedApiLock(nullptr);
+    }
+    return ScopedApiLock(&mutex_);
   }
 
  private:
-  bool adaptorIsThreadSafe_{false};
+  std::atomic<Granularity> granularity_{Granularity::GLOBAL};
   mutable std::mutex mutex_;
+  mutable std::array<std::mutex, SAI_API_MAX> apiMutexes_;
 };
 } // namespace facebook::fboss
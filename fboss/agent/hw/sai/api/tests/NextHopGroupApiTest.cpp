@@ -116,6 +116,38 @@ TEST_F(NextHopGroupApiTest, createNextHopGroupMember) {
   checkNextHopGroupMember(nextHopGroupId, nextHopGroupMemberId, nextHopWeight);
 }
 
+TEST_F(NextHopGroupApiTest, bulkCreateRemoveNextHopGroupMembers) {
+  auto nextHopGroupId = createNextHopGroup(SAI_NEXT_HOP_GROUP_TYPE_ECMP);
+  checkNextHopGroup(nextHopGroupId);
+
+  std::vector<SaiNextHopGroupMemberTraits::CreateAttributes> attributes;
+  for (sai_uint32_t i = 1; i <= 4; ++i) {
+    attributes.push_back({nextHopGroupId, 40 + i, i});
+  }
+  auto nextHopGroupMemberIds =
+      nextHopGroupApi->bulkCreate<SaiNextHopGroupMemberTraits>(attributes, 0);
+  ASSERT_EQ(4, nextHopGroupMemberIds.size());
+  for (sai_uint32_t i = 0; i < 4; ++i) {
+    checkNextHopGroupMember(nextHopGroupId, nextHopGroupMemberIds[i], i + 1);
+  }
+  EXPECT_EQ(
+      4,
+      nextHopGroupApi
+          ->getAttribute(
+              nextHopGroupId,
+              SaiNextHopGroupTraits::Attributes::NextHopMemberList())
+          .size());
+
+  nextHopGroupApi->bulkRemove(nextHopGroupMemberIds);
+  EXPECT_EQ(
+      0,
+      nextHopGroupApi
+          ->getAttribute(
+              nextHopGroupId,
+              SaiNextHopGroupTraits::Attributes::NextHopMemberList())
+          .size());
+}
+
 TEST_F(NextHopGroupApiTest, removeNextHopGroupMember) {
   auto nextHopGroupId = createNextHopGroup(SAI_NEXT_HOP_GROUP_TYPE_ECMP);
   checkNextHopGroup(nextHopGroupId);
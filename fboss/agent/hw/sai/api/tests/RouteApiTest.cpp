@@ -147,6 +147,49 @@ TEST_F(RouteApiTest, setPacketAction) {
       SAI_PACKET_ACTION_FORWARD);
 }
 
+TEST_F(RouteApiTest, bulkCreateSetRemoveRoutes) {
+  std::vector<SaiRouteTraits::RouteEntry> routeEntries;
+  std::vector<SaiRouteTraits::CreateAttributes> attributes;
+  for (uint8_t i = 0; i < 10; ++i) {
+    folly::CIDRNetwork prefix(folly::IPAddressV4::fromLongHBO(i << 8), 24);
+    routeEntries.emplace_back(0, 0, prefix);
+    attributes.push_back({SAI_PACKET_ACTION_FORWARD, i, std::nullopt});
+  }
+  routeApi->bulkCreate<SaiRouteTraits>(routeEntries, attributes);
+  EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 10);
+  for (uint8_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(
+        routeApi->getAttribute(
+            routeEntries[i], SaiRouteTraits::Attributes::NextHopId()),
+        i);
+  }
+
+  std::vector<SaiRouteTraits::Attributes::NextHopId> nextHops;
+  for (uint8_t i = 0; i < 10; ++i) {
+    nextHops.emplace_back(100 + i);
+  }
+  routeApi->bulkSetAttribute(routeEntries, nextHops);
+  for (uint8_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(
+        routeApi->getAttribute(
+            routeEntries[i], SaiRouteTraits::Attributes::NextHopId()),
+        100 + i);
+  }
+
+  routeApi->bulkRemove(routeEntries);
+  EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 0);
+}
+
+TEST_F(RouteApiTest, bulkRemoveMissingRoute) {
+  folly::CIDRNetwork prefix(ip4, 24);
+  SaiRouteTraits::RouteEntry r(0, 0, prefix);
+  routeApi->create<SaiRouteTraits>(
+      r, {SAI_PACKET_ACTION_DROP, std::nullopt, std::nullopt});
+  SaiRouteTraits::RouteEntry missing(0, 0, folly::CIDRNetwork(ip6, 64));
+  EXPECT_THROW(routeApi->bulkRemove(std::vector{r, missing}), SaiApiError);
+  EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 0);
+}
+
 TEST_F(RouteApiTest, routeCount) {
   uint32_t count = getObjectCount<SaiRouteTraits>(0);
   EXPECT_EQ(count, 0);
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/hw/sai/api/PortApi.h"
+#include "fboss/agent/hw/sai/api/RouteApi.h"
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
+#include "fboss/agent/hw/sai/fake/FakeSai.h"
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddressV6.h>
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace facebook::fboss;
+
+DEFINE_int32(
+    stats_threads,
+    1,
+    "Number of threads polling port stats while routes are programmed");
+
+namespace {
+static constexpr uint32_t kNumRoutes = 1000;
+
+/*
+ * Program and remove kNumRoutes routes while stats threads hammer the port
+ * api, the way the stats collection thread competes with route programming
+ * in the agent. Under GLOBAL granularity the two serialize on the single
+ * adapter lock, under PER_API they only contend within each api.
+ */
+void programRoutesUnderStatsLoad(
+    SaiApiLock::Granularity granularity,
+    uint32_t iters) {
+  std::shared_ptr<FakeSai> fs;
+  std::unique_ptr<RouteApi> routeApi;
+  std::unique_ptr<PortApi> portApi;
+  std::vector<SaiRouteTraits::RouteEntry> entries;
+  BENCHMARK_SUSPEND {
+    fs = FakeSai::getInstance();
+    sai_api_initialize(0, nullptr);
+    routeApi = std::make_unique<RouteApi>();
+    portApi = std::make_unique<PortApi>();
+    SaiApiLock::getInstance()->setGranularity(granularity);
+    entries.reserve(kNumRoutes);
+    for (uint32_t i = 0; i < kNumRoutes; ++i) {
+      std::array<uint8_t, 16> bytes{0x20, 0x01, 0x0d, 0xb8};
+      bytes[4] = i >> 8;
+      bytes[5] = i;
+      entries.emplace_back(
+          0,
+          0,
+          folly::CIDRNetwork(
+              folly::IPAddressV6::fromBinary(
+                  folly::ByteRange(bytes.data(), bytes.size())),
+              64));
+    }
+  }
+
+  std::atomic<bool> done{false};
+  std::vector<std::thread> statsThreads;
+  for (auto i = 0; i < FLAGS_stats_threads; ++i) {
+    statsThreads.emplace_back([&portApi, &done]() {
+      // Fake SAI does not keep per port counters, any port id will do
+      PortSaiId portId{1};
+      while (!done.load(std::memory_order_relaxed)) {
+        folly::doNotOptimizeAway(
+            portApi->getStats<SaiPortTraits>(portId, SAI_STATS_MODE_READ));
+      }
+    });
+  }
+
+  SaiRouteTraits::CreateAttributes attrs{
+      SaiRouteTraits::Attributes::PacketAction{SAI_PACKET_ACTION_FORWARD},
+      std::nullopt,
+      std::nullopt};
+  for (uint32_t iter = 0; iter < iters; ++iter) {
+    for (const auto& entry : entries) {
+      routeApi->create<SaiRouteTraits>(entry, attrs);
+    }
+    for (const auto& entry : entries) {
+      routeApi->remove(entry);
+    }
+  }
+
+  BENCHMARK_SUSPEND {
+    done = true;
+    for (auto& thread : statsThreads) {
+      thread.join();
+    }
+    SaiApiLock::getInstance()->setGranularity(
+        SaiApiLock::Granularity::GLOBAL);
+    FakeSai::clear();
+  }
+}
+} // namespace
+
+BENCHMARK(RouteProgrammingGlobalLock, iters) {
+  programRoutesUnderStatsLoad(SaiApiLock::Granularity::GLOBAL, iters);
+}
+
+BENCHMARK_RELATIVE(RouteProgrammingPerApiLock, iters) {
+  programRoutesUnderStatsLoad(SaiApiLock::Granularity::PER_API, iters);
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,160 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
+#include "fboss/agent/hw/sai/api/PortApi.h"
+#include "fboss/agent/hw/sai/api/RouteApi.h"
+#include "fboss/agent/hw/sai/fake/FakeSai.h"
+
+#include <folly/IPAddressV6.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace facebook::fboss;
+
+namespace {
+// Long enough for an uncontended lock to be taken on a loaded test host
+constexpr auto kAcquireTimeout = std::chrono::seconds(10);
+// How long a contended lock is expected to stay blocked
+constexpr auto kBlockedTimeout = std::chrono::milliseconds(50);
+} // namespace
+
+class SaiApiLockTest : public ::testing::Test {
+ public:
+  void TearDown() override {
+    SaiApiLock::getInstance()->setGranularity(
+        SaiApiLock::Granularity::GLOBAL);
+  }
+
+  /*
+   * Take the lock for heldApi, then try to take the lock for otherApi from
+   * another thread. Returns whether the other thread got its lock while the
+   * first one was held.
+   */
+  bool acquiresWhileHeld(
+      SaiApiLock::Granularity granularity,
+      sai_api_t heldApi,
+      sai_api_t otherApi) {
+    auto apiLock = SaiApiLock::getInstance();
+    apiLock->setGranularity(granularity);
+    std::future<void> other;
+    bool acquired;
+    {
+      auto held = apiLock->lock(heldApi);
+      other = std::async(std::launch::async, [apiLock, otherApi]() {
+        auto g = apiLock->lock(otherApi);
+      });
+      // Only wait for the full timeout when the lock is expected to be free
+      auto timeout = granularity == SaiApiLock::Granularity::GLOBAL ||
+              (granularity == SaiApiLock::Granularity::PER_API &&
+               heldApi == otherApi)
+          ? kBlockedTimeout
+          : kAcquireTimeout;
+      acquired = other.wait_for(timeout) == std::future_status::ready;
+    }
+    other.get();
+    return acquired;
+  }
+};
+
+TEST_F(SaiApiLockTest, globalSerializesAllApis) {
+  EXPECT_FALSE(acquiresWhileHeld(
+      SaiApiLock::Granularity::GLOBAL, SAI_API_PORT, SAI_API_PORT));
+  EXPECT_FALSE(acquiresWhileHeld(
+      SaiApiLock::Granularity::GLOBAL, SAI_API_PORT, SAI_API_ROUTE));
+}
+
+TEST_F(SaiApiLockTest, perApiSerializesSameApi) {
+  EXPECT_FALSE(acquiresWhileHeld(
+      SaiApiLock::Granularity::PER_API, SAI_API_PORT, SAI_API_PORT));
+}
+
+TEST_F(SaiApiLockTest, perApiAllowsDifferentApis) {
+  EXPECT_TRUE(acquiresWhileHeld(
+      SaiApiLock::Granularity::PER_API, SAI_API_PORT, SAI_API_ROUTE));
+  EXPECT_TRUE(acquiresWhileHeld(
+      SaiApiLock::Granularity::PER_API, SAI_API_QUEUE, SAI_API_NEXT_HOP_GROUP));
+}
+
+TEST_F(SaiApiLockTest, noneNeverBlocks) {
+  EXPECT_TRUE(acquiresWhileHeld(
+      SaiApiLock::Granularity::NONE, SAI_API_PORT, SAI_API_PORT));
+}
+
+TEST_F(SaiApiLockTest, setAdaptorIsThreadSafe) {
+  auto apiLock = SaiApiLock::getInstance();
+  apiLock->setAdaptorIsThreadSafe(true);
+  EXPECT_EQ(apiLock->getGranularity(), SaiApiLock::Granularity::NONE);
+  apiLock->setAdaptorIsThreadSafe(false);
+  EXPECT_EQ(apiLock->getGranularity(), SaiApiLock::Granularity::GLOBAL);
+}
+
+/*
+ * Program routes while another thread polls port stats, the way the stats
+ * thread runs next to state delta processing under PER_API.
+ */
+TEST_F(SaiApiLockTest, perApiRoutesUnderStatsLoad) {
+  auto fs = FakeSai::getInstance();
+  sai_api_initialize(0, nullptr);
+  RouteApi routeApi;
+  PortApi portApi;
+  SaiApiLock::getInstance()->setGranularity(
+      SaiApiLock::Granularity::PER_API);
+
+  std::vector<SaiRouteTraits::RouteEntry> entries;
+  for (uint8_t i = 0; i < 100; ++i) {
+    std::array<uint8_t, 16> bytes{0x20, 0x01, 0x0d, 0xb8, 0, i};
+    entries.emplace_back(
+        0,
+        0,
+        folly::CIDRNetwork(
+            folly::IPAddressV6::fromBinary(
+                folly::ByteRange(bytes.data(), bytes.size())),
+            64));
+  }
+
+  std::atomic<bool> done{false};
+  std::atomic<uint64_t> statsReads{0};
+  std::thread statsThread([&portApi, &done, &statsReads]() {
+    // Fake SAI does not keep per port counters, any port id will do
+    PortSaiId portId{1};
+    while (!done.load()) {
+      portApi.getStats<SaiPortTraits>(portId, SAI_STATS_MODE_READ);
+      ++statsReads;
+    }
+  });
+
+  SaiRouteTraits::CreateAttributes attrs{
+      SaiRouteTraits::Attributes::PacketAction{SAI_PACKET_ACTION_FORWARD},
+      std::nullopt,
+      std::nullopt};
+  for (const auto& entry : entries) {
+    routeApi.create<SaiRouteTraits>(entry, attrs);
+  }
+  for (const auto& entry : entries) {
+    EXPECT_EQ(
+        routeApi.getAttribute(
+            entry, SaiRouteTraits::Attributes::PacketAction{}),
+        SAI_PACKET_ACTION_FORWARD);
+    routeApi.remove(entry);
+  }
+  // Make sure stats were actually read concurrently at least once
+  while (statsReads.load() == 0) {
+    std::this_thread::yield();
+  }
+  done = true;
+  statsThread.join();
+}
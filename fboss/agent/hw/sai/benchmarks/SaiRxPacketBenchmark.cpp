@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/RxPacket.h"
+#include "fboss/agent/hw/sai/switch/SaiManagerTable.h"
+#include "fboss/agent/hw/sai/switch/SaiPortManager.h"
+#include "fboss/agent/hw/sai/switch/SaiSwitch.h"
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/hw/test/HwSwitchEnsemble.h"
+#include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
+#include "fboss/agent/test/TrunkUtils.h"
+
+#include <folly/Benchmark.h>
+#include <folly/chrono/Hardware.h>
+#include <folly/logging/xlog.h>
+
+#include <array>
+
+namespace facebook::fboss {
+
+namespace {
+constexpr auto kNumPackets = 100'000;
+// Upper bound on LAGs, each with a single member port
+constexpr auto kMaxLags = 64;
+
+/*
+ * Stands in for SwSwitch: looks at the ethernet header of every packet
+ * delivered by the HwSwitch, like SwSwitch::handlePacket() does.
+ */
+class RxPacketSink : public HwSwitchEnsemble::HwSwitchEventObserverIf {
+ public:
+  explicit RxPacketSink(HwSwitchEnsemble* ensemble) : ensemble_(ensemble) {
+    ensemble_->addHwEventObserver(this);
+  }
+  ~RxPacketSink() override {
+    ensemble_->removeHwEventObserver(this);
+  }
+
+  uint64_t received() const {
+    return received_;
+  }
+
+ private:
+  void packetReceived(RxPacket* pkt) noexcept override {
+    folly::doNotOptimizeAway(pkt->getL2Header().ethertype);
+    ++received_;
+  }
+  void linkStateChanged(PortID /*port*/, bool /*up*/) override {}
+  void l2LearningUpdateReceived(
+      L2Entry /*l2Entry*/,
+      L2EntryUpdateType /*l2EntryUpdateType*/) override {}
+
+  HwSwitchEnsemble* ensemble_;
+  uint64_t received_{0};
+};
+
+/*
+ * Push kNumPackets 64B frames through SaiSwitch::packetRxCallback(), as
+ * the SAI adapter would, with either a plain port or a LAG member port as
+ * the ingress port. The last of kMaxLags LAGs is used for the latter, so
+ * that any per LAG scan on the rx path shows up.
+ */
+void runRxPacketBenchmark(bool lagMember) {
+  folly::BenchmarkSuspender suspender;
+  auto ensemble = createHwEnsemble(HwSwitchEnsemble::getAllFeatures());
+  auto hwSwitch = ensemble->getHwSwitch();
+  auto ports = ensemble->masterLogicalPortIds();
+  auto config = utility::onePortPerVlanConfig(hwSwitch, ports);
+  // Port 0 stays a regular port, every other port gets its own LAG
+  auto numLags = std::min<int>(ports.size() - 1, kMaxLags);
+  CHECK_GT(numLags, 0);
+  for (auto i = 0; i < numLags; ++i) {
+    utility::addAggPort(i + 1, {static_cast<int32_t>(ports[i + 1])}, &config);
+  }
+  ensemble->applyInitialConfig(config);
+  ensemble->applyNewState(
+      utility::enableTrunkPorts(ensemble->getProgrammedState()));
+
+  auto saiSwitch = static_cast<SaiSwitch*>(hwSwitch);
+  auto ingressPort = lagMember ? ports[numLags] : ports[0];
+  auto portSaiId = saiSwitch->managerTable()
+                       ->portManager()
+                       .getPortHandle(ingressPort)
+                       ->port->adapterKey();
+  std::array<sai_attribute_t, 1> attrs;
+  attrs[0].id = SAI_HOSTIF_PACKET_ATTR_INGRESS_PORT;
+  attrs[0].value.oid = static_cast<sai_object_id_t>(portSaiId);
+
+  // Minimum size IPv6 frame, the payload does not matter
+  std::array<uint8_t, 64> frame{};
+  const std::array<uint8_t, 14> ethHdr = {
+      0x02, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x00,
+      0x00, 0x00, 0x00, 0x02, 0x86, 0xdd};
+  std::copy(ethHdr.begin(), ethHdr.end(), frame.begin());
+
+  RxPacketSink sink(ensemble.get());
+  auto switchId = saiSwitch->getSwitchId();
+  suspender.dismiss();
+  auto start = folly::hardware_timestamp();
+  for (auto i = 0; i < kNumPackets; ++i) {
+    saiSwitch->packetRxCallback(
+        switchId, frame.size(), frame.data(), attrs.size(), attrs.data());
+  }
+  auto ticks = folly::hardware_timestamp() - start;
+  suspender.rehire();
+
+  CHECK_EQ(sink.received(), static_cast<uint64_t>(kNumPackets));
+  XLOG(INFO) << (lagMember ? "LAG member" : "Port") << " rx, " << numLags
+             << " LAGs: " << ticks / kNumPackets << " ticks per packet";
+}
+} // namespace
+
+BENCHMARK(SaiRxPacketPort) {
+  runRxPacketBenchmark(false /* lagMember */);
+}
+
+BENCHMARK(SaiRxPacketLagMember) {
+  runRxPacketBenchmark(true /* lagMember */);
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/store/SaiStore.h"
+#include "fboss/agent/hw/sai/switch/SaiSwitch.h"
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/hw/test/HwSwitchEnsemble.h"
+#include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
+#include "fboss/agent/hw/test/HwSwitchEnsembleRouteUpdateWrapper.h"
+#include "fboss/agent/test/RouteDistributionGenerator.h"
+
+#include <folly/Benchmark.h>
+#include <folly/logging/xlog.h>
+
+#include <unistd.h>
+#include <fstream>
+
+namespace facebook::fboss {
+
+namespace {
+constexpr auto kNumV6Routes = 50'000;
+constexpr auto kNumV4Routes = 50'000;
+constexpr auto kEcmpWidth = 4;
+constexpr auto kChunkSize = 4'000;
+
+// Resident set size, from /proc/self/statm
+size_t residentBytes() {
+  size_t totalPages = 0, residentPages = 0;
+  std::ifstream statm("/proc/self/statm");
+  statm >> totalPages >> residentPages;
+  return residentPages * sysconf(_SC_PAGESIZE);
+}
+
+/*
+ * Program 100k routes through the SAI adapter and report how much memory
+ * the SaiStore holds for them, along with the agent's RSS growth. Run
+ * against fake SAI, this is all SaiStore and switch state memory.
+ */
+void runStoreMemoryBenchmark() {
+  folly::BenchmarkSuspender suspender;
+  auto ensemble = createHwEnsemble({HwSwitchEnsemble::LINKSCAN});
+  auto config = utility::onePortPerVlanConfig(
+      ensemble->getHwSwitch(), ensemble->masterLogicalPortIds());
+  ensemble->applyInitialConfig(config);
+
+  utility::RouteDistributionGenerator routeGen(
+      ensemble->getProgrammedState(),
+      {{64, kNumV6Routes}},
+      {{24, kNumV4Routes}},
+      kChunkSize,
+      kEcmpWidth,
+      RouterID(0));
+  ensemble->applyNewState(
+      routeGen.resolveNextHops(ensemble->getProgrammedState()));
+  const auto& routeChunks = routeGen.getThriftRoutes();
+
+  auto saiStore =
+      static_cast<SaiSwitch*>(ensemble->getHwSwitch())->getSaiStore();
+  const auto& routeStore = saiStore->get<SaiRouteTraits>();
+  auto rssBefore = residentBytes();
+  suspender.dismiss();
+  auto updater = ensemble->getRouteUpdater();
+  updater.programRoutes(RouterID(0), ClientID::BGPD, routeChunks);
+  suspender.rehire();
+
+  auto routeUsage = routeStore.memoryUsage();
+  CHECK_GE(routeUsage.numValues, kNumV6Routes + kNumV4Routes);
+  XLOG(INFO) << "Route store: " << routeUsage.numValues << " routes, "
+             << routeUsage.bytes << " bytes, "
+             << routeUsage.bytes / routeUsage.numValues << " bytes per route";
+  XLOG(INFO) << "RSS growth: "
+             << static_cast<int64_t>(residentBytes() - rssBefore) << " bytes";
+}
+} // namespace
+
+BENCHMARK(SaiStoreMemory100kRoutes) {
+  runStoreMemoryBenchmark();
+}
+
+} // namespace facebook::fboss
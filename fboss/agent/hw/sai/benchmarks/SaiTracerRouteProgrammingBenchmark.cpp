@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/SaiTracer.h"
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/hw/test/HwSwitchEnsemble.h"
+#include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
+#include "fboss/agent/hw/test/HwSwitchEnsembleRouteUpdateWrapper.h"
+#include "fboss/agent/test/RouteDistributionGenerator.h"
+
+#include <folly/Benchmark.h>
+#include <gflags/gflags.h>
+
+namespace facebook::fboss {
+
+namespace {
+constexpr auto kNumV6Routes = 50'000;
+constexpr auto kNumV4Routes = 50'000;
+constexpr auto kEcmpWidth = 4;
+constexpr auto kChunkSize = 4'000;
+
+/*
+ * Program 100k routes with SAI call tracing on or off. The tracer is set up
+ * when the switch is, tracing is only turned off for the measured part, so
+ * that the logs of the two runs are not replayable.
+ *
+ * Run once as is and once with --sai_replayer_binary_trace to compare the
+ * overhead of generating C source with that of binary tracing.
+ */
+void routeProgrammingWithTracing(bool tracing) {
+  folly::BenchmarkSuspender suspender;
+  FLAGS_enable_replayer = true;
+  auto ensemble = createHwEnsemble({HwSwitchEnsemble::LINKSCAN});
+  auto config = utility::onePortPerVlanConfig(
+      ensemble->getHwSwitch(), ensemble->masterLogicalPortIds());
+  ensemble->applyInitialConfig(config);
+
+  utility::RouteDistributionGenerator routeGen(
+      ensemble->getProgrammedState(),
+      {{64, kNumV6Routes}},
+      {{24, kNumV4Routes}},
+      kChunkSize,
+      kEcmpWidth,
+      RouterID(0));
+  ensemble->applyNewState(
+      routeGen.resolveNextHops(ensemble->getProgrammedState()));
+  const auto& routeChunks = routeGen.getThriftRoutes();
+
+  FLAGS_enable_replayer = tracing;
+  suspender.dismiss();
+  auto updater = ensemble->getRouteUpdater();
+  updater.programRoutes(RouterID(0), ClientID::BGPD, routeChunks);
+  suspender.rehire();
+  FLAGS_enable_replayer = true;
+}
+} // namespace
+
+BENCHMARK(SaiRouteProgrammingTracingOff) {
+  routeProgrammingWithTracing(false);
+}
+
+BENCHMARK_RELATIVE(SaiRouteProgrammingTracingOn) {
+  routeProgrammingWithTracing(true);
+}
+
+} // namespace facebook::fboss
@@ -234,6 +234,17 @@ class SaiObject {
     live_ = true;
   }
 
+  // Take ownership of one already created in the adapter by a bulk create
+  SaiObject(
+      const typename SaiObjectTraits::AdapterKey& adapterKey,
+      const typename SaiObjectTraits::AdapterHostKey& adapterHostKey,
+      const typename SaiObjectTraits::CreateAttributes& attributes)
+      : adapterKey_(adapterKey),
+        adapterHostKey_(adapterHostKey),
+        attributes_(attributes) {
+    live_ = true;
+  }
+
   bool live() const {
     return live_;
   }
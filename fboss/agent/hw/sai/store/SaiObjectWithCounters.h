@@ -15,10 +15,59 @@
 #include "fboss/lib/RefMap.h"
 #include "fboss/lib/TupleUtils.h"
 
+#include <exception>
 #include <variant>
+#include <vector>
 
 namespace facebook::fboss {
 
+/*
+ * Counters of an object read from the adapter by its adapter key alone, e.g.
+ * without holding the lock guarding the store. Recorded on the object with
+ * SaiObjectWithCounters::setStats() once the object is looked up again.
+ */
+template <typename SaiObjectTraits>
+struct SaiCounterValues {
+  typename SaiObjectTraits::AdapterKey adapterKey;
+  std::vector<sai_stat_id_t> counterIds;
+  std::vector<uint64_t> counters;
+  // Set if a read failed, e.g. as the object was removed meanwhile
+  std::exception_ptr readError;
+
+  // Read the counters SaiObjectWithCounters::updateStats() reads
+  void read() {
+    read(
+        SaiObjectTraits::CounterIdsToRead.data(),
+        SaiObjectTraits::CounterIdsToRead.size(),
+        SAI_STATS_MODE_READ);
+    read(
+        SaiObjectTraits::CounterIdsToReadAndClear.data(),
+        SaiObjectTraits::CounterIdsToReadAndClear.size(),
+        SAI_STATS_MODE_READ_AND_CLEAR);
+  }
+
+  void read(const std::vector<sai_stat_id_t>& ids, sai_stats_mode_t mode) {
+    read(ids.data(), ids.size(), mode);
+  }
+
+ private:
+  void read(const sai_stat_id_t* ids, size_t numIds, sai_stats_mode_t mode) {
+    if (readError || !numIds) {
+      return;
+    }
+    try {
+      auto& api = SaiApiTable::getInstance()
+                      ->getApi<typename SaiObjectTraits::SaiApiT>();
+      auto values = api.template getStats<SaiObjectTraits>(
+          adapterKey, std::vector<sai_stat_id_t>(ids, ids + numIds), mode);
+      counterIds.insert(counterIds.end(), ids, ids + numIds);
+      counters.insert(counters.end(), values.begin(), values.end());
+    } catch (const std::exception&) {
+      readError = std::current_exception();
+    }
+  }
+};
+
 template <typename SaiObjectTraits>
 class SaiObjectWithCounters : public SaiObject<SaiObjectTraits> {
  public:
@@ -63,6 +112,20 @@ class SaiObjectWithCounters : public SaiObject<SaiObjectTraits> {
     fillInStats(counterIds.data(), counters);
   }
 
+  /*
+   * Record counters read with SaiCounterValues, rethrowing the error of a
+   * failed read: the object being still there, it is not a removal race.
+   */
+  template <typename T = SaiObjectTraits>
+  void setStats(const SaiCounterValues<T>& values) {
+    static_assert(SaiObjectHasStats<T>::value, "invalid traits for the api");
+    CHECK(values.adapterKey == this->adapterKey());
+    if (values.readError) {
+      std::rethrow_exception(values.readError);
+    }
+    fillInStats(values.counterIds.data(), values.counters);
+  }
+
   template <typename T = SaiObjectTraits>
   const StatsMap getStats() const {
     static_assert(SaiObjectHasStats<T>::value, "invalid traits for the api");
@@ -10,6 +10,8 @@
 
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 
+#include <fb303/ServiceData.h>
+
 namespace facebook::fboss {
 
 SaiStore::SaiStore() {}
@@ -108,6 +110,18 @@ std::string SaiStore::storeStr(sai_object_type_t objType) const {
   return output;
 }
 
+void SaiStore::exportMemoryUsage() const {
+  tupleForEach(
+      [](const auto& store) {
+        auto usage = store.memoryUsage();
+        auto prefix =
+            folly::to<std::string>("sai_store.", store.objectTypeName());
+        fb303::fbData->setCounter(prefix + ".objects", usage.numValues);
+        fb303::fbData->setCounter(prefix + ".bytes", usage.bytes);
+      },
+      stores_);
+}
+
 void SaiStore::checkUnexpectedUnclaimedWarmbootHandles() const {
   bool hasUnexpectedUnclaimedWarmbootHandles = false;
   tupleForEach(
@@ -26,6 +26,7 @@
 
 #include <folly/dynamic.h>
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <sstream>
@@ -60,6 +61,9 @@ class SaiObjectStore {
       SaiObjectWithCounters<SaiObjectTraits>,
       SaiObject<SaiObjectTraits>>::type;
   using ObjectTraits = SaiObjectTraits;
+  // Max number of objects programmed per bulk call by setObjects and
+  // removeObjects
+  static constexpr size_t kMaxBulkSize = 1024;
 
   explicit SaiObjectStore(sai_object_id_t switchId) : switchId_(switchId) {}
   SaiObjectStore() {}
@@ -230,6 +234,125 @@ class SaiObjectStore {
     return object;
   }
 
+  /*
+   * Bulk version of setObject for objects keyed by an entry struct (routes,
+   * neighbors, ...). Objects missing from the store are created in the
+   * adapter with bulk create calls of up to kMaxBulkSize objects, existing
+   * ones get their attributes updated. Adapter host keys must be unique.
+   *
+   * If the adapter fails to create some of the objects, none of the newly
+   * created ones are kept.
+   */
+  std::vector<std::shared_ptr<ObjectType>> setObjects(
+      const std::vector<typename SaiObjectTraits::AdapterHostKey>&
+          adapterHostKeys,
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          attributes,
+      bool notify = true) {
+    static_assert(
+        AdapterKeyIsEntryStruct<SaiObjectTraits>::value,
+        "setObjects is only available for objects keyed by entry structs");
+    if constexpr (IsObjectPublisher<SaiObjectTraits>::value) {
+      static_assert(
+          !IsPublisherKeyCustomType<SaiObjectTraits>::value,
+          "method not available for objects with publisher attributes of custom types");
+    }
+    CHECK_EQ(adapterHostKeys.size(), attributes.size());
+    XLOGF(
+        DBG5,
+        "SaiStore setting {} {} objects",
+        adapterHostKeys.size(),
+        objectTypeName());
+    std::vector<std::shared_ptr<ObjectType>> objects(adapterHostKeys.size());
+    std::vector<bool> programmed(adapterHostKeys.size(), false);
+    std::vector<size_t> toCreate;
+    for (size_t i = 0; i < adapterHostKeys.size(); ++i) {
+      objects[i] = objects_.ref(adapterHostKeys[i]);
+      if (objects[i]) {
+        objects[i]->setAttributes(attributes[i]);
+      } else {
+        toCreate.push_back(i);
+      }
+    }
+    auto& api =
+        SaiApiTable::getInstance()->getApi<typename SaiObjectTraits::SaiApiT>();
+    for (size_t start = 0; start < toCreate.size(); start += kMaxBulkSize) {
+      auto end = std::min(start + kMaxBulkSize, toCreate.size());
+      std::vector<typename SaiObjectTraits::AdapterKey> keys;
+      std::vector<typename SaiObjectTraits::CreateAttributes> createAttributes;
+      keys.reserve(end - start);
+      createAttributes.reserve(end - start);
+      for (auto j = start; j < end; ++j) {
+        keys.push_back(adapterHostKeys[toCreate[j]]);
+        createAttributes.push_back(attributes[toCreate[j]]);
+      }
+      api.template bulkCreate<SaiObjectTraits>(keys, createAttributes);
+      for (auto j = start; j < end; ++j) {
+        auto i = toCreate[j];
+        objects[i] = objects_
+                         .refOrInsert(
+                             adapterHostKeys[i],
+                             ObjectType(
+                                 adapterHostKeys[i],
+                                 adapterHostKeys[i],
+                                 attributes[i]),
+                             true /*force*/)
+                         .first;
+        programmed[i] = true;
+      }
+    }
+    for (size_t i = 0; i < adapterHostKeys.size(); ++i) {
+      auto iter = warmBootHandles_.find(adapterHostKeys[i]);
+      if (iter != warmBootHandles_.end()) {
+        warmBootHandles_.erase(iter);
+        programmed[i] = true;
+      }
+      if (notify && programmed[i]) {
+        if constexpr (IsObjectPublisher<SaiObjectTraits>::value) {
+          objects[i]->notifyAfterCreate(objects[i]);
+        }
+      }
+    }
+    return objects;
+  }
+
+  /*
+   * Drop the given references, removing the objects they were the last
+   * reference to from the adapter with bulk remove calls of up to
+   * kMaxBulkSize objects. Objects still referenced elsewhere are left alone
+   * and get removed once their last reference goes away, as usual.
+   */
+  void removeObjects(std::vector<std::shared_ptr<ObjectType>> objects) {
+    std::vector<typename SaiObjectTraits::AdapterKey> keys;
+    std::vector<std::shared_ptr<ObjectType>> removed;
+    for (auto& object : objects) {
+      if (!object || object.use_count() != 1 || !object->live() ||
+          object->isOwnedByAdapter() || object->ignoreMissingInHwOnDelete_) {
+        // removed individually (if at all) when dropping the reference
+        continue;
+      }
+      if constexpr (IsObjectPublisher<SaiObjectTraits>::value) {
+        object->notifyBeforeDestroy();
+      }
+      keys.push_back(object->adapterKey());
+      object->release();
+      removed.push_back(std::move(object));
+    }
+    objects.clear();
+    XLOGF(
+        DBG5,
+        "SaiStore removing {} {} objects",
+        keys.size(),
+        objectTypeName());
+    auto& api =
+        SaiApiTable::getInstance()->getApi<typename SaiObjectTraits::SaiApiT>();
+    for (size_t start = 0; start < keys.size(); start += kMaxBulkSize) {
+      auto end = std::min(start + kMaxBulkSize, keys.size());
+      api.bulkRemove(std::vector<typename SaiObjectTraits::AdapterKey>(
+          keys.begin() + start, keys.begin() + end));
+    }
+  }
+
   std::shared_ptr<ObjectType> get(
       const typename SaiObjectTraits::AdapterHostKey& adapterHostKey) {
     XLOGF(DBG5, "SaiStore get object {}", adapterHostKey);
@@ -297,6 +420,11 @@ class SaiObjectStore {
   uint64_t size() const {
     return objects_.size();
   }
+
+  // Objects and the memory the store holds for them, attributes aside
+  RefMapMemoryUsage memoryUsage() const {
+    return objects_.memoryUsage();
+  }
   typename UnorderedRefMap<
       typename SaiObjectTraits::AdapterHostKey,
       ObjectType>::MapType::const_iterator
@@ -487,6 +615,12 @@ class SaiStore {
   }
 
   std::string storeStr(sai_object_type_t objType) const;
+  /*
+   * Export the number of objects and memory held by each SaiObjectStore as
+   * sai_store.<object type>.objects/bytes fb303 counters. Safe to call
+   * while objects are being created or removed.
+   */
+  void exportMemoryUsage() const;
   folly::dynamic adapterKeysFollyDynamic() const;
 
   void exitForWarmBoot();
@@ -584,6 +718,9 @@ struct formatter<facebook::fboss::SaiObjectStore<SaiObjectTraits>> {
       std::ignore = key;
       ss << fmt::format("{}", *object.lock()) << std::endl;
     }
+    auto usage = store.memoryUsage();
+    ss << "Objects: " << usage.numValues << ", memory: " << usage.bytes
+       << " bytes" << std::endl;
     return format_to(ctx.out(), "{}", ss.str());
   }
 };
@@ -77,6 +77,46 @@ TEST_F(SaiStoreTest, routeCreateCtor) {
   EXPECT_EQ(GET_OPT_ATTR(Route, Metadata, obj.attributes()), 42);
 }
 
+TEST_F(SaiStoreTest, bulkSetAndRemoveRoutes) {
+  saiStore->setSwitchId(0);
+  auto& store = saiStore->get<SaiRouteTraits>();
+  SaiRouteTraits::RouteEntry existing(
+      0, 0, folly::CIDRNetwork(folly::IPAddress("10.10.10.0"), 24));
+  auto existingObj =
+      store.setObject(existing, {SAI_PACKET_ACTION_FORWARD, 5, std::nullopt});
+
+  std::vector<SaiRouteTraits::RouteEntry> entries{existing};
+  std::vector<SaiRouteTraits::CreateAttributes> attributes{
+      {SAI_PACKET_ACTION_FORWARD, 6, std::nullopt}};
+  for (int i = 0; i < 3; ++i) {
+    entries.emplace_back(
+        0,
+        0,
+        folly::CIDRNetwork(
+            folly::IPAddress(folly::to<std::string>("10.10.", i, ".0")), 24));
+    attributes.push_back({SAI_PACKET_ACTION_FORWARD, 7 + i, std::nullopt});
+  }
+  auto objects = store.setObjects(entries, attributes);
+  ASSERT_EQ(4, objects.size());
+  EXPECT_EQ(existingObj, objects[0]);
+  EXPECT_EQ(GET_OPT_ATTR(Route, NextHopId, existingObj->attributes()), 6);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(objects[i], store.get(entries[i]));
+    EXPECT_EQ(
+        saiApiTable->routeApi().getAttribute(
+            entries[i], SaiRouteTraits::Attributes::NextHopId()),
+        6 + i);
+  }
+  EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 4);
+
+  // Still referenced by existingObj, left to be removed with it
+  store.removeObjects(std::move(objects));
+  EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 1);
+  EXPECT_EQ(existingObj, store.get(existing));
+  existingObj.reset();
+  EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 0);
+}
+
 TEST_F(SaiStoreTest, routeSetToPunt) {
   folly::IPAddress ip4{"10.10.10.1"};
   folly::CIDRNetwork dest(ip4, 24);
@@ -45,6 +45,11 @@ struct ConcurrentIndices {
    * lag sai id to aggregate port id
    */
   folly::ConcurrentHashMap<LagSaiId, AggregatePortID> aggregatePortIds;
+  /*
+   * Reverse of aggregatePortIds, used by rx to find the lag of a member port
+   * without scanning every lag
+   */
+  folly::ConcurrentHashMap<AggregatePortID, LagSaiId> aggregatePortSaiIds;
 };
 
 } // namespace facebook::fboss
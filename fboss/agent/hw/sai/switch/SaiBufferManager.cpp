@@ -157,12 +157,35 @@ void SaiBufferManager::setupEgressBufferPool() {
 }
 
 void SaiBufferManager::updateStats() {
-  if (egressBufferPoolHandle_) {
-    egressBufferPoolHandle_->bufferPool->updateStats();
-    auto counters = egressBufferPoolHandle_->bufferPool->getStats();
-    deviceWatermarkBytes_ = counters[SAI_BUFFER_POOL_STAT_WATERMARK_BYTES];
-    publishDeviceWatermark(deviceWatermarkBytes_);
+  if (auto counters = prepareStats()) {
+    counters->read();
+    finishStats(*counters);
+  }
+}
+
+std::optional<SaiCounterValues<SaiBufferPoolTraits>>
+SaiBufferManager::prepareStats() const {
+  if (!egressBufferPoolHandle_) {
+    return std::nullopt;
+  }
+  SaiCounterValues<SaiBufferPoolTraits> counters;
+  counters.adapterKey = egressBufferPoolHandle_->bufferPool->adapterKey();
+  return counters;
+}
+
+void SaiBufferManager::finishStats(
+    const SaiCounterValues<SaiBufferPoolTraits>& counters) {
+  if (!egressBufferPoolHandle_ ||
+      egressBufferPoolHandle_->bufferPool->adapterKey() !=
+          counters.adapterKey) {
+    // Pool was removed or recreated while its counters were read
+    return;
   }
+  auto& bufferPool = egressBufferPoolHandle_->bufferPool;
+  bufferPool->setStats(counters);
+  auto poolCounters = bufferPool->getStats();
+  deviceWatermarkBytes_ = poolCounters[SAI_BUFFER_POOL_STAT_WATERMARK_BYTES];
+  publishDeviceWatermark(deviceWatermarkBytes_);
 }
 
 SaiBufferProfileTraits::CreateAttributes SaiBufferManager::profileCreateAttrs(
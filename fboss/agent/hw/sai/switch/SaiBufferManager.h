@@ -17,6 +17,7 @@
 #include "fboss/lib/RefMap.h"
 
 #include <memory>
+#include <optional>
 
 namespace facebook::fboss {
 
@@ -44,6 +45,10 @@ class SaiBufferManager {
 
   void setupEgressBufferPool();
   void updateStats();
+  // updateStats() in steps, see SaiPortManager::prepareStats(). The pool
+  // counters are read with SaiCounterValues::read() in between.
+  std::optional<SaiCounterValues<SaiBufferPoolTraits>> prepareStats() const;
+  void finishStats(const SaiCounterValues<SaiBufferPoolTraits>& counters);
   uint64_t getDeviceWatermarkBytes() const {
     return deviceWatermarkBytes_;
   }
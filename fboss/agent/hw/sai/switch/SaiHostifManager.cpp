@@ -410,10 +410,22 @@ void SaiHostifManager::loadCpuPort() {
 }
 
 void SaiHostifManager::updateStats(bool updateWatermarks) {
+  auto queues = prepareStats();
+  SaiQueueManager::readStats(queues, updateWatermarks);
+  finishStats(queues, updateWatermarks);
+}
+
+std::vector<SaiQueueStats> SaiHostifManager::prepareStats() const {
+  return SaiQueueManager::statsQueues(cpuPortHandle_->configuredQueues);
+}
+
+void SaiHostifManager::finishStats(
+    const std::vector<SaiQueueStats>& queues,
+    bool updateWatermarks) {
   auto now = duration_cast<seconds>(system_clock::now().time_since_epoch());
   HwPortStats cpuQueueStats;
-  managerTable_->queueManager().updateStats(
-      cpuPortHandle_->configuredQueues, cpuQueueStats, updateWatermarks);
+  SaiQueueManager::fillStats(
+      cpuPortHandle_->configuredQueues, queues, cpuQueueStats);
   cpuStats_.updateStats(cpuQueueStats, now);
   if (updateWatermarks) {
     for (const auto& queueId2Name : cpuStats_.getQueueId2Name()) {
@@ -76,6 +76,11 @@ class SaiHostifManager {
   const SaiQueueHandle* getQueueHandle(
       const SaiQueueConfig& saiQueueConfig) const;
   void updateStats(bool updateWatermarks = false);
+  // updateStats() in steps, see SaiPortManager::prepareStats()
+  std::vector<SaiQueueStats> prepareStats() const;
+  void finishStats(
+      const std::vector<SaiQueueStats>& queues,
+      bool updateWatermarks = false);
   HwPortStats getCpuPortStats() const;
   QueueConfig getQueueSettings() const;
   const HwCpuFb303Stats& getCpuFb303Stats() const {
@@ -58,6 +58,8 @@ LagSaiId SaiLagManager::addLag(
       PortDescriptorSaiId(lag->adapterKey()), vlanID);
   concurrentIndices_->aggregatePortIds.emplace(
       lag->adapterKey(), aggregatePort->getID());
+  concurrentIndices_->aggregatePortSaiIds.emplace(
+      aggregatePort->getID(), lag->adapterKey());
   auto handle = std::make_unique<SaiLagHandle>();
 
   handle->members = std::move(members);
@@ -224,6 +226,7 @@ void SaiLagManager::removeLagHandle(
   concurrentIndices_->vlanIds.erase(
       PortDescriptorSaiId(handle->lag->adapterKey()));
   concurrentIndices_->aggregatePortIds.erase(handle->lag->adapterKey());
+  concurrentIndices_->aggregatePortSaiIds.erase(aggPort);
   // remove lag
   handle->lag.reset();
 }
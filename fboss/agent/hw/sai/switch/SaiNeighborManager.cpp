@@ -23,6 +23,8 @@
 #include "fboss/agent/state/NdpEntry.h"
 #include "folly/IPAddress.h"
 
+#include <algorithm>
+
 namespace facebook::fboss {
 
 SaiNeighborManager::SaiNeighborManager(
@@ -131,18 +133,83 @@ void SaiNeighborManager::removeNeighbor(
   }
   XLOG(INFO) << "removeNeighbor " << swEntry->getIP();
   auto subscriberKey = saiEntryFromSwEntry(swEntry);
-  if (managedNeighbors_.find(subscriberKey) == managedNeighbors_.end()) {
+  auto iter = managedNeighbors_.find(subscriberKey);
+  if (iter == managedNeighbors_.end()) {
     throw FbossError(
         "Attempted to remove non-existent neighbor: ", swEntry->getIP());
   }
-  managedNeighbors_.erase(subscriberKey);
+  if (batching_) {
+    cancelQueuedSaiObject(iter->second.get());
+    if (auto neighbor = iter->second->getSaiNeighbor()) {
+      pendingRemoves_.push_back(std::move(neighbor));
+    }
+  }
+  managedNeighbors_.erase(iter);
   XLOG(DBG2) << "Remove Neighbor: " << swEntry->str();
 }
 
 void SaiNeighborManager::clear() {
+  pendingAdds_.clear();
+  pendingAddIndices_.clear();
+  pendingRemoves_.clear();
   managedNeighbors_.clear();
 }
 
+void SaiNeighborManager::startBatch() {
+  batching_ = true;
+}
+
+void SaiNeighborManager::flushBatch() {
+  batching_ = false;
+  auto pendingAdds = std::move(pendingAdds_);
+  auto pendingRemoves = std::move(pendingRemoves_);
+  pendingAdds_.clear();
+  pendingAddIndices_.clear();
+  pendingRemoves_.clear();
+  auto& store = saiStore_->get<SaiNeighborTraits>();
+
+  // Neighbors changed in this batch are removed, then added back
+  store.removeObjects(std::move(pendingRemoves));
+
+  pendingAdds.erase(
+      std::remove_if(
+          pendingAdds.begin(),
+          pendingAdds.end(),
+          [](const auto& pending) { return !pending.neighbor; }),
+      pendingAdds.end());
+  std::vector<SaiNeighborTraits::AdapterHostKey> keys;
+  std::vector<SaiNeighborTraits::CreateAttributes> attributes;
+  keys.reserve(pendingAdds.size());
+  attributes.reserve(pendingAdds.size());
+  for (const auto& pending : pendingAdds) {
+    keys.push_back(pending.key);
+    attributes.push_back(pending.attributes);
+  }
+  auto objects = store.setObjects(keys, attributes);
+  for (size_t i = 0; i < pendingAdds.size(); ++i) {
+    pendingAdds[i].neighbor->setSaiObject(objects[i], pendingAdds[i].fdbEntry);
+  }
+}
+
+void SaiNeighborManager::queueSaiObject(
+    ManagedNeighbor* neighbor,
+    const SaiNeighborTraits::AdapterHostKey& key,
+    const SaiNeighborTraits::CreateAttributes& attributes,
+    const SaiFdbEntry* fdbEntry) {
+  cancelQueuedSaiObject(neighbor);
+  pendingAddIndices_.emplace(neighbor, pendingAdds_.size());
+  pendingAdds_.push_back({neighbor, key, attributes, fdbEntry});
+}
+
+void SaiNeighborManager::cancelQueuedSaiObject(ManagedNeighbor* neighbor) {
+  auto iter = pendingAddIndices_.find(neighbor);
+  if (iter == pendingAddIndices_.end()) {
+    return;
+  }
+  pendingAdds_[iter->second].neighbor = nullptr;
+  pendingAddIndices_.erase(iter);
+}
+
 std::shared_ptr<SaiNeighbor> SaiNeighborManager::createSaiObject(
     const SaiNeighborTraits::AdapterHostKey& key,
     const SaiNeighborTraits::CreateAttributes& attributes) {
@@ -191,10 +258,22 @@ void ManagedNeighbor::createObject(PublisherObjects objects) {
 
   auto createAttributes = SaiNeighborTraits::CreateAttributes{
       fdbEntry->adapterHostKey().mac(), metadata_};
+  if (manager_->isBatching()) {
+    manager_->queueSaiObject(
+        this, adapterHostKey, createAttributes, fdbEntry.get());
+    XLOG(DBG2) << "ManagedNeigbhor::createObject: queued " << toString();
+    return;
+  }
   auto object = manager_->createSaiObject(adapterHostKey, createAttributes);
+  setSaiObject(object, fdbEntry.get());
+}
+
+void ManagedNeighbor::setSaiObject(
+    std::shared_ptr<SaiNeighbor> object,
+    const SaiFdbEntry* fdbEntry) {
   this->setObject(object);
   handle_->neighbor = getSaiObject();
-  handle_->fdbEntry = fdbEntry.get();
+  handle_->fdbEntry = fdbEntry;
 
   XLOG(DBG2) << "ManagedNeigbhor::createObject: " << toString();
 }
@@ -202,6 +281,7 @@ void ManagedNeighbor::createObject(PublisherObjects objects) {
 void ManagedNeighbor::removeObject(size_t, PublisherObjects) {
   XLOG(DBG2) << "ManagedNeigbhor::removeObject: " << toString();
 
+  manager_->cancelQueuedSaiObject(this);
   this->resetObject();
   handle_->neighbor = nullptr;
   handle_->fdbEntry = nullptr;
@@ -21,6 +21,7 @@
 
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -81,6 +82,15 @@ class ManagedNeighbor : public SaiObjectEventAggregateSubscriber<
 
   void notifySubscribers() const;
 
+  // Take the object created for this neighbor by a batch, see createObject
+  void setSaiObject(
+      std::shared_ptr<SaiNeighbor> object,
+      const SaiFdbEntry* fdbEntry);
+
+  std::shared_ptr<SaiNeighbor> getSaiNeighbor() const {
+    return this->getObject();
+  }
+
  private:
   std::string toString() const;
 
@@ -129,10 +139,34 @@ class SaiNeighborManager {
 
   bool isLinkUp(SaiPortDescriptor port);
 
+  /*
+   * Neighbors created or removed between startBatch() and flushBatch() are
+   * queued and programmed with bulk SAI calls on flushBatch(). Subscribers
+   * of a queued neighbor (next hops) are notified once it is created.
+   */
+  void startBatch();
+  void flushBatch();
+  bool isBatching() const {
+    return batching_;
+  }
+  void queueSaiObject(
+      ManagedNeighbor* neighbor,
+      const SaiNeighborTraits::AdapterHostKey& key,
+      const SaiNeighborTraits::CreateAttributes& attributes,
+      const SaiFdbEntry* fdbEntry);
+  void cancelQueuedSaiObject(ManagedNeighbor* neighbor);
+
  private:
   SaiNeighborHandle* getNeighborHandleImpl(
       const SaiNeighborTraits::NeighborEntry& entry) const;
 
+  struct PendingNeighbor {
+    ManagedNeighbor* neighbor;
+    SaiNeighborTraits::AdapterHostKey key;
+    SaiNeighborTraits::CreateAttributes attributes;
+    const SaiFdbEntry* fdbEntry;
+  };
+
   SaiStore* saiStore_;
   SaiManagerTable* managerTable_;
   const SaiPlatform* platform_;
@@ -140,6 +174,10 @@ class SaiNeighborManager {
       SaiNeighborTraits::NeighborEntry,
       std::shared_ptr<ManagedNeighbor>>
       managedNeighbors_;
+  bool batching_{false};
+  std::vector<PendingNeighbor> pendingAdds_;
+  folly::F14FastMap<ManagedNeighbor*, size_t> pendingAddIndices_;
+  std::vector<std::shared_ptr<SaiNeighbor>> pendingRemoves_;
 };
 
 } // namespace facebook::fboss
@@ -600,17 +600,51 @@ SaiQueueHandle* SaiPortManager::getQueueHandle(
 }
 
 void SaiPortManager::updateStats(PortID portId, bool updateWatermarks) {
+  if (auto stats = prepareStats(portId, updateWatermarks)) {
+    stats->readCounters();
+    finishStats(*stats);
+  }
+}
+
+std::optional<SaiPortStats> SaiPortManager::prepareStats(
+    PortID portId,
+    bool updateWatermarks) const {
   auto handlesItr = handles_.find(portId);
   if (handlesItr == handles_.end()) {
+    return std::nullopt;
+  }
+  if (portStats_.find(portId) == portStats_.end()) {
+    // We don't maintain port stats for disabled ports.
+    return std::nullopt;
+  }
+  const auto* handle = handlesItr->second.get();
+  SaiPortStats stats{portId, updateWatermarks, &supportedStats()};
+  stats.port.adapterKey = handle->port->adapterKey();
+  stats.queues = SaiQueueManager::statsQueues(handle->configuredQueues);
+  return stats;
+}
+
+void SaiPortStats::readCounters() {
+  port.read(*counterIds, SAI_STATS_MODE_READ);
+  SaiQueueManager::readStats(queues, updateWatermarks);
+}
+
+void SaiPortManager::finishStats(const SaiPortStats& stats) {
+  auto portId = stats.portId;
+  auto handlesItr = handles_.find(portId);
+  if (handlesItr == handles_.end() ||
+      handlesItr->second->port->adapterKey() != stats.port.adapterKey) {
+    // Port was removed or recreated while its counters were read
     return;
   }
   auto now = duration_cast<seconds>(system_clock::now().time_since_epoch());
-  auto* handle = handlesItr->second.get();
   auto portStatItr = portStats_.find(portId);
   if (portStatItr == portStats_.end()) {
     // We don't maintain port stats for disabled ports.
     return;
   }
+  const auto* handle = handlesItr->second.get();
+  handle->port->setStats(stats.port);
   const auto& prevPortStats = portStatItr->second->portStats();
   HwPortStats curPortStats{prevPortStats};
   // All stats start with a unitialized (-1) value. If there are no in
@@ -621,7 +655,6 @@ void SaiPortManager::updateStats(PortID portId, bool updateWatermarks) {
       ? 0
       : *curPortStats.inDiscards__ref();
   curPortStats.timestamp__ref() = now.count();
-  handle->port->updateStats(supportedStats(), SAI_STATS_MODE_READ);
   const auto& counters = handle->port->getStats();
   fillHwPortStats(counters, managerTable_->debugCounterManager(), curPortStats);
   std::vector<utility::CounterPrevAndCur> toSubtractFromInDiscardsRaw = {
@@ -631,10 +664,10 @@ void SaiPortManager::updateStats(PortID portId, bool updateWatermarks) {
   *curPortStats.inDiscards__ref() += utility::subtractIncrements(
       {*prevPortStats.inDiscardsRaw__ref(), *curPortStats.inDiscardsRaw__ref()},
       toSubtractFromInDiscardsRaw);
-  managerTable_->queueManager().updateStats(
-      handle->configuredQueues, curPortStats, updateWatermarks);
+  SaiQueueManager::fillStats(
+      handle->configuredQueues, stats.queues, curPortStats);
   managerTable_->macsecManager().updateStats(portId, curPortStats);
-  portStats_[portId]->updateStats(curPortStats, now);
+  portStatItr->second->updateStats(curPortStats, now);
 }
 
 std::map<PortID, HwPortStats> SaiPortManager::getPortStats() const {
@@ -85,6 +85,21 @@ struct SaiPortHandle {
   SaiPortMirrorInfo mirrorInfo;
 };
 
+/*
+ * Counters of a port being read outside of saiSwitchMutex_, see
+ * SaiPortManager::prepareStats().
+ */
+struct SaiPortStats {
+  PortID portId;
+  bool updateWatermarks{false};
+  const std::vector<sai_stat_id_t>* counterIds{nullptr};
+  SaiCounterValues<SaiPortTraits> port;
+  std::vector<SaiQueueStats> queues;
+
+  // Only makes SAI calls by adapter key, under the port and queue api locks
+  void readCounters();
+};
+
 class SaiPortManager {
   using Handles = folly::F14FastMap<PortID, std::unique_ptr<SaiPortHandle>>;
   using Stats = folly::F14FastMap<PortID, std::unique_ptr<HwPortFb303Stats>>;
@@ -151,6 +166,22 @@ class SaiPortManager {
 
   void updateStats(PortID portID, bool updateWatermarks = false);
 
+  /*
+   * updateStats() in steps, so that SaiSwitch reads counters without holding
+   * saiSwitchMutex_ and thus concurrently with state updates:
+   *  - prepareStats() picks the adapter keys to read counters of,
+   *  - SaiPortStats::readCounters() reads them into the SaiPortStats,
+   *  - finishStats() records them on the port and queue objects still there
+   *    and computes and publishes port stats.
+   * prepareStats() and finishStats() must be called while holding
+   * saiSwitchMutex_. SaiPortStats holds no store objects, so ports and queues
+   * are removed and recreated as usual while their counters are read.
+   */
+  std::optional<SaiPortStats> prepareStats(
+      PortID portID,
+      bool updateWatermarks = false) const;
+  void finishStats(const SaiPortStats& stats);
+
   void clearStats(PortID portID);
 
   void programMirrorOnAllPorts(
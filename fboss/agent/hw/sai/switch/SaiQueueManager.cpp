@@ -18,6 +18,8 @@
 #include "fboss/agent/hw/switch_asics/HwAsic.h"
 #include "fboss/lib/TupleUtils.h"
 
+#include <algorithm>
+
 namespace facebook::fboss {
 
 namespace {
@@ -214,26 +216,72 @@ void SaiQueueManager::updateStats(
     const std::vector<SaiQueueHandle*>& queueHandles,
     HwPortStats& hwPortStats,
     bool updateWatermarks) {
-  hwPortStats.outCongestionDiscardPkts__ref() = 0;
+  auto queues = statsQueues(queueHandles);
+  readStats(queues, updateWatermarks);
+  fillStats(queueHandles, queues, hwPortStats);
+}
+
+std::vector<SaiQueueStats> SaiQueueManager::statsQueues(
+    const std::vector<SaiQueueHandle*>& queueHandles) {
+  std::vector<SaiQueueStats> queues;
+  queues.reserve(queueHandles.size());
+  for (auto queueHandle : queueHandles) {
+    SaiQueueStats queueStats;
+    queueStats.counters.adapterKey = queueHandle->queue->adapterKey();
+    queues.push_back(std::move(queueStats));
+  }
+  return queues;
+}
+
+void SaiQueueManager::readStats(
+    std::vector<SaiQueueStats>& queues,
+    bool updateWatermarks) {
   static std::vector<sai_stat_id_t> nonWatermarkStatsRead(
       SaiQueueTraits::NonWatermarkCounterIdsToRead.begin(),
       SaiQueueTraits::NonWatermarkCounterIdsToRead.end());
   static std::vector<sai_stat_id_t> nonWatermarkStatsReadAndClear(
       SaiQueueTraits::NonWatermarkCounterIdsToReadAndClear.begin(),
       SaiQueueTraits::NonWatermarkCounterIdsToReadAndClear.end());
-  for (auto queueHandle : queueHandles) {
+  for (auto& queueStats : queues) {
+    auto& counters = queueStats.counters;
     if (updateWatermarks) {
-      queueHandle->queue->updateStats();
+      counters.read();
     } else {
-      queueHandle->queue->updateStats(
-          nonWatermarkStatsRead, SAI_STATS_MODE_READ);
-      queueHandle->queue->updateStats(
+      counters.read(nonWatermarkStatsRead, SAI_STATS_MODE_READ);
+      counters.read(
           nonWatermarkStatsReadAndClear, SAI_STATS_MODE_READ_AND_CLEAR);
     }
-    const auto& counters = queueHandle->queue->getStats();
-    auto queueId = SaiApiTable::getInstance()->queueApi().getAttribute(
-        queueHandle->queue->adapterKey(), SaiQueueTraits::Attributes::Index{});
-    fillHwQueueStats(queueId, counters, hwPortStats);
+    if (counters.readError) {
+      continue;
+    }
+    try {
+      queueStats.queueId =
+          SaiApiTable::getInstance()->queueApi().getAttribute(
+              counters.adapterKey, SaiQueueTraits::Attributes::Index{});
+    } catch (const std::exception&) {
+      counters.readError = std::current_exception();
+    }
+  }
+}
+
+void SaiQueueManager::fillStats(
+    const std::vector<SaiQueueHandle*>& queueHandles,
+    const std::vector<SaiQueueStats>& queues,
+    HwPortStats& hwPortStats) {
+  hwPortStats.outCongestionDiscardPkts__ref() = 0;
+  for (const auto& queueStats : queues) {
+    auto queueHandle = std::find_if(
+        queueHandles.begin(), queueHandles.end(), [&](const auto* handle) {
+          return handle->queue->adapterKey() ==
+              queueStats.counters.adapterKey;
+        });
+    if (queueHandle == queueHandles.end()) {
+      // Queue was removed while its counters were read
+      continue;
+    }
+    auto& queue = (*queueHandle)->queue;
+    queue->setStats(queueStats.counters);
+    fillHwQueueStats(queueStats.queueId, queue->getStats(), hwPortStats);
   }
 }
 
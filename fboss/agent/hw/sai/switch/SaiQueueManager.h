@@ -48,6 +48,12 @@ struct SaiQueueHandle {
 using SaiQueueHandles =
     folly::F14FastMap<SaiQueueConfig, std::unique_ptr<SaiQueueHandle>>;
 
+// Counters of a queue being read, see SaiQueueManager::readStats()
+struct SaiQueueStats {
+  SaiCounterValues<SaiQueueTraits> counters;
+  uint8_t queueId{0};
+};
+
 class SaiQueueManager {
  public:
   SaiQueueManager(
@@ -66,6 +72,21 @@ class SaiQueueManager {
       const std::vector<SaiQueueHandle*>& queues,
       HwPortStats& stats,
       bool updateWatermarks);
+  /*
+   * updateStats() in steps, so that counters can be read without holding
+   * saiSwitchMutex_: statsQueues() and fillStats() must be called while
+   * holding it, readStats() only makes SAI calls by adapter key and does not
+   * need it. fillStats() skips the queues no longer in queueHandles.
+   */
+  static std::vector<SaiQueueStats> statsQueues(
+      const std::vector<SaiQueueHandle*>& queueHandles);
+  static void readStats(
+      std::vector<SaiQueueStats>& queues,
+      bool updateWatermarks);
+  static void fillStats(
+      const std::vector<SaiQueueHandle*>& queueHandles,
+      const std::vector<SaiQueueStats>& queues,
+      HwPortStats& stats);
   void getStats(SaiQueueHandles& queueHandles, HwPortStats& hwPortStats);
   QueueConfig getQueueSettings(const SaiQueueHandles& queueHandles) const;
 
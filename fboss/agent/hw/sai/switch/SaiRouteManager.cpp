@@ -21,6 +21,7 @@
 
 #include "fboss/agent/platforms/sai/SaiPlatform.h"
 
+#include <algorithm>
 #include <optional>
 
 namespace facebook::fboss {
@@ -241,6 +242,11 @@ void SaiRouteManager::addOrUpdateRoute(
 
     XLOG(DBG3) << "Route action DROP: " << newRoute->str();
   }
+  if (batching_ && !routeHandle->route) {
+    pendingAdds_.push_back({routeHandle, entry, attributes.value()});
+    routeHandle->nexthopHandle_ = nextHopHandle;
+    return;
+  }
   auto& store = saiStore_->get<SaiRouteTraits>();
   auto route = store.setObject(entry, attributes.value());
   routeHandle->route = route;
@@ -297,11 +303,27 @@ void SaiRouteManager::removeRoute(
     RouterID routerId) {
   XLOG(DBG3) << "Remove route: " << swRoute->str();
   SaiRouteTraits::RouteEntry entry = routeEntryFromSwRoute(routerId, swRoute);
-  size_t count = handles_.erase(entry);
-  if (!count) {
+  auto itr = handles_.find(entry);
+  if (itr == handles_.end()) {
     throw FbossError(
         "Failed to remove non-existent route to ", swRoute->prefix().str());
   }
+  if (batching_) {
+    if (!itr->second->route) {
+      // added in this batch, drop the queued creation
+      auto handle = itr->second.get();
+      pendingAdds_.erase(
+          std::remove_if(
+              pendingAdds_.begin(),
+              pendingAdds_.end(),
+              [handle](const auto& pending) {
+                return pending.handle == handle;
+              }),
+          pendingAdds_.end());
+    }
+    pendingRemoves_.push_back(std::move(itr->second));
+  }
+  handles_.erase(itr);
 }
 
 SaiRouteHandle* SaiRouteManager::getRouteHandle(
@@ -327,9 +349,59 @@ SaiRouteHandle* SaiRouteManager::getRouteHandleImpl(
 }
 
 void SaiRouteManager::clear() {
+  pendingAdds_.clear();
+  pendingRemoves_.clear();
   handles_.clear();
 }
 
+void SaiRouteManager::startBatch() {
+  batching_ = true;
+}
+
+void SaiRouteManager::flushBatch() {
+  batching_ = false;
+  auto pendingAdds = std::move(pendingAdds_);
+  auto pendingRemoves = std::move(pendingRemoves_);
+  pendingAdds_.clear();
+  pendingRemoves_.clear();
+  auto& store = saiStore_->get<SaiRouteTraits>();
+
+  // Remove routes first, to free up hw resources for the added ones
+  std::vector<std::shared_ptr<SaiRoute>> removed;
+  removed.reserve(pendingRemoves.size());
+  for (auto& handle : pendingRemoves) {
+    removed.push_back(std::move(handle->route));
+  }
+  store.removeObjects(std::move(removed));
+  pendingRemoves.clear();
+
+  std::vector<SaiRouteTraits::RouteEntry> entries;
+  std::vector<SaiRouteTraits::CreateAttributes> attributes;
+  entries.reserve(pendingAdds.size());
+  attributes.reserve(pendingAdds.size());
+  for (auto& pending : pendingAdds) {
+    // The next hop may have been resolved or unresolved since the route was
+    // queued, pick up its current adapter key
+    std::visit(
+        [&pending](const auto& handle) {
+          using HandleT = std::decay_t<decltype(handle)>;
+          if constexpr (!std::is_same_v<
+                            HandleT,
+                            std::shared_ptr<SaiNextHopGroupHandle>>) {
+            std::get<std::optional<SaiRouteTraits::Attributes::NextHopId>>(
+                pending.attributes) = handle->adapterKey();
+          }
+        },
+        pending.handle->nexthopHandle_);
+    entries.push_back(pending.entry);
+    attributes.push_back(pending.attributes);
+  }
+  auto routes = store.setObjects(entries, attributes);
+  for (size_t i = 0; i < pendingAdds.size(); ++i) {
+    pendingAdds[i].handle->route = routes[i];
+  }
+}
+
 std::shared_ptr<SaiObject<SaiRouteTraits>> SaiRouteManager::getRouteObject(
     SaiRouteTraits::AdapterHostKey routeKey) {
   return saiStore_->get<SaiRouteTraits>().get(routeKey);
@@ -410,6 +482,11 @@ void ManagedRouteNextHop<NextHopTraitsT>::beforeRemove() {
 
   // set route to CPU
   auto route = routeManager_->getRouteObject(routeKey_);
+  if (!route) {
+    // route is not yet created, it picks up the CPU port when it is.
+    this->setPublisherObject(nullptr);
+    return;
+  }
   auto attributes = route->attributes();
 
   std::get<std::optional<SaiRouteTraits::Attributes::NextHopId>>(attributes) =
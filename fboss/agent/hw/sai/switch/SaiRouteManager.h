@@ -22,6 +22,7 @@
 
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -117,6 +118,15 @@ class SaiRouteManager {
   std::shared_ptr<SaiObject<SaiRouteTraits>> getRouteObject(
       SaiRouteTraits::AdapterHostKey routeKey);
 
+  /*
+   * Routes added or removed between startBatch() and flushBatch() are
+   * queued and programmed with bulk SAI calls on flushBatch(), instead of
+   * one SAI call per route. Route handles (and the next hops they hold)
+   * are updated right away, so the batch is invisible to other managers.
+   */
+  void startBatch();
+  void flushBatch();
+
  private:
   SaiRouteHandle* getRouteHandleImpl(
       const SaiRouteTraits::RouteEntry& entry) const;
@@ -144,6 +154,16 @@ class SaiRouteManager {
   const SaiPlatform* platform_;
   folly::F14FastMap<SaiRouteTraits::RouteEntry, std::unique_ptr<SaiRouteHandle>>
       handles_;
+
+  struct PendingRoute {
+    SaiRouteHandle* handle;
+    SaiRouteTraits::RouteEntry entry;
+    SaiRouteTraits::CreateAttributes attributes;
+  };
+  bool batching_{false};
+  std::vector<PendingRoute> pendingAdds_;
+  // Removed handles are kept until flush so that next hops outlive routes
+  std::vector<std::unique_ptr<SaiRouteHandle>> pendingRemoves_;
 };
 
 } // namespace facebook::fboss
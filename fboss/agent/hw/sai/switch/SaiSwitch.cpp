@@ -547,31 +547,33 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImpl(
       &SaiRouterInterfaceManager::addRouterInterface,
       &SaiRouterInterfaceManager::removeRouterInterface);
 
-  for (const auto& vlanDelta : delta.getVlansDelta()) {
-    processDelta(
-        vlanDelta.getArpDelta(),
-        managerTable_->neighborManager(),
-        lockPolicy,
-        &SaiNeighborManager::changeNeighbor<ArpEntry>,
-        &SaiNeighborManager::addNeighbor<ArpEntry>,
-        &SaiNeighborManager::removeNeighbor<ArpEntry>);
-
-    processDelta(
-        vlanDelta.getNdpDelta(),
-        managerTable_->neighborManager(),
-        lockPolicy,
-        &SaiNeighborManager::changeNeighbor<NdpEntry>,
-        &SaiNeighborManager::addNeighbor<NdpEntry>,
-        &SaiNeighborManager::removeNeighbor<NdpEntry>);
-
-    processDelta(
-        vlanDelta.getMacDelta(),
-        managerTable_->fdbManager(),
-        lockPolicy,
-        &SaiFdbManager::changeMac,
-        &SaiFdbManager::addMac,
-        &SaiFdbManager::removeMac);
-  }
+  processBatched(managerTable_->neighborManager(), lockPolicy, [&]() {
+    for (const auto& vlanDelta : delta.getVlansDelta()) {
+      processDelta(
+          vlanDelta.getArpDelta(),
+          managerTable_->neighborManager(),
+          lockPolicy,
+          &SaiNeighborManager::changeNeighbor<ArpEntry>,
+          &SaiNeighborManager::addNeighbor<ArpEntry>,
+          &SaiNeighborManager::removeNeighbor<ArpEntry>);
+
+      processDelta(
+          vlanDelta.getNdpDelta(),
+          managerTable_->neighborManager(),
+          lockPolicy,
+          &SaiNeighborManager::changeNeighbor<NdpEntry>,
+          &SaiNeighborManager::addNeighbor<NdpEntry>,
+          &SaiNeighborManager::removeNeighbor<NdpEntry>);
+
+      processDelta(
+          vlanDelta.getMacDelta(),
+          managerTable_->fdbManager(),
+          lockPolicy,
+          &SaiFdbManager::changeMac,
+          &SaiFdbManager::addMac,
+          &SaiFdbManager::removeMac);
+    }
+  });
 
   auto processV4RoutesDelta = [this, &lockPolicy](
                                   RouterID rid, const auto& routesDelta) {
@@ -597,14 +599,16 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImpl(
         rid);
   };
 
-  for (const auto& routeDelta : delta.getFibsDelta()) {
-    auto routerID = routeDelta.getOld() ? routeDelta.getOld()->getID()
-                                        : routeDelta.getNew()->getID();
-    processV4RoutesDelta(
-        routerID, routeDelta.getFibDelta<folly::IPAddressV4>());
-    processV6RoutesDelta(
-        routerID, routeDelta.getFibDelta<folly::IPAddressV6>());
-  }
+  processBatched(managerTable_->routeManager(), lockPolicy, [&]() {
+    for (const auto& routeDelta : delta.getFibsDelta()) {
+      auto routerID = routeDelta.getOld() ? routeDelta.getOld()->getID()
+                                          : routeDelta.getNew()->getID();
+      processV4RoutesDelta(
+          routerID, routeDelta.getFibDelta<folly::IPAddressV4>());
+      processV6RoutesDelta(
+          routerID, routeDelta.getFibDelta<folly::IPAddressV6>());
+    }
+  });
   {
     auto controlPlaneDelta = delta.getControlPlaneDelta();
     if (*controlPlaneDelta.getOld() != *controlPlaneDelta.getNew()) {
@@ -1300,14 +1304,9 @@ void SaiSwitch::packetRxCallback(
     // hack if SAI_HOSTIF_PACKET_ATTR_INGRESS_LAG is not set on packet on lag!
     // if port belongs to some aggregate port, process packet as if coming
     // from lag.
-    auto [portSaiId, aggregatePortId] = *iter;
-    std::ignore = portSaiId;
-    for (auto entry : concurrentIndices_->aggregatePortIds) {
-      auto [lagSaiId, swLagId] = entry;
-      if (swLagId == aggregatePortId) {
-        lagSaiIdOpt = lagSaiId;
-        break;
-      }
+    auto lagItr = concurrentIndices_->aggregatePortSaiIds.find(iter->second);
+    if (lagItr != concurrentIndices_->aggregatePortSaiIds.end()) {
+      lagSaiIdOpt = lagItr->second;
     }
   }
 
@@ -2059,6 +2058,26 @@ void SaiSwitch::processRemovedDelta(
       });
 }
 
+template <typename Manager, typename LockPolicyT, typename ProcessFn>
+void SaiSwitch::processBatched(
+    Manager& manager,
+    const LockPolicyT& lockPolicy,
+    ProcessFn processFn) {
+  {
+    [[maybe_unused]] const auto& lock = lockPolicy.lock();
+    manager.startBatch();
+  }
+  try {
+    processFn();
+  } catch (const std::exception&) {
+    [[maybe_unused]] const auto& lock = lockPolicy.lock();
+    manager.flushBatch();
+    throw;
+  }
+  [[maybe_unused]] const auto& lock = lockPolicy.lock();
+  manager.flushBatch();
+}
+
 void SaiSwitch::dumpDebugState(const std::string& path) const {
   saiCheckError(sai_dbg_generate_dump(path.c_str()));
 }
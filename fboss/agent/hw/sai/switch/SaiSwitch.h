@@ -368,6 +368,17 @@ class SaiSwitch : public HwSwitch {
       RemovedFunc removedFunc,
       Args... args);
 
+  /*
+   * Run processFn with manager queueing its SAI calls into a batch (see
+   * SaiRouteManager::startBatch) which is flushed on return, or before
+   * rethrowing if processFn throws.
+   */
+  template <typename Manager, typename LockPolicyT, typename ProcessFn>
+  void processBatched(
+      Manager& manager,
+      const LockPolicyT& lockPolicy,
+      ProcessFn processFn);
+
   template <typename LockPolicyT>
   void processSwitchSettingsChanged(
       const StateDelta& delta,
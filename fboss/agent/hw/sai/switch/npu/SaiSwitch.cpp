@@ -11,12 +11,14 @@
 #include "fboss/agent/hw/sai/switch/SaiSwitch.h"
 
 #include "fboss/agent/hw/HwResourceStatsPublisher.h"
+#include "fboss/agent/hw/sai/store/SaiStore.h"
 #include "fboss/agent/hw/sai/switch/ConcurrentIndices.h"
 #include "fboss/agent/hw/sai/switch/SaiAclTableManager.h"
 #include "fboss/agent/hw/sai/switch/SaiBufferManager.h"
 #include "fboss/agent/hw/sai/switch/SaiHostifManager.h"
 #include "fboss/agent/hw/sai/switch/SaiLagManager.h"
 #include "fboss/agent/hw/sai/switch/SaiPortManager.h"
+#include "fboss/agent/hw/sai/switch/SaiQueueManager.h"
 
 namespace facebook::fboss {
 void SaiSwitch::updateStatsImpl(SwitchStats* /* switchStats */) {
@@ -28,13 +30,26 @@ void SaiSwitch::updateStatsImpl(SwitchStats* /* switchStats */) {
     watermarkStatsUpdateTime_ = now;
   }
 
+  /*
+   * Counters are read without holding saiSwitchMutex_, so that they are read
+   * concurrently with state updates, e.g. route programming. Only adapter
+   * keys and counter values cross the unlocked window: the keys are picked,
+   * and the values recorded on the objects still in the store, while holding
+   * it.
+   */
   auto portsIter = concurrentIndices_->portIds.begin();
   while (portsIter != concurrentIndices_->portIds.end()) {
+    std::optional<SaiPortStats> portStats;
     {
       std::lock_guard<std::mutex> locked(saiSwitchMutex_);
-      managerTable_->portManager().updateStats(
+      portStats = managerTable_->portManager().prepareStats(
           portsIter->second, updateWatermarks);
     }
+    if (portStats) {
+      portStats->readCounters();
+      std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+      managerTable_->portManager().finishStats(*portStats);
+    }
     ++portsIter;
   }
   auto lagsIter = concurrentIndices_->aggregatePortIds.begin();
@@ -46,12 +61,26 @@ void SaiSwitch::updateStatsImpl(SwitchStats* /* switchStats */) {
     ++lagsIter;
   }
   {
+    std::vector<SaiQueueStats> cpuQueues;
+    {
+      std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+      cpuQueues = managerTable_->hostifManager().prepareStats();
+    }
+    SaiQueueManager::readStats(cpuQueues, updateWatermarks);
     std::lock_guard<std::mutex> locked(saiSwitchMutex_);
-    managerTable_->hostifManager().updateStats(updateWatermarks);
+    managerTable_->hostifManager().finishStats(cpuQueues, updateWatermarks);
   }
   {
-    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
-    managerTable_->bufferManager().updateStats();
+    std::optional<SaiCounterValues<SaiBufferPoolTraits>> bufferPool;
+    {
+      std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+      bufferPool = managerTable_->bufferManager().prepareStats();
+    }
+    if (bufferPool) {
+      bufferPool->read();
+      std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+      managerTable_->bufferManager().finishStats(*bufferPool);
+    }
   }
   {
     std::lock_guard<std::mutex> locked(saiSwitchMutex_);
@@ -61,5 +90,7 @@ void SaiSwitch::updateStatsImpl(SwitchStats* /* switchStats */) {
     std::lock_guard<std::mutex> locked(saiSwitchMutex_);
     managerTable_->aclTableManager().updateStats();
   }
+  // Memory usage counters are atomics, no need to hold saiSwitchMutex_
+  saiStore_->exportMemoryUsage();
 }
 } // namespace facebook::fboss
@@ -41,6 +41,61 @@ WRAP_GET_ATTR_FUNC(
     SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER,
     nextHopGroup);
 
+// Bulk calls are logged as the per object calls they stand for
+sai_status_t wrap_create_next_hop_group_members(
+    sai_object_id_t switch_id,
+    uint32_t object_count,
+    const uint32_t* attr_count,
+    const sai_attribute_t** attr_list,
+    sai_bulk_op_error_mode_t mode,
+    sai_object_id_t* object_id,
+    sai_status_t* object_statuses) {
+  auto rv =
+      SaiTracer::getInstance()->nextHopGroupApi_->create_next_hop_group_members(
+          switch_id,
+          object_count,
+          attr_count,
+          attr_list,
+          mode,
+          object_id,
+          object_statuses);
+
+  for (uint32_t i = 0; i < object_count; ++i) {
+    if (object_statuses[i] != SAI_STATUS_NOT_EXECUTED) {
+      SaiTracer::getInstance()->logCreateFn(
+          "create_next_hop_group_member",
+          &object_id[i],
+          switch_id,
+          attr_count[i],
+          attr_list[i],
+          SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER,
+          object_statuses[i]);
+    }
+  }
+  return rv;
+}
+
+sai_status_t wrap_remove_next_hop_group_members(
+    uint32_t object_count,
+    const sai_object_id_t* object_id,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  auto rv =
+      SaiTracer::getInstance()->nextHopGroupApi_->remove_next_hop_group_members(
+          object_count, object_id, mode, object_statuses);
+
+  for (uint32_t i = 0; i < object_count; ++i) {
+    if (object_statuses[i] != SAI_STATUS_NOT_EXECUTED) {
+      SaiTracer::getInstance()->logRemoveFn(
+          "remove_next_hop_group_member",
+          object_id[i],
+          SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER,
+          object_statuses[i]);
+    }
+  }
+  return rv;
+}
+
 sai_next_hop_group_api_t* wrappedNextHopGroupApi() {
   static sai_next_hop_group_api_t nextHopGroupWrappers;
 
@@ -58,6 +113,10 @@ sai_next_hop_group_api_t* wrappedNextHopGroupApi() {
       &wrap_set_next_hop_group_member_attribute;
   nextHopGroupWrappers.get_next_hop_group_member_attribute =
       &wrap_get_next_hop_group_member_attribute;
+  nextHopGroupWrappers.create_next_hop_group_members =
+      &wrap_create_next_hop_group_members;
+  nextHopGroupWrappers.remove_next_hop_group_members =
+      &wrap_remove_next_hop_group_members;
 
   return &nextHopGroupWrappers;
 }
@@ -0,0 +1,283 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/SaiTraceRecord.h"
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/hw/sai/tracer/Utils.h"
+
+#include <folly/container/F14Map.h>
+#include <folly/logging/xlog.h>
+#include <glog/logging.h>
+
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace facebook::fboss {
+
+namespace {
+
+constexpr size_t kAlignment = 8;
+
+size_t padded(size_t size) {
+  return (size + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+size_t entrySize(int32_t objectType) {
+  switch (objectType) {
+    case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+      return sizeof(sai_route_entry_t);
+    case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+      return sizeof(sai_neighbor_entry_t);
+    case SAI_OBJECT_TYPE_FDB_ENTRY:
+      return sizeof(sai_fdb_entry_t);
+    case SAI_OBJECT_TYPE_INSEG_ENTRY:
+      return sizeof(sai_inseg_entry_t);
+    default:
+      return 0;
+  }
+}
+
+size_t listElementSize(TraceListType type) {
+  switch (type) {
+    case TraceListType::OBJECT_LIST:
+    case TraceListType::ACL_ACTION_OBJECT_LIST:
+      return sizeof(sai_object_id_t);
+    case TraceListType::S8_LIST:
+      return sizeof(int8_t);
+    case TraceListType::S32_LIST:
+      return sizeof(int32_t);
+    case TraceListType::U32_LIST:
+      return sizeof(uint32_t);
+    case TraceListType::QOS_MAP_LIST:
+      return sizeof(sai_qos_map_t);
+    case TraceListType::NONE:
+      break;
+  }
+  return 0;
+}
+
+// All SAI lists are laid out as a count followed by the elements' address
+struct SaiList {
+  uint32_t count;
+  void* list;
+};
+
+template <typename Value>
+auto listOf(Value& value, TraceListType type) {
+  using List =
+      std::conditional_t<std::is_const_v<Value>, const SaiList, SaiList>;
+  switch (type) {
+    case TraceListType::S8_LIST:
+      return reinterpret_cast<List*>(&value.s8list);
+    case TraceListType::S32_LIST:
+      return reinterpret_cast<List*>(&value.s32list);
+    case TraceListType::U32_LIST:
+      return reinterpret_cast<List*>(&value.u32list);
+    case TraceListType::QOS_MAP_LIST:
+      return reinterpret_cast<List*>(&value.qosmap);
+    case TraceListType::ACL_ACTION_OBJECT_LIST:
+      return reinterpret_cast<List*>(&value.aclaction.parameter.objlist);
+    case TraceListType::OBJECT_LIST:
+    case TraceListType::NONE:
+      break;
+  }
+  return reinterpret_cast<List*>(&value.objlist);
+}
+
+} // namespace
+
+TraceListType traceListType(sai_object_type_t objectType, sai_attr_id_t id) {
+  // Looked up for every traced attribute, the set*Attributes() functions
+  // are only probed once per thread for each attribute
+  static thread_local folly::F14FastMap<uint64_t, TraceListType> listTypes;
+  auto key = (static_cast<uint64_t>(objectType) << 32) | id;
+  if (auto it = listTypes.find(key); it != listTypes.end()) {
+    return it->second;
+  }
+  sai_attribute_t attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.id = id;
+  std::vector<std::string> attrLines;
+  ListTypeProbe probe;
+  setObjectAttributes(&attr, 1, objectType, attrLines);
+  listTypes.emplace(key, probe.listType());
+  return probe.listType();
+}
+
+void TraceRecordWriter::begin(
+    TraceOp op,
+    sai_object_type_t objectType,
+    sai_status_t rv,
+    sai_object_id_t objectId,
+    sai_object_id_t switchId) {
+  buffer_.resize(sizeof(TraceRecordHeader));
+  auto hdr = header<TraceRecordHeader>();
+  std::memset(hdr, 0, sizeof(TraceRecordHeader));
+  hdr->op = op;
+  hdr->objectType = objectType;
+  hdr->rv = rv;
+  hdr->timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count();
+  hdr->objectId = objectId;
+  hdr->switchId = switchId;
+  objectType_ = objectType;
+}
+
+void TraceRecordWriter::append(const void* data, size_t size) {
+  if (!size) {
+    return;
+  }
+  auto offset = buffer_.size();
+  buffer_.resize(offset + size);
+  std::memcpy(buffer_.data() + offset, data, size);
+}
+
+void TraceRecordWriter::pad() {
+  buffer_.resize(padded(buffer_.size()));
+}
+
+void TraceRecordWriter::addEntry(const void* entry, size_t size) {
+  append(entry, size);
+  pad();
+}
+
+void TraceRecordWriter::addFnName(folly::StringPiece fnName) {
+  CHECK_LE(fnName.size(), std::numeric_limits<uint8_t>::max());
+  header<TraceRecordHeader>()->fnNameSize = fnName.size();
+  append(fnName.data(), fnName.size());
+  pad();
+}
+
+void TraceRecordWriter::addData(const void* data, size_t size) {
+  header<TraceRecordHeader>()->dataSize = size;
+  append(data, size);
+  pad();
+}
+
+void TraceRecordWriter::addAttributes(
+    const sai_attribute_t* attrList,
+    uint32_t attrCount) {
+  header<TraceRecordHeader>()->attrCount = attrCount;
+  for (uint32_t i = 0; i < attrCount; ++i) {
+    TraceAttribute attr;
+    attr.id = attrList[i].id;
+    attr.value = attrList[i].value;
+    auto listType = traceListType(objectType_, attr.id);
+    const void* listData = nullptr;
+    attr.listBytes = 0;
+    if (listType != TraceListType::NONE) {
+      auto list = listOf(attrList[i].value, listType);
+      listData = list->list;
+      if (listData) {
+        attr.listBytes = list->count * listElementSize(listType);
+      }
+    }
+    append(&attr, sizeof(attr));
+    append(listData, attr.listBytes);
+    pad();
+  }
+}
+
+folly::ByteRange TraceRecordWriter::finish() {
+  header<TraceRecordHeader>()->size = buffer_.size();
+  return folly::ByteRange(buffer_.data(), buffer_.size());
+}
+
+std::optional<TraceRecord> TraceReader::next() {
+  if (trace_.empty()) {
+    return std::nullopt;
+  }
+  // The last record is cut short if the agent died while logging it
+  if (trace_.size() < sizeof(TraceRecordHeader)) {
+    XLOG(WARN) << "Ignoring truncated SAI trace record header of "
+               << trace_.size() << " bytes at the end of the trace";
+    trace_.clear();
+    return std::nullopt;
+  }
+  TraceRecordHeader hdr;
+  std::memcpy(&hdr, trace_.data(), sizeof(hdr));
+  if (hdr.size < sizeof(hdr) || hdr.size % kAlignment) {
+    throw FbossError("Bad SAI trace record size ", hdr.size);
+  }
+  if (hdr.size > trace_.size()) {
+    XLOG(WARN) << "Ignoring truncated SAI trace record of " << trace_.size()
+               << " out of " << hdr.size << " bytes at the end of the trace";
+    trace_.clear();
+    return std::nullopt;
+  }
+  record_.resize(hdr.size / sizeof(uint64_t));
+  std::memcpy(record_.data(), trace_.data(), hdr.size);
+  trace_.advance(hdr.size);
+
+  auto start = reinterpret_cast<uint8_t*>(record_.data());
+  auto end = start + hdr.size;
+  auto cursor = start + sizeof(hdr);
+  auto take = [&cursor, end](size_t size) {
+    if (padded(size) > static_cast<size_t>(end - cursor)) {
+      throw FbossError("Truncated SAI trace record");
+    }
+    auto data = cursor;
+    cursor += padded(size);
+    return data;
+  };
+
+  TraceRecord record;
+  record.header = hdr;
+  if (hdr.op == TraceOp::BEGIN) {
+    uint64_t magic;
+    uint32_t version;
+    if (hdr.dataSize != sizeof(magic) + sizeof(version)) {
+      throw FbossError("Not a SAI trace");
+    }
+    auto data = take(hdr.dataSize);
+    std::memcpy(&magic, data, sizeof(magic));
+    std::memcpy(&version, data + sizeof(magic), sizeof(version));
+    if (magic != kTraceMagic || version != kTraceVersion) {
+      throw FbossError("Unsupported SAI trace version ", version);
+    }
+    record.data = folly::ByteRange(data, hdr.dataSize);
+    return record;
+  }
+  if (auto size = entrySize(hdr.objectType);
+      size && hdr.op != TraceOp::GET_OBJECT_KEY) {
+    record.entry = take(size);
+  }
+  if (hdr.fnNameSize) {
+    record.fnName = folly::StringPiece(
+        reinterpret_cast<const char*>(take(hdr.fnNameSize)), hdr.fnNameSize);
+  }
+  if (hdr.dataSize) {
+    record.data = folly::ByteRange(take(hdr.dataSize), hdr.dataSize);
+  }
+  auto objectType = static_cast<sai_object_type_t>(hdr.objectType);
+  record.attributes.resize(hdr.attrCount);
+  for (auto& attr : record.attributes) {
+    TraceAttribute traced;
+    std::memcpy(&traced, take(sizeof(traced)), sizeof(traced));
+    attr.id = traced.id;
+    attr.value = traced.value;
+    auto listType = traceListType(objectType, attr.id);
+    if (listType == TraceListType::NONE) {
+      continue;
+    }
+    // Lists that were null stay null, others now point into the record
+    auto list = listOf(attr.value, listType);
+    if (list->list) {
+      list->list = take(traced.listBytes);
+    }
+  }
+  return record;
+}
+
+} // namespace facebook::fboss
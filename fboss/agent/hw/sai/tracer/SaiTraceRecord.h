@@ -0,0 +1,168 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/Range.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <sai.h>
+}
+
+namespace facebook::fboss {
+
+/*
+ * Binary SAI trace format.
+ *
+ * With --sai_replayer_binary_trace, SaiTracer logs every SAI call as a fixed
+ * layout record rather than as C source, which keeps tracing cheap enough to
+ * leave on while programming routes at scale. sai_trace_to_c converts a
+ * trace back into the replayer C source offline.
+ *
+ * A trace is a sequence of records, each starting with a TraceRecordHeader
+ * and padded to 8 bytes:
+ *   - BEGIN starts the trace of a boot, its payload is kTraceMagic and
+ *     kTraceVersion. Traces of successive boots may be appended to one file.
+ *   - The entry (route, neighbor, fdb or inseg) the call is made on, as is,
+ *     for calls on entries.
+ *   - fnNameSize bytes of the name of the SAI function called (e.g.
+ *     "create_next_hop"), for calls on objects.
+ *   - dataSize bytes of op specific data: the packet for SEND_HOSTIF_PACKET,
+ *     the object ids for GET_OBJECT_KEY, the api name for API_QUERY and the
+ *     NUL separated profile variables and values for API_INITIALIZE.
+ *   - attrCount TraceAttributes, each followed by its list elements.
+ */
+enum class TraceOp : uint8_t {
+  BEGIN,
+  API_INITIALIZE,
+  API_QUERY,
+  CREATE,
+  REMOVE,
+  SET_ATTRIBUTE,
+  GET_OBJECT_KEY,
+  SEND_HOSTIF_PACKET,
+};
+
+constexpr uint64_t kTraceMagic = 0x45434152'54494153; // "SAITRACE"
+constexpr uint32_t kTraceVersion = 1;
+
+struct TraceRecordHeader {
+  // Whole record, header and padding included
+  uint32_t size;
+  TraceOp op;
+  uint8_t fnNameSize;
+  uint16_t attrCount;
+  int32_t objectType;
+  int32_t rv;
+  uint32_t dataSize;
+  uint32_t reserved;
+  // Wall clock time of the call, in nanoseconds since the epoch
+  uint64_t timestampNs;
+  /*
+   * Object created, removed or set, the hostif a packet is sent on, the api
+   * queried or the number of keys returned by sai_get_object_key().
+   */
+  uint64_t objectId;
+  // Switch an object is created on
+  uint64_t switchId;
+};
+
+struct TraceAttribute {
+  sai_attr_id_t id;
+  // Size of the list elements following the attribute, padding excluded
+  uint32_t listBytes;
+  // List pointers are only meaningful as far as being null or not
+  sai_attribute_value_t value;
+};
+
+/*
+ * Attribute value lists are copied into the trace. The layout of each list
+ * attribute is known from the object and attribute type: it is the list the
+ * set*Attributes() functions of the *ApiTracer.cpp files serialize when
+ * generating C source. Other attributes are traced by value alone.
+ */
+enum class TraceListType : uint8_t {
+  NONE,
+  OBJECT_LIST,
+  S8_LIST,
+  S32_LIST,
+  U32_LIST,
+  QOS_MAP_LIST,
+  ACL_ACTION_OBJECT_LIST,
+};
+
+TraceListType traceListType(sai_object_type_t objectType, sai_attr_id_t id);
+
+/*
+ * Builds records into a reusable buffer. Nothing is allocated once the
+ * buffer has grown to the largest record.
+ */
+class TraceRecordWriter {
+ public:
+  void begin(
+      TraceOp op,
+      sai_object_type_t objectType,
+      sai_status_t rv,
+      sai_object_id_t objectId = SAI_NULL_OBJECT_ID,
+      sai_object_id_t switchId = SAI_NULL_OBJECT_ID);
+  // Only one of each, in this order, and before the attributes
+  void addEntry(const void* entry, size_t size);
+  void addFnName(folly::StringPiece fnName);
+  void addData(const void* data, size_t size);
+  void addAttributes(const sai_attribute_t* attrList, uint32_t attrCount);
+  // The complete record, valid until the next begin()
+  folly::ByteRange finish();
+
+ private:
+  template <typename T>
+  T* header() {
+    return reinterpret_cast<T*>(buffer_.data());
+  }
+  void append(const void* data, size_t size);
+  void pad();
+
+  std::vector<uint8_t> buffer_;
+  sai_object_type_t objectType_{SAI_OBJECT_TYPE_NULL};
+};
+
+/*
+ * A decoded record. Attributes point into the record, their lists included,
+ * so that they can be handed to the tracer as they were to the SAI adapter.
+ */
+struct TraceRecord {
+  TraceRecordHeader header;
+  const void* entry{nullptr};
+  folly::StringPiece fnName;
+  folly::ByteRange data;
+  std::vector<sai_attribute_t> attributes;
+};
+
+/*
+ * Reads records out of a trace. A truncated last record, as left behind by
+ * a crash, ends the trace. Throws FbossError on otherwise malformed traces.
+ */
+class TraceReader {
+ public:
+  explicit TraceReader(folly::ByteRange trace) : trace_(trace) {}
+
+  // Next record, valid until the following call, or nothing at the end
+  std::optional<TraceRecord> next();
+
+ private:
+  folly::ByteRange trace_;
+  // 8 byte aligned copy of the current record
+  std::vector<uint64_t> record_;
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,246 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+/*
+ * Generates the SAI replayer C source out of a binary SAI trace
+ * (--sai_replayer_binary_trace), e.g.
+ *   sai_trace_to_c --sai_trace=sai_replayer.bin --sai_log=/tmp/SaiLog.cpp
+ * Each traced call is fed to the same SaiTracer functions that generate the
+ * source when tracing in text mode, so both produce the same replayer.
+ */
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/hw/sai/tracer/SaiTraceRecord.h"
+#include "fboss/agent/hw/sai/tracer/SaiTracer.h"
+
+#include <folly/FileUtil.h>
+#include <folly/Singleton.h>
+#include <folly/init/Init.h>
+#include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+DEFINE_string(sai_trace, "", "Binary SAI trace to generate C source from");
+
+namespace facebook::fboss {
+
+namespace {
+
+void convertApiInitialize(SaiTracer& tracer, const TraceRecord& record) {
+  std::vector<const char*> variables;
+  std::vector<const char*> values;
+  auto profile = folly::StringPiece(record.data);
+  while (!profile.empty()) {
+    auto& strings = variables.size() == values.size() ? variables : values;
+    auto end = profile.find('\0');
+    if (end == folly::StringPiece::npos) {
+      throw FbossError("Unterminated SAI profile value in trace");
+    }
+    strings.push_back(profile.data());
+    profile.advance(end + 1);
+  }
+  if (variables.size() != values.size()) {
+    throw FbossError("SAI profile variable without a value in trace");
+  }
+  tracer.logApiInitialize(variables.data(), values.data(), variables.size());
+}
+
+void convertCreate(SaiTracer& tracer, const TraceRecord& record) {
+  const auto& hdr = record.header;
+  auto objectType = static_cast<sai_object_type_t>(hdr.objectType);
+  auto attrCount = record.attributes.size();
+  auto attrList = record.attributes.data();
+  auto rv = static_cast<sai_status_t>(hdr.rv);
+  switch (objectType) {
+    case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+      tracer.logRouteEntryCreateFn(
+          static_cast<const sai_route_entry_t*>(record.entry),
+          attrCount,
+          attrList,
+          rv);
+      return;
+    case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+      tracer.logNeighborEntryCreateFn(
+          static_cast<const sai_neighbor_entry_t*>(record.entry),
+          attrCount,
+          attrList,
+          rv);
+      return;
+    case SAI_OBJECT_TYPE_FDB_ENTRY:
+      tracer.logFdbEntryCreateFn(
+          static_cast<const sai_fdb_entry_t*>(record.entry),
+          attrCount,
+          attrList,
+          rv);
+      return;
+    case SAI_OBJECT_TYPE_INSEG_ENTRY:
+      tracer.logInsegEntryCreateFn(
+          static_cast<const sai_inseg_entry_t*>(record.entry),
+          attrCount,
+          attrList,
+          rv);
+      return;
+    default:
+      break;
+  }
+  sai_object_id_t objectId = hdr.objectId;
+  if (objectType == SAI_OBJECT_TYPE_SWITCH) {
+    tracer.logSwitchCreateFn(&objectId, attrCount, attrList, rv);
+    return;
+  }
+  tracer.logCreateFn(
+      record.fnName,
+      &objectId,
+      hdr.switchId,
+      attrCount,
+      attrList,
+      objectType,
+      rv);
+}
+
+void convertRemove(SaiTracer& tracer, const TraceRecord& record) {
+  const auto& hdr = record.header;
+  auto objectType = static_cast<sai_object_type_t>(hdr.objectType);
+  auto rv = static_cast<sai_status_t>(hdr.rv);
+  switch (objectType) {
+    case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+      tracer.logRouteEntryRemoveFn(
+          static_cast<const sai_route_entry_t*>(record.entry), rv);
+      return;
+    case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+      tracer.logNeighborEntryRemoveFn(
+          static_cast<const sai_neighbor_entry_t*>(record.entry), rv);
+      return;
+    case SAI_OBJECT_TYPE_FDB_ENTRY:
+      tracer.logFdbEntryRemoveFn(
+          static_cast<const sai_fdb_entry_t*>(record.entry), rv);
+      return;
+    case SAI_OBJECT_TYPE_INSEG_ENTRY:
+      tracer.logInsegEntryRemoveFn(
+          static_cast<const sai_inseg_entry_t*>(record.entry), rv);
+      return;
+    default:
+      tracer.logRemoveFn(record.fnName, hdr.objectId, objectType, rv);
+      return;
+  }
+}
+
+void convertSetAttribute(SaiTracer& tracer, const TraceRecord& record) {
+  const auto& hdr = record.header;
+  auto objectType = static_cast<sai_object_type_t>(hdr.objectType);
+  auto rv = static_cast<sai_status_t>(hdr.rv);
+  if (record.attributes.size() != 1) {
+    throw FbossError(
+        "Set attribute call with ", record.attributes.size(), " attributes");
+  }
+  const auto* attr = record.attributes.data();
+  switch (objectType) {
+    case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+      tracer.logRouteEntrySetAttrFn(
+          static_cast<const sai_route_entry_t*>(record.entry), attr, rv);
+      return;
+    case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+      tracer.logNeighborEntrySetAttrFn(
+          static_cast<const sai_neighbor_entry_t*>(record.entry), attr, rv);
+      return;
+    case SAI_OBJECT_TYPE_FDB_ENTRY:
+      tracer.logFdbEntrySetAttrFn(
+          static_cast<const sai_fdb_entry_t*>(record.entry), attr, rv);
+      return;
+    case SAI_OBJECT_TYPE_INSEG_ENTRY:
+      tracer.logInsegEntrySetAttrFn(
+          static_cast<const sai_inseg_entry_t*>(record.entry), attr, rv);
+      return;
+    default:
+      tracer.logSetAttrFn(record.fnName, hdr.objectId, attr, objectType, rv);
+      return;
+  }
+}
+
+void convertRecord(SaiTracer& tracer, const TraceRecord& record) {
+  const auto& hdr = record.header;
+  tracer.setCallTime(std::chrono::system_clock::time_point(
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::nanoseconds(hdr.timestampNs))));
+  switch (hdr.op) {
+    case TraceOp::BEGIN:
+      // As in text mode, the calls of appended boots simply follow
+      return;
+    case TraceOp::API_INITIALIZE:
+      convertApiInitialize(tracer, record);
+      return;
+    case TraceOp::API_QUERY:
+      tracer.logApiQuery(
+          static_cast<sai_api_t>(hdr.objectId),
+          folly::StringPiece(record.data).str());
+      return;
+    case TraceOp::CREATE:
+      convertCreate(tracer, record);
+      return;
+    case TraceOp::REMOVE:
+      convertRemove(tracer, record);
+      return;
+    case TraceOp::SET_ATTRIBUTE:
+      convertSetAttribute(tracer, record);
+      return;
+    case TraceOp::GET_OBJECT_KEY:
+      tracer.logGetObjectKeyFn(
+          static_cast<sai_object_type_t>(hdr.objectType),
+          hdr.objectId,
+          reinterpret_cast<const sai_object_key_t*>(record.data.data()));
+      return;
+    case TraceOp::SEND_HOSTIF_PACKET:
+      tracer.logSendHostifPacketFn(
+          hdr.objectId,
+          record.data.size(),
+          record.data.data(),
+          record.attributes.size(),
+          record.attributes.data(),
+          static_cast<sai_status_t>(hdr.rv));
+      return;
+  }
+  throw FbossError("Unknown SAI trace op ", static_cast<int>(hdr.op));
+}
+
+} // namespace
+
+} // namespace facebook::fboss
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  using namespace facebook::fboss;
+
+  std::string trace;
+  if (!folly::readFile(FLAGS_sai_trace.c_str(), trace)) {
+    XLOG(FATAL) << "Failed to read SAI trace " << FLAGS_sai_trace;
+  }
+
+  // Generate C source, as SaiTracer does when tracing in text mode
+  FLAGS_enable_replayer = true;
+  FLAGS_enable_packet_log = true;
+  FLAGS_sai_replayer_binary_trace = false;
+
+  size_t numRecords = 0;
+  {
+    auto tracer = SaiTracer::getInstance();
+    TraceReader reader(folly::ByteRange(folly::StringPiece(trace)));
+    while (auto record = reader.next()) {
+      convertRecord(*tracer, *record);
+      ++numRecords;
+    }
+  }
+  // Write the source footer and flush it out
+  folly::SingletonVault::singleton()->destroyInstances();
+  XLOG(INFO) << "Generated C source for " << numRecords << " SAI trace records";
+  return 0;
+}
@@ -7,7 +7,9 @@
  *  of patent rights can be found in the PATENTS file in the same directory.
  *
  */
+#include <array>
 #include <chrono>
+#include <cstring>
 #include <ctime>
 #include <iomanip>
 #include <ostream>
@@ -76,6 +78,18 @@ DEFINE_string(
     "/var/facebook/logs/fboss/sdk/sai_replayer.log",
     "File path to the SAI Replayer logs");
 
+DEFINE_bool(
+    sai_replayer_binary_trace,
+    false,
+    "Log SAI calls as compact binary records to --sai_binary_log rather than "
+    "as C source to --sai_log. Use sai_trace_to_c to generate the replayer "
+    "source out of the binary trace.");
+
+DEFINE_string(
+    sai_binary_log,
+    "/var/facebook/logs/fboss/sdk/sai_replayer.bin",
+    "File path to the binary SAI Replayer trace");
+
 DEFINE_int32(
     default_list_size,
     1024,
@@ -336,41 +350,8 @@ sai_status_t __wrap_sai_get_object_key(
     return rv;
   }
 
-  vector<string> getObjectKeyLines = {
-      to<string>("expected_object_count=", *object_count),
-      to<string>(
-          "sai_get_object_count(switch_0, (_sai_object_type_t)",
-          object_type,
-          ", &object_count)"),
-      "object_list.resize(object_count)",
-      to<string>(
-          "sai_get_object_key(switch_0, (_sai_object_type_t)",
-          object_type,
-          ", &object_count, object_list.data())"),
-      to<string>(
-          "if (object_count < expected_object_count) { printf(\"[WARNING] current switch reloaded %u ",
-          facebook::fboss::saiObjectTypeToString(object_type),
-          " objects, expected %u\\n\", expected_object_count, object_count); }"),
-  };
-
-  vector<string> declarationLines;
-  declarationLines.reserve(*object_count);
-  for (int i = 0; i < *object_count; ++i) {
-    sai_object_key_t object = object_list[i];
-    string declaration = std::get<0>(SaiTracer::getInstance()->declareVariable(
-        &object.key.object_id, object_type));
-    declarationLines.push_back(to<string>(
-        declaration,
-        "=assignObject(object_list.data(), object_count, ",
-        i,
-        ", ",
-        object.key.object_id,
-        ")"));
-  }
-  vector<string> lines;
-  lines.insert(lines.end(), getObjectKeyLines.begin(), getObjectKeyLines.end());
-  lines.insert(lines.end(), declarationLines.begin(), declarationLines.end());
-  SaiTracer::getInstance()->writeToFile(lines);
+  SaiTracer::getInstance()->logGetObjectKeyFn(
+      object_type, *object_count, object_list);
   return rv;
 }
 
@@ -380,12 +361,26 @@ namespace {
 
 folly::Singleton<facebook::fboss::SaiTracer> _saiTracer;
 
+// Records are built per thread, then copied into the async logger buffer
+facebook::fboss::TraceRecordWriter& recordWriter() {
+  static thread_local facebook::fboss::TraceRecordWriter writer;
+  return writer;
+}
+
 } // namespace
 
 namespace facebook::fboss {
 
 SaiTracer::SaiTracer() {
-  if (FLAGS_enable_replayer) {
+  if (FLAGS_enable_replayer && FLAGS_sai_replayer_binary_trace) {
+    asyncLogger_ = std::make_unique<AsyncLogger>(
+        FLAGS_sai_binary_log,
+        FLAGS_log_timeout,
+        AsyncLogger::SAI_REPLAYER_BINARY);
+
+    asyncLogger_->startFlushThread();
+    writeBeginRecord();
+  } else if (FLAGS_enable_replayer) {
     asyncLogger_ = std::make_unique<AsyncLogger>(
         FLAGS_sai_log, FLAGS_log_timeout, AsyncLogger::SAI_REPLAYER);
 
@@ -399,7 +394,9 @@ SaiTracer::SaiTracer() {
 
 SaiTracer::~SaiTracer() {
   if (FLAGS_enable_replayer) {
-    writeFooter();
+    if (!FLAGS_sai_replayer_binary_trace) {
+      writeFooter();
+    }
     asyncLogger_->forceFlush();
     asyncLogger_->stopFlushThread();
   }
@@ -429,6 +426,25 @@ void SaiTracer::logApiInitialize(
     const char** variables,
     const char** values,
     int size) {
+  if (!FLAGS_enable_replayer) {
+    return;
+  }
+
+  if (FLAGS_sai_replayer_binary_trace) {
+    // Profile variables and values, NUL separated
+    string profile;
+    for (int i = 0; i < size; ++i) {
+      profile.append(variables[i]).push_back('\0');
+      profile.append(values[i]).push_back('\0');
+    }
+    auto& writer = recordWriter();
+    writer.begin(
+        TraceOp::API_INITIALIZE, SAI_OBJECT_TYPE_NULL, SAI_STATUS_SUCCESS);
+    writer.addData(profile.data(), profile.size());
+    writeRecord(writer.finish());
+    return;
+  }
+
   vector<string> lines;
 
   for (int i = 0; i < size; ++i) {
@@ -464,6 +480,15 @@ void SaiTracer::logApiQuery(sai_api_t api_id, const std::string& api_var) {
 
   init_api_.emplace(api_id, api_var);
 
+  if (FLAGS_sai_replayer_binary_trace) {
+    auto& writer = recordWriter();
+    writer.begin(
+        TraceOp::API_QUERY, SAI_OBJECT_TYPE_NULL, SAI_STATUS_SUCCESS, api_id);
+    writer.addData(api_var.data(), api_var.size());
+    writeRecord(writer.finish());
+    return;
+  }
+
   writeToFile(
       {to<string>("sai_", api_var, "_t* ", api_var),
        to<string>(
@@ -479,6 +504,19 @@ void SaiTracer::logSwitchCreateFn(
     return;
   }
 
+  if (FLAGS_sai_replayer_binary_trace) {
+    traceObjectFn(
+        TraceOp::CREATE,
+        "create_switch",
+        SAI_OBJECT_TYPE_SWITCH,
+        *switch_id,
+        SAI_NULL_OBJECT_ID,
+        attr_count,
+        attr_list,
+        rv);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_SWITCH);
@@ -521,6 +559,18 @@ void SaiTracer::logRouteEntryCreateFn(
     return;
   }
 
+  if (FLAGS_sai_replayer_binary_trace) {
+    traceEntryFn(
+        TraceOp::CREATE,
+        SAI_OBJECT_TYPE_ROUTE_ENTRY,
+        route_entry,
+        sizeof(*route_entry),
+        attr_count,
+        attr_list,
+        rv);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_ROUTE_ENTRY);
@@ -557,6 +607,18 @@ void SaiTracer::logNeighborEntryCreateFn(
     return;
   }
 
+  if (FLAGS_sai_replayer_binary_trace) {
+    traceEntryFn(
+        TraceOp::CREATE,
+        SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+        neighbor_entry,
+        sizeof(*neighbor_entry),
+        attr_count,
+        attr_list,
+        rv);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_NEIGHBOR_ENTRY);
@@ -593,6 +655,18 @@ void SaiTracer::logFdbEntryCreateFn(
     return;
   }
 
+  if (FLAGS_sai_replayer_binary_trace) {
+    traceEntryFn(
+        TraceOp::CREATE,
+        SAI_OBJECT_TYPE_FDB_ENTRY,
+        fdb_entry,
+        sizeof(*fdb_entry),
+        attr_count,
+        attr_list,
+        rv);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_FDB_ENTRY);
@@ -629,6 +703,18 @@ void SaiTracer::logInsegEntryCreateFn(
     return;
   }
 
+  if (FLAGS_sai_replayer_binary_trace) {
+    traceEntryFn(
+        TraceOp::CREATE,
+        SAI_OBJECT_TYPE_INSEG_ENTRY,
+        inseg_entry,
+        sizeof(*inseg_entry),
+        attr_count,
+        attr_list,
+        rv);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_INSEG_ENTRY);
@@ -657,7 +743,7 @@ void SaiTracer::logInsegEntryCreateFn(
 }
 
 void SaiTracer::logCreateFn(
-    const string& fn_name,
+    folly::StringPiece fn_name,
     sai_object_id_t* create_object_id,
     sai_object_id_t switch_id,
     uint32_t attr_count,
@@ -668,6 +754,19 @@ void SaiTracer::logCreateFn(
     return;
   }
 
+  if (FLAGS_sai_replayer_binary_trace) {
+    traceObjectFn(
+        TraceOp::CREATE,
+        fn_name,
+        object_type,
+        *create_object_id,
+        switch_id,
+        attr_count,
+        attr_list,
+        rv);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines = setAttrList(attr_list, attr_count, object_type);
 
@@ -697,6 +796,18 @@ void SaiTracer::logRouteEntryRemoveFn(
     return;
   }
 
+  if (FLAGS_sai_replayer_binary_trace) {
+    traceEntryFn(
+        TraceOp::REMOVE,
+        SAI_OBJECT_TYPE_ROUTE_ENTRY,
+        route_entry,
+        sizeof(*route_entry),
+        0,
+        nullptr,
+        rv);
+    return;
+  }
+
   vector<string> lines{};
   setRouteEntry(route_entry, lines);
 
@@ -724,6 +835,18 @@ void SaiTracer::logNeighborEntryRemoveFn(
     return;
   }
 
+  if (FLAGS_sai_replayer_binary_trace) {
+    traceEntryFn(
+        TraceOp::REMOVE,
+        SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+        neighbor_entry,
+        sizeof(*neighbor_entry),
+        0,
+        nullptr,
+        rv);
+    return;
+  }
+
   vector<string> lines{};
   setNeighborEntry(neighbor_entry, lines);
 
@@ -751,6 +874,18 @@ void SaiTracer::logFdbEntryRemoveFn(
     return;
   }
 
+  if (FLAGS_sai_replayer_binary_trace) {
+    traceEntryFn(
+        TraceOp::REMOVE,
+        SAI_OBJECT_TYPE_FDB_ENTRY,
+        fdb_entry,
+        sizeof(*fdb_entry),
+        0,
+        nullptr,
+        rv);
+    return;
+  }
+
   vector<string> lines{};
   setFdbEntry(fdb_entry, lines);
 
@@ -778,6 +913,18 @@ void SaiTracer::logInsegEntryRemoveFn(
     return;
   }
 
+  if (FLAGS_sai_replayer_binary_trace) {
+    traceEntryFn(
+        TraceOp::REMOVE,
+        SAI_OBJECT_TYPE_INSEG_ENTRY,
+        inseg_entry,
+        sizeof(*inseg_entry),
+        0,
+        nullptr,
+        rv);
+    return;
+  }
+
   vector<string> lines{};
   setInsegEntry(inseg_entry, lines);
 
@@ -799,7 +946,7 @@ void SaiTracer::logInsegEntryRemoveFn(
 }
 
 void SaiTracer::logRemoveFn(
-    const string& fn_name,
+    folly::StringPiece fn_name,
     sai_object_id_t remove_object_id,
     sai_object_type_t object_type,
     sai_status_t rv) {
@@ -807,6 +954,19 @@ void SaiTracer::logRemoveFn(
     return;
   }
 
+  if (FLAGS_sai_replayer_binary_trace) {
+    traceObjectFn(
+        TraceOp::REMOVE,
+        fn_name,
+        object_type,
+        remove_object_id,
+        SAI_NULL_OBJECT_ID,
+        0,
+        nullptr,
+        rv);
+    return;
+  }
+
   vector<string> lines{};
 
   // Log current timestamp, object id and return value
@@ -839,6 +999,18 @@ void SaiTracer::logRouteEntrySetAttrFn(
     return;
   }
 
+  if (FLAGS_sai_replayer_binary_trace) {
+    traceEntryFn(
+        TraceOp::SET_ATTRIBUTE,
+        SAI_OBJECT_TYPE_ROUTE_ENTRY,
+        route_entry,
+        sizeof(*route_entry),
+        1,
+        attr,
+        rv);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_ROUTE_ENTRY);
 
@@ -870,6 +1042,18 @@ void SaiTracer::logNeighborEntrySetAttrFn(
     return;
   }
 
+  if (FLAGS_sai_replayer_binary_trace) {
+    traceEntryFn(
+        TraceOp::SET_ATTRIBUTE,
+        SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+        neighbor_entry,
+        sizeof(*neighbor_entry),
+        1,
+        attr,
+        rv);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_NEIGHBOR_ENTRY);
 
@@ -901,6 +1085,18 @@ void SaiTracer::logFdbEntrySetAttrFn(
     return;
   }
 
+  if (FLAGS_sai_replayer_binary_trace) {
+    traceEntryFn(
+        TraceOp::SET_ATTRIBUTE,
+        SAI_OBJECT_TYPE_FDB_ENTRY,
+        fdb_entry,
+        sizeof(*fdb_entry),
+        1,
+        attr,
+        rv);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_FDB_ENTRY);
 
@@ -932,6 +1128,18 @@ void SaiTracer::logInsegEntrySetAttrFn(
     return;
   }
 
+  if (FLAGS_sai_replayer_binary_trace) {
+    traceEntryFn(
+        TraceOp::SET_ATTRIBUTE,
+        SAI_OBJECT_TYPE_INSEG_ENTRY,
+        inseg_entry,
+        sizeof(*inseg_entry),
+        1,
+        attr,
+        rv);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_INSEG_ENTRY);
 
@@ -956,7 +1164,7 @@ void SaiTracer::logInsegEntrySetAttrFn(
 }
 
 void SaiTracer::logSetAttrFn(
-    const string& fn_name,
+    folly::StringPiece fn_name,
     sai_object_id_t set_object_id,
     const sai_attribute_t* attr,
     sai_object_type_t object_type,
@@ -965,6 +1173,19 @@ void SaiTracer::logSetAttrFn(
     return;
   }
 
+  if (FLAGS_sai_replayer_binary_trace) {
+    traceObjectFn(
+        TraceOp::SET_ATTRIBUTE,
+        fn_name,
+        object_type,
+        set_object_id,
+        SAI_NULL_OBJECT_ID,
+        1,
+        attr,
+        rv);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, object_type);
 
@@ -998,6 +1219,19 @@ void SaiTracer::logSendHostifPacketFn(
     return;
   }
 
+  if (FLAGS_sai_replayer_binary_trace) {
+    auto& writer = recordWriter();
+    writer.begin(
+        TraceOp::SEND_HOSTIF_PACKET,
+        SAI_OBJECT_TYPE_HOSTIF_PACKET,
+        rv,
+        hostif_id);
+    writer.addData(buffer, buffer_size);
+    writer.addAttributes(attr_list, attr_count);
+    writeRecord(writer.finish());
+    return;
+  }
+
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_HOSTIF_PACKET);
 
@@ -1041,6 +1275,60 @@ void SaiTracer::logSendHostifPacketFn(
   writeToFile(lines);
 }
 
+void SaiTracer::logGetObjectKeyFn(
+    sai_object_type_t object_type,
+    uint32_t object_count,
+    const sai_object_key_t* object_list) {
+  if (!FLAGS_enable_replayer) {
+    return;
+  }
+
+  if (FLAGS_sai_replayer_binary_trace) {
+    auto& writer = recordWriter();
+    writer.begin(
+        TraceOp::GET_OBJECT_KEY, object_type, SAI_STATUS_SUCCESS, object_count);
+    writer.addData(object_list, object_count * sizeof(sai_object_key_t));
+    writeRecord(writer.finish());
+    return;
+  }
+
+  vector<string> getObjectKeyLines = {
+      to<string>("expected_object_count=", object_count),
+      to<string>(
+          "sai_get_object_count(switch_0, (_sai_object_type_t)",
+          object_type,
+          ", &object_count)"),
+      "object_list.resize(object_count)",
+      to<string>(
+          "sai_get_object_key(switch_0, (_sai_object_type_t)",
+          object_type,
+          ", &object_count, object_list.data())"),
+      to<string>(
+          "if (object_count < expected_object_count) { printf(\"[WARNING] current switch reloaded %u ",
+          saiObjectTypeToString(object_type),
+          " objects, expected %u\\n\", expected_object_count, object_count); }"),
+  };
+
+  vector<string> declarationLines;
+  declarationLines.reserve(object_count);
+  for (int i = 0; i < object_count; ++i) {
+    sai_object_key_t object = object_list[i];
+    string declaration =
+        std::get<0>(declareVariable(&object.key.object_id, object_type));
+    declarationLines.push_back(to<string>(
+        declaration,
+        "=assignObject(object_list.data(), object_count, ",
+        i,
+        ", ",
+        object.key.object_id,
+        ")"));
+  }
+  vector<string> lines;
+  lines.insert(lines.end(), getObjectKeyLines.begin(), getObjectKeyLines.end());
+  lines.insert(lines.end(), declarationLines.begin(), declarationLines.end());
+  writeToFile(lines);
+}
+
 std::tuple<string, string> SaiTracer::declareVariable(
     sai_object_id_t* object_id,
     sai_object_type_t object_type) {
@@ -1101,6 +1389,16 @@ vector<string> SaiTracer::setAttrList(
 
   // Call functions defined in *ApiTracer.h to serialize attributes
   // that are specific to each Sai object type
+  setObjectAttributes(attr_list, attr_count, object_type, attrLines);
+
+  return attrLines;
+}
+
+void setObjectAttributes(
+    const sai_attribute_t* attr_list,
+    uint32_t attr_count,
+    sai_object_type_t object_type,
+    std::vector<std::string>& attrLines) {
   switch (object_type) {
     case SAI_OBJECT_TYPE_ACL_COUNTER:
       setAclCounterAttributes(attr_list, attr_count, attrLines);
@@ -1245,12 +1543,10 @@ vector<string> SaiTracer::setAttrList(
       // setAttributes() function here
       break;
   }
-
-  return attrLines;
 }
 
 string SaiTracer::createFnCall(
-    const string& fn_name,
+    folly::StringPiece fn_name,
     const string& var1,
     const string& var2,
     uint32_t attr_count,
@@ -1373,7 +1669,7 @@ string SaiTracer::rvCheck(sai_status_t rv) {
 }
 
 string SaiTracer::logTimeAndRv(sai_status_t rv, sai_object_id_t object_id) {
-  auto now = std::chrono::system_clock::now();
+  auto now = callTime_ ? *callTime_ : std::chrono::system_clock::now();
   auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                     now.time_since_epoch()) %
       1000;
@@ -1472,6 +1768,56 @@ void SaiTracer::writeFooter() {
   asyncLogger_->appendLog(footer.c_str(), footer.size());
 }
 
+void SaiTracer::writeBeginRecord() {
+  std::array<uint8_t, sizeof(kTraceMagic) + sizeof(kTraceVersion)> begin;
+  std::memcpy(begin.data(), &kTraceMagic, sizeof(kTraceMagic));
+  std::memcpy(
+      begin.data() + sizeof(kTraceMagic),
+      &kTraceVersion,
+      sizeof(kTraceVersion));
+
+  auto& writer = recordWriter();
+  writer.begin(TraceOp::BEGIN, SAI_OBJECT_TYPE_NULL, SAI_STATUS_SUCCESS);
+  writer.addData(begin.data(), begin.size());
+  writeRecord(writer.finish());
+}
+
+void SaiTracer::traceEntryFn(
+    TraceOp op,
+    sai_object_type_t object_type,
+    const void* entry,
+    size_t entry_size,
+    uint32_t attr_count,
+    const sai_attribute_t* attr_list,
+    sai_status_t rv) {
+  auto& writer = recordWriter();
+  writer.begin(op, object_type, rv);
+  writer.addEntry(entry, entry_size);
+  writer.addAttributes(attr_list, attr_count);
+  writeRecord(writer.finish());
+}
+
+void SaiTracer::traceObjectFn(
+    TraceOp op,
+    folly::StringPiece fn_name,
+    sai_object_type_t object_type,
+    sai_object_id_t object_id,
+    sai_object_id_t switch_id,
+    uint32_t attr_count,
+    const sai_attribute_t* attr_list,
+    sai_status_t rv) {
+  auto& writer = recordWriter();
+  writer.begin(op, object_type, rv, object_id, switch_id);
+  writer.addFnName(fn_name);
+  writer.addAttributes(attr_list, attr_count);
+  writeRecord(writer.finish());
+}
+
+void SaiTracer::writeRecord(folly::ByteRange record) {
+  asyncLogger_->appendLog(
+      reinterpret_cast<const char*>(record.data()), record.size());
+}
+
 void SaiTracer::initVarCounts() {
   varCounts_.emplace(SAI_OBJECT_TYPE_ACL_COUNTER, 0);
   varCounts_.emplace(SAI_OBJECT_TYPE_ACL_ENTRY, 0);
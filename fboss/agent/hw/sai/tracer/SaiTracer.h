@@ -9,12 +9,15 @@
  */
 #pragma once
 
+#include <chrono>
 #include <map>
 #include <memory>
+#include <optional>
 #include <tuple>
 
 #include "fboss/agent/AsyncLogger.h"
 #include "fboss/agent/hw/sai/api/SaiVersion.h"
+#include "fboss/agent/hw/sai/tracer/SaiTraceRecord.h"
 
 #include <folly/File.h>
 #include <folly/String.h>
@@ -28,6 +31,7 @@ extern "C" {
 DECLARE_bool(enable_replayer);
 DECLARE_bool(enable_packet_log);
 DECLARE_bool(explicit_attr_name);
+DECLARE_bool(sai_replayer_binary_trace);
 
 namespace facebook::fboss {
 
@@ -79,7 +83,7 @@ class SaiTracer {
       sai_status_t rv);
 
   void logCreateFn(
-      const std::string& fn_name,
+      folly::StringPiece fn_name,
       sai_object_id_t* create_object_id,
       sai_object_id_t switch_id,
       uint32_t attr_count,
@@ -102,7 +106,7 @@ class SaiTracer {
       sai_status_t rv);
 
   void logRemoveFn(
-      const std::string& fn_name,
+      folly::StringPiece fn_name,
       sai_object_id_t remove_object_id,
       sai_object_type_t object_type,
       sai_status_t rv);
@@ -128,7 +132,7 @@ class SaiTracer {
       sai_status_t rv);
 
   void logSetAttrFn(
-      const std::string& fn_name,
+      folly::StringPiece fn_name,
       sai_object_id_t set_object_id,
       const sai_attribute_t* attr,
       sai_object_type_t object_type,
@@ -142,6 +146,19 @@ class SaiTracer {
       const sai_attribute_t* attr_list,
       sai_status_t rv);
 
+  void logGetObjectKeyFn(
+      sai_object_type_t object_type,
+      uint32_t object_count,
+      const sai_object_key_t* object_list);
+
+  /*
+   * Log the calls that follow as made at the given time rather than now.
+   * Used when generating C source out of a binary trace.
+   */
+  void setCallTime(std::chrono::system_clock::time_point callTime) {
+    callTime_ = callTime;
+  }
+
   std::string getVariable(sai_object_id_t object_id);
 
   uint32_t
@@ -186,7 +203,7 @@ class SaiTracer {
       sai_object_type_t object_type);
 
   std::string createFnCall(
-      const std::string& fn_name,
+      folly::StringPiece fn_name,
       const std::string& var1,
       const std::string& var2,
       uint32_t attr_count,
@@ -222,10 +239,32 @@ class SaiTracer {
 
   void writeFooter();
 
+  // Binary trace (--sai_replayer_binary_trace) helpers
+  void writeBeginRecord();
+  void traceEntryFn(
+      TraceOp op,
+      sai_object_type_t object_type,
+      const void* entry,
+      size_t entry_size,
+      uint32_t attr_count,
+      const sai_attribute_t* attr_list,
+      sai_status_t rv);
+  void traceObjectFn(
+      TraceOp op,
+      folly::StringPiece fn_name,
+      sai_object_type_t object_type,
+      sai_object_id_t object_id,
+      sai_object_id_t switch_id,
+      uint32_t attr_count,
+      const sai_attribute_t* attr_list,
+      sai_status_t rv);
+  void writeRecord(folly::ByteRange record);
+
   uint32_t maxAttrCount_;
   uint32_t maxListCount_;
   uint32_t numCalls_;
   std::unique_ptr<AsyncLogger> asyncLogger_;
+  std::optional<std::chrono::system_clock::time_point> callTime_;
 
   // Variables mappings in generated C code
   // varCounts map from object type to the current counter
@@ -402,6 +441,16 @@ class SaiTracer {
       "void run_trace() {\n";
 };
 
+/*
+ * Serializes the attributes specific to each SAI object type, with the
+ * set*Attributes() functions of the *ApiTracer.cpp files.
+ */
+void setObjectAttributes(
+    const sai_attribute_t* attr_list,
+    uint32_t attr_count,
+    sai_object_type_t object_type,
+    std::vector<std::string>& attrLines);
+
 #define SET_ATTRIBUTE_FUNC_DECLARATION(obj_type) \
   void set##obj_type##Attributes(                \
       const sai_attribute_t* attr_list,          \
@@ -18,6 +18,26 @@ using std::vector;
 
 namespace facebook::fboss {
 
+namespace {
+thread_local ListTypeProbe* listTypeProbe{nullptr};
+} // namespace
+
+ListTypeProbe::ListTypeProbe() : previous_(listTypeProbe) {
+  listTypeProbe = this;
+}
+
+ListTypeProbe::~ListTypeProbe() {
+  listTypeProbe = previous_;
+}
+
+bool ListTypeProbe::record(TraceListType listType) {
+  if (!listTypeProbe) {
+    return false;
+  }
+  listTypeProbe->listType_ = listType;
+  return true;
+}
+
 string oidAttr(const sai_attribute_t* attr_list, int i) {
   return to<string>(
       "s_a[",
@@ -31,6 +51,9 @@ void oidListAttr(
     int i,
     uint32_t listIndex,
     std::vector<std::string>& attrLines) {
+  if (ListTypeProbe::record(TraceListType::OBJECT_LIST)) {
+    return;
+  }
   // First make sure we have enough lists for use
   uint32_t listLimit = SaiTracer::getInstance()->checkListCount(
       listIndex + 1, sizeof(sai_object_id_t), attr_list[i].value.objlist.count);
@@ -71,6 +94,9 @@ void aclEntryActionSaiObjectIdListAttr(
     int i,
     uint32_t listIndex,
     std::vector<std::string>& attrLines) {
+  if (ListTypeProbe::record(TraceListType::ACL_ACTION_OBJECT_LIST)) {
+    return;
+  }
   uint32_t objectListCount =
       attr_list[i].value.aclaction.parameter.objlist.count;
 
@@ -274,6 +300,9 @@ void s8ListAttr(
     uint32_t listIndex,
     vector<string>& attrLines,
     bool nullable) {
+  if (ListTypeProbe::record(TraceListType::S8_LIST)) {
+    return;
+  }
   // First make sure we have enough lists for use
   uint32_t listLimit = SaiTracer::getInstance()->checkListCount(
       listIndex + 1, sizeof(sai_int8_t), attr_list[i].value.s8list.count);
@@ -303,6 +332,9 @@ void s32ListAttr(
     int i,
     uint32_t listIndex,
     vector<string>& attrLines) {
+  if (ListTypeProbe::record(TraceListType::S32_LIST)) {
+    return;
+  }
   // First make sure we have enough lists for use
   uint32_t listLimit = SaiTracer::getInstance()->checkListCount(
       listIndex + 1, sizeof(sai_int32_t), attr_list[i].value.s32list.count);
@@ -324,6 +356,9 @@ void u32ListAttr(
     int i,
     uint32_t listIndex,
     vector<string>& attrLines) {
+  if (ListTypeProbe::record(TraceListType::U32_LIST)) {
+    return;
+  }
   // First make sure we have enough lists for use
   uint32_t listLimit = SaiTracer::getInstance()->checkListCount(
       listIndex + 1, sizeof(sai_uint32_t), attr_list[i].value.u32list.count);
@@ -363,6 +398,9 @@ void qosMapListAttr(
     int i,
     uint32_t listIndex,
     std::vector<std::string>& attrLines) {
+  if (ListTypeProbe::record(TraceListType::QOS_MAP_LIST)) {
+    return;
+  }
   // First make sure we have enough lists for use
   uint32_t listLimit = SaiTracer::getInstance()->checkListCount(
       listIndex + 1, sizeof(sai_qos_map_t), attr_list[i].value.qosmap.count);
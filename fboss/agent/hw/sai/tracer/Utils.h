@@ -17,6 +17,28 @@ extern "C" {
 
 namespace facebook::fboss {
 
+/*
+ * While a ListTypeProbe is alive, the *ListAttr() helpers below serialize
+ * nothing and only record the type of list they were called for. This tells
+ * the binary trace which attribute lists the C source generation reads.
+ */
+class ListTypeProbe {
+ public:
+  ListTypeProbe();
+  ~ListTypeProbe();
+
+  TraceListType listType() const {
+    return listType_;
+  }
+
+  // Records the list type on the thread's probe, if any
+  static bool record(TraceListType listType);
+
+ private:
+  TraceListType listType_{TraceListType::NONE};
+  ListTypeProbe* previous_;
+};
+
 // Helper methods to setup attributes
 
 // OidAttr not only serializes oid, but also look into the variable mappings
@@ -0,0 +1,174 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/hw/sai/tracer/SaiTraceRecord.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace facebook::fboss;
+
+namespace {
+
+std::string record(
+    TraceRecordWriter& writer,
+    TraceOp op,
+    sai_object_type_t objectType,
+    sai_object_id_t objectId,
+    folly::StringPiece fnName,
+    const std::vector<sai_attribute_t>& attrs) {
+  writer.begin(op, objectType, SAI_STATUS_SUCCESS, objectId, 1);
+  writer.addFnName(fnName);
+  writer.addAttributes(attrs.data(), attrs.size());
+  return folly::StringPiece(writer.finish()).str();
+}
+
+} // namespace
+
+TEST(SaiTraceRecordTest, listTypes) {
+  // List types follow the set*Attributes() functions of the api tracers
+  EXPECT_EQ(
+      traceListType(SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_HW_LANE_LIST),
+      TraceListType::U32_LIST);
+  for (auto id :
+       {SAI_PORT_ATTR_INGRESS_MIRROR_SESSION,
+        SAI_PORT_ATTR_EGRESS_MIRROR_SESSION,
+        SAI_PORT_ATTR_QOS_QUEUE_LIST}) {
+    EXPECT_EQ(
+        traceListType(SAI_OBJECT_TYPE_PORT, id), TraceListType::OBJECT_LIST);
+  }
+  EXPECT_EQ(
+      traceListType(
+          SAI_OBJECT_TYPE_ACL_ENTRY, SAI_ACL_ENTRY_ATTR_ACTION_MIRROR_INGRESS),
+      TraceListType::ACL_ACTION_OBJECT_LIST);
+  EXPECT_EQ(
+      traceListType(
+          SAI_OBJECT_TYPE_QOS_MAP, SAI_QOS_MAP_ATTR_MAP_TO_VALUE_LIST),
+      TraceListType::QOS_MAP_LIST);
+  EXPECT_EQ(
+      traceListType(SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_SPEED),
+      TraceListType::NONE);
+  EXPECT_EQ(
+      traceListType(
+          SAI_OBJECT_TYPE_ROUTE_ENTRY, SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID),
+      TraceListType::NONE);
+}
+
+TEST(SaiTraceRecordTest, roundTrip) {
+  std::vector<uint32_t> lanes{1, 2, 3, 4};
+  std::vector<sai_object_id_t> mirrors{42};
+  std::vector<sai_attribute_t> attrs(4);
+  attrs[0].id = SAI_PORT_ATTR_HW_LANE_LIST;
+  attrs[0].value.u32list.count = lanes.size();
+  attrs[0].value.u32list.list = lanes.data();
+  attrs[1].id = SAI_PORT_ATTR_SPEED;
+  attrs[1].value.u32 = 100000;
+  attrs[2].id = SAI_PORT_ATTR_INGRESS_MIRROR_SESSION;
+  attrs[2].value.objlist.count = mirrors.size();
+  attrs[2].value.objlist.list = mirrors.data();
+  attrs[3].id = SAI_PORT_ATTR_EGRESS_MIRROR_SESSION;
+  attrs[3].value.objlist.count = 0;
+  attrs[3].value.objlist.list = nullptr;
+
+  TraceRecordWriter writer;
+  auto trace = record(
+      writer, TraceOp::CREATE, SAI_OBJECT_TYPE_PORT, 7, "create_port", attrs);
+
+  sai_route_entry_t routeEntry;
+  std::memset(&routeEntry, 0, sizeof(routeEntry));
+  routeEntry.switch_id = 1;
+  routeEntry.vr_id = 2;
+  routeEntry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+  routeEntry.destination.addr.ip4 = 0x0a000000;
+  routeEntry.destination.mask.ip4 = 0xffffff00;
+  sai_attribute_t nextHop;
+  nextHop.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+  nextHop.value.oid = 9;
+  writer.begin(TraceOp::SET_ATTRIBUTE, SAI_OBJECT_TYPE_ROUTE_ENTRY, -1);
+  writer.addEntry(&routeEntry, sizeof(routeEntry));
+  writer.addAttributes(&nextHop, 1);
+  trace += folly::StringPiece(writer.finish()).str();
+
+  TraceReader reader(folly::ByteRange(folly::StringPiece(trace)));
+  auto port = reader.next();
+  ASSERT_TRUE(port);
+  EXPECT_EQ(port->header.op, TraceOp::CREATE);
+  EXPECT_EQ(port->header.objectType, SAI_OBJECT_TYPE_PORT);
+  EXPECT_EQ(port->header.objectId, 7);
+  EXPECT_EQ(port->header.switchId, 1);
+  EXPECT_EQ(port->fnName, "create_port");
+  ASSERT_EQ(port->attributes.size(), attrs.size());
+  const auto& gotLanes = port->attributes[0].value.u32list;
+  ASSERT_EQ(gotLanes.count, lanes.size());
+  EXPECT_NE(gotLanes.list, lanes.data());
+  EXPECT_EQ(
+      std::vector<uint32_t>(gotLanes.list, gotLanes.list + gotLanes.count),
+      lanes);
+  EXPECT_EQ(port->attributes[1].value.u32, 100000);
+  const auto& gotMirrors = port->attributes[2].value.objlist;
+  ASSERT_EQ(gotMirrors.count, mirrors.size());
+  EXPECT_NE(gotMirrors.list, mirrors.data());
+  EXPECT_EQ(gotMirrors.list[0], 42);
+  EXPECT_EQ(port->attributes[3].value.objlist.list, nullptr);
+
+  auto route = reader.next();
+  ASSERT_TRUE(route);
+  EXPECT_EQ(route->header.op, TraceOp::SET_ATTRIBUTE);
+  EXPECT_EQ(route->header.rv, -1);
+  ASSERT_NE(route->entry, nullptr);
+  EXPECT_EQ(std::memcmp(route->entry, &routeEntry, sizeof(routeEntry)), 0);
+  ASSERT_EQ(route->attributes.size(), 1);
+  EXPECT_EQ(route->attributes[0].value.oid, 9);
+
+  EXPECT_FALSE(reader.next());
+}
+
+TEST(SaiTraceRecordTest, truncatedLastRecord) {
+  std::vector<sai_attribute_t> attrs(1);
+  attrs[0].id = SAI_PORT_ATTR_SPEED;
+  attrs[0].value.u32 = 100000;
+  TraceRecordWriter writer;
+  auto first = record(
+      writer, TraceOp::CREATE, SAI_OBJECT_TYPE_PORT, 7, "create_port", attrs);
+  auto second = record(
+      writer,
+      TraceOp::SET_ATTRIBUTE,
+      SAI_OBJECT_TYPE_PORT,
+      7,
+      "set_port_attribute",
+      attrs);
+
+  // Cut in the record and in its header
+  for (auto cut : {second.size() - 8, sizeof(TraceRecordHeader) / 2}) {
+    auto trace = first + second.substr(0, cut);
+    TraceReader reader(folly::ByteRange(folly::StringPiece(trace)));
+    auto got = reader.next();
+    ASSERT_TRUE(got);
+    EXPECT_EQ(got->fnName, "create_port");
+    EXPECT_FALSE(reader.next());
+    EXPECT_FALSE(reader.next());
+  }
+}
+
+TEST(SaiTraceRecordTest, badRecordSize) {
+  TraceRecordWriter writer;
+  auto trace = record(
+      writer, TraceOp::REMOVE, SAI_OBJECT_TYPE_PORT, 7, "remove_port", {});
+  TraceRecordHeader hdr;
+  std::memcpy(&hdr, trace.data(), sizeof(hdr));
+  hdr.size = sizeof(hdr) + 1;
+  std::memcpy(trace.data(), &hdr, sizeof(hdr));
+  TraceReader reader(folly::ByteRange(folly::StringPiece(trace)));
+  EXPECT_THROW(reader.next(), FbossError);
+}
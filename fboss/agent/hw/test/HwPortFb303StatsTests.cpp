@@ -386,3 +386,30 @@ TEST(HwPortFb303Stats, queueNameChangeResetsValue) {
     }
   }
 }
+
+TEST(HwPortFb303Stats, updateStatsAfterQueueAdd) {
+  HwPortFb303Stats portStats(kPortName, kQueue2Name);
+  updateStats(portStats);
+  portStats.queueChanged(3, "platinum");
+  auto now = duration_cast<seconds>(system_clock::now().time_since_epoch());
+  auto stats = getInitedStats();
+  for (auto* queueStats :
+       {&*stats.queueOutDiscardBytes__ref(),
+        &*stats.queueOutDiscardPackets__ref(),
+        &*stats.queueOutBytes__ref(),
+        &*stats.queueOutPackets__ref()}) {
+    (*queueStats)[3] = 0;
+  }
+  portStats.updateStats(stats, now);
+  (*stats.queueOutBytes__ref())[3] = 10;
+  portStats.updateStats(stats, now);
+  EXPECT_EQ(
+      portStats.getCounterLastIncrement(
+          HwPortFb303Stats::statName(kOutBytes(), kPortName, 3, "platinum")),
+      10);
+  // Existing queues are still updated after the new queue was resolved
+  EXPECT_EQ(
+      portStats.getCounterLastIncrement(
+          HwPortFb303Stats::statName(kOutBytes(), kPortName, 1, "gold")),
+      0);
+}
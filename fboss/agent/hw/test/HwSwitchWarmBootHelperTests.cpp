@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/HwSwitchWarmBootHelper.h"
+#include "fboss/agent/FbossError.h"
+
+#include <folly/json.h>
+
+#include <gtest/gtest.h>
+using namespace facebook::fboss;
+
+namespace {
+using StateFormat = HwSwitchWarmBootHelper::StateFormat;
+
+folly::dynamic makeState() {
+  folly::dynamic routes = folly::dynamic::array(
+      folly::dynamic::object("prefix", "10.0.0.0")("mask", 24),
+      folly::dynamic::object("prefix", "2401:db00::")("mask", 64));
+  folly::dynamic state = folly::dynamic::object;
+  state["swSwitch"] = folly::dynamic::object("routes", routes);
+  state["hwSwitch"] = folly::dynamic::object("numRoutes", 2)("weight", 1.5);
+  return state;
+}
+
+folly::dynamic roundTrip(const folly::dynamic& state, StateFormat format) {
+  auto serialized =
+      HwSwitchWarmBootHelper::serializeWarmBootState(state, format);
+  return HwSwitchWarmBootHelper::deserializeWarmBootState(
+      folly::StringPiece(serialized));
+}
+} // namespace
+
+TEST(HwSwitchWarmBootHelperTest, JsonRoundTrip) {
+  auto state = makeState();
+  EXPECT_EQ(roundTrip(state, StateFormat::JSON), state);
+}
+
+TEST(HwSwitchWarmBootHelperTest, BinaryRoundTrip) {
+  auto state = makeState();
+  EXPECT_EQ(roundTrip(state, StateFormat::BINARY), state);
+}
+
+TEST(HwSwitchWarmBootHelperTest, BinaryIsSmallerThanJson) {
+  auto state = makeState();
+  EXPECT_LT(
+      HwSwitchWarmBootHelper::serializeWarmBootState(state, StateFormat::BINARY)
+          .size(),
+      HwSwitchWarmBootHelper::serializeWarmBootState(state, StateFormat::JSON)
+          .size());
+}
+
+TEST(HwSwitchWarmBootHelperTest, UnsupportedVersion) {
+  auto serialized = HwSwitchWarmBootHelper::serializeWarmBootState(
+      makeState(), StateFormat::BINARY);
+  // Version immediately follows the 4 byte magic
+  serialized[4] = 0xff;
+  EXPECT_THROW(
+      HwSwitchWarmBootHelper::deserializeWarmBootState(
+          folly::StringPiece(serialized)),
+      FbossError);
+}
@@ -14,6 +14,13 @@
 
 #include <cstdio>
 #include <cstring>
+DEFINE_bool(
+    sai_bcm_per_api_lock,
+    false,
+    "Only serialize calls to the same SAI api, so that e.g. stats collection "
+    "does not stall route programming. To be enabled only with SDK versions "
+    "validated to be safe for concurrent calls to different apis");
+
 namespace facebook::fboss {
 
 std::string SaiBcmPlatform::getHwConfig() {
@@ -29,6 +36,11 @@ std::string SaiBcmPlatform::getHwConfig() {
   return hwConfig;
 }
 
+SaiApiLock::Granularity SaiBcmPlatform::getSaiApiLockGranularity() const {
+  return FLAGS_sai_bcm_per_api_lock ? SaiApiLock::Granularity::PER_API
+                                    : SaiApiLock::Granularity::GLOBAL;
+}
+
 std::vector<PortID> SaiBcmPlatform::getAllPortsInGroup(PortID portID) const {
   std::vector<PortID> allPortsinGroup;
   if (const auto& platformPorts = getPlatformPorts(); !platformPorts.empty()) {
@@ -12,6 +12,9 @@
 #include "fboss/agent/platforms/sai/SaiHwPlatform.h"
 
 #include <folly/Range.h>
+#include <gflags/gflags.h>
+
+DECLARE_bool(sai_bcm_per_api_lock);
 
 namespace facebook::fboss {
 
@@ -34,6 +37,7 @@ class SaiBcmPlatform : public SaiHwPlatform {
   bool supportInterfaceType() const override {
     return true;
   }
+  SaiApiLock::Granularity getSaiApiLockGranularity() const override;
   const char* getHwConfigValue(const std::string& key) const;
   virtual uint32_t numLanesPerCore() const = 0;
 
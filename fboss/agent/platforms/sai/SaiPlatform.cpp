@@ -182,6 +182,7 @@ void SaiPlatform::initSaiProfileValues() {
 
 void SaiPlatform::initImpl(uint32_t hwFeaturesDesired) {
   initSaiProfileValues();
+  SaiApiLock::getInstance()->setGranularity(getSaiApiLockGranularity());
   SaiApiTable::getInstance()->queryApis(
       getServiceMethodTable(), getSupportedApiList());
   saiSwitch_ = std::make_unique<SaiSwitch>(this, hwFeaturesDesired);
@@ -19,6 +19,7 @@
 #include "fboss/agent/platforms/tests/utils/TestPlatformTypes.h"
 #include "fboss/lib/phy/PhyInterfaceHandler.h"
 
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
 #include "fboss/agent/hw/sai/api/SaiVersion.h"
 #include "fboss/agent/hw/sai/api/SwitchApi.h"
 
@@ -91,6 +92,15 @@ class SaiPlatform : public Platform, public StateObserver {
 
   virtual bool isSerdesApiSupported() const = 0;
 
+  /*
+   * Concurrency the SAI adapter supports, see SaiApiLock. Adapters which
+   * can be called concurrently on different apis should return PER_API, so
+   * that e.g. stats collection does not stall route programming.
+   */
+  virtual SaiApiLock::Granularity getSaiApiLockGranularity() const {
+    return SaiApiLock::Granularity::GLOBAL;
+  }
+
   std::vector<SaiPlatformPort*> getPortsWithTransceiverID(
       TransceiverID id) const;
 
@@ -21,6 +21,7 @@ ConfigApplier::ConfigApplier(
     RouterID vrf,
     IPv4NetworkToRouteMap* v4NetworkToRoute,
     IPv6NetworkToRouteMap* v6NetworkToRoute,
+    RouteDependencyIndex* dependencyIndex,
     folly::Range<DirectlyConnectedRouteIterator> directlyConnectedRouteRange,
     folly::Range<StaticRouteNoNextHopsIterator> staticCpuRouteRange,
     folly::Range<StaticRouteNoNextHopsIterator> staticDropRouteRange,
@@ -29,6 +30,7 @@ ConfigApplier::ConfigApplier(
     : vrf_(vrf),
       v4NetworkToRoute_(v4NetworkToRoute),
       v6NetworkToRoute_(v6NetworkToRoute),
+      dependencyIndex_(dependencyIndex),
       directlyConnectedRouteRange_(directlyConnectedRouteRange),
       staticCpuRouteRange_(staticCpuRouteRange),
       staticDropRouteRange_(staticDropRouteRange),
@@ -38,8 +40,9 @@ ConfigApplier::ConfigApplier(
   CHECK_NOTNULL(v6NetworkToRoute_);
 }
 
-void ConfigApplier::apply() {
-  RibRouteUpdater updater(v4NetworkToRoute_, v6NetworkToRoute_);
+std::optional<RibChangedPrefixes> ConfigApplier::apply() {
+  RibRouteUpdater updater(
+      v4NetworkToRoute_, v6NetworkToRoute_, dependencyIndex_);
 
   // Update static routes
   std::vector<RibRouteUpdater::RouteEntry> staticRoutes;
@@ -96,6 +99,7 @@ void ConfigApplier::apply() {
       {ClientID::STATIC_ROUTE,
        ClientID::LINKLOCAL_ROUTE,
        ClientID::INTERFACE_ROUTE});
+  return updater.changedPrefixes();
 }
 
 } // namespace facebook::fboss
@@ -48,18 +48,24 @@ class ConfigApplier {
       RouterID vrf,
       IPv4NetworkToRouteMap* v4RouteTable,
       IPv6NetworkToRouteMap* v6RouteTable,
+      RouteDependencyIndex* dependencyIndex,
       folly::Range<DirectlyConnectedRouteIterator> directlyConnectedRouteRange,
       folly::Range<StaticRouteNoNextHopsIterator> staticCpuRouteRange,
       folly::Range<StaticRouteNoNextHopsIterator> staticDropRouteRange,
       folly::Range<StaticRouteWithNextHopsIterator> staticRouteRange,
       folly::Range<StaticIp2MplsRouteIterator> staticIp2MplsRouteRange);
 
-  void apply();
+  /*
+   * Returns prefixes changed by config application, std::nullopt if all
+   * routes were re-resolved.
+   */
+  std::optional<RibChangedPrefixes> apply();
 
  private:
   RouterID vrf_;
   IPv4NetworkToRouteMap* v4NetworkToRoute_;
   IPv6NetworkToRouteMap* v6NetworkToRoute_;
+  RouteDependencyIndex* dependencyIndex_;
   folly::Range<DirectlyConnectedRouteIterator> directlyConnectedRouteRange_;
   folly::Range<StaticRouteNoNextHopsIterator> staticCpuRouteRange_;
   folly::Range<StaticRouteNoNextHopsIterator> staticDropRouteRange_;
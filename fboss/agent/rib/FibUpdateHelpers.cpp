@@ -18,9 +18,10 @@ std::shared_ptr<facebook::fboss::SwitchState> ribToSwitchStateUpdate(
     facebook::fboss::RouterID vrf,
     const IPv4NetworkToRouteMap& v4NetworkToRoute,
     const IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const RibChangedPrefixes* changedPrefixes,
     void* cookie) {
   ForwardingInformationBaseUpdater fibUpdater(
-      vrf, v4NetworkToRoute, v6NetworkToRoute);
+      vrf, v4NetworkToRoute, v6NetworkToRoute, changedPrefixes);
 
   auto switchState =
       static_cast<std::shared_ptr<facebook::fboss::SwitchState>*>(cookie);
@@ -33,6 +34,7 @@ std::shared_ptr<facebook::fboss::SwitchState> noopFibUpdate(
     facebook::fboss::RouterID /*vrf*/,
     const IPv4NetworkToRouteMap& /*v4NetworkToRoute*/,
     const IPv6NetworkToRouteMap& /*v6NetworkToRoute*/,
+    const RibChangedPrefixes* /*changedPrefixes*/,
     void* /*cookie*/) {
   return nullptr;
 }
@@ -25,10 +25,12 @@ namespace facebook::fboss {
 ForwardingInformationBaseUpdater::ForwardingInformationBaseUpdater(
     RouterID vrf,
     const IPv4NetworkToRouteMap& v4NetworkToRoute,
-    const IPv6NetworkToRouteMap& v6NetworkToRoute)
+    const IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const RibChangedPrefixes* changedPrefixes)
     : vrf_(vrf),
       v4NetworkToRoute_(v4NetworkToRoute),
-      v6NetworkToRoute_(v6NetworkToRoute) {}
+      v6NetworkToRoute_(v6NetworkToRoute),
+      changedPrefixes_(changedPrefixes) {}
 
 std::shared_ptr<SwitchState> ForwardingInformationBaseUpdater::operator()(
     const std::shared_ptr<SwitchState>& state) {
@@ -42,18 +44,36 @@ std::shared_ptr<SwitchState> ForwardingInformationBaseUpdater::operator()(
   // SwitchState for a single VRF.
   std::shared_ptr<SwitchState> nextState(state);
   auto previousFibContainer = nextState->getFibs()->getFibContainerIf(vrf_);
+  bool fullRebuild = !changedPrefixes_;
   if (!previousFibContainer) {
+    if (!fullRebuild) {
+      // Building it from just the changed routes would drop all others
+      throw FibContainerMissingError(
+          "No FIB to patch for VRF ", vrf_, ", rebuild it from the RIB");
+    }
     auto fibMap = nextState->getFibs()->modify(&nextState);
     fibMap->updateForwardingInformationBaseContainer(
         std::make_shared<ForwardingInformationBaseContainer>(vrf_));
     previousFibContainer = nextState->getFibs()->getFibContainerIf(vrf_);
   }
   CHECK(previousFibContainer);
-  auto newFibV4 =
-      createUpdatedFib(v4NetworkToRoute_, previousFibContainer->getFibV4());
-
-  auto newFibV6 =
-      createUpdatedFib(v6NetworkToRoute_, previousFibContainer->getFibV6());
+  std::shared_ptr<ForwardingInformationBaseV4> newFibV4;
+  std::shared_ptr<ForwardingInformationBaseV6> newFibV6;
+  if (fullRebuild) {
+    newFibV4 =
+        createUpdatedFib(v4NetworkToRoute_, previousFibContainer->getFibV4());
+    newFibV6 =
+        createUpdatedFib(v6NetworkToRoute_, previousFibContainer->getFibV6());
+  } else {
+    newFibV4 = patchFib(
+        v4NetworkToRoute_,
+        changedPrefixes_->v4,
+        previousFibContainer->getFibV4());
+    newFibV6 = patchFib(
+        v6NetworkToRoute_,
+        changedPrefixes_->v6,
+        previousFibContainer->getFibV6());
+  }
 
   if (!newFibV4 && !newFibV6) {
     // return nextState in case we modified state above to insert new VRF
@@ -90,7 +110,6 @@ ForwardingInformationBaseUpdater::createUpdatedFib(
       continue;
     }
 
-    // TODO(samank): optimize to linear time intersection algorithm
     facebook::fboss::RoutePrefix<AddressT> fibPrefix{
         ribRoute->prefix().network, ribRoute->prefix().mask};
     std::shared_ptr<facebook::fboss::Route<AddressT>> fibRoute =
@@ -114,7 +133,7 @@ ForwardingInformationBaseUpdater::createUpdatedFib(
   // and have now been removed
   for (const auto& fibEntry : *fib) {
     const auto& prefix = fibEntry->prefix();
-    if (updatedFib.find(prefix) == updatedFib.end()) {
+    if (!updatedFib.count(prefix)) {
       updated = true;
       break;
     }
@@ -135,4 +154,44 @@ ForwardingInformationBaseUpdater::createUpdatedFib(
                  : nullptr;
 }
 
+template <typename AddressT>
+std::shared_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
+ForwardingInformationBaseUpdater::patchFib(
+    const facebook::fboss::NetworkToRouteMap<AddressT>& rib,
+    const std::vector<RoutePrefix<AddressT>>& changedPrefixes,
+    const std::shared_ptr<facebook::fboss::ForwardingInformationBase<AddressT>>&
+        fib) {
+  std::shared_ptr<ForwardingInformationBase<AddressT>> updatedFib;
+  auto writableFib = [&updatedFib, &fib]() {
+    if (!updatedFib) {
+      updatedFib = fib->clone();
+    }
+    return updatedFib.get();
+  };
+  for (const auto& prefix : changedPrefixes) {
+    auto ritr = rib.exactMatch(prefix.network, prefix.mask);
+    std::shared_ptr<facebook::fboss::Route<AddressT>> ribRoute;
+    if (ritr != rib.end() && ritr->value()->isResolved()) {
+      ribRoute = ritr->value();
+    }
+    auto fibRoute = fib->getNodeIf(prefix);
+    if (!ribRoute) {
+      if (fibRoute) {
+        // deleted or no longer resolved route
+        writableFib()->removeNode(prefix);
+      }
+      continue;
+    }
+    CHECK(ribRoute->isPublished());
+    if (!fibRoute) {
+      // new route
+      writableFib()->addNode(ribRoute);
+    } else if (fibRoute != ribRoute && !fibRoute->isSame(ribRoute.get())) {
+      writableFib()->updateNode(ribRoute);
+    }
+    // else pointer or contents are same, reuse existing route
+  }
+  return updatedFib;
+}
+
 } // namespace facebook::fboss
@@ -9,7 +9,9 @@
  */
 #pragma once
 
+#include "fboss/agent/FbossError.h"
 #include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/RouteUpdater.h"
 
 #include "fboss/agent/state/ForwardingInformationBase.h"
 #include "fboss/agent/state/RouteTypes.h"
@@ -21,12 +23,24 @@ namespace facebook::fboss {
 
 class SwitchState;
 
+/*
+ * Thrown when asked to patch the FIB of a VRF which has none yet. With
+ * changed prefixes, the routes handed in may be just the changed ones (see
+ * RibRouteTables::PendingFibUpdate), so the FIB has to be built again from
+ * the whole RIB.
+ */
+class FibContainerMissingError : public FbossError {
+ public:
+  using FbossError::FbossError;
+};
+
 class ForwardingInformationBaseUpdater {
  public:
   ForwardingInformationBaseUpdater(
       RouterID vrf,
       const IPv4NetworkToRouteMap& v4NetworkToRoute,
-      const IPv6NetworkToRouteMap& v6NetworkToRoute);
+      const IPv6NetworkToRouteMap& v6NetworkToRoute,
+      const RibChangedPrefixes* changedPrefixes = nullptr);
 
   std::shared_ptr<SwitchState> operator()(
       const std::shared_ptr<SwitchState>& state);
@@ -42,9 +56,26 @@ class ForwardingInformationBaseUpdater {
       const std::shared_ptr<
           facebook::fboss::ForwardingInformationBase<AddressT>>& fib);
 
+  /*
+   * Like createUpdatedFib, but only looks at changedPrefixes. Cost is
+   * proportional to the number of changed prefixes rather than RIB size.
+   */
+  template <typename AddressT>
+  std::shared_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
+  patchFib(
+      const facebook::fboss::NetworkToRouteMap<AddressT>& rib,
+      const std::vector<RoutePrefix<AddressT>>& changedPrefixes,
+      const std::shared_ptr<
+          facebook::fboss::ForwardingInformationBase<AddressT>>& fib);
+
   RouterID vrf_;
   const IPv4NetworkToRouteMap& v4NetworkToRoute_;
   const IPv6NetworkToRouteMap& v6NetworkToRoute_;
+  /*
+   * Null if unknown, in which case FIBs are rebuilt from the RIB. Otherwise
+   * the routes above need only hold the changed prefixes.
+   */
+  const RibChangedPrefixes* changedPrefixes_;
 };
 
 } // namespace facebook::fboss
@@ -0,0 +1,362 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/rib/LpmSnapshot.h"
+
+#include "fboss/agent/rib/RouteUpdater.h"
+
+#include <folly/lang/Bits.h>
+#include <folly/synchronization/Rcu.h>
+
+#include <algorithm>
+#include <type_traits>
+
+namespace {
+constexpr auto kBitsPerLevel = 8;
+constexpr auto kSlotsPerLevel = 1 << kBitsPerLevel;
+
+bool isSet(const std::array<uint64_t, 4>& bitmap, size_t bit) {
+  return bitmap[bit / 64] & (1ULL << (bit % 64));
+}
+
+void setBit(std::array<uint64_t, 4>* bitmap, size_t bit) {
+  (*bitmap)[bit / 64] |= 1ULL << (bit % 64);
+}
+
+// Number of bits set below position bit
+size_t rank(const std::array<uint64_t, 4>& bitmap, size_t bit) {
+  size_t count = 0;
+  for (size_t word = 0; word < bit / 64; ++word) {
+    count += folly::popcount(bitmap[word]);
+  }
+  if (bit % 64) {
+    count += folly::popcount(bitmap[bit / 64] & ((1ULL << (bit % 64)) - 1));
+  }
+  return count;
+}
+} // namespace
+
+namespace facebook::fboss {
+
+namespace {
+/*
+ * Rebuilding is cheaper than patching once a RIB update touches more than
+ * 1/kRebuildRatio of the table, e.g. after a client resets its routes.
+ */
+constexpr size_t kRebuildRatio = 4;
+
+template <typename AddrT>
+std::shared_ptr<const LpmTable<AddrT>> updateTable(
+    const std::shared_ptr<const LpmTable<AddrT>>& table,
+    const NetworkToRouteMap<AddrT>& routes,
+    const std::vector<RoutePrefix<AddrT>>* changedPrefixes) {
+  if (!table || !changedPrefixes ||
+      changedPrefixes->size() * kRebuildRatio > routes.size()) {
+    return std::make_shared<const LpmTable<AddrT>>(routes);
+  }
+  if (changedPrefixes->empty()) {
+    return table;
+  }
+  return std::make_shared<const LpmTable<AddrT>>(
+      *table, routes, *changedPrefixes);
+}
+} // namespace
+
+template <typename AddrT>
+LpmTable<AddrT>::LpmTable(const NetworkToRouteMap<AddrT>& routes) {
+  std::vector<PendingRoute> pending;
+  for (const auto& routeNode : routes) {
+    const auto& route = routeNode.value();
+    PendingRoute entry;
+    const auto& network = route->prefix().network;
+    std::copy_n(network.bytes(), entry.bytes.size(), entry.bytes.begin());
+    entry.mask = route->prefix().mask;
+    entry.route = route;
+    pending.push_back(std::move(entry));
+  }
+  // Shortest prefixes first, so that longer ones overwrite their slots
+  std::sort(
+      pending.begin(),
+      pending.end(),
+      [](const PendingRoute& lhs, const PendingRoute& rhs) {
+        return lhs.mask < rhs.mask;
+      });
+  root_ = build(0, pending.data(), pending.data() + pending.size());
+}
+
+template <typename AddrT>
+LpmTable<AddrT>::LpmTable(
+    const LpmTable& base,
+    const NetworkToRouteMap<AddrT>& routes,
+    const std::vector<RoutePrefix<AddrT>>& changedPrefixes)
+    : root_(base.root_), numNodes_(base.numNodes_) {
+  std::vector<PendingRoute> pending;
+  pending.reserve(changedPrefixes.size());
+  for (const auto& prefix : changedPrefixes) {
+    PendingRoute entry;
+    std::copy_n(
+        prefix.network.bytes(), entry.bytes.size(), entry.bytes.begin());
+    entry.mask = prefix.mask;
+    pending.push_back(std::move(entry));
+  }
+  // Prefixes under the same node are then contiguous at every level
+  std::sort(
+      pending.begin(),
+      pending.end(),
+      [](const PendingRoute& lhs, const PendingRoute& rhs) {
+        return lhs.bytes < rhs.bytes;
+      });
+  root_ = patch(
+      root_.get(), 0, routes, pending.data(), pending.data() + pending.size());
+}
+
+/*
+ * [begin, end) are the routes within the node, sorted by mask. Routes
+ * ending at this level are expanded into its slots, the others are handed
+ * to the child node of their slot.
+ */
+template <typename AddrT>
+std::shared_ptr<const typename LpmTable<AddrT>::Node>
+LpmTable<AddrT>::build(size_t level, PendingRoute* begin, PendingRoute* end) {
+  const size_t levelEnd = (level + 1) * kBitsPerLevel;
+  Slots slots;
+  auto deeper =
+      std::stable_partition(begin, end, [levelEnd](const PendingRoute& route) {
+        return route.mask <= levelEnd;
+      });
+  for (auto route = begin; route != deeper; ++route) {
+    uint32_t span = 1U << (levelEnd - route->mask);
+    uint32_t first = route->bytes[level] & ~(span - 1);
+    std::fill_n(slots.routes.begin() + first, span, route->route);
+  }
+  // Group the remaining routes by slot, keeping them sorted by mask
+  std::stable_sort(
+      deeper, end, [level](const PendingRoute& lhs, const PendingRoute& rhs) {
+        return lhs.bytes[level] < rhs.bytes[level];
+      });
+  for (auto groupBegin = deeper; groupBegin != end;) {
+    auto slot = groupBegin->bytes[level];
+    auto groupEnd = std::find_if(
+        groupBegin, end, [level, slot](const PendingRoute& route) {
+          return route.bytes[level] != slot;
+        });
+    slots.children[slot] = build(level + 1, groupBegin, groupEnd);
+    groupBegin = groupEnd;
+  }
+  return compress(slots);
+}
+
+/*
+ * Copy of node with the slots of the changed prefixes [begin, end) ending
+ * at this level looked up again in routes, and the child nodes of the
+ * others patched in turn. Null if nothing is left in the node.
+ */
+template <typename AddrT>
+std::shared_ptr<const typename LpmTable<AddrT>::Node> LpmTable<AddrT>::patch(
+    const Node* node,
+    size_t level,
+    const NetworkToRouteMap<AddrT>& routes,
+    PendingRoute* begin,
+    PendingRoute* end) {
+  const size_t levelEnd = (level + 1) * kBitsPerLevel;
+  Slots slots;
+  if (node) {
+    size_t leaf = 0;
+    size_t child = 0;
+    for (size_t slot = 0; slot < kSlotsPerLevel; ++slot) {
+      if (isSet(node->leaves, slot)) {
+        ++leaf;
+      }
+      slots.routes[slot] = node->leafRoutes[leaf - 1];
+      if (isSet(node->children, slot)) {
+        slots.children[slot] = node->childNodes[child++];
+      }
+    }
+    // Replaced by its copy
+    --numNodes_;
+  }
+  auto deeper =
+      std::stable_partition(begin, end, [levelEnd](const PendingRoute& route) {
+        return route.mask <= levelEnd;
+      });
+  if (begin != deeper) {
+    Bitmap changed{};
+    for (auto prefix = begin; prefix != deeper; ++prefix) {
+      uint32_t span = 1U << (levelEnd - prefix->mask);
+      uint32_t first = prefix->bytes[level] & ~(span - 1);
+      for (auto slot = first; slot < first + span; ++slot) {
+        setBit(&changed, slot);
+      }
+    }
+    // All prefixes within the node share the bytes above its level
+    auto bytes = begin->bytes;
+    std::fill(bytes.begin() + level, bytes.end(), 0);
+    for (size_t slot = 0; slot < kSlotsPerLevel; ++slot) {
+      if (!isSet(changed, slot)) {
+        continue;
+      }
+      bytes[level] = slot;
+      auto itr = routes.longestMatch(
+          AddrT::fromBinary(folly::ByteRange(bytes.data(), bytes.size())),
+          levelEnd);
+      // Shorter routes belong to the slots of the levels above
+      slots.routes[slot] = itr != routes.end() &&
+              (level == 0 ||
+               itr->value()->prefix().mask > levelEnd - kBitsPerLevel)
+          ? itr->value()
+          : nullptr;
+    }
+  }
+  for (auto groupBegin = deeper; groupBegin != end;) {
+    auto slot = groupBegin->bytes[level];
+    auto groupEnd = std::find_if(
+        groupBegin, end, [level, slot](const PendingRoute& route) {
+          return route.bytes[level] != slot;
+        });
+    slots.children[slot] = patch(
+        slots.children[slot].get(), level + 1, routes, groupBegin, groupEnd);
+    groupBegin = groupEnd;
+  }
+  return compress(slots);
+}
+
+template <typename AddrT>
+std::shared_ptr<const typename LpmTable<AddrT>::Node> LpmTable<AddrT>::compress(
+    const Slots& slots) {
+  auto node = std::make_shared<Node>();
+  for (size_t slot = 0; slot < kSlotsPerLevel; ++slot) {
+    if (slot == 0 || slots.routes[slot] != slots.routes[slot - 1]) {
+      setBit(&node->leaves, slot);
+      node->leafRoutes.push_back(slots.routes[slot]);
+    }
+    if (slots.children[slot]) {
+      setBit(&node->children, slot);
+      node->childNodes.push_back(slots.children[slot]);
+    }
+  }
+  if (node->childNodes.empty() && !node->leafRoutes[0] &&
+      node->leafRoutes.size() == 1) {
+    return nullptr;
+  }
+  ++numNodes_;
+  return node;
+}
+
+template <typename AddrT>
+std::shared_ptr<Route<AddrT>> LpmTable<AddrT>::longestMatch(
+    const AddrT& addr) const {
+  const auto* bytes = addr.bytes();
+  const Node* node = root_.get();
+  const std::shared_ptr<RouteT>* match = nullptr;
+  // Host routes end at the last level, which never has children
+  for (size_t level = 0; node && level < kNumLevels; ++level) {
+    auto slot = bytes[level];
+    const auto& route = node->leafRoutes[rank(node->leaves, slot + 1) - 1];
+    if (route) {
+      match = &route;
+    }
+    if (!isSet(node->children, slot)) {
+      break;
+    }
+    node = node->childNodes[rank(node->children, slot)].get();
+  }
+  return match ? *match : nullptr;
+}
+
+RibLpmSnapshot::~RibLpmSnapshot() {
+  if (auto snapshot = snapshot_.exchange(nullptr)) {
+    folly::rcu_retire(snapshot);
+  }
+}
+
+RibLpmSnapshot::RibLpmSnapshot(RibLpmSnapshot&& other) noexcept
+    : snapshot_(other.snapshot_.exchange(nullptr)) {}
+
+RibLpmSnapshot& RibLpmSnapshot::operator=(RibLpmSnapshot&& other) noexcept {
+  if (this != &other) {
+    std::lock_guard<std::mutex> g(publishLock_);
+    if (auto snapshot = snapshot_.exchange(other.snapshot_.exchange(nullptr))) {
+      folly::rcu_retire(snapshot);
+    }
+  }
+  return *this;
+}
+
+template <typename AddrT>
+std::shared_ptr<Route<AddrT>> RibLpmSnapshot::longestMatch(
+    const AddrT& addr,
+    RouterID vrf) const {
+  folly::rcu_reader guard;
+  const auto* snapshot = snapshot_.load(std::memory_order_acquire);
+  if (!snapshot) {
+    return nullptr;
+  }
+  auto it = snapshot->find(vrf);
+  if (it == snapshot->end()) {
+    return nullptr;
+  }
+  if constexpr (std::is_same_v<AddrT, folly::IPAddressV4>) {
+    return it->second.v4->longestMatch(addr);
+  } else {
+    return it->second.v6->longestMatch(addr);
+  }
+}
+
+void RibLpmSnapshot::update(
+    RouterID vrf,
+    const IPv4NetworkToRouteMap& v4NetworkToRoute,
+    const IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const RibChangedPrefixes* changedPrefixes) {
+  std::lock_guard<std::mutex> g(publishLock_);
+  // Writers are serialized, the current snapshot can't be retired under us
+  const auto* current = snapshot_.load(std::memory_order_acquire);
+  auto next = current ? std::make_unique<Snapshot>(*current)
+                      : std::make_unique<Snapshot>();
+  auto& tables = (*next)[vrf];
+  tables.v4 = updateTable(
+      tables.v4,
+      v4NetworkToRoute,
+      changedPrefixes ? &changedPrefixes->v4 : nullptr);
+  tables.v6 = updateTable(
+      tables.v6,
+      v6NetworkToRoute,
+      changedPrefixes ? &changedPrefixes->v6 : nullptr);
+  publish(std::move(next));
+}
+
+void RibLpmSnapshot::removeVrf(RouterID vrf) {
+  std::lock_guard<std::mutex> g(publishLock_);
+  const auto* current = snapshot_.load(std::memory_order_acquire);
+  if (!current || current->find(vrf) == current->end()) {
+    return;
+  }
+  auto next = std::make_unique<Snapshot>(*current);
+  next->erase(vrf);
+  publish(std::move(next));
+}
+
+void RibLpmSnapshot::publish(std::unique_ptr<Snapshot> snapshot) {
+  auto old = snapshot_.exchange(snapshot.release(), std::memory_order_acq_rel);
+  if (old) {
+    // Freed once all readers that may have loaded it are done
+    folly::rcu_retire(old);
+  }
+}
+
+template class LpmTable<folly::IPAddressV4>;
+template class LpmTable<folly::IPAddressV6>;
+
+template std::shared_ptr<Route<folly::IPAddressV4>>
+RibLpmSnapshot::longestMatch(const folly::IPAddressV4& addr, RouterID vrf)
+    const;
+template std::shared_ptr<Route<folly::IPAddressV6>>
+RibLpmSnapshot::longestMatch(const folly::IPAddressV6& addr, RouterID vrf)
+    const;
+
+} // namespace facebook::fboss
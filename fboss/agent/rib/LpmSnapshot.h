@@ -0,0 +1,152 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/state/Route.h"
+#include "fboss/agent/types.h"
+
+#include <boost/container/flat_map.hpp>
+#include <folly/IPAddressV4.h>
+#include <folly/IPAddressV6.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace facebook::fboss {
+
+struct RibChangedPrefixes;
+
+/*
+ * LpmTable is an immutable longest prefix match structure built from the
+ * routes of one RIB table. It is a multibit trie consuming one address byte
+ * per level (4 levels for v4, 16 for v6), with prefixes expanded into the
+ * 256 slots of the level they end at. A lookup walks down the trie and
+ * returns the last route it went through.
+ *
+ * Each node keeps a bitmap of the slots that have a child and a bitmap of
+ * the slots starting a new run of the same route, so that a step down is a
+ * popcount.
+ *
+ * Nodes are shared between tables: a table patched with the prefixes of a
+ * RIB update copies just the nodes on the path of those prefixes and shares
+ * the others with the table it was patched from.
+ */
+template <typename AddrT>
+class LpmTable {
+ public:
+  using RouteT = Route<AddrT>;
+
+  explicit LpmTable(const NetworkToRouteMap<AddrT>& routes);
+  /*
+   * base with changedPrefixes looked up again in routes, which must be the
+   * routes base was built from with just changedPrefixes changed.
+   */
+  LpmTable(
+      const LpmTable& base,
+      const NetworkToRouteMap<AddrT>& routes,
+      const std::vector<RoutePrefix<AddrT>>& changedPrefixes);
+
+  std::shared_ptr<RouteT> longestMatch(const AddrT& addr) const;
+
+  size_t numNodes() const {
+    return numNodes_;
+  }
+
+ private:
+  static constexpr size_t kNumLevels = AddrT::byteCount();
+  using Bitmap = std::array<uint64_t, 4>;
+
+  struct Node {
+    // Slots leading to a child node
+    Bitmap children{};
+    // Slots whose route differs from the previous slot
+    Bitmap leaves{};
+    std::vector<std::shared_ptr<const Node>> childNodes;
+    // Routes ending at this level, null where none covers the slot
+    std::vector<std::shared_ptr<RouteT>> leafRoutes;
+  };
+  // A node with its slots expanded, while being built
+  struct Slots {
+    std::array<std::shared_ptr<RouteT>, 256> routes;
+    std::array<std::shared_ptr<const Node>, 256> children;
+  };
+  struct PendingRoute {
+    std::array<uint8_t, AddrT::byteCount()> bytes;
+    uint8_t mask;
+    std::shared_ptr<RouteT> route;
+  };
+
+  std::shared_ptr<const Node>
+  build(size_t level, PendingRoute* begin, PendingRoute* end);
+  std::shared_ptr<const Node> patch(
+      const Node* node,
+      size_t level,
+      const NetworkToRouteMap<AddrT>& routes,
+      PendingRoute* begin,
+      PendingRoute* end);
+  std::shared_ptr<const Node> compress(const Slots& slots);
+
+  std::shared_ptr<const Node> root_;
+  size_t numNodes_{0};
+};
+
+/*
+ * RibLpmSnapshot publishes per VRF LpmTables, updated by the RIB along with
+ * every FIB update, to slow path lookups (IPv4/IPv6 handlers, mirror
+ * resolution, thrift). Readers never take a lock: the current snapshot is
+ * reached through an RCU protected pointer, and writers replace it with a
+ * copy patched with the changed prefixes.
+ */
+class RibLpmSnapshot {
+ public:
+  RibLpmSnapshot() = default;
+  ~RibLpmSnapshot();
+  RibLpmSnapshot(RibLpmSnapshot&& other) noexcept;
+  RibLpmSnapshot& operator=(RibLpmSnapshot&& other) noexcept;
+
+  template <typename AddrT>
+  std::shared_ptr<Route<AddrT>> longestMatch(const AddrT& addr, RouterID vrf)
+      const;
+
+  /*
+   * Update the tables of vrf to its RIB routes. With changedPrefixes, only
+   * the trie nodes on the path of the changed prefixes are copied, without
+   * the tables are rebuilt from scratch.
+   */
+  void update(
+      RouterID vrf,
+      const IPv4NetworkToRouteMap& v4NetworkToRoute,
+      const IPv6NetworkToRouteMap& v6NetworkToRoute,
+      const RibChangedPrefixes* changedPrefixes);
+  void removeVrf(RouterID vrf);
+
+ private:
+  struct VrfTables {
+    std::shared_ptr<const LpmTable<folly::IPAddressV4>> v4;
+    std::shared_ptr<const LpmTable<folly::IPAddressV6>> v6;
+  };
+  using Snapshot = boost::container::flat_map<RouterID, VrfTables>;
+
+  // Forbidden copy constructor and assignment operator
+  RibLpmSnapshot(RibLpmSnapshot const&) = delete;
+  RibLpmSnapshot& operator=(RibLpmSnapshot const&) = delete;
+
+  void publish(std::unique_ptr<Snapshot> snapshot);
+
+  // Serializes writers, readers go through the RCU domain only
+  std::mutex publishLock_;
+  std::atomic<Snapshot*> snapshot_{nullptr};
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/rib/RouteDependencyIndex.h"
+
+namespace facebook::fboss {
+
+void RouteDependencyIndex::clear() {
+  prefixToNextHops_.clear();
+  v4NextHopToDependents_.clear();
+  v6NextHopToDependents_.clear();
+}
+
+void RouteDependencyIndex::updateDependencies(
+    const folly::CIDRNetwork& prefix,
+    const RouteNextHopSet& nhops) {
+  removeDependencies(prefix);
+  std::vector<folly::IPAddress> nhopAddrs;
+  for (const auto& nhop : nhops) {
+    if (nhop.intfID().has_value()) {
+      // Interface and v6 link local next hops resolve without a lookup
+      continue;
+    }
+    auto addr = nhop.addr();
+    if (addr.isV4()) {
+      v4NextHopToDependents_[addr.asV4()].insert(prefix);
+    } else {
+      v6NextHopToDependents_[addr.asV6()].insert(prefix);
+    }
+    nhopAddrs.push_back(std::move(addr));
+  }
+  if (!nhopAddrs.empty()) {
+    prefixToNextHops_.emplace(prefix, std::move(nhopAddrs));
+  }
+}
+
+void RouteDependencyIndex::removeDependencies(
+    const folly::CIDRNetwork& prefix) {
+  auto it = prefixToNextHops_.find(prefix);
+  if (it == prefixToNextHops_.end()) {
+    return;
+  }
+  auto removeDependent = [&prefix](auto& nhopToDependents, const auto& addr) {
+    auto dItr = nhopToDependents.find(addr);
+    if (dItr == nhopToDependents.end()) {
+      return;
+    }
+    dItr->second.erase(prefix);
+    if (dItr->second.empty()) {
+      nhopToDependents.erase(dItr);
+    }
+  };
+  for (const auto& addr : it->second) {
+    if (addr.isV4()) {
+      removeDependent(v4NextHopToDependents_, addr.asV4());
+    } else {
+      removeDependent(v6NextHopToDependents_, addr.asV6());
+    }
+  }
+  prefixToNextHops_.erase(it);
+}
+
+template <typename AddressT>
+void RouteDependencyIndex::collectDependents(
+    const std::map<AddressT, std::set<folly::CIDRNetwork>>& nhopToDependents,
+    const AddressT& network,
+    uint8_t mask,
+    std::vector<folly::CIDRNetwork>* toVisit,
+    std::set<folly::CIDRNetwork>* closure) const {
+  // Addresses within a prefix form a contiguous range in the ordered map,
+  // starting at the (masked) network address.
+  for (auto it = nhopToDependents.lower_bound(network);
+       it != nhopToDependents.end() && it->first.mask(mask) == network;
+       ++it) {
+    for (const auto& dependent : it->second) {
+      if (closure->insert(dependent).second) {
+        toVisit->push_back(dependent);
+      }
+    }
+  }
+}
+
+std::set<folly::CIDRNetwork> RouteDependencyIndex::dependencyClosure(
+    const std::set<folly::CIDRNetwork>& changed) const {
+  std::set<folly::CIDRNetwork> closure(changed.begin(), changed.end());
+  std::vector<folly::CIDRNetwork> toVisit(changed.begin(), changed.end());
+  while (!toVisit.empty()) {
+    auto prefix = toVisit.back();
+    toVisit.pop_back();
+    if (prefix.first.isV4()) {
+      collectDependents(
+          v4NextHopToDependents_,
+          prefix.first.asV4().mask(prefix.second),
+          prefix.second,
+          &toVisit,
+          &closure);
+    } else {
+      collectDependents(
+          v6NextHopToDependents_,
+          prefix.first.asV6().mask(prefix.second),
+          prefix.second,
+          &toVisit,
+          &closure);
+    }
+  }
+  return closure;
+}
+
+} // namespace facebook::fboss
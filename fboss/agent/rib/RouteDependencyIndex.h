@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/state/RouteNextHopEntry.h"
+
+#include <folly/IPAddress.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * RouteDependencyIndex is a reverse index from next hop address to the
+ * prefixes whose best entry points at that next hop. It lets RibRouteUpdater
+ * re-resolve only the routes affected by an update instead of walking the
+ * whole RIB.
+ *
+ * A route R depends on prefix P if one of R's (unresolved) next hops falls
+ * within P - i.e. P is a candidate for the longest match of that next hop.
+ * Whenever P is added, removed or its resolution changes, every route with a
+ * next hop inside P needs to be re-resolved, and so on recursively.
+ *
+ * The index is only meaningful if every RIB mutation goes through an updater
+ * maintaining it. Code paths that rebuild the RIB wholesale (deserialization,
+ * rollback) must invalidate() it, after which the next update falls back to
+ * full resolution and rebuilds the index.
+ */
+class RouteDependencyIndex {
+ public:
+  bool isValid() const {
+    return valid_;
+  }
+  void markValid() {
+    valid_ = true;
+  }
+  void invalidate() {
+    clear();
+    valid_ = false;
+  }
+  void clear();
+
+  /*
+   * Replace the set of next hops prefix depends on. Next hops with an
+   * interface are already resolved and hence never tracked.
+   */
+  void updateDependencies(
+      const folly::CIDRNetwork& prefix,
+      const RouteNextHopSet& nhops);
+  void removeDependencies(const folly::CIDRNetwork& prefix);
+
+  /*
+   * Return changed prefixes along with all prefixes that directly or
+   * recursively depend on them.
+   */
+  std::set<folly::CIDRNetwork> dependencyClosure(
+      const std::set<folly::CIDRNetwork>& changed) const;
+
+  size_t numPrefixes() const {
+    return prefixToNextHops_.size();
+  }
+
+ private:
+  template <typename AddressT>
+  void collectDependents(
+      const std::map<AddressT, std::set<folly::CIDRNetwork>>& nhopToDependents,
+      const AddressT& network,
+      uint8_t mask,
+      std::vector<folly::CIDRNetwork>* toVisit,
+      std::set<folly::CIDRNetwork>* closure) const;
+
+  std::map<folly::CIDRNetwork, std::vector<folly::IPAddress>>
+      prefixToNextHops_;
+  std::map<folly::IPAddressV4, std::set<folly::CIDRNetwork>>
+      v4NextHopToDependents_;
+  std::map<folly::IPAddressV6, std::set<folly::CIDRNetwork>>
+      v6NextHopToDependents_;
+  bool valid_{false};
+};
+
+} // namespace facebook::fboss
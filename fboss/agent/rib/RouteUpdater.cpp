@@ -41,8 +41,11 @@ static const auto kInterfaceRouteClientId = ClientID::INTERFACE_ROUTE;
 
 RibRouteUpdater::RibRouteUpdater(
     IPv4NetworkToRouteMap* v4Routes,
-    IPv6NetworkToRouteMap* v6Routes)
-    : v4Routes_(v4Routes), v6Routes_(v6Routes) {}
+    IPv6NetworkToRouteMap* v6Routes,
+    RouteDependencyIndex* dependencyIndex)
+    : v4Routes_(v4Routes),
+      v6Routes_(v6Routes),
+      dependencyIndex_(dependencyIndex) {}
 
 void RibRouteUpdater::update(
     const std::map<ClientID, std::vector<RouteEntry>>& toAdd,
@@ -104,14 +107,14 @@ void RibRouteUpdater::addOrReplaceRouteImpl(
     if (!existingRouteForClient || !(*existingRouteForClient == entry)) {
       route = writableRoute<AddressT>(it);
       route->update(clientID, entry);
+      recordRouteChange(prefix, route);
     }
     return;
   }
 
-  routes->insert(
-      prefix.network,
-      prefix.mask,
-      std::make_shared<Route<AddressT>>(prefix, clientID, entry));
+  auto route = std::make_shared<Route<AddressT>>(prefix, clientID, entry);
+  recordRouteChange(prefix, route);
+  routes->insert(prefix.network, prefix.mask, std::move(route));
 }
 
 void RibRouteUpdater::addOrReplaceRoute(
@@ -149,9 +152,11 @@ void RibRouteUpdater::delRouteImpl(
     // If this client's the only entry, simply erase
     XLOG(DBG3) << "Deleting route: " << route->str();
     routes->erase(it);
+    recordRouteChange(prefix, std::shared_ptr<Route<AddressT>>());
   } else {
     route = writableRoute<AddressT>(it);
     route->delEntryForClient(clientID);
+    recordRouteChange(prefix, route);
 
     XLOG(DBG3) << "Deleted next-hops for prefix " << prefix.str()
                << "from client " << folly::to<std::string>(clientID);
@@ -194,12 +199,16 @@ void RibRouteUpdater::removeAllRoutesFromClientImpl(
       if (route->hasNoEntry()) {
         // The nexthops we removed was the only one.  Delete the route->
         toDelete.push_back(it);
+      } else {
+        recordRouteChange(route->prefix(), route);
       }
     }
   }
 
   // Now, delete whatever routes went from 1 nexthoplist to 0.
   for (auto it : toDelete) {
+    recordRouteChange(
+        it->value()->prefix(), std::shared_ptr<Route<AddressT>>());
     routes->erase(it);
   }
 }
@@ -484,10 +493,11 @@ std::shared_ptr<Route<AddressT>> RibRouteUpdater::resolveOne(
   auto& route = ritr->value();
   // Starting resolution for this route, remove from resolution queue
   needsResolution_.erase(route.get());
+  ++numRoutesResolved_;
 
   bool hasToCpu{false};
   bool hasDrop{false};
-  RouteNextHopSet* fwd{nullptr};
+  const RouteNextHopEntry::NextHopSetPtr* fwd{nullptr};
 
   auto bestPair = route->getBestEntry();
   const auto clientId = bestPair.first;
@@ -499,7 +509,8 @@ std::shared_ptr<Route<AddressT>> RibRouteUpdater::resolveOne(
   } else if (action == RouteForwardAction::TO_CPU) {
     hasToCpu = true;
   } else {
-    auto fwItr = unresolvedToResolvedNhops_.find(bestEntry->getNextHopSet());
+    auto fwItr =
+        unresolvedToResolvedNhops_.find(bestEntry->getNextHopSetPtr());
     if (fwItr == unresolvedToResolvedNhops_.end()) {
       NextHopForwardInfos nhToFwds;
       // loop through all nexthops to find out the forward info
@@ -540,9 +551,10 @@ std::shared_ptr<Route<AddressT>> RibRouteUpdater::resolveOne(
       }
 
       fwItr = unresolvedToResolvedNhops_
-                  .insert(
-                      {bestEntry->getNextHopSet(),
-                       mergeForwardInfos(nhToFwds, route)})
+                  .emplace(
+                      bestEntry->getNextHopSetPtr(),
+                      RouteNextHopEntry::internNextHopSet(
+                          mergeForwardInfos(nhToFwds, route)))
                   .first;
     }
     fwd = &(fwItr->second);
@@ -566,8 +578,8 @@ std::shared_ptr<Route<AddressT>> RibRouteUpdater::resolveOne(
     XLOG(DBG3) << (updatedRoute->isResolved() ? "Resolved" : "Cannot resolve")
                << " route " << updatedRoute->str();
   };
-  if (fwd && !fwd->empty()) {
-    if (route->getForwardInfo().getNextHopSet() != *fwd ||
+  if (fwd && !(*fwd)->empty()) {
+    if (route->getForwardInfo().getNextHopSetPtr() != *fwd ||
         route->getForwardInfo().getCounterID() != counterID) {
       updateRoute(
           ritr,
@@ -615,6 +627,24 @@ std::shared_ptr<Route<AddressT>> RibRouteUpdater::writableRoute(
   return ritr->value();
 }
 
+template <typename AddressT>
+void RibRouteUpdater::recordRouteChange(
+    const Prefix<AddressT>& prefix,
+    const std::shared_ptr<Route<AddressT>>& route) {
+  if (!dependencyIndex_ || !dependencyIndex_->isValid()) {
+    // Full resolution will run, no need to track individual changes
+    return;
+  }
+  folly::CIDRNetwork network{prefix.network, prefix.mask};
+  touchedPrefixes_.insert(network);
+  if (route) {
+    dependencyIndex_->updateDependencies(
+        network, route->getBestEntry().second->getNextHopSet());
+  } else {
+    dependencyIndex_->removeDependencies(network);
+  }
+}
+
 template <typename AddressT>
 void RibRouteUpdater::resolve(NetworkToRouteMap<AddressT>* routes) {
   for (auto ritr = routes->begin(); ritr != routes->end(); ++ritr) {
@@ -630,7 +660,79 @@ bool RibRouteUpdater::needResolve(
   return needsResolution_.find(route.get()) != needsResolution_.end();
 }
 
+void RibRouteUpdater::resolveChanged() {
+  auto toResolve = dependencyIndex_->dependencyClosure(touchedPrefixes_);
+  std::vector<IPv4NetworkToRouteMap::Iterator> v4ToResolve;
+  std::vector<IPv6NetworkToRouteMap::Iterator> v6ToResolve;
+  changedPrefixes_ = RibChangedPrefixes();
+  auto markForResolution = [this](auto* routes, const auto& addr, auto mask) {
+    auto ritr = routes->exactMatch(addr, mask);
+    if (ritr != routes->end()) {
+      needsResolution_.insert(ritr->value().get());
+    }
+    return ritr;
+  };
+  // Mark all affected routes before resolving any of them, so that
+  // recursive resolution (getFwdInfoFromNhop) picks up the ones not
+  // yet visited.
+  for (const auto& prefix : toResolve) {
+    if (prefix.first.isV4()) {
+      changedPrefixes_->v4.push_back(
+          RoutePrefixV4{prefix.first.asV4(), prefix.second});
+      auto ritr =
+          markForResolution(v4Routes_, prefix.first.asV4(), prefix.second);
+      if (ritr != v4Routes_->end()) {
+        v4ToResolve.push_back(ritr);
+      }
+    } else {
+      changedPrefixes_->v6.push_back(
+          RoutePrefixV6{prefix.first.asV6(), prefix.second});
+      auto ritr =
+          markForResolution(v6Routes_, prefix.first.asV6(), prefix.second);
+      if (ritr != v6Routes_->end()) {
+        v6ToResolve.push_back(ritr);
+      }
+    }
+  }
+  for (auto ritr : v4ToResolve) {
+    if (needResolve(ritr->value())) {
+      resolveOne<IPAddressV4>(ritr);
+    }
+  }
+  for (auto ritr : v6ToResolve) {
+    if (needResolve(ritr->value())) {
+      resolveOne<IPAddressV6>(ritr);
+    }
+  }
+}
+
+void RibRouteUpdater::rebuildDependencyIndex() {
+  dependencyIndex_->clear();
+  auto addDependencies = [this](const auto& routes) {
+    for (const auto& ritr : *routes) {
+      const auto& route = ritr.value();
+      dependencyIndex_->updateDependencies(
+          {route->prefix().network, route->prefix().mask},
+          route->getBestEntry().second->getNextHopSet());
+    }
+  };
+  addDependencies(v4Routes_);
+  addDependencies(v6Routes_);
+  dependencyIndex_->markValid();
+}
+
 void RibRouteUpdater::updateDone() {
+  SCOPE_EXIT {
+    needsResolution_.clear();
+    unresolvedToResolvedNhops_.clear();
+    touchedPrefixes_.clear();
+  };
+  numRoutesResolved_ = 0;
+  changedPrefixes_.reset();
+  if (dependencyIndex_ && dependencyIndex_->isValid()) {
+    resolveChanged();
+    return;
+  }
   // Record all routes as needing resolution
   auto markForResolution = [this](const auto& routes) {
     std::for_each(routes->begin(), routes->end(), [this](const auto& route) {
@@ -639,12 +741,11 @@ void RibRouteUpdater::updateDone() {
   };
   markForResolution(v4Routes_);
   markForResolution(v6Routes_);
-  SCOPE_EXIT {
-    needsResolution_.clear();
-    unresolvedToResolvedNhops_.clear();
-  };
   resolve(v4Routes_);
   resolve(v6Routes_);
+  if (dependencyIndex_) {
+    rebuildDependencyIndex();
+  }
 }
 
 } // namespace facebook::fboss
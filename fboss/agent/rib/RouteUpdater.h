@@ -13,11 +13,22 @@
 #include "fboss/agent/types.h"
 
 #include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/RouteDependencyIndex.h"
 
 #include <folly/IPAddress.h>
 
 namespace facebook::fboss {
 
+/*
+ * Prefixes touched by a RIB update - added, deleted, modified or re-resolved.
+ * Lets FIB construction patch just these entries instead of rebuilding the
+ * FIB from the entire RIB.
+ */
+struct RibChangedPrefixes {
+  std::vector<RoutePrefixV4> v4;
+  std::vector<RoutePrefixV6> v6;
+};
+
 /**
  * Expected behavior of RibRouteUpdater::resolve():
  *
@@ -41,12 +52,18 @@ namespace facebook::fboss {
  *    only IP nexthops will be in the final ECMP group.
  * 5. If and only if TO_CPU is the only nexthop (directly or indirectly) of
  *    a route, TO_CPU action will be only path in the resolved ECMP group.
+ *
+ * If a RouteDependencyIndex is supplied (and valid), only the prefixes
+ * touched by the update and the routes which recursively depend on them are
+ * re-resolved. Otherwise the whole table is resolved, and the index (if any)
+ * is rebuilt from scratch.
  */
 class RibRouteUpdater {
  public:
   RibRouteUpdater(
       IPv4NetworkToRouteMap* v4Routes,
-      IPv6NetworkToRouteMap* v6Routes);
+      IPv6NetworkToRouteMap* v6Routes,
+      RouteDependencyIndex* dependencyIndex = nullptr);
 
   struct RouteEntry {
     folly::CIDRNetwork prefix;
@@ -74,6 +91,21 @@ class RibRouteUpdater {
       const std::map<ClientID, std::vector<folly::CIDRNetwork>>& toDel,
       const std::set<ClientID>& resetClientsRoutesFor);
 
+  /*
+   * Number of routes (re)resolved by the last update
+   */
+  size_t numRoutesResolved() const {
+    return numRoutesResolved_;
+  }
+  /*
+   * Prefixes whose resolved state may have changed in the last update.
+   * std::nullopt if the whole table was resolved, since every route may
+   * have changed then.
+   */
+  const std::optional<RibChangedPrefixes>& changedPrefixes() const {
+    return changedPrefixes_;
+  }
+
  private:
   void updateImpl(
       ClientID client,
@@ -110,8 +142,15 @@ class RibRouteUpdater {
       NetworkToRouteMap<AddressT>* routes,
       ClientID clientID);
 
+  template <typename AddressT>
+  void recordRouteChange(
+      const Prefix<AddressT>& prefix,
+      const std::shared_ptr<Route<AddressT>>& route);
+
   template <typename AddressT>
   void resolve(NetworkToRouteMap<AddressT>* routes);
+  void resolveChanged();
+  void rebuildDependencyIndex();
 
   template <typename AddressT>
   std::shared_ptr<Route<AddressT>> resolveOne(
@@ -138,13 +177,25 @@ class RibRouteUpdater {
 
   IPv4NetworkToRouteMap* v4Routes_{nullptr};
   IPv6NetworkToRouteMap* v6Routes_{nullptr};
+  RouteDependencyIndex* dependencyIndex_{nullptr};
+  /*
+   * Prefixes added, removed or modified in this update. Only tracked when
+   * a valid dependency index is present.
+   */
+  std::set<folly::CIDRNetwork> touchedPrefixes_;
+  std::optional<RibChangedPrefixes> changedPrefixes_;
+  size_t numRoutesResolved_{0};
   std::unordered_set<void*> needsResolution_;
   /*
    * Cache for next hop to FWD informatio. For our use case
    * its pretty common for the same next hops to repeat, so
-   * cache resolution
+   * cache resolution. Next hop sets being interned, this is keyed on
+   * their pointer, and the resolved sets are interned as well.
    */
-  std::map<RouteNextHopSet, RouteNextHopSet> unresolvedToResolvedNhops_;
+  std::unordered_map<
+      RouteNextHopEntry::NextHopSetPtr,
+      RouteNextHopEntry::NextHopSetPtr>
+      unresolvedToResolvedNhops_;
 };
 
 } // namespace facebook::fboss
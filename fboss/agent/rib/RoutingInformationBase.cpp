@@ -31,6 +31,13 @@
 
 #include <folly/ScopeGuard.h>
 #include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+
+DEFINE_bool(
+    rib_pipelined_fib_updates,
+    true,
+    "Resolve the next RIB update while the FIB update of the previous one is "
+    "being programmed");
 
 namespace facebook::fboss {
 
@@ -80,6 +87,23 @@ void reconstructRibFromFib(
             route->prefix().network, route->prefix().mask, route);
       });
 }
+
+/*
+ * Copy the RIB routes of the changed prefixes. Deleted prefixes have none,
+ * an incremental FIB update drops the prefixes it does not find.
+ */
+template <typename AddressT>
+void copyChangedRoutes(
+    const NetworkToRouteMap<AddressT>& rib,
+    const std::vector<RoutePrefix<AddressT>>& changedPrefixes,
+    NetworkToRouteMap<AddressT>* changedRoutes) {
+  for (const auto& prefix : changedPrefixes) {
+    auto ritr = rib.exactMatch(prefix.network, prefix.mask);
+    if (ritr != rib.end()) {
+      changedRoutes->insert(prefix.network, prefix.mask, ritr->value());
+    }
+  }
+}
 } // namespace
 
 template <typename RibUpdateFn>
@@ -90,6 +114,11 @@ void RibRouteTables::updateRib(RouterID vrf, const RibUpdateFn& updateRibFn) {
     throw FbossError("VRF ", vrf, " not configured");
   }
   auto& routeTable = it->second;
+  SCOPE_FAIL {
+    // Routes may have been partially updated, without their changed prefixes
+    // making it to the LPM snapshot. Rebuild everything on the next update.
+    routeTable.dependencyIndex.invalidate();
+  };
   updateRibFn(routeTable);
 }
 
@@ -131,11 +160,13 @@ void RibRouteTables::reconfigure(
 
         // ConfigApplier can be made independent of the VRF whose routes it
         // is processing by the use of boost::filter_iterator.
+        std::optional<RibChangedPrefixes> changedPrefixes;
         updateRib(vrf, [&](auto& routeTable) {
           ConfigApplier configApplier(
               vrf,
               &(routeTable.v4NetworkToRoute),
               &(routeTable.v6NetworkToRoute),
+              &(routeTable.dependencyIndex),
               folly::range(interfaceRoutes.cbegin(), interfaceRoutes.cend()),
               folly::range(
                   staticRoutesToCpu.cbegin(), staticRoutesToCpu.cend()),
@@ -147,9 +178,9 @@ void RibRouteTables::reconfigure(
               folly::range(
                   staticIp2MplsRoutes.cbegin(), staticIp2MplsRoutes.cend()));
           // Apply config
-          configApplier.apply();
+          changedPrefixes = configApplier.apply();
         });
-        updateFib(vrf, updateFibCallback, cookie);
+        updateFib(vrf, updateFibCallback, cookie, changedPrefixes);
       };
   // Because of this sequential loop over each VRF, config application scales
   // linearly with the number of VRFs. If FBOSS is run in a multi-VRF routing
@@ -171,6 +202,11 @@ void RibRouteTables::reconfigure(
     auto lockedRouteTables = synchronizedRouteTables_.wlock();
     *lockedRouteTables = constructRouteTables(
         lockedRouteTables, configRouterIDToInterfaceRoutes);
+    for (auto vrf : existingVrfs) {
+      if (lockedRouteTables->find(vrf) == lockedRouteTables->end()) {
+        lpmSnapshot_.removeVrf(vrf);
+      }
+    }
   }
   for (auto& vrf : getVrfList()) {
     const auto& interfaceRoutes = configRouterIDToInterfaceRoutes.at(vrf);
@@ -188,44 +224,182 @@ void RibRouteTables::update(
     folly::StringPiece updateType,
     const FibUpdateFunction& fibUpdateCallback,
     void* cookie) {
+  std::optional<RibChangedPrefixes> changedPrefixes;
   updateRib(routerID, [&](auto& routeTable) {
     RibRouteUpdater updater(
-        &(routeTable.v4NetworkToRoute), &(routeTable.v6NetworkToRoute));
+        &(routeTable.v4NetworkToRoute),
+        &(routeTable.v6NetworkToRoute),
+        &(routeTable.dependencyIndex));
     updater.update(clientID, toAddRoutes, toDelPrefixes, resetClientsRoutes);
+    changedPrefixes = updater.changedPrefixes();
   });
-  updateFib(routerID, fibUpdateCallback, cookie);
+  updateFib(routerID, fibUpdateCallback, cookie, changedPrefixes);
 }
 
 void RibRouteTables::updateFib(
     RouterID vrf,
     const FibUpdateFunction& fibUpdateCallback,
-    void* cookie) {
+    void* cookie,
+    const std::optional<RibChangedPrefixes>& changedPrefixes) {
   try {
     auto lockedRouteTables = synchronizedRouteTables_.rlock();
     auto& routeTable = lockedRouteTables->find(vrf)->second;
+    // Lookups see the RIB changes as soon as they are made, as they did
+    // when served from the route tables, not only once programmed
+    lpmSnapshot_.update(
+        vrf,
+        routeTable.v4NetworkToRoute,
+        routeTable.v6NetworkToRoute,
+        changedPrefixes ? &(*changedPrefixes) : nullptr);
+    try {
+      fibUpdateCallback(
+          vrf,
+          routeTable.v4NetworkToRoute,
+          routeTable.v6NetworkToRoute,
+          changedPrefixes ? &(*changedPrefixes) : nullptr,
+          cookie);
+    } catch (const FibContainerMissingError&) {
+      // These are all of the VRF's routes, build its FIB from them
+      fibUpdateCallback(
+          vrf,
+          routeTable.v4NetworkToRoute,
+          routeTable.v6NetworkToRoute,
+          nullptr,
+          cookie);
+    }
+  } catch (const FbossHwUpdateError& hwUpdateError) {
+    {
+      SCOPE_FAIL {
+        XLOG(FATAL) << " RIB Rollback failed, aborting program";
+      };
+      auto lockedRouteTables = synchronizedRouteTables_.wlock();
+      rollbackRib(
+          vrf,
+          lockedRouteTables->find(vrf)->second,
+          hwUpdateError.appliedState);
+    }
+    throw;
+  } catch (const std::exception&) {
+    // FIB may now be out of sync with RIB. Invalidating the dependency
+    // index forces the next update to resolve and rebuild FIB from scratch.
+    auto lockedRouteTables = synchronizedRouteTables_.wlock();
+    auto& routeTable = lockedRouteTables->find(vrf)->second;
+    routeTable.dependencyIndex.invalidate();
+    ++routeTable.rollbacks;
+    throw;
+  }
+}
+
+void RibRouteTables::rollbackRib(
+    RouterID vrf,
+    RouteTable& routeTable,
+    const std::shared_ptr<SwitchState>& appliedState) {
+  auto fib = appliedState->getFibs()->getFibContainer(vrf);
+  reconstructRibFromFib<folly::IPAddressV4>(
+      fib->getFibV4(), &routeTable.v4NetworkToRoute);
+  reconstructRibFromFib<folly::IPAddressV6>(
+      fib->getFibV6(), &routeTable.v6NetworkToRoute);
+  // Routes were replaced wholesale, next update rebuilds the index
+  routeTable.dependencyIndex.invalidate();
+  lpmSnapshot_.update(
+      vrf, routeTable.v4NetworkToRoute, routeTable.v6NetworkToRoute, nullptr);
+  ++routeTable.rollbacks;
+}
+
+RibRouteTables::PendingFibUpdate RibRouteTables::updateRibOnly(
+    RouterID routerID,
+    ClientID clientID,
+    const std::vector<RibRouteUpdater::RouteEntry>& toAddRoutes,
+    const std::vector<folly::CIDRNetwork>& toDelPrefixes,
+    bool resetClientsRoutes) {
+  PendingFibUpdate fibUpdate;
+  fibUpdate.vrf = routerID;
+  updateRib(routerID, [&](auto& routeTable) {
+    RibRouteUpdater updater(
+        &(routeTable.v4NetworkToRoute),
+        &(routeTable.v6NetworkToRoute),
+        &(routeTable.dependencyIndex));
+    updater.update(clientID, toAddRoutes, toDelPrefixes, resetClientsRoutes);
+    fibUpdate.changedPrefixes = updater.changedPrefixes();
+    fibUpdate.ribRollbacks = routeTable.rollbacks;
+    if (!fibUpdate.changedPrefixes) {
+      // Rebuilt from the RIB itself, which also republishes the LPM snapshot
+      return;
+    }
+    copyChangedRoutes(
+        routeTable.v4NetworkToRoute,
+        fibUpdate.changedPrefixes->v4,
+        &fibUpdate.v4NetworkToRoute);
+    copyChangedRoutes(
+        routeTable.v6NetworkToRoute,
+        fibUpdate.changedPrefixes->v6,
+        &fibUpdate.v6NetworkToRoute);
+    lpmSnapshot_.update(
+        routerID,
+        routeTable.v4NetworkToRoute,
+        routeTable.v6NetworkToRoute,
+        &(*fibUpdate.changedPrefixes));
+  });
+  return fibUpdate;
+}
+
+void RibRouteTables::programFibUpdate(
+    const PendingFibUpdate& fibUpdate,
+    const FibUpdateFunction& fibUpdateCallback,
+    void* cookie) {
+  if (!fibUpdate.changedPrefixes) {
+    updateFib(fibUpdate.vrf, fibUpdateCallback, cookie, std::nullopt);
+    return;
+  }
+  auto vrf = fibUpdate.vrf;
+  try {
     fibUpdateCallback(
-        vrf, routeTable.v4NetworkToRoute, routeTable.v6NetworkToRoute, cookie);
+        vrf,
+        fibUpdate.v4NetworkToRoute,
+        fibUpdate.v6NetworkToRoute,
+        &(*fibUpdate.changedPrefixes),
+        cookie);
+  } catch (const FibContainerMissingError&) {
+    // Only the changed routes were handed in, build the FIB from the whole
+    // RIB instead. Anything the RIB took on since is programmed along.
+    updateFib(vrf, fibUpdateCallback, cookie, std::nullopt);
   } catch (const FbossHwUpdateError& hwUpdateError) {
     {
       SCOPE_FAIL {
         XLOG(FATAL) << " RIB Rollback failed, aborting program";
       };
-      auto fib = hwUpdateError.appliedState->getFibs()->getFibContainer(vrf);
+      // Also drops whatever the RIB took on since this update
       auto lockedRouteTables = synchronizedRouteTables_.wlock();
-      auto& routeTable = lockedRouteTables->find(vrf)->second;
-      reconstructRibFromFib<folly::IPAddressV4>(
-          fib->getFibV4(), &routeTable.v4NetworkToRoute);
-      reconstructRibFromFib<folly::IPAddressV6>(
-          fib->getFibV6(), &routeTable.v6NetworkToRoute);
+      rollbackRib(
+          vrf,
+          lockedRouteTables->find(vrf)->second,
+          hwUpdateError.appliedState);
     }
     throw;
+  } catch (const std::exception&) {
+    auto lockedRouteTables = synchronizedRouteTables_.wlock();
+    auto& routeTable = lockedRouteTables->find(vrf)->second;
+    routeTable.dependencyIndex.invalidate();
+    ++routeTable.rollbacks;
+    throw;
   }
 }
 
+uint64_t RibRouteTables::ribRollbacks(RouterID vrf) const {
+  auto lockedRouteTables = synchronizedRouteTables_.rlock();
+  auto routeTable = lockedRouteTables->find(vrf);
+  return routeTable == lockedRouteTables->end() ? 0
+                                                : routeTable->second.rollbacks;
+}
+
 void RibRouteTables::ensureVrf(RouterID rid) {
   auto lockedRouteTables = synchronizedRouteTables_.wlock();
   if (lockedRouteTables->find(rid) == lockedRouteTables->end()) {
-    lockedRouteTables->insert(std::make_pair(rid, RouteTable()));
+    const auto& routeTable =
+        lockedRouteTables->insert(std::make_pair(rid, RouteTable()))
+            .first->second;
+    lpmSnapshot_.update(
+        rid, routeTable.v4NetworkToRoute, routeTable.v6NetworkToRoute, nullptr);
   }
 }
 
@@ -244,44 +418,48 @@ void RibRouteTables::setClassID(
     FibUpdateFunction fibUpdateCallback,
     std::optional<cfg::AclLookupClass> classId,
     void* cookie) {
+  std::optional<RibChangedPrefixes> changedPrefixes;
   updateRib(rid, [&](auto& routeTable) {
+    RibChangedPrefixes classIdChanges;
     // Update rib
     auto updateRoute = [&classId](auto& rib, auto ip, uint8_t mask) {
       auto ritr = rib.exactMatch(ip, mask);
       if (ritr == rib.end() || ritr->value()->getClassID() == classId) {
-        return;
+        return false;
       }
       ritr->value() = ritr->value()->clone();
       ritr->value()->updateClassID(classId);
       ritr->value()->publish();
+      return true;
     };
     auto& v4Rib = routeTable.v4NetworkToRoute;
     auto& v6Rib = routeTable.v6NetworkToRoute;
     for (auto& prefix : prefixes) {
       if (prefix.first.isV4()) {
-        updateRoute(v4Rib, prefix.first.asV4(), prefix.second);
+        if (updateRoute(v4Rib, prefix.first.asV4(), prefix.second)) {
+          classIdChanges.v4.push_back(
+              RoutePrefixV4{prefix.first.asV4(), prefix.second});
+        }
       } else {
-        updateRoute(v6Rib, prefix.first.asV6(), prefix.second);
+        if (updateRoute(v6Rib, prefix.first.asV6(), prefix.second)) {
+          classIdChanges.v6.push_back(
+              RoutePrefixV6{prefix.first.asV6(), prefix.second});
+        }
       }
     }
+    if (routeTable.dependencyIndex.isValid()) {
+      // Otherwise FIB may be out of sync with RIB, rebuild it from scratch
+      changedPrefixes = std::move(classIdChanges);
+    }
   });
-  updateFib(rid, fibUpdateCallback, cookie);
+  updateFib(rid, fibUpdateCallback, cookie, changedPrefixes);
 }
 
 template <typename AddressT>
 std::shared_ptr<Route<AddressT>> RibRouteTables::longestMatch(
     const AddressT& address,
     RouterID vrf) const {
-  StopWatch lookupTimer(std::nullopt, false);
-  auto ribTables = synchronizedRouteTables_.rlock();
-  auto vrfIt = ribTables->find(vrf);
-  auto rt =
-      vrfIt == ribTables->end() ? nullptr : vrfIt->second.longestMatch(address);
-  if (lookupTimer.msecsElapsed().count() > 1000) {
-    XLOG(WARNING) << " Lookup for : " << address
-                  << " took: " << lookupTimer.msecsElapsed().count() << " ms ";
-  }
-  return rt;
+  return lpmSnapshot_.longestMatch(address, vrf);
 }
 
 RibRouteTables::RouterIDToRouteTable RibRouteTables::constructRouteTables(
@@ -318,6 +496,10 @@ RoutingInformationBase::RoutingInformationBase() {
     initThread("ribUpdateThread");
     ribUpdateEventBase_.loopForever();
   });
+  fibUpdateThread_ = std::make_unique<std::thread>([this] {
+    initThread("ribFibUpdateThread");
+    fibUpdateEventBase_.loopForever();
+  });
 }
 
 RoutingInformationBase::~RoutingInformationBase() {
@@ -331,6 +513,13 @@ void RoutingInformationBase::stop() {
     ribUpdateThread_->join();
     ribUpdateThread_.reset();
   }
+  // After the RIB update thread, which may still be queueing FIB updates
+  if (fibUpdateThread_) {
+    fibUpdateEventBase_.runInEventBaseThread(
+        [this] { fibUpdateEventBase_.terminateLoopSoon(); });
+    fibUpdateThread_->join();
+    fibUpdateThread_.reset();
+  }
 }
 
 void RoutingInformationBase::ensureRunning() const {
@@ -350,6 +539,7 @@ void RoutingInformationBase::reconfigure(
     void* cookie) {
   ensureRunning();
   auto updateFn = [&] {
+    waitForFibUpdate();
     ribTables_.reconfigure(
         configRouterIDToInterfaceRoutes,
         staticRoutesWithNextHops,
@@ -378,6 +568,7 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::update(
   std::shared_ptr<SwitchState> appliedState;
   Timer updateTimer(&duration);
   std::exception_ptr updateException;
+  auto fibUpdated = folly::makeSemiFuture();
   auto updateFn = [&]() {
     std::vector<RibRouteUpdater::RouteEntry> toAddRoutes;
     toAddRoutes.reserve(toAdd.size());
@@ -423,16 +614,28 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::update(
             toDelPrefixes.push_back({network, mask});
           });
 
-      ribTables_.update(
-          routerID,
-          clientID,
-          adminDistanceFromClientID,
-          toAddRoutes,
-          toDelPrefixes,
-          resetClientsRoutes,
-          updateType,
-          fibUpdateCallback,
-          cookie);
+      if (FLAGS_rib_pipelined_fib_updates) {
+        fibUpdated = pipelinedUpdate(
+            routerID,
+            clientID,
+            toAddRoutes,
+            toDelPrefixes,
+            resetClientsRoutes,
+            fibUpdateCallback,
+            cookie);
+      } else {
+        waitForFibUpdate();
+        ribTables_.update(
+            routerID,
+            clientID,
+            adminDistanceFromClientID,
+            toAddRoutes,
+            toDelPrefixes,
+            resetClientsRoutes,
+            updateType,
+            fibUpdateCallback,
+            cookie);
+      }
     } catch (const std::exception& e) {
       updateException = std::current_exception();
     }
@@ -441,10 +644,59 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::update(
   if (updateException) {
     std::rethrow_exception(updateException);
   }
+  // The RIB update thread may already be onto the next update
+  std::move(fibUpdated).get();
   stats.duration = duration;
   return stats;
 }
 
+folly::SemiFuture<folly::Unit> RoutingInformationBase::pipelinedUpdate(
+    RouterID routerID,
+    ClientID clientID,
+    const std::vector<RibRouteUpdater::RouteEntry>& toAddRoutes,
+    const std::vector<folly::CIDRNetwork>& toDelPrefixes,
+    bool resetClientsRoutes,
+    const FibUpdateFunction& fibUpdateCallback,
+    void* cookie) {
+  auto fibUpdate = ribTables_.updateRibOnly(
+      routerID, clientID, toAddRoutes, toDelPrefixes, resetClientsRoutes);
+  // FIB updates must be programmed in order
+  waitForFibUpdate();
+  if (ribTables_.ribRollbacks(routerID) != fibUpdate.ribRollbacks) {
+    // A previous FIB update of this VRF failed and its routes were rolled
+    // back to the FIB, dropping our changes along with its own
+    fibUpdate = ribTables_.updateRibOnly(
+        routerID, clientID, toAddRoutes, toDelPrefixes, resetClientsRoutes);
+  }
+  if (!fibUpdate.changedPrefixes) {
+    // Full FIB rebuilds read the live RIB, program them right here
+    return folly::makeSemiFutureWith([&] {
+      ribTables_.programFibUpdate(fibUpdate, fibUpdateCallback, cookie);
+    });
+  }
+  auto programmed = std::make_shared<folly::SharedPromise<folly::Unit>>();
+  inFlightFibUpdate_ = programmed;
+  auto pendingFibUpdate =
+      std::make_shared<RibRouteTables::PendingFibUpdate>(std::move(fibUpdate));
+  fibUpdateEventBase_.runInEventBaseThread(
+      [this, programmed, pendingFibUpdate, fibUpdateCallback, cookie] {
+        programmed->setWith([&] {
+          ribTables_.programFibUpdate(
+              *pendingFibUpdate, fibUpdateCallback, cookie);
+        });
+      });
+  return programmed->getSemiFuture();
+}
+
+void RoutingInformationBase::waitForFibUpdate() {
+  if (!inFlightFibUpdate_) {
+    return;
+  }
+  // Errors are for the update's caller to handle
+  inFlightFibUpdate_->getSemiFuture().wait();
+  inFlightFibUpdate_.reset();
+}
+
 void RoutingInformationBase::setClassIDImpl(
     RouterID rid,
     const std::vector<folly::CIDRNetwork>& prefixes,
@@ -454,6 +706,7 @@ void RoutingInformationBase::setClassIDImpl(
     bool async) {
   ensureRunning();
   auto updateFn = [=]() {
+    waitForFibUpdate();
     ribTables_.setClassID(rid, prefixes, fibUpdateCallback, classId, cookie);
   };
   if (async) {
@@ -531,6 +784,10 @@ RibRouteTables RibRouteTables::fromFollyDynamic(
       importRoutes(fib->getFibV4(), &routeTables.v4NetworkToRoute);
     }
   }
+  for (const auto& [vrf, routeTable] : *lockedRouteTables) {
+    rib.lpmSnapshot_.update(
+        vrf, routeTable.v4NetworkToRoute, routeTable.v6NetworkToRoute, nullptr);
+  }
   return rib;
 }
 
@@ -11,11 +11,15 @@
 
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/if/gen-cpp2/FbossCtrl.h"
+#include "fboss/agent/rib/LpmSnapshot.h"
 #include "fboss/agent/rib/NetworkToRouteMap.h"
 #include "fboss/agent/rib/RouteUpdater.h"
 #include "fboss/agent/types.h"
 
 #include <folly/Synchronized.h>
+#include <folly/futures/Future.h>
+#include <folly/futures/SharedPromise.h>
+#include <folly/io/async/EventBase.h>
 
 #include <functional>
 #include <memory>
@@ -26,10 +30,20 @@ namespace facebook::fboss {
 class SwitchState;
 class ForwardingInformationBaseMap;
 
+/*
+ * changedPrefixes, if non null, is the set of prefixes whose RIB entries
+ * may have changed since the last FIB update for this VRF. A null value
+ * means any prefix may have changed.
+ *
+ * With changedPrefixes, the route maps are only guaranteed to hold the
+ * routes of those prefixes: pipelined updates hand over just these, as the
+ * RIB may already have moved on to the next update.
+ */
 using FibUpdateFunction = std::function<std::shared_ptr<SwitchState>(
     RouterID vrf,
     const IPv4NetworkToRouteMap& v4NetworkToRoute,
     const IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const RibChangedPrefixes* changedPrefixes,
     void* cookie)>;
 
 /*
@@ -37,6 +51,10 @@ using FibUpdateFunction = std::function<std::shared_ptr<SwitchState>(
  * structures and programming them down to the FIB. Its designed to abstract
  * away granular locking logic over RIB data structures to allow for fast
  * lookups that are not encumbered by long HW write cycles
+ *
+ * Longest match lookups don't touch the route tables at all: they are served
+ * from an LPM snapshot republished ahead of every FIB update, so that slow
+ * path lookups never contend with RIB writers.
  */
 class RibRouteTables {
  public:
@@ -51,6 +69,41 @@ class RibRouteTables {
       const FibUpdateFunction& fibUpdateCallback,
       void* cookie);
 
+  /*
+   * A FIB update which no longer refers to the RIB route tables, so that it
+   * can be programmed while the RIB moves on. It only holds the routes of
+   * the changed prefixes, all an incremental FIB update looks at.
+   */
+  struct PendingFibUpdate {
+    RouterID vrf;
+    IPv4NetworkToRouteMap v4NetworkToRoute;
+    IPv6NetworkToRouteMap v6NetworkToRoute;
+    // Null if the FIB must be rebuilt from the whole RIB, see updateFib()
+    std::optional<RibChangedPrefixes> changedPrefixes;
+    // Number of rollbacks of the VRF's routes when the RIB was updated
+    uint64_t ribRollbacks{0};
+  };
+
+  /*
+   * update() split in two for pipelining. updateRibOnly() applies the route
+   * changes to the RIB and returns the FIB update to program with
+   * programFibUpdate(), which rolls the RIB back on failure just like
+   * update() does. A rollback also drops the changes made to the VRF's
+   * routes after the failed update: those whose ribRollbacks is not the
+   * VRF's current ribRollbacks() anymore must be redone.
+   */
+  PendingFibUpdate updateRibOnly(
+      RouterID routerID,
+      ClientID clientID,
+      const std::vector<RibRouteUpdater::RouteEntry>& toAddRoutes,
+      const std::vector<folly::CIDRNetwork>& toDelPrefixes,
+      bool resetClientsRoutes);
+  void programFibUpdate(
+      const PendingFibUpdate& fibUpdate,
+      const FibUpdateFunction& fibUpdateCallback,
+      void* cookie);
+  uint64_t ribRollbacks(RouterID vrf) const;
+
   void setClassID(
       RouterID rid,
       const std::vector<folly::CIDRNetwork>& prefixes,
@@ -107,6 +160,16 @@ class RibRouteTables {
   struct RouteTable {
     IPv4NetworkToRouteMap v4NetworkToRoute;
     IPv6NetworkToRouteMap v6NetworkToRoute;
+    /*
+     * Next hop -> dependent prefixes, used for incremental route
+     * resolution. Not part of the table's identity, hence not compared.
+     */
+    RouteDependencyIndex dependencyIndex;
+    /*
+     * Bumped whenever a failed FIB update leaves the routes rebuilt or the
+     * dependency index invalidated. Not part of the table's identity either.
+     */
+    uint64_t rollbacks{0};
 
     bool operator==(const RouteTable& other) const {
       return v4NetworkToRoute == other.v4NetworkToRoute &&
@@ -115,24 +178,20 @@ class RibRouteTables {
     bool operator!=(const RouteTable& other) const {
       return !(*this == other);
     }
-    std::shared_ptr<Route<folly::IPAddressV4>> longestMatch(
-        const folly::IPAddressV4& addr) const {
-      auto it = v4NetworkToRoute.longestMatch(addr, addr.bitCount());
-      return it == v4NetworkToRoute.end() ? nullptr : it->value();
-    }
-    std::shared_ptr<Route<folly::IPAddressV6>> longestMatch(
-        const folly::IPAddressV6& addr) const {
-      auto it = v6NetworkToRoute.longestMatch(addr, addr.bitCount());
-      return it == v6NetworkToRoute.end() ? nullptr : it->value();
-    }
   };
 
   void updateFib(
       RouterID vrf,
       const FibUpdateFunction& fibUpdateCallback,
-      void* cookie);
+      void* cookie,
+      const std::optional<RibChangedPrefixes>& changedPrefixes);
   template <typename RibUpdateFn>
   void updateRib(RouterID vrf, const RibUpdateFn& updateRib);
+  // Rebuild the VRF's RIB from its applied FIB, with the RIB write locked
+  void rollbackRib(
+      RouterID vrf,
+      RouteTable& routeTable,
+      const std::shared_ptr<SwitchState>& appliedState);
   /*
    * Currently, route updates to separate VRFs are made to be sequential. In the
    * event FBOSS has to operate in a routing architecture with numerous VRFs,
@@ -149,6 +208,7 @@ class RibRouteTables {
           configRouterIDToInterfaceRoutes) const;
 
   SynchronizedRouteTables synchronizedRouteTables_;
+  RibLpmSnapshot lpmSnapshot_;
 };
 
 class RoutingInformationBase {
@@ -172,6 +232,12 @@ class RoutingInformationBase {
    * 1. Injects and removes routes in `toAdd` and `toDelete`, respectively.
    * 2. Triggers recursive (IP) resolution.
    * 3. Updates the FIB synchronously.
+   * With --rib_pipelined_fib_updates, the FIB update of step 3 is handed to
+   * a separate thread, so that the RIB can take on the next update (steps
+   * 1 and 2) while this one is being programmed. update() still returns
+   * only once its own FIB update is done, and rethrows its errors. Should
+   * programming fail, the RIB is rolled back as before and the update that
+   * was applied meanwhile is redone on top of it.
    * NOTE : there is no order guarantee b/w toAdd and toDelete. We may do
    * either first. This does not matter for non overlapping add/del, but
    * can be meaningful for overlaps. If so, the caller is responsible for
@@ -268,7 +334,8 @@ class RoutingInformationBase {
 
   void waitForRibUpdates() {
     ensureRunning();
-    ribUpdateEventBase_.runInEventBaseThreadAndWait([] { return; });
+    ribUpdateEventBase_.runInEventBaseThreadAndWait(
+        [this] { waitForFibUpdate(); });
   }
 
   void stop();
@@ -289,9 +356,28 @@ class RoutingInformationBase {
       std::optional<cfg::AclLookupClass> classId,
       void* cookie,
       bool async);
+  /*
+   * Run on the RIB update thread. Updates the RIB and queues its FIB update
+   * behind the one in flight, returns once the latter is programmed.
+   */
+  folly::SemiFuture<folly::Unit> pipelinedUpdate(
+      RouterID routerID,
+      ClientID clientID,
+      const std::vector<RibRouteUpdater::RouteEntry>& toAddRoutes,
+      const std::vector<folly::CIDRNetwork>& toDelPrefixes,
+      bool resetClientsRoutes,
+      const FibUpdateFunction& fibUpdateCallback,
+      void* cookie);
+  // Run on the RIB update thread, before touching the RIB out of order
+  void waitForFibUpdate();
 
   std::unique_ptr<std::thread> ribUpdateThread_;
   folly::EventBase ribUpdateEventBase_;
+  // Programs the FIB updates of pipelined RIB updates
+  std::unique_ptr<std::thread> fibUpdateThread_;
+  folly::EventBase fibUpdateEventBase_;
+  // FIB update being programmed, only accessed on the RIB update thread
+  std::shared_ptr<folly::SharedPromise<folly::Unit>> inFlightFibUpdate_;
   RibRouteTables ribTables_;
 };
 
@@ -14,6 +14,7 @@
 #include "fboss/agent/if/gen-cpp2/ctrl_types.h"
 #include "fboss/agent/rib/ForwardingInformationBaseUpdater.h"
 #include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/RouteUpdater.h"
 
 #include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
 #include "fboss/agent/state/ForwardingInformationBase.h"
@@ -411,3 +412,101 @@ TEST(ForwardingInformationBaseUpdater, Deduplication) {
   ASSERT_TRUE(route3);
   EXPECT_NE(route, route3);
 }
+
+TEST(ForwardingInformationBaseUpdater, IncrementalMatchesFullRebuild) {
+  const RouterID vrfZero{0};
+  IPv4NetworkToRouteMap v4Rib;
+  IPv6NetworkToRouteMap v6Rib;
+  RouteDependencyIndex dependencyIndex;
+  RibRouteUpdater ribUpdater(&v4Rib, &v6Rib, &dependencyIndex);
+
+  auto fibContainer =
+      std::make_shared<ForwardingInformationBaseContainer>(vrfZero);
+  fibContainer->writableFields()->fibV4 =
+      std::make_shared<ForwardingInformationBaseV4>();
+  fibContainer->writableFields()->fibV6 =
+      std::make_shared<ForwardingInformationBaseV6>();
+  auto fibMap = std::make_shared<ForwardingInformationBaseMap>();
+  fibMap->addNode(fibContainer);
+  auto state = std::make_shared<SwitchState>();
+  state->resetForwardingInformationBases(fibMap);
+  state->publish();
+
+  auto expectFibsMatch = [](const auto& fibA, const auto& fibB) {
+    EXPECT_EQ(fibA->size(), fibB->size());
+    for (const auto& routeA : *fibA) {
+      auto routeB = fibB->exactMatch(routeA->prefix());
+      ASSERT_NE(nullptr, routeB);
+      EXPECT_TRUE(routeA->isSame(routeB.get()));
+    }
+  };
+  auto makeNextHops = [](const std::string& ip) {
+    RouteNextHopSet nhops;
+    nhops.emplace(UnresolvedNextHop(folly::IPAddress(ip), ECMP_WEIGHT));
+    return RouteNextHopEntry(nhops, kDefaultAdminDistance);
+  };
+  auto update = [&](ClientID client,
+                    const std::vector<RibRouteUpdater::RouteEntry>& toAdd,
+                    const std::vector<folly::CIDRNetwork>& toDel) {
+    ribUpdater.update(client, toAdd, toDel, false);
+    const auto& changedPrefixes = ribUpdater.changedPrefixes();
+    auto incrementalState =
+        ForwardingInformationBaseUpdater(
+            vrfZero,
+            v4Rib,
+            v6Rib,
+            changedPrefixes ? &(*changedPrefixes) : nullptr)(state);
+    auto fullState =
+        ForwardingInformationBaseUpdater(vrfZero, v4Rib, v6Rib)(state);
+    auto incrementalFibs =
+        incrementalState->getFibs()->getFibContainer(vrfZero);
+    auto fullFibs = fullState->getFibs()->getFibContainer(vrfZero);
+    expectFibsMatch(incrementalFibs->getFibV4(), fullFibs->getFibV4());
+    expectFibsMatch(incrementalFibs->getFibV6(), fullFibs->getFibV6());
+    state = incrementalState;
+    state->publish();
+  };
+
+  update(
+      ClientID::INTERFACE_ROUTE,
+      {{{folly::IPAddress("1.1.1.0"), 24},
+        RouteNextHopEntry(
+            ResolvedNextHop(
+                folly::IPAddress("1.1.1.1"),
+                InterfaceID(1),
+                UCMP_DEFAULT_WEIGHT),
+            AdminDistance::DIRECTLY_CONNECTED)},
+       {{folly::IPAddress("1::"), 64},
+        RouteNextHopEntry(
+            ResolvedNextHop(
+                folly::IPAddress("1::1"), InterfaceID(1), UCMP_DEFAULT_WEIGHT),
+            AdminDistance::DIRECTLY_CONNECTED)}},
+      {});
+  EXPECT_FALSE(ribUpdater.changedPrefixes().has_value());
+  // Added routes
+  update(
+      ClientID::BGPD,
+      {{{folly::IPAddress("10.0.0.0"), 8}, makeNextHops("1.1.1.10")},
+       {{folly::IPAddress("20.0.0.0"), 8}, makeNextHops("10.0.0.1")},
+       {{folly::IPAddress("30.0.0.0"), 8}, makeNextHops("40.0.0.1")},
+       {{folly::IPAddress("10::"), 64}, makeNextHops("1::10")}},
+      {});
+  ASSERT_TRUE(ribUpdater.changedPrefixes().has_value());
+  EXPECT_EQ(4, ribUpdater.changedPrefixes()->v4.size());
+  EXPECT_EQ(1, ribUpdater.changedPrefixes()->v6.size());
+  // Changed route, with a recursively dependent route
+  update(
+      ClientID::BGPD,
+      {{{folly::IPAddress("10.0.0.0"), 8}, makeNextHops("1.1.1.20")}},
+      {});
+  // Removed route, with a dependent route becoming unresolved
+  update(ClientID::BGPD, {}, {{folly::IPAddress("10.0.0.0"), 8}});
+  EXPECT_EQ(
+      nullptr,
+      state->getFibs()->getFibContainer(vrfZero)->getFibV4()->exactMatch(
+          RoutePrefixV4{folly::IPAddressV4("20.0.0.0"), 8}));
+  // Untouched route is shared with the previous FIB
+  auto v6Fib = state->getFibs()->getFibContainer(vrfZero)->getFibV6();
+  update(ClientID::BGPD, {}, {{folly::IPAddress("30.0.0.0"), 8}});
+  EXPECT_EQ(v6Fib, state->getFibs()->getFibContainer(vrfZero)->getFibV6());
+}
@@ -0,0 +1,173 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/rib/LpmSnapshot.h"
+#include "fboss/agent/rib/NetworkToRouteMap.h"
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddressV4.h>
+#include <folly/IPAddressV6.h>
+#include <folly/init/Init.h>
+
+#include <array>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+using namespace facebook::fboss;
+
+DEFINE_int32(lpm_routes_v4, 500000, "Number of v4 routes to look up into");
+DEFINE_int32(lpm_routes_v6, 100000, "Number of v6 routes to look up into");
+DEFINE_int32(lpm_lookups, 1000000, "Number of random addresses looked up");
+
+namespace {
+
+template <typename AddrT>
+AddrT randomAddress(std::mt19937& gen) {
+  std::array<uint8_t, AddrT::byteCount()> bytes;
+  for (auto& byte : bytes) {
+    byte = gen();
+  }
+  return AddrT::fromBinary(folly::ByteRange(bytes.data(), bytes.size()));
+}
+
+/*
+ * Roughly the shape of a full table: mostly /24s (v4) and /48s (v6) with a
+ * tail of shorter and host routes.
+ */
+uint8_t randomMask(std::mt19937& gen, uint8_t bitCount) {
+  auto pick = gen() % 10;
+  if (pick < 6) {
+    return bitCount == 32 ? 24 : 48;
+  }
+  if (pick < 9) {
+    return 8 + gen() % (bitCount == 32 ? 16 : 40);
+  }
+  return bitCount;
+}
+
+template <typename AddrT>
+struct LpmBenchmarkData {
+  explicit LpmBenchmarkData(size_t numRoutes) {
+    std::mt19937 gen(numRoutes);
+    for (size_t i = 0; i < numRoutes; ++i) {
+      auto mask = randomMask(gen, AddrT::bitCount());
+      RoutePrefix<AddrT> prefix{randomAddress<AddrT>(gen).mask(mask), mask};
+      routes.insert(
+          prefix.network, prefix.mask, std::make_shared<Route<AddrT>>(prefix));
+    }
+    table = std::make_unique<LpmTable<AddrT>>(routes);
+    for (auto i = 0; i < FLAGS_lpm_lookups; ++i) {
+      addresses.push_back(randomAddress<AddrT>(gen));
+    }
+  }
+
+  NetworkToRouteMap<AddrT> routes;
+  std::unique_ptr<LpmTable<AddrT>> table;
+  std::vector<AddrT> addresses;
+};
+
+template <typename AddrT>
+const LpmBenchmarkData<AddrT>& getData() {
+  static const LpmBenchmarkData<AddrT> data(
+      std::is_same_v<AddrT, folly::IPAddressV4> ? FLAGS_lpm_routes_v4
+                                                : FLAGS_lpm_routes_v6);
+  return data;
+}
+
+template <typename AddrT>
+void radixTreeLookups() {
+  const auto& data = getData<AddrT>();
+  for (const auto& addr : data.addresses) {
+    auto it = data.routes.longestMatch(addr, addr.bitCount());
+    folly::doNotOptimizeAway(it);
+  }
+}
+
+template <typename AddrT>
+void lpmTableLookups() {
+  const auto& data = getData<AddrT>();
+  for (const auto& addr : data.addresses) {
+    folly::doNotOptimizeAway(data.table->longestMatch(addr));
+  }
+}
+} // namespace
+
+BENCHMARK(RadixTreeLongestMatchV4) {
+  radixTreeLookups<folly::IPAddressV4>();
+}
+
+BENCHMARK_RELATIVE(LpmTableLongestMatchV4) {
+  lpmTableLookups<folly::IPAddressV4>();
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(RadixTreeLongestMatchV6) {
+  radixTreeLookups<folly::IPAddressV6>();
+}
+
+BENCHMARK_RELATIVE(LpmTableLongestMatchV6) {
+  lpmTableLookups<folly::IPAddressV6>();
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(LpmTableBuildV4) {
+  folly::BenchmarkSuspender suspender;
+  const auto& data = getData<folly::IPAddressV4>();
+  suspender.dismiss();
+  LpmTable<folly::IPAddressV4> table(data.routes);
+  folly::doNotOptimizeAway(table.numNodes());
+}
+
+BENCHMARK(LpmTableBuildV6) {
+  folly::BenchmarkSuspender suspender;
+  const auto& data = getData<folly::IPAddressV6>();
+  suspender.dismiss();
+  LpmTable<folly::IPAddressV6> table(data.routes);
+  folly::doNotOptimizeAway(table.numNodes());
+}
+
+/*
+ * Patch the table with a typical RIB update worth of changed prefixes, as
+ * done under the RIB lock on every update, instead of rebuilding it.
+ */
+template <typename AddrT>
+void lpmTablePatch(size_t numChanged) {
+  folly::BenchmarkSuspender suspender;
+  const auto& data = getData<AddrT>();
+  std::vector<RoutePrefix<AddrT>> changed;
+  for (const auto& routeNode : data.routes) {
+    if (changed.size() == numChanged) {
+      break;
+    }
+    changed.push_back(routeNode.value()->prefix());
+  }
+  suspender.dismiss();
+  LpmTable<AddrT> table(*data.table, data.routes, changed);
+  folly::doNotOptimizeAway(table.numNodes());
+}
+
+BENCHMARK(LpmTablePatch100V4) {
+  lpmTablePatch<folly::IPAddressV4>(100);
+}
+
+BENCHMARK(LpmTablePatch100V6) {
+  lpmTablePatch<folly::IPAddressV6>(100);
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  // Build the tables outside of the measured runs
+  getData<folly::IPAddressV4>();
+  getData<folly::IPAddressV6>();
+  folly::runBenchmarks();
+  return 0;
+}
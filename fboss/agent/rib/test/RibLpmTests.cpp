@@ -9,6 +9,7 @@
  */
 #include "fboss/agent/Utils.h"
 #include "fboss/agent/rib/FibUpdateHelpers.h"
+#include "fboss/agent/rib/LpmSnapshot.h"
 #include "fboss/agent/rib/NetworkToRouteMap.h"
 #include "fboss/agent/rib/RoutingInformationBase.h"
 
@@ -18,7 +19,9 @@
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
 #include <gtest/gtest.h>
+#include <array>
 #include <memory>
+#include <random>
 
 using namespace facebook::fboss;
 
@@ -202,3 +205,191 @@ TEST_F(V6LpmTest, DecreasingLPMSequence) {
     CHECK_LPM(longestMatch(address), address, address.bitCount());
   }
 }
+
+TEST_F(V4LpmTest, LPMAfterDelete) {
+  rib.update(
+      kRid0,
+      ClientID::BGPD,
+      AdminDistance::EBGP,
+      {},
+      {toIpPrefix({folly::IPAddress(ip4_0), 4})},
+      false,
+      "Rib only delete",
+      noopFibUpdate,
+      nullptr);
+  // Candidate prefixes: 0/1
+  CHECK_LPM(longestMatch(folly::IPAddressV4("0.0.0.0")), ip4_0, 1);
+}
+
+TEST_F(V6LpmTest, LPMAfterDelete) {
+  rib.update(
+      kRid0,
+      ClientID::BGPD,
+      AdminDistance::EBGP,
+      {},
+      {toIpPrefix({folly::IPAddress(ip6_0), 4})},
+      false,
+      "Rib only delete",
+      noopFibUpdate,
+      nullptr);
+  // Candidate prefixes: ::/1
+  CHECK_LPM(longestMatch(folly::IPAddressV6("::")), ip6_0, 1);
+}
+
+TEST(RibLpm, LPMUnknownVrf) {
+  RoutingInformationBase rib;
+  EXPECT_EQ(nullptr, rib.longestMatch(ip4_0, kRid0));
+  EXPECT_EQ(nullptr, rib.longestMatch(ip6_0, kRid0));
+}
+
+namespace {
+template <typename AddressT>
+AddressT randomAddress(std::mt19937& gen) {
+  std::array<uint8_t, AddressT::byteCount()> bytes;
+  for (auto& byte : bytes) {
+    byte = gen();
+  }
+  return AddressT::fromBinary(folly::ByteRange(bytes.data(), bytes.size()));
+}
+
+/*
+ * Random prefixes of every length, looked up both with random addresses
+ * and with addresses within the inserted prefixes.
+ */
+template <typename AddressT>
+void checkLpmTableMatchesRadixTree(size_t numRoutes, size_t numLookups) {
+  std::mt19937 gen(numRoutes);
+  std::uniform_int_distribution<int> maskDist(0, AddressT::bitCount());
+  NetworkToRouteMap<AddressT> routes;
+  std::vector<RoutePrefix<AddressT>> prefixes;
+  for (size_t i = 0; i < numRoutes; ++i) {
+    auto mask = maskDist(gen);
+    RoutePrefix<AddressT> prefix{randomAddress<AddressT>(gen).mask(mask),
+                                 static_cast<uint8_t>(mask)};
+    routes.insert(
+        prefix.network, prefix.mask, std::make_shared<Route<AddressT>>(prefix));
+    prefixes.push_back(prefix);
+  }
+  LpmTable<AddressT> table(routes);
+
+  std::uniform_int_distribution<size_t> prefixDist(0, prefixes.size() - 1);
+  for (size_t i = 0; i < numLookups; ++i) {
+    auto addr = randomAddress<AddressT>(gen);
+    if (i % 2) {
+      // Keep the host bits, take the network bits of an inserted prefix
+      const auto& prefix = prefixes[prefixDist(gen)];
+      auto bytes = addr.toByteArray();
+      auto networkBytes = prefix.network.toByteArray();
+      for (size_t bit = 0; bit < prefix.mask; ++bit) {
+        uint8_t bitMask = 0x80 >> (bit % 8);
+        bytes[bit / 8] =
+            (bytes[bit / 8] & ~bitMask) | (networkBytes[bit / 8] & bitMask);
+      }
+      addr = AddressT::fromBinary(folly::ByteRange(bytes.data(), bytes.size()));
+    }
+    auto it = routes.longestMatch(addr, addr.bitCount());
+    auto expected = it == routes.end() ? nullptr : it->value();
+    EXPECT_EQ(expected, table.longestMatch(addr)) << addr;
+  }
+}
+
+/*
+ * Tables patched with batches of added, replaced and deleted prefixes
+ * should match the radix tree they were patched from, and share the nodes
+ * no prefix changed under with their base.
+ */
+template <typename AddressT>
+void checkPatchedLpmTableMatchesRadixTree(
+    size_t numRoutes,
+    size_t numBatches,
+    size_t numLookups) {
+  std::mt19937 gen(numRoutes);
+  std::uniform_int_distribution<int> maskDist(0, AddressT::bitCount());
+  auto randomPrefix = [&]() {
+    auto mask = maskDist(gen);
+    return RoutePrefix<AddressT>{randomAddress<AddressT>(gen).mask(mask),
+                                 static_cast<uint8_t>(mask)};
+  };
+  NetworkToRouteMap<AddressT> routes;
+  std::vector<RoutePrefix<AddressT>> prefixes;
+  for (size_t i = 0; i < numRoutes; ++i) {
+    auto prefix = randomPrefix();
+    routes.insert(
+        prefix.network, prefix.mask, std::make_shared<Route<AddressT>>(prefix));
+    prefixes.push_back(prefix);
+  }
+  auto table = std::make_shared<LpmTable<AddressT>>(routes);
+
+  for (size_t batch = 0; batch < numBatches; ++batch) {
+    std::vector<RoutePrefix<AddressT>> changed;
+    for (size_t i = 0; i < 10; ++i) {
+      std::uniform_int_distribution<size_t> prefixDist(0, prefixes.size() - 1);
+      auto prefix = i % 3 ? prefixes[prefixDist(gen)] : randomPrefix();
+      if (i % 3 == 1) {
+        routes.erase(prefix.network, prefix.mask);
+      } else {
+        routes.insert(
+            prefix.network,
+            prefix.mask,
+            std::make_shared<Route<AddressT>>(prefix));
+        prefixes.push_back(prefix);
+      }
+      changed.push_back(prefix);
+    }
+    table = std::make_shared<LpmTable<AddressT>>(*table, routes, changed);
+    EXPECT_EQ(LpmTable<AddressT>(routes).numNodes(), table->numNodes());
+  }
+
+  for (size_t i = 0; i < numLookups; ++i) {
+    auto addr = randomAddress<AddressT>(gen);
+    auto it = routes.longestMatch(addr, addr.bitCount());
+    auto expected = it == routes.end() ? nullptr : it->value();
+    EXPECT_EQ(expected, table->longestMatch(addr)) << addr;
+  }
+  for (const auto& prefix : prefixes) {
+    auto it = routes.longestMatch(prefix.network, prefix.network.bitCount());
+    auto expected = it == routes.end() ? nullptr : it->value();
+    EXPECT_EQ(expected, table->longestMatch(prefix.network)) << prefix.str();
+  }
+}
+} // namespace
+
+TEST(LpmTable, EmptyTable) {
+  LpmTable<folly::IPAddressV4> v4Table{IPv4NetworkToRouteMap()};
+  EXPECT_EQ(nullptr, v4Table.longestMatch(ip4_0));
+  LpmTable<folly::IPAddressV6> v6Table{IPv6NetworkToRouteMap()};
+  EXPECT_EQ(nullptr, v6Table.longestMatch(ip6_0));
+}
+
+TEST(LpmTable, V4MatchesRadixTree) {
+  checkLpmTableMatchesRadixTree<folly::IPAddressV4>(10000, 100000);
+}
+
+TEST(LpmTable, V6MatchesRadixTree) {
+  checkLpmTableMatchesRadixTree<folly::IPAddressV6>(10000, 100000);
+}
+
+TEST(LpmTable, V4PatchedMatchesRadixTree) {
+  checkPatchedLpmTableMatchesRadixTree<folly::IPAddressV4>(10000, 100, 100000);
+}
+
+TEST(LpmTable, V6PatchedMatchesRadixTree) {
+  checkPatchedLpmTableMatchesRadixTree<folly::IPAddressV6>(10000, 100, 100000);
+}
+
+TEST(LpmTable, PatchToEmpty) {
+  IPv4NetworkToRouteMap routes;
+  RoutePrefix<folly::IPAddressV4> prefix{ip4_64, 3};
+  routes.insert(
+      prefix.network,
+      prefix.mask,
+      std::make_shared<Route<folly::IPAddressV4>>(prefix));
+  LpmTable<folly::IPAddressV4> table(routes);
+  EXPECT_NE(nullptr, table.longestMatch(ip4_72));
+  routes.erase(prefix.network, prefix.mask);
+  LpmTable<folly::IPAddressV4> patched(table, routes, {prefix});
+  EXPECT_EQ(nullptr, patched.longestMatch(ip4_72));
+  EXPECT_EQ(0u, patched.numNodes());
+  // The base table is left as it was
+  EXPECT_NE(nullptr, table.longestMatch(ip4_72));
+}
@@ -20,9 +20,15 @@
 #include <folly/IPAddress.h>
 #include <folly/dynamic.h>
 #include <folly/logging/xlog.h>
+#include <folly/synchronization/Baton.h>
 
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 
+#include <thread>
+
+DECLARE_bool(rib_pipelined_fib_updates);
+
 using namespace facebook::fboss;
 
 using facebook::network::toBinaryAddress;
@@ -36,6 +42,7 @@ constexpr ClientID kOpenrClient = ClientID::OPENR;
 const RouterID kRid(0);
 auto kPrefix1 = IPAddress::createNetwork("1::1/64");
 auto kPrefix2 = IPAddress::createNetwork("2::2/64");
+auto kPrefix3 = IPAddress::createNetwork("3::3/64");
 
 } // namespace
 
@@ -47,6 +54,7 @@ class FailSomeUpdates {
       RouterID vrf,
       const IPv4NetworkToRouteMap& v4NetworkToRoute,
       const IPv6NetworkToRouteMap& v6NetworkToRoute,
+      const RibChangedPrefixes* changedPrefixes,
       void* cookie) {
     if (toFail_.find(++cnt_) != toFail_.end()) {
       auto curSwitchStatePtr =
@@ -57,11 +65,12 @@ class FailSomeUpdates {
           vrf,
           v4NetworkToRoute,
           v6NetworkToRoute,
+          changedPrefixes,
           static_cast<void*>(&desiredState));
       throw FbossHwUpdateError(desiredState, *curSwitchStatePtr);
     }
     return ribToSwitchStateUpdate(
-        vrf, v4NetworkToRoute, v6NetworkToRoute, cookie);
+        vrf, v4NetworkToRoute, v6NetworkToRoute, changedPrefixes, cookie);
   }
 
  private:
@@ -334,3 +343,126 @@ TEST_F(RibRollbackTest, syncFibRollbackNewClient) {
   assertRouteCount(0, 1);
   EXPECT_EQ(routeTableBeforeFailedUpdate, rib_.getRouteTableDetails(kRid));
 }
+
+TEST_F(RibRollbackTest, pipelinedUpdatesFromConcurrentClients) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_rib_pipelined_fib_updates = true;
+  constexpr auto kNumUpdates = 50;
+  auto addRoutes = [this](ClientID client, AdminDistance distance, int base) {
+    for (auto i = 0; i < kNumUpdates; ++i) {
+      auto prefix = IPAddress::createNetwork(
+          folly::to<std::string>(base + i, "::/64"));
+      rib_.update(
+          kRid,
+          client,
+          distance,
+          {makeDropUnicastRoute(prefix)},
+          {},
+          false,
+          "add only",
+          ribToSwitchStateUpdate,
+          &switchState_);
+    }
+  };
+  std::thread bgpThread(addRoutes, kBgpClient, kBgpDistance, 1000);
+  std::thread openrThread(addRoutes, kOpenrClient, kOpenrDistance, 2000);
+  bgpThread.join();
+  openrThread.join();
+  assertRouteCount(0, 1 + 2 * kNumUpdates);
+}
+
+TEST_F(RibRollbackTest, rollbackRedoesPipelinedUpdate) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_rib_pipelined_fib_updates = true;
+  // Hold the failing FIB update until the next RIB update is applied
+  folly::Baton<> failingUpdateStarted;
+  folly::Baton<> failUpdate;
+  FailSomeUpdates failFirstUpdate({1});
+  auto failAfterNextRibUpdate = [&](RouterID vrf,
+                                    const IPv4NetworkToRouteMap& v4Routes,
+                                    const IPv6NetworkToRouteMap& v6Routes,
+                                    const RibChangedPrefixes* changedPrefixes,
+                                    void* cookie) {
+    failingUpdateStarted.post();
+    failUpdate.wait();
+    return failFirstUpdate(vrf, v4Routes, v6Routes, changedPrefixes, cookie);
+  };
+  std::thread failingThread([&] {
+    EXPECT_THROW(
+        rib_.update(
+            kRid,
+            kBgpClient,
+            kBgpDistance,
+            {makeDropUnicastRoute(kPrefix3)},
+            {},
+            false,
+            "fail add",
+            failAfterNextRibUpdate,
+            &switchState_),
+        FbossHwUpdateError);
+  });
+  failingUpdateStarted.wait();
+  std::thread nextThread([&] {
+    rib_.update(
+        kRid,
+        kOpenrClient,
+        kOpenrDistance,
+        {makeDropUnicastRoute(kPrefix2)},
+        {},
+        false,
+        "add only",
+        ribToSwitchStateUpdate,
+        &switchState_);
+  });
+  // Lookups see RIB updates before they are programmed
+  while (!rib_.longestMatch(kPrefix2.first.asV6(), kRid)) {
+    std::this_thread::yield();
+  }
+  failUpdate.post();
+  failingThread.join();
+  nextThread.join();
+  // Rollback dropped kPrefix3 and kPrefix2 was redone on top
+  assertRouteCount(0, 2);
+  EXPECT_TRUE(rib_.longestMatch(kPrefix2.first.asV6(), kRid));
+  EXPECT_EQ(
+      nullptr,
+      switchState_->getFibs()
+          ->getFibContainer(kRid)
+          ->getFibV6()
+          ->exactMatch(RoutePrefixV6{kPrefix3.first.asV6(), 64}));
+}
+
+TEST_F(RibRollbackTest, missingFibRebuiltFromRib) {
+  // Switch state lost the VRF's FIB, e.g. after being reset
+  switchState_ = std::make_shared<SwitchState>();
+  rib_.update(
+      kRid,
+      kOpenrClient,
+      kOpenrDistance,
+      {makeDropUnicastRoute(kPrefix2)},
+      {},
+      false,
+      "add only",
+      ribToSwitchStateUpdate,
+      &switchState_);
+  assertRouteCount(0, 2);
+}
+
+TEST_F(RibRollbackTest, missingFibRebuiltFromRibPipelined) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_rib_pipelined_fib_updates = true;
+  switchState_ = std::make_shared<SwitchState>();
+  // Pipelined FIB updates only carry the changed routes, the FIB must still
+  // get all of them
+  rib_.update(
+      kRid,
+      kOpenrClient,
+      kOpenrDistance,
+      {makeDropUnicastRoute(kPrefix2)},
+      {},
+      false,
+      "add only",
+      ribToSwitchStateUpdate,
+      &switchState_);
+  assertRouteCount(0, 2);
+}
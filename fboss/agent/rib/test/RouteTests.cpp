@@ -45,6 +45,18 @@ RouteNextHopSet makeNextHops(std::vector<std::string> ipsAsStrings) {
   return nhops;
 }
 
+RibRouteUpdater::RouteEntry makeInterfaceRoute(
+    const std::string& network,
+    uint8_t mask,
+    const std::string& intfAddr,
+    InterfaceID intf) {
+  return {
+      {IPAddress(network), mask},
+      RouteNextHopEntry(
+          ResolvedNextHop(IPAddress(intfAddr), intf, UCMP_DEFAULT_WEIGHT),
+          AdminDistance::DIRECTLY_CONNECTED)};
+}
+
 template <typename AddrT>
 void EXPECT_ROUTES_MATCH(
     const NetworkToRouteMap<AddrT>* routesA,
@@ -151,4 +163,120 @@ TEST(Route, serializeRouteTable) {
   EXPECT_ROUTES_MATCH(origV6Routes, &newV6Routes);
 }
 
+TEST(Route, incrementalResolutionMatchesFullResolution) {
+  // Same updates applied with and without a dependency index must yield
+  // identical route tables.
+  IPv4NetworkToRouteMap v4Incremental, v4Full;
+  IPv6NetworkToRouteMap v6Incremental, v6Full;
+  RouteDependencyIndex dependencyIndex;
+  RibRouteUpdater incremental(&v4Incremental, &v6Incremental, &dependencyIndex);
+  RibRouteUpdater full(&v4Full, &v6Full);
+
+  auto update = [&](ClientID client,
+                    const std::vector<RibRouteUpdater::RouteEntry>& toAdd,
+                    const std::vector<folly::CIDRNetwork>& toDel) {
+    incremental.update(client, toAdd, toDel, false);
+    full.update(client, toAdd, toDel, false);
+    EXPECT_TRUE(dependencyIndex.isValid());
+    EXPECT_ROUTES_MATCH(&v4Incremental, &v4Full);
+    EXPECT_ROUTES_MATCH(&v6Incremental, &v6Full);
+  };
+
+  update(
+      ClientID::INTERFACE_ROUTE,
+      {makeInterfaceRoute("1.1.1.0", 24, "1.1.1.1", InterfaceID(1)),
+       makeInterfaceRoute("2.2.2.0", 24, "2.2.2.1", InterfaceID(2)),
+       makeInterfaceRoute("1::", 64, "1::1", InterfaceID(1))},
+      {});
+  // 10.0.0.0/8 resolves via 1.1.1.10, 20.0.0.0/8 recursively via 10.0.0.0/8
+  // 30::/64 resolves over the v6 interface route, 40.0.0.0/8 is unresolved
+  update(
+      kClientA,
+      {{{IPAddress("10.0.0.0"), 8},
+        RouteNextHopEntry(makeNextHops({"1.1.1.10"}), kDistance)},
+       {{IPAddress("20.0.0.0"), 8},
+        RouteNextHopEntry(makeNextHops({"10.1.1.1"}), kDistance)},
+       {{IPAddress("30::"), 64},
+        RouteNextHopEntry(makeNextHops({"1::10"}), kDistance)},
+       {{IPAddress("40.0.0.0"), 8},
+        RouteNextHopEntry(makeNextHops({"50.1.1.1"}), kDistance)}},
+      {});
+  // Change the next hop of the route everything depends on
+  update(
+      kClientA,
+      {{{IPAddress("10.0.0.0"), 8},
+        RouteNextHopEntry(makeNextHops({"2.2.2.10"}), kDistance)}},
+      {});
+  // More specific route captures a next hop of a resolved route
+  update(
+      kClientB,
+      {{{IPAddress("10.1.0.0"), 16},
+        RouteNextHopEntry(makeNextHops({"1.1.1.20"}), kDistance)}},
+      {});
+  // Previously unresolved route becomes resolvable
+  update(
+      kClientB,
+      {{{IPAddress("50.0.0.0"), 8},
+        RouteNextHopEntry(makeNextHops({"20.0.0.1"}), kDistance)}},
+      {});
+  EXPECT_TRUE(
+      v4Incremental.exactMatch(IPAddressV4("40.0.0.0"), 8)
+          ->value()
+          ->isResolved());
+  // Deleting the more specific route falls back to the covering one
+  update(kClientB, {}, {{IPAddress("10.1.0.0"), 16}});
+  // Deleting a route on the resolution path makes dependents unresolved
+  update(kClientA, {}, {{IPAddress("10.0.0.0"), 8}});
+  EXPECT_FALSE(
+      v4Incremental.exactMatch(IPAddressV4("40.0.0.0"), 8)
+          ->value()
+          ->isResolved());
+}
+
+TEST(Route, incrementalResolutionScale) {
+  // Per update resolution cost must depend on the number of affected routes,
+  // not on the size of the table.
+  for (size_t numRoutes : {1000, 10000, 100000}) {
+    IPv4NetworkToRouteMap v4Routes;
+    IPv6NetworkToRouteMap v6Routes;
+    RouteDependencyIndex dependencyIndex;
+    RibRouteUpdater updater(&v4Routes, &v6Routes, &dependencyIndex);
+
+    updater.update(
+        ClientID::INTERFACE_ROUTE,
+        {makeInterfaceRoute("1.1.1.0", 24, "1.1.1.1", InterfaceID(1))},
+        {},
+        false);
+    std::vector<RibRouteUpdater::RouteEntry> routes;
+    auto nhops = RouteNextHopEntry(makeNextHops({"1.1.1.10"}), kDistance);
+    for (size_t i = 0; i < numRoutes; ++i) {
+      routes.push_back(
+          {{IPAddress::fromLongHBO(0x0a000000 + (i << 8)), 24}, nhops});
+    }
+    updater.update(kClientA, routes, {}, false);
+    EXPECT_EQ(numRoutes + 1, v4Routes.size());
+
+    folly::CIDRNetwork prefix{IPAddress("100.0.0.0"), 24};
+    updater.update(kClientB, {{prefix, nhops}}, {}, false);
+    EXPECT_EQ(1, updater.numRoutesResolved());
+    EXPECT_TRUE(
+        v4Routes.exactMatch(IPAddressV4("100.0.0.0"), 24)
+            ->value()
+            ->isResolved());
+    updater.update(kClientB, {}, {prefix}, false);
+    EXPECT_EQ(0, updater.numRoutesResolved());
+
+    // Change to the route all others resolve over touches all of them
+    updater.update(
+        kClientB,
+        {{{IPAddress("1.1.1.10"), 32},
+          RouteNextHopEntry(RouteForwardAction::DROP, kDistance)}},
+        {},
+        false);
+    EXPECT_EQ(numRoutes + 1, updater.numRoutesResolved());
+    EXPECT_TRUE(
+        v4Routes.exactMatch(IPAddressV4("10.0.0.0"), 24)->value()->isDrop());
+  }
+}
+
 } // namespace facebook::fboss
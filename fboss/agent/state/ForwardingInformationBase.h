@@ -23,7 +23,7 @@ using ForwardingInformationBaseTraits = NodeMapTraits<
     RoutePrefix<AddressT>,
     Route<AddressT>,
     NodeMapNoExtraFields,
-    std::map<RoutePrefix<AddressT>, std::shared_ptr<Route<AddressT>>>>;
+    PersistentMap<RoutePrefix<AddressT>, std::shared_ptr<Route<AddressT>>>>;
 
 template <typename AddressT>
 class ForwardingInformationBase
@@ -9,6 +9,7 @@
  */
 #include "fboss/agent/state/ForwardingInformationBaseContainer.h"
 #include "fboss/agent/state/NodeBase-defs.h"
+#include "fboss/agent/state/NodeJsonPath.h"
 #include "fboss/agent/state/SwitchState.h"
 
 #include <folly/logging/xlog.h>
@@ -83,6 +84,53 @@ ForwardingInformationBaseContainer* ForwardingInformationBaseContainer::modify(
   return rtn;
 }
 
+namespace {
+template <typename AddressT>
+std::shared_ptr<ForwardingInformationBaseContainer> mergePatchFib(
+    const ForwardingInformationBaseContainer& node,
+    const JsonPathTokens& path,
+    size_t pos,
+    const folly::dynamic& patch) {
+  using Fib = ForwardingInformationBase<AddressT>;
+  auto fib =
+      NodeJsonPath<Fib>::mergePatch(*node.getFib<AddressT>(), path, pos, patch);
+  auto newNode = node.clone();
+  newNode->setFib<AddressT>(fib);
+  return newNode;
+}
+} // namespace
+
+folly::dynamic NodeJsonPath<ForwardingInformationBaseContainer>::get(
+    const ForwardingInformationBaseContainer& node,
+    const JsonPathTokens& path,
+    size_t pos) {
+  if (pos < path.size() && path[pos] == kFibV4) {
+    return NodeJsonPath<ForwardingInformationBaseV4>::get(
+        *node.getFibV4(), path, pos + 1);
+  }
+  if (pos < path.size() && path[pos] == kFibV6) {
+    return NodeJsonPath<ForwardingInformationBaseV6>::get(
+        *node.getFibV6(), path, pos + 1);
+  }
+  return json_path::get(node.toFollyDynamic(), path, pos);
+}
+
+std::shared_ptr<ForwardingInformationBaseContainer>
+NodeJsonPath<ForwardingInformationBaseContainer>::mergePatch(
+    const ForwardingInformationBaseContainer& node,
+    const JsonPathTokens& path,
+    size_t pos,
+    const folly::dynamic& patch) {
+  if (pos < path.size() && path[pos] == kFibV4) {
+    return mergePatchFib<folly::IPAddressV4>(node, path, pos + 1, patch);
+  }
+  if (pos < path.size() && path[pos] == kFibV6) {
+    return mergePatchFib<folly::IPAddressV6>(node, path, pos + 1, patch);
+  }
+  return ForwardingInformationBaseContainer::fromFollyDynamic(
+      json_path::mergePatch(node.toFollyDynamic(), path, pos, patch));
+}
+
 template class NodeBaseT<
     ForwardingInformationBaseContainer,
     ForwardingInformationBaseContainerFields>;
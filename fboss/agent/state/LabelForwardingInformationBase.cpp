@@ -102,19 +102,22 @@ LabelForwardingInformationBase::purgeEntriesForClient(
     ClientID client) {
   auto* writableLabelFib = modify(state);
 
-  auto iter = writableLabelFib->writableNodes().begin();
-  while (iter != writableLabelFib->writableNodes().end()) {
-    if (iter->second->getEntryForClient(client)) {
-      auto* entry = iter->second->modify(state);
-      entry->delEntryForClient(client);
-      if (entry->isEmpty()) {
-        XLOG(DBG1) << "Purging empty forwarding entry for label:"
-                   << entry->getID();
-        iter = writableLabelFib->writableNodes().erase(iter);
-        continue;
-      }
+  // Modifying entries updates the map, so collect the labels to purge
+  // before touching any of them.
+  std::vector<MplsLabel> labels;
+  for (const auto& entry : *writableLabelFib) {
+    if (entry->getEntryForClient(client)) {
+      labels.push_back(entry->getID());
+    }
+  }
+  for (auto label : labels) {
+    auto* entry = writableLabelFib->getNode(label)->modify(state);
+    entry->delEntryForClient(client);
+    if (entry->isEmpty()) {
+      XLOG(DBG1) << "Purging empty forwarding entry for label:"
+                 << entry->getID();
+      writableLabelFib->removeNode(label);
     }
-    ++iter;
   }
 
   return writableLabelFib;
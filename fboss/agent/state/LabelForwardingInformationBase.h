@@ -10,7 +10,12 @@
 
 namespace facebook::fboss {
 
-typedef NodeMapTraits<MplsLabel, LabelForwardingEntry> LabelForwardingRoute;
+typedef NodeMapTraits<
+    MplsLabel,
+    LabelForwardingEntry,
+    NodeMapNoExtraFields,
+    PersistentMap<MplsLabel, std::shared_ptr<LabelForwardingEntry>>>
+    LabelForwardingRoute;
 
 class LabelForwardingInformationBase
     : public NodeMapT<LabelForwardingInformationBase, LabelForwardingRoute> {
@@ -19,7 +19,11 @@
 
 namespace facebook::fboss {
 
-using MacTableTraits = NodeMapTraits<folly::MacAddress, MacEntry>;
+using MacTableTraits = NodeMapTraits<
+    folly::MacAddress,
+    MacEntry,
+    NodeMapNoExtraFields,
+    PersistentMap<folly::MacAddress, std::shared_ptr<MacEntry>>>;
 
 class MacTable : public NodeMapT<MacTable, MacTableTraits> {
  public:
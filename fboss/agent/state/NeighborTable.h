@@ -30,8 +30,7 @@ struct NeighborTableTraits {
   using KeyType = IPADDR;
   using Node = ENTRY;
   using ExtraFields = NodeMapNoExtraFields;
-  using NodeContainer =
-      boost::container::flat_map<KeyType, std::shared_ptr<Node>>;
+  using NodeContainer = PersistentMap<KeyType, std::shared_ptr<Node>>;
 
   static KeyType getKey(const std::shared_ptr<Node>& entry) {
     return entry->getIP();
@@ -41,12 +40,8 @@ struct NeighborTableTraits {
 /*
  * A map of IP --> MAC for the IP addresses of other nodes on a VLAN.
  *
- * TODO: We should switch from NodeMap to PrefixMap when the new PrefixMap
- * implementation is ready.
- *
- * Any change to a NodeMap is O(N), so it is really only suitable for small
- * maps that do not change frequently.  Our new PrefixMap implementation will
- * allow us to perform cheaper copy-on-write updates.
+ * Entries are kept in a PersistentMap, so adding, updating or removing a
+ * neighbor only copies O(log N) of the table instead of the whole table.
  */
 template <typename IPADDR, typename ENTRY, typename SUBCLASS>
 class NeighborTable
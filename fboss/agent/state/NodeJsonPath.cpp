@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/state/NodeJsonPath.h"
+
+namespace facebook::fboss::json_path {
+
+folly::dynamic*
+lookup(folly::dynamic& json, const JsonPathTokens& path, size_t pos) {
+  auto* dyn = &json;
+  for (; pos < path.size(); ++pos) {
+    const auto& token = path[pos];
+    if (dyn->isObject()) {
+      dyn = dyn->get_ptr(token);
+    } else if (dyn->isArray()) {
+      auto index = folly::tryTo<size_t>(token);
+      if (!index.hasValue() || *index >= dyn->size()) {
+        return nullptr;
+      }
+      dyn = &(*dyn)[*index];
+    } else {
+      return nullptr;
+    }
+    if (!dyn) {
+      return nullptr;
+    }
+  }
+  return dyn;
+}
+
+folly::dynamic
+get(const folly::dynamic& json, const JsonPathTokens& path, size_t pos) {
+  // lookup does not modify json, it only hands out a mutable pointer into it
+  auto* dyn = lookup(const_cast<folly::dynamic&>(json), path, pos);
+  if (!dyn) {
+    throw FbossError("JSON Pointer does not address proper object");
+  }
+  return *dyn;
+}
+
+folly::dynamic mergePatch(
+    folly::dynamic json,
+    const JsonPathTokens& path,
+    size_t pos,
+    const folly::dynamic& patch) {
+  auto* dyn = lookup(json, path, pos);
+  if (!dyn) {
+    throw FbossError("JSON Pointer does not address proper object");
+  }
+  // mutates in place, i.e. modifies json too
+  dyn->merge_patch(patch);
+  return json;
+}
+
+} // namespace facebook::fboss::json_path
@@ -0,0 +1,209 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/Constants.h"
+#include "fboss/agent/FbossError.h"
+
+#include <folly/Conv.h>
+#include <folly/dynamic.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace facebook::fboss {
+
+class AclMap;
+class AclTableGroupMap;
+class AggregatePortMap;
+class BufferPoolCfgMap;
+template <typename AddressT>
+class ForwardingInformationBase;
+class ForwardingInformationBaseContainer;
+class ForwardingInformationBaseMap;
+class LabelForwardingInformationBase;
+class MirrorMap;
+class QosPolicyMap;
+class SflowCollectorMap;
+class SwitchState;
+class TransceiverMap;
+class VlanMap;
+
+/*
+ * NodeJsonPath resolves a JSON pointer into the toFollyDynamic() form of a
+ * node without serializing the whole node: it walks down the children the
+ * pointer goes through, and only serializes the node at the end of the walk.
+ * Patches are applied the same way: the node at the end of the walk is
+ * rebuilt with fromFollyDynamic() from its patched form, and the nodes above
+ * it are cloned to point to it. Everything else is shared with the original.
+ *
+ * Paths are the tokens of the JSON pointer, from position pos on.
+ *
+ * The primary template treats the node as a leaf. Nodes with children that
+ * pointers should walk into specialize it, e.g. by deriving from
+ * NodeMapJsonPath for maps serialized in the default NodeMapT layout.
+ */
+using JsonPathTokens = std::vector<std::string>;
+
+namespace json_path {
+
+// The part of json addressed by path[pos:], or nullptr if there is none
+folly::dynamic* lookup(
+    folly::dynamic& json,
+    const JsonPathTokens& path,
+    size_t pos);
+
+// Copy of the part of json addressed by path[pos:]
+folly::dynamic get(
+    const folly::dynamic& json,
+    const JsonPathTokens& path,
+    size_t pos);
+
+// Merge patch the part of json addressed by path[pos:], return the result
+folly::dynamic mergePatch(
+    folly::dynamic json,
+    const JsonPathTokens& path,
+    size_t pos,
+    const folly::dynamic& patch);
+
+} // namespace json_path
+
+template <typename NodeT>
+struct NodeJsonPath {
+  static folly::dynamic
+  get(const NodeT& node, const JsonPathTokens& path, size_t pos) {
+    return json_path::get(node.toFollyDynamic(), path, pos);
+  }
+
+  static std::shared_ptr<NodeT> mergePatch(
+      const NodeT& node,
+      const JsonPathTokens& path,
+      size_t pos,
+      const folly::dynamic& patch) {
+    return NodeT::fromFollyDynamic(
+        json_path::mergePatch(node.toFollyDynamic(), path, pos, patch));
+  }
+};
+
+/*
+ * Maps serialized as {"entries": [...], "extraFields": ...}, where
+ * "entries/<index>" addresses the node at that position in the map.
+ */
+template <typename MapT>
+struct NodeMapJsonPath {
+  static folly::dynamic
+  get(const MapT& map, const JsonPathTokens& path, size_t pos) {
+    using Node = typename MapT::Node;
+    if (auto node = entry(map, path, pos)) {
+      return NodeJsonPath<Node>::get(*node, path, pos + 2);
+    }
+    return json_path::get(map.toFollyDynamic(), path, pos);
+  }
+
+  static std::shared_ptr<MapT> mergePatch(
+      const MapT& map,
+      const JsonPathTokens& path,
+      size_t pos,
+      const folly::dynamic& patch) {
+    using Node = typename MapT::Node;
+    using Traits = typename MapT::Traits;
+    auto node = entry(map, path, pos);
+    if (!node) {
+      return MapT::fromFollyDynamic(
+          json_path::mergePatch(map.toFollyDynamic(), path, pos, patch));
+    }
+    std::shared_ptr<Node> newNode =
+        NodeJsonPath<Node>::mergePatch(*node, path, pos + 2, patch);
+    auto newMap = map.clone();
+    if (Traits::getKey(newNode) == Traits::getKey(node)) {
+      newMap->updateNode(newNode);
+    } else {
+      // The patch changed the key, as when rebuilding the whole map
+      newMap->removeNode(node);
+      newMap->addNode(newNode);
+    }
+    return newMap;
+  }
+
+ private:
+  // The node addressed by "entries/<index>" at pos, if that's the path
+  static std::shared_ptr<typename MapT::Node>
+  entry(const MapT& map, const JsonPathTokens& path, size_t pos) {
+    if (path.size() < pos + 2 || path[pos] != kEntries) {
+      return nullptr;
+    }
+    auto index = folly::tryTo<size_t>(path[pos + 1]);
+    if (!index.hasValue() || *index >= map.size()) {
+      throw FbossError("JSON Pointer does not address proper object");
+    }
+    auto it = map.begin();
+    for (size_t i = 0; i < *index; ++i) {
+      ++it;
+    }
+    return *it;
+  }
+};
+
+template <>
+struct NodeJsonPath<AclMap> : NodeMapJsonPath<AclMap> {};
+template <>
+struct NodeJsonPath<AclTableGroupMap> : NodeMapJsonPath<AclTableGroupMap> {};
+template <>
+struct NodeJsonPath<AggregatePortMap> : NodeMapJsonPath<AggregatePortMap> {};
+template <>
+struct NodeJsonPath<BufferPoolCfgMap> : NodeMapJsonPath<BufferPoolCfgMap> {};
+template <>
+struct NodeJsonPath<ForwardingInformationBaseMap>
+    : NodeMapJsonPath<ForwardingInformationBaseMap> {};
+template <typename AddressT>
+struct NodeJsonPath<ForwardingInformationBase<AddressT>>
+    : NodeMapJsonPath<ForwardingInformationBase<AddressT>> {};
+template <>
+struct NodeJsonPath<LabelForwardingInformationBase>
+    : NodeMapJsonPath<LabelForwardingInformationBase> {};
+template <>
+struct NodeJsonPath<MirrorMap> : NodeMapJsonPath<MirrorMap> {};
+template <>
+struct NodeJsonPath<QosPolicyMap> : NodeMapJsonPath<QosPolicyMap> {};
+template <>
+struct NodeJsonPath<SflowCollectorMap> : NodeMapJsonPath<SflowCollectorMap> {};
+template <>
+struct NodeJsonPath<TransceiverMap> : NodeMapJsonPath<TransceiverMap> {};
+template <>
+struct NodeJsonPath<VlanMap> : NodeMapJsonPath<VlanMap> {};
+
+// Walks into "fibV4" and "fibV6"
+template <>
+struct NodeJsonPath<ForwardingInformationBaseContainer> {
+  static folly::dynamic get(
+      const ForwardingInformationBaseContainer& node,
+      const JsonPathTokens& path,
+      size_t pos);
+  static std::shared_ptr<ForwardingInformationBaseContainer> mergePatch(
+      const ForwardingInformationBaseContainer& node,
+      const JsonPathTokens& path,
+      size_t pos,
+      const folly::dynamic& patch);
+};
+
+// Walks into the child nodes of the switch state
+template <>
+struct NodeJsonPath<SwitchState> {
+  static folly::dynamic
+  get(const SwitchState& state, const JsonPathTokens& path, size_t pos);
+  static std::shared_ptr<SwitchState> mergePatch(
+      const SwitchState& state,
+      const JsonPathTokens& path,
+      size_t pos,
+      const folly::dynamic& patch);
+};
+
+} // namespace facebook::fboss
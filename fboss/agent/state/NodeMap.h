@@ -13,6 +13,7 @@
 
 #include "fboss/agent/state/NodeBase.h"
 #include "fboss/agent/state/NodeMapIterator.h"
+#include "fboss/agent/state/PersistentMap.h"
 
 namespace facebook::fboss {
 
@@ -33,8 +34,14 @@ struct NodeMapFields {
 
   template <typename Fn>
   void forEachChild(Fn fn) {
-    for (const auto& nodePtr : nodes) {
-      fn(nodePtr.second.get());
+    if constexpr (IsPersistentMap<NodeContainer>::value) {
+      // Tree nodes shared with a published map only hold published
+      // children, so there is no need to walk them again.
+      nodes.freeze([&fn](const auto& entry) { fn(entry.second.get()); });
+    } else {
+      for (const auto& nodePtr : nodes) {
+        fn(nodePtr.second.get());
+      }
     }
     extra.forEachChild(fn);
   }
@@ -59,7 +66,9 @@ struct NodeMapNoExtraFields {
 /* Traits provide flexibility on customizing NodeMap. While there
  * is a fair amount of flexibility in most fields, for NodeContainer
  * we are restricted to sorted map containers - boost::flat_map,
- * std::map etc. The sorted property is leveraged in delta calculation
+ * std::map, PersistentMap etc. The sorted property is leveraged in delta
+ * calculation. Large or frequently updated maps should use PersistentMap,
+ * which makes cloning the map O(1) and modifying it O(log N).
  */
 template <
     typename KeyT,
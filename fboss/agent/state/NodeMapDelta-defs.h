@@ -11,6 +11,7 @@
 
 #include <glog/logging.h>
 #include "fboss/agent/state/NodeMapDelta.h"
+#include "fboss/agent/state/PersistentMap.h"
 
 namespace facebook::fboss {
 
@@ -30,11 +31,7 @@ NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::Iterator(
       newMap_(newMap),
       value_(nullNode_, nullNode_) {
   // Advance to the first difference
-  while (oldIt_ != oldMap_->end() && newIt_ != newMap_->end() &&
-         *oldIt_ == *newIt_) {
-    ++oldIt_;
-    ++newIt_;
-  }
+  skipUnchanged();
   updateValue();
 }
 
@@ -101,12 +98,23 @@ void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::advance() {
   }
 
   // Advance past any unchanged nodes.
+  skipUnchanged();
+  updateValue();
+}
+
+template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
+void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::skipUnchanged() {
   while (oldIt_ != oldMap_->end() && newIt_ != newMap_->end() &&
          *oldIt_ == *newIt_) {
-    ++oldIt_;
-    ++newIt_;
+    if constexpr (IsPersistentMap<typename MapType::NodeContainer>::value) {
+      // Jump over whole subtrees the two maps share, making the delta walk
+      // proportional to the number of changes rather than the map size.
+      oldIt_.skipShared(newIt_);
+    } else {
+      ++oldIt_;
+      ++newIt_;
+    }
   }
-  updateValue();
 }
 
 } // namespace facebook::fboss
@@ -187,6 +187,7 @@ class NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator {
   using Traits = typename MapType::Traits;
 
   void advance();
+  void skipUnchanged();
   void updateValue();
 
   InnerIter oldIt_{nullptr};
@@ -52,6 +52,15 @@ class NodeMapIterator
     return it_ != other.it_;
   }
 
+  /*
+   * Advance this and other, which must point to the same node, past all
+   * the nodes their maps share. Only available for PersistentMap storage,
+   * see PersistentMap::skipShared().
+   */
+  void skipShared(NodeMapIterator& other) {
+    NodeContainer::skipShared(it_, other.it_);
+  }
+
  private:
   typename NodeContainer::const_iterator it_;
 };
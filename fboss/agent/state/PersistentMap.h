@@ -0,0 +1,702 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * PersistentMap is a sorted associative container implemented as a
+ * copy-on-write B+tree.
+ *
+ * Copying a PersistentMap is O(1): the copy shares all of its tree nodes with
+ * the original. A modification only copies the O(log N) tree nodes on the
+ * path to the modified entry, tree nodes that are not shared with another
+ * map are modified in place. This makes it a good fit for the NodeMaps of
+ * SwitchState, which are cloned on every update even if only a handful of
+ * entries change.
+ *
+ * It implements the subset of the std::map interface NodeMapT relies on, so
+ * it can be plugged in as NodeMapTraits::NodeContainer. The differences
+ * from std::map are:
+ *  - begin()/end() always return const iterators. Mutable iterators are only
+ *    handed out by the non-const find()/insert()/emplace_hint(), which first
+ *    un-share the tree nodes on the path to the entry.
+ *  - As with boost::container::flat_map, any modification invalidates all
+ *    iterators.
+ */
+template <
+    typename KeyT,
+    typename ValueT,
+    typename CompareT = std::less<KeyT>,
+    size_t kMaxNodeSize = 32>
+class PersistentMap {
+  static_assert(kMaxNodeSize >= 4, "B+tree nodes need at least 4 slots");
+
+  struct TreeNode;
+  using TreeNodePtr = std::shared_ptr<TreeNode>;
+  struct IteratorLevel {
+    TreeNode* node{nullptr};
+    uint32_t index{0};
+  };
+
+ public:
+  using key_type = KeyT;
+  using mapped_type = ValueT;
+  using value_type = std::pair<KeyT, ValueT>;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using key_compare = CompareT;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+
+  template <bool kConst>
+  class IteratorImpl {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = PersistentMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer =
+        std::conditional_t<kConst, const value_type*, value_type*>;
+    using reference =
+        std::conditional_t<kConst, const value_type&, value_type&>;
+
+    IteratorImpl() {}
+
+    // Mutable iterators are convertible to const ones, not vice versa
+    template <
+        bool kOtherConst,
+        typename = std::enable_if_t<kConst && !kOtherConst>>
+    /* implicit */ IteratorImpl(const IteratorImpl<kOtherConst>& other)
+        : root_(other.root_), depth_(other.depth_), path_(other.path_) {}
+
+    reference operator*() const {
+      const auto& level = path_[depth_ - 1];
+      return level.node->entries[level.index];
+    }
+    pointer operator->() const {
+      return &**this;
+    }
+
+    IteratorImpl& operator++() {
+      increment();
+      return *this;
+    }
+    IteratorImpl operator++(int) {
+      IteratorImpl tmp(*this);
+      increment();
+      return tmp;
+    }
+    IteratorImpl& operator--() {
+      decrement();
+      return *this;
+    }
+    IteratorImpl operator--(int) {
+      IteratorImpl tmp(*this);
+      decrement();
+      return tmp;
+    }
+
+    template <bool kOtherConst>
+    bool operator==(const IteratorImpl<kOtherConst>& other) const {
+      if (depth_ == 0 || other.depth_ == 0) {
+        return depth_ == other.depth_;
+      }
+      const auto& leaf = path_[depth_ - 1];
+      const auto& otherLeaf = other.path_[other.depth_ - 1];
+      return leaf.node == otherLeaf.node && leaf.index == otherLeaf.index;
+    }
+    template <bool kOtherConst>
+    bool operator!=(const IteratorImpl<kOtherConst>& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    friend class PersistentMap;
+    template <bool>
+    friend class IteratorImpl;
+
+    using Level = IteratorLevel;
+    /*
+     * Non-root tree nodes have at least kMaxNodeSize / 2 children, so even
+     * with the minimum node size supported this bounds the map to billions
+     * of entries.
+     */
+    static constexpr size_t kMaxDepth = 24;
+
+    explicit IteratorImpl(TreeNode* root) : root_(root) {}
+
+    void push(TreeNode* node, size_t index) {
+      CHECK_LT(depth_, kMaxDepth);
+      path_[depth_++] = Level{node, static_cast<uint32_t>(index)};
+    }
+    void descendLeftmost(TreeNode* node) {
+      while (true) {
+        push(node, 0);
+        if (node->leaf) {
+          return;
+        }
+        node = node->children.front().get();
+      }
+    }
+    void descendRightmost(TreeNode* node) {
+      while (true) {
+        push(node, node->width() - 1);
+        if (node->leaf) {
+          return;
+        }
+        node = node->children.back().get();
+      }
+    }
+    void increment() {
+      DCHECK_GT(depth_, 0);
+      auto& leaf = path_[depth_ - 1];
+      if (++leaf.index < leaf.node->entries.size()) {
+        return;
+      }
+      skipSubtree(0);
+    }
+    /*
+     * Move to the first entry after the subtree height levels above the
+     * current leaf (0 being the leaf itself).
+     */
+    void skipSubtree(size_t height) {
+      DCHECK_GT(depth_, height);
+      depth_ -= height + 1;
+      // Climb up to the first ancestor with a right sibling subtree. If
+      // there is none we are done and depth_ ends up 0, i.e. at end().
+      while (depth_ > 0) {
+        auto& parent = path_[depth_ - 1];
+        if (++parent.index < parent.node->children.size()) {
+          descendLeftmost(parent.node->children[parent.index].get());
+          return;
+        }
+        --depth_;
+      }
+    }
+    void decrement() {
+      if (depth_ == 0) {
+        DCHECK(root_);
+        descendRightmost(root_);
+        return;
+      }
+      auto& leaf = path_[depth_ - 1];
+      if (leaf.index > 0) {
+        --leaf.index;
+        return;
+      }
+      while (--depth_ > 0) {
+        auto& parent = path_[depth_ - 1];
+        if (parent.index > 0) {
+          --parent.index;
+          descendRightmost(parent.node->children[parent.index].get());
+          return;
+        }
+      }
+    }
+
+    TreeNode* root_{nullptr};
+    size_t depth_{0};
+    std::array<Level, kMaxDepth> path_;
+  };
+
+  using iterator = IteratorImpl<false>;
+  using const_iterator = IteratorImpl<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  PersistentMap() {}
+
+  size_t size() const {
+    return root_ ? root_->size : 0;
+  }
+  bool empty() const {
+    return !root_;
+  }
+  void clear() {
+    root_.reset();
+  }
+
+  const_iterator begin() const {
+    const_iterator it(root_.get());
+    if (root_) {
+      it.descendLeftmost(root_.get());
+    }
+    return it;
+  }
+  const_iterator end() const {
+    return const_iterator(root_.get());
+  }
+  const_iterator cbegin() const {
+    return begin();
+  }
+  const_iterator cend() const {
+    return end();
+  }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+  const_reverse_iterator crbegin() const {
+    return rbegin();
+  }
+  const_reverse_iterator crend() const {
+    return rend();
+  }
+
+  const_iterator find(const KeyT& key) const {
+    auto it = lower_bound(key);
+    if (it == end() || comp_(key, it->first)) {
+      return end();
+    }
+    return it;
+  }
+  /*
+   * Look up key, un-sharing the tree nodes on the path to it so that the
+   * value can be modified through the returned iterator.
+   */
+  iterator find(const KeyT& key) {
+    if (static_cast<const PersistentMap*>(this)->find(key) == end()) {
+      return iterator(root_.get());
+    }
+    return findWritable(key);
+  }
+  size_t count(const KeyT& key) const {
+    return find(key) == end() ? 0 : 1;
+  }
+
+  const_iterator lower_bound(const KeyT& key) const {
+    const_iterator it(root_.get());
+    if (!root_) {
+      return it;
+    }
+    auto node = root_.get();
+    while (!node->leaf) {
+      auto idx = childIndex(node, key);
+      it.push(node, idx);
+      node = node->children[idx].get();
+    }
+    auto pos = std::lower_bound(
+        node->entries.begin(),
+        node->entries.end(),
+        key,
+        [this](const value_type& entry, const KeyT& k) {
+          return comp_(entry.first, k);
+        });
+    if (pos != node->entries.end()) {
+      it.push(node, pos - node->entries.begin());
+    } else {
+      // Key is larger than everything in this leaf, point to the first
+      // entry of the next one (or end).
+      it.push(node, node->entries.size() - 1);
+      it.increment();
+    }
+    return it;
+  }
+  const_iterator upper_bound(const KeyT& key) const {
+    auto it = lower_bound(key);
+    if (it != end() && !comp_(key, it->first)) {
+      ++it;
+    }
+    return it;
+  }
+
+  std::pair<iterator, bool> insert(value_type value) {
+    if (count(value.first)) {
+      return std::make_pair(findWritable(value.first), false);
+    }
+    KeyT key = value.first;
+    insertNew(std::move(value));
+    return std::make_pair(findWritable(key), true);
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+  /*
+   * The hint is ignored, a B+tree insert is O(log N) regardless. Inserting
+   * in sorted order is still cheap since it only ever modifies the
+   * rightmost path.
+   */
+  template <typename... Args>
+  iterator emplace_hint(const_iterator /* hint */, Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...)).first;
+  }
+  ValueT& operator[](const KeyT& key) {
+    return insert(value_type(key, ValueT())).first->second;
+  }
+
+  size_t erase(const KeyT& key) {
+    if (!count(key)) {
+      return 0;
+    }
+    eraseImpl(root_, key);
+    if (root_->leaf) {
+      if (root_->entries.empty()) {
+        root_.reset();
+      }
+    } else if (root_->children.size() == 1) {
+      root_ = root_->children.front();
+    }
+    return 1;
+  }
+  const_iterator erase(const_iterator pos) {
+    auto next = std::next(pos);
+    if (next == end()) {
+      erase(KeyT(pos->first));
+      return end();
+    }
+    KeyT nextKey = next->first;
+    erase(KeyT(pos->first));
+    return lower_bound(nextKey);
+  }
+
+  /*
+   * Given iterators into two maps pointing to the same entry, advance both
+   * past that entry along with all following entries the two maps share
+   * through a common tree node. This lets delta computation skip over the
+   * unchanged parts of a modified copy in O(log N) instead of comparing
+   * every entry.
+   */
+  static void skipShared(const_iterator& a, const_iterator& b) {
+    DCHECK(a.depth_ > 0 && b.depth_ > 0);
+    // Tree nodes are compared bottom up, since the trees may have different
+    // heights. Once the two paths go through the same tree node, the
+    // remainder of its subtree is identical in both maps.
+    size_t height = 0;
+    while (height < a.depth_ && height < b.depth_ &&
+           a.path_[a.depth_ - 1 - height].node ==
+               b.path_[b.depth_ - 1 - height].node) {
+      ++height;
+    }
+    if (height == 0) {
+      a.increment();
+      b.increment();
+      return;
+    }
+    a.skipSubtree(height - 1);
+    b.skipSubtree(height - 1);
+  }
+
+  /*
+   * Invoke fn on every entry stored in a tree node modified since the last
+   * call to freeze(), then mark those tree nodes frozen. Frozen tree nodes
+   * are never modified in place again, so entries reachable only through
+   * frozen tree nodes are guaranteed to have been visited before.
+   *
+   * NodeMapFields uses this to publish only the children a NodeMap did not
+   * inherit from an already published NodeMap.
+   */
+  template <typename Fn>
+  void freeze(const Fn& fn) {
+    if (root_) {
+      freezeImpl(root_.get(), fn);
+    }
+  }
+
+  bool operator==(const PersistentMap& other) const {
+    return root_ == other.root_ ||
+        (size() == other.size() &&
+         std::equal(begin(), end(), other.begin()));
+  }
+  bool operator!=(const PersistentMap& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  static constexpr size_t kMinNodeSize = kMaxNodeSize / 2;
+
+  struct TreeNode {
+    size_t width() const {
+      return leaf ? entries.size() : children.size();
+    }
+
+    bool leaf{true};
+    // See freeze()
+    bool frozen{false};
+    // Number of entries in this subtree
+    size_t size{0};
+    // Leaf nodes only
+    std::vector<value_type> entries;
+    // Internal nodes only, keys[i] is the smallest key in children[i + 1]
+    std::vector<KeyT> keys;
+    std::vector<TreeNodePtr> children;
+  };
+  struct Split {
+    KeyT key;
+    TreeNodePtr right;
+  };
+
+  /*
+   * Return a tree node that may be modified in place, copying it if it is
+   * frozen or shared with another map.
+   */
+  static TreeNode* writable(TreeNodePtr& ptr) {
+    if (ptr->frozen || ptr.use_count() != 1) {
+      auto copy = std::make_shared<TreeNode>(*ptr);
+      copy->frozen = false;
+      ptr = std::move(copy);
+    } else {
+      // Synchronize with the release of other references to this node
+      std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return ptr.get();
+  }
+
+  size_t childIndex(const TreeNode* node, const KeyT& key) const {
+    return std::upper_bound(
+               node->keys.begin(), node->keys.end(), key, comp_) -
+        node->keys.begin();
+  }
+  size_t entryIndex(const TreeNode* node, const KeyT& key) const {
+    return std::lower_bound(
+               node->entries.begin(),
+               node->entries.end(),
+               key,
+               [this](const value_type& entry, const KeyT& k) {
+                 return comp_(entry.first, k);
+               }) -
+        node->entries.begin();
+  }
+
+  iterator findWritable(const KeyT& key) {
+    auto ptr = &root_;
+    auto node = writable(*ptr);
+    iterator it(node);
+    while (!node->leaf) {
+      auto idx = childIndex(node, key);
+      it.push(node, idx);
+      ptr = &node->children[idx];
+      node = writable(*ptr);
+    }
+    it.push(node, entryIndex(node, key));
+    return it;
+  }
+
+  void insertNew(value_type&& value) {
+    if (!root_) {
+      root_ = std::make_shared<TreeNode>();
+    }
+    auto split = insertImpl(root_, std::move(value));
+    if (split) {
+      auto newRoot = std::make_shared<TreeNode>();
+      newRoot->leaf = false;
+      newRoot->size = root_->size + split->right->size;
+      newRoot->keys.push_back(std::move(split->key));
+      newRoot->children.push_back(std::move(root_));
+      newRoot->children.push_back(std::move(split->right));
+      root_ = std::move(newRoot);
+    }
+  }
+
+  std::optional<Split> insertImpl(TreeNodePtr& ptr, value_type&& value) {
+    auto node = writable(ptr);
+    ++node->size;
+    if (node->leaf) {
+      auto pos = entryIndex(node, value.first);
+      node->entries.insert(node->entries.begin() + pos, std::move(value));
+    } else {
+      auto idx = childIndex(node, value.first);
+      auto split = insertImpl(node->children[idx], std::move(value));
+      if (split) {
+        node->keys.insert(node->keys.begin() + idx, std::move(split->key));
+        node->children.insert(
+            node->children.begin() + idx + 1, std::move(split->right));
+      }
+    }
+    if (node->width() > kMaxNodeSize) {
+      return splitNode(node);
+    }
+    return std::nullopt;
+  }
+
+  static Split splitNode(TreeNode* node) {
+    auto right = std::make_shared<TreeNode>();
+    right->leaf = node->leaf;
+    auto mid = node->width() / 2;
+    if (node->leaf) {
+      right->entries.assign(
+          std::make_move_iterator(node->entries.begin() + mid),
+          std::make_move_iterator(node->entries.end()));
+      node->entries.erase(node->entries.begin() + mid, node->entries.end());
+      right->size = right->entries.size();
+      node->size = node->entries.size();
+      KeyT key = right->entries.front().first;
+      return Split{std::move(key), std::move(right)};
+    }
+    right->children.assign(
+        std::make_move_iterator(node->children.begin() + mid),
+        std::make_move_iterator(node->children.end()));
+    right->keys.assign(
+        std::make_move_iterator(node->keys.begin() + mid),
+        std::make_move_iterator(node->keys.end()));
+    KeyT key = std::move(node->keys[mid - 1]);
+    node->children.erase(node->children.begin() + mid, node->children.end());
+    node->keys.erase(node->keys.begin() + mid - 1, node->keys.end());
+    right->size = subtreeSize(right.get());
+    node->size -= right->size;
+    return Split{std::move(key), std::move(right)};
+  }
+
+  static size_t subtreeSize(const TreeNode* node) {
+    size_t size = 0;
+    for (const auto& child : node->children) {
+      size += child->size;
+    }
+    return size;
+  }
+
+  void eraseImpl(TreeNodePtr& ptr, const KeyT& key) {
+    auto node = writable(ptr);
+    --node->size;
+    if (node->leaf) {
+      node->entries.erase(node->entries.begin() + entryIndex(node, key));
+      return;
+    }
+    auto idx = childIndex(node, key);
+    eraseImpl(node->children[idx], key);
+    if (node->children[idx]->width() < kMinNodeSize) {
+      rebalance(node, idx);
+    }
+  }
+
+  /*
+   * Child idx of node underflowed, merge it with a sibling or borrow
+   * entries from it.
+   */
+  static void rebalance(TreeNode* node, size_t idx) {
+    DCHECK_GT(node->children.size(), 1);
+    auto l = idx + 1 < node->children.size() ? idx : idx - 1;
+    auto r = l + 1;
+    auto left = writable(node->children[l]);
+    auto right = writable(node->children[r]);
+    if (left->width() + right->width() <= kMaxNodeSize) {
+      if (left->leaf) {
+        std::move(
+            right->entries.begin(),
+            right->entries.end(),
+            std::back_inserter(left->entries));
+      } else {
+        left->keys.push_back(std::move(node->keys[l]));
+        std::move(
+            right->keys.begin(),
+            right->keys.end(),
+            std::back_inserter(left->keys));
+        std::move(
+            right->children.begin(),
+            right->children.end(),
+            std::back_inserter(left->children));
+      }
+      left->size += right->size;
+      node->keys.erase(node->keys.begin() + l);
+      node->children.erase(node->children.begin() + r);
+      return;
+    }
+    auto total = left->size + right->size;
+    if (left->leaf) {
+      std::vector<value_type> all;
+      all.reserve(left->entries.size() + right->entries.size());
+      std::move(
+          left->entries.begin(), left->entries.end(), std::back_inserter(all));
+      std::move(
+          right->entries.begin(),
+          right->entries.end(),
+          std::back_inserter(all));
+      auto half = all.size() / 2;
+      left->entries.assign(
+          std::make_move_iterator(all.begin()),
+          std::make_move_iterator(all.begin() + half));
+      right->entries.assign(
+          std::make_move_iterator(all.begin() + half),
+          std::make_move_iterator(all.end()));
+      node->keys[l] = right->entries.front().first;
+      left->size = left->entries.size();
+      right->size = right->entries.size();
+      return;
+    }
+    std::vector<KeyT> keys;
+    std::vector<TreeNodePtr> children;
+    std::move(left->keys.begin(), left->keys.end(), std::back_inserter(keys));
+    keys.push_back(std::move(node->keys[l]));
+    std::move(
+        right->keys.begin(), right->keys.end(), std::back_inserter(keys));
+    std::move(
+        left->children.begin(),
+        left->children.end(),
+        std::back_inserter(children));
+    std::move(
+        right->children.begin(),
+        right->children.end(),
+        std::back_inserter(children));
+    auto half = children.size() / 2;
+    left->children.assign(
+        std::make_move_iterator(children.begin()),
+        std::make_move_iterator(children.begin() + half));
+    left->keys.assign(
+        std::make_move_iterator(keys.begin()),
+        std::make_move_iterator(keys.begin() + half - 1));
+    node->keys[l] = std::move(keys[half - 1]);
+    right->children.assign(
+        std::make_move_iterator(children.begin() + half),
+        std::make_move_iterator(children.end()));
+    right->keys.assign(
+        std::make_move_iterator(keys.begin() + half),
+        std::make_move_iterator(keys.end()));
+    left->size = subtreeSize(left);
+    right->size = total - left->size;
+  }
+
+  template <typename Fn>
+  static void freezeImpl(TreeNode* node, const Fn& fn) {
+    if (node->frozen) {
+      return;
+    }
+    if (node->leaf) {
+      for (const auto& entry : node->entries) {
+        fn(entry);
+      }
+    } else {
+      for (const auto& child : node->children) {
+        freezeImpl(child.get(), fn);
+      }
+    }
+    node->frozen = true;
+  }
+
+  TreeNodePtr root_;
+  CompareT comp_;
+};
+
+template <typename T>
+struct IsPersistentMap : std::false_type {};
+template <
+    typename KeyT,
+    typename ValueT,
+    typename CompareT,
+    size_t kMaxNodeSize>
+struct IsPersistentMap<PersistentMap<KeyT, ValueT, CompareT, kMaxNodeSize>>
+    : std::true_type {};
+
+} // namespace facebook::fboss
@@ -12,9 +12,13 @@
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/state/RouteNextHop.h"
 
+#include <folly/Synchronized.h>
+#include <folly/hash/Hash.h>
 #include <folly/logging/xlog.h>
 #include <gflags/gflags.h>
+#include <memory>
 #include <numeric>
+#include <unordered_map>
 #include "folly/IPAddress.h"
 
 namespace {
@@ -36,6 +40,104 @@ std::vector<facebook::fboss::NextHopThrift> thriftNextHopsFromAddresses(
   }
   return nhs;
 }
+
+using facebook::fboss::RouteNextHopEntry;
+
+size_t hashNextHopSet(const RouteNextHopEntry::NextHopSet& nhopSet) {
+  // Label actions are left to the equality check
+  size_t hash = nhopSet.size();
+  for (const auto& nhop : nhopSet) {
+    hash = folly::hash::hash_combine(
+        hash,
+        nhop.addr(),
+        nhop.weight(),
+        nhop.intfID() ? static_cast<uint32_t>(*nhop.intfID()) : 0);
+  }
+  return hash;
+}
+
+/*
+ * Table of the interned next hop sets. It only holds weak references: a set
+ * is removed when the last entry referring to it goes away.
+ */
+class NextHopSetInterner {
+ public:
+  // Deleter of the interned sets, which tells them apart from any other
+  struct Deleter {
+    void operator()(const RouteNextHopEntry::NextHopSet* nhopSet) const {
+      interner->release(hash, nhopSet);
+    }
+    NextHopSetInterner* interner;
+    size_t hash;
+  };
+
+  static bool isInterned(const RouteNextHopEntry::NextHopSetPtr& nhopSet) {
+    return std::get_deleter<Deleter>(nhopSet) != nullptr;
+  }
+
+  RouteNextHopEntry::NextHopSetPtr intern(
+      RouteNextHopEntry::NextHopSet nhopSet) {
+    auto hash = hashNextHopSet(nhopSet);
+    // Dropped once unlocked, as dropping the last reference to a set takes
+    // the lock to remove it
+    std::vector<RouteNextHopEntry::NextHopSetPtr> collisions;
+    auto lockedSets = sets_.lock();
+    auto& bucket = (*lockedSets)[hash];
+    for (const auto& weakSet : bucket) {
+      auto internedSet = weakSet.lock();
+      if (internedSet && *internedSet == nhopSet) {
+        return internedSet;
+      }
+      collisions.push_back(std::move(internedSet));
+    }
+    RouteNextHopEntry::NextHopSetPtr internedSet(
+        new RouteNextHopEntry::NextHopSet(std::move(nhopSet)),
+        Deleter{this, hash});
+    bucket.push_back(internedSet);
+    return internedSet;
+  }
+
+  size_t size() const {
+    auto lockedSets = sets_.lock();
+    size_t numSets = 0;
+    for (const auto& hashAndBucket : *lockedSets) {
+      numSets += hashAndBucket.second.size();
+    }
+    return numSets;
+  }
+
+ private:
+  void release(size_t hash, const RouteNextHopEntry::NextHopSet* nhopSet) {
+    {
+      auto lockedSets = sets_.lock();
+      auto it = lockedSets->find(hash);
+      if (it != lockedSets->end()) {
+        auto& bucket = it->second;
+        bucket.erase(
+            std::remove_if(
+                bucket.begin(),
+                bucket.end(),
+                [](const auto& weakSet) { return weakSet.expired(); }),
+            bucket.end());
+        if (bucket.empty()) {
+          lockedSets->erase(it);
+        }
+      }
+    }
+    delete nhopSet;
+  }
+
+  folly::Synchronized<std::unordered_map<
+      size_t,
+      std::vector<std::weak_ptr<const RouteNextHopEntry::NextHopSet>>>>
+      sets_;
+};
+
+NextHopSetInterner& getNextHopSetInterner() {
+  // Leaked, routes may outlive any static
+  static auto interner = new NextHopSetInterner();
+  return *interner;
+}
 } // namespace
 
 DEFINE_bool(wide_ecmp, false, "Enable fixed width wide ECMP feature");
@@ -88,11 +190,41 @@ RouteNextHopEntry::RouteNextHopEntry(
     std::optional<RouteCounterID> counterID)
     : adminDistance_(distance),
       action_(Action::NEXTHOPS),
-      counterID_(counterID),
-      nhopSet_(std::move(nhopSet)) {
-  if (nhopSet_.size() == 0) {
+      counterID_(counterID) {
+  if (nhopSet.size() == 0) {
+    throw FbossError("Empty nexthop set is passed to the RouteNextHopEntry");
+  }
+  nhopSet_ = internNextHopSet(std::move(nhopSet));
+}
+
+RouteNextHopEntry::RouteNextHopEntry(
+    NextHopSetPtr nhopSet,
+    AdminDistance distance,
+    std::optional<RouteCounterID> counterID)
+    : adminDistance_(distance),
+      action_(Action::NEXTHOPS),
+      counterID_(counterID) {
+  if (!nhopSet || nhopSet->size() == 0) {
     throw FbossError("Empty nexthop set is passed to the RouteNextHopEntry");
   }
+  nhopSet_ = NextHopSetInterner::isInterned(nhopSet)
+      ? std::move(nhopSet)
+      : internNextHopSet(*nhopSet);
+}
+
+RouteNextHopEntry::NextHopSetPtr RouteNextHopEntry::internNextHopSet(
+    NextHopSet nhopSet) {
+  return getNextHopSetInterner().intern(std::move(nhopSet));
+}
+
+const RouteNextHopEntry::NextHopSetPtr& RouteNextHopEntry::emptyNextHopSet() {
+  // Held forever, saves DROP and TO_CPU entries a trip to the interner
+  static const NextHopSetPtr kEmptySet = internNextHopSet(NextHopSet());
+  return kEmptySet;
+}
+
+size_t RouteNextHopEntry::numInternedNextHopSets() {
+  return getNextHopSetInterner().size();
 }
 
 NextHopWeight RouteNextHopEntry::getTotalWeight() const {
@@ -125,7 +257,7 @@ std::string RouteNextHopEntry::str() const {
 bool operator==(const RouteNextHopEntry& a, const RouteNextHopEntry& b) {
   return (
       a.getAction() == b.getAction() and
-      a.getNextHopSet() == b.getNextHopSet() and
+      a.getNextHopSetPtr() == b.getNextHopSetPtr() and
       a.getAdminDistance() == b.getAdminDistance() and
       a.getCounterID() == b.getCounterID());
 }
@@ -175,7 +307,7 @@ folly::dynamic RouteNextHopEntry::toFollyDynamic() const {
   folly::dynamic entry = folly::dynamic::object;
   entry[kAction] = forwardActionStr(action_);
   folly::dynamic nhops = folly::dynamic::array;
-  for (const auto& nhop : nhopSet_) {
+  for (const auto& nhop : *nhopSet_) {
     nhops.push_back(nhop.toFollyDynamic());
   }
   entry[kNexthops] = std::move(nhops);
@@ -195,9 +327,11 @@ RouteNextHopEntry RouteNextHopEntry::fromFollyDynamic(
       : AdminDistance(entryJson[kAdminDistance].asInt());
   RouteNextHopEntry entry(Action::DROP, adminDistance);
   entry.action_ = action;
+  NextHopSet nhopSet;
   for (const auto& nhop : entryJson[kNexthops]) {
-    entry.nhopSet_.insert(util::nextHopFromFollyDynamic(nhop));
+    nhopSet.insert(util::nextHopFromFollyDynamic(nhop));
   }
+  entry.nhopSet_ = internNextHopSet(std::move(nhopSet));
   if (entryJson.find(kCounterID) != entryJson.items().end()) {
     entry.counterID_ = RouteCounterID(entryJson[kCounterID].asString());
   }
@@ -208,7 +342,7 @@ bool RouteNextHopEntry::isValid(bool forMplsRoute) const {
   bool valid = true;
   if (!forMplsRoute) {
     /* for ip2mpls routes, next hop label forwarding action must be push */
-    for (const auto& nexthop : nhopSet_) {
+    for (const auto& nexthop : *nhopSet_) {
       if (action_ != Action::NEXTHOPS) {
         continue;
       }
@@ -13,6 +13,8 @@
 
 #include <folly/dynamic.h>
 
+#include <memory>
+
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/state/RouteNextHop.h"
 #include "fboss/agent/state/RouteTypes.h"
@@ -22,16 +24,28 @@ DECLARE_bool(optimized_ucmp);
 
 namespace facebook::fboss {
 
+/*
+ * Next hop sets are interned: a few hundred distinct ECMP sets are shared by
+ * hundreds of thousands of routes, in the RIB and in the FIB alike. Entries
+ * hold an immutable, ref counted NextHopSet which is shared by every entry
+ * with the same next hops, and freed along with the last of them. Equal sets
+ * being the same object, comparing them is a pointer comparison.
+ */
 class RouteNextHopEntry {
  public:
   using Action = RouteForwardAction;
   using NextHopSet = boost::container::flat_set<NextHop>;
+  // Always an interned set, see internNextHopSet()
+  using NextHopSetPtr = std::shared_ptr<const NextHopSet>;
 
   RouteNextHopEntry(
       Action action,
       AdminDistance distance,
       std::optional<RouteCounterID> counterID = std::nullopt)
-      : adminDistance_(distance), action_(action), counterID_(counterID) {
+      : adminDistance_(distance),
+        action_(action),
+        counterID_(counterID),
+        nhopSet_(emptyNextHopSet()) {
     CHECK_NE(action_, Action::NEXTHOPS);
   }
 
@@ -40,15 +54,17 @@ class RouteNextHopEntry {
       AdminDistance distance,
       std::optional<RouteCounterID> counterID = std::nullopt);
 
+  // Takes nhopSet as is if it was interned, interns a copy of it otherwise
+  RouteNextHopEntry(
+      NextHopSetPtr nhopSet,
+      AdminDistance distance,
+      std::optional<RouteCounterID> counterID = std::nullopt);
+
   RouteNextHopEntry(
       NextHop nhop,
       AdminDistance distance,
       std::optional<RouteCounterID> counterID = std::nullopt)
-      : adminDistance_(distance),
-        action_(Action::NEXTHOPS),
-        counterID_(counterID) {
-    nhopSet_.emplace(std::move(nhop));
-  }
+      : RouteNextHopEntry(NextHopSet{std::move(nhop)}, distance, counterID) {}
 
   AdminDistance getAdminDistance() const {
     return adminDistance_;
@@ -59,6 +75,11 @@ class RouteNextHopEntry {
   }
 
   const NextHopSet& getNextHopSet() const {
+    return *nhopSet_;
+  }
+
+  // Identifies the next hop set: key on this rather than on the set
+  const NextHopSetPtr& getNextHopSetPtr() const {
     return nhopSet_;
   }
 
@@ -96,7 +117,7 @@ class RouteNextHopEntry {
 
   // Reset the NextHopSet
   void reset() {
-    nhopSet_.clear();
+    nhopSet_ = emptyNextHopSet();
     action_ = Action::DROP;
     counterID_ = std::nullopt;
   }
@@ -120,6 +141,12 @@ class RouteNextHopEntry {
       std::vector<uint64_t>& nhWeights,
       uint64_t normalizedPathCount);
 
+  // The shared copy of nhopSet, interned along the way if need be
+  static NextHopSetPtr internNextHopSet(NextHopSet nhopSet);
+  static const NextHopSetPtr& emptyNextHopSet();
+  // Distinct next hop sets currently in use
+  static size_t numInternedNextHopSets();
+
  private:
   void normalize(
       std::vector<NextHopWeight>& scaledWeights,
@@ -127,7 +154,7 @@ class RouteNextHopEntry {
   AdminDistance adminDistance_;
   Action action_{Action::DROP};
   std::optional<RouteCounterID> counterID_;
-  NextHopSet nhopSet_;
+  NextHopSetPtr nhopSet_;
 };
 
 /**
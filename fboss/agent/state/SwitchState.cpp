@@ -30,6 +30,9 @@
 #include "fboss/agent/state/VlanMap.h"
 
 #include "fboss/agent/state/NodeBase-defs.h"
+#include "fboss/agent/state/NodeJsonPath.h"
+
+#include <optional>
 
 using std::make_shared;
 using std::shared_ptr;
@@ -454,6 +457,97 @@ std::shared_ptr<SwitchState> SwitchState::modifyTransceivers(
   }
 }
 
+namespace {
+// Calls fn with the SwitchStateFields member serialized under key, if it's a
+// node
+template <typename Fn>
+void visitChild(const std::string& key, Fn&& fn) {
+  if (key == kPorts) {
+    fn(&SwitchStateFields::ports);
+  } else if (key == kAggregatePorts) {
+    fn(&SwitchStateFields::aggPorts);
+  } else if (key == kVlans) {
+    fn(&SwitchStateFields::vlans);
+  } else if (key == kInterfaces) {
+    fn(&SwitchStateFields::interfaces);
+  } else if (key == kAcls) {
+    fn(&SwitchStateFields::acls);
+  } else if (key == kAclTableGroups) {
+    fn(&SwitchStateFields::aclTableGroups);
+  } else if (key == kSflowCollectors) {
+    fn(&SwitchStateFields::sFlowCollectors);
+  } else if (key == kQosPolicies) {
+    fn(&SwitchStateFields::qosPolicies);
+  } else if (key == kControlPlane) {
+    fn(&SwitchStateFields::controlPlane);
+  } else if (key == kLoadBalancers) {
+    fn(&SwitchStateFields::loadBalancers);
+  } else if (key == kMirrors) {
+    fn(&SwitchStateFields::mirrors);
+  } else if (key == kFibs) {
+    fn(&SwitchStateFields::fibs);
+  } else if (key == kLabelForwardingInformationBase) {
+    fn(&SwitchStateFields::labelFib);
+  } else if (key == kSwitchSettings) {
+    fn(&SwitchStateFields::switchSettings);
+  } else if (key == kQcmCfg) {
+    fn(&SwitchStateFields::qcmCfg);
+  } else if (key == kBufferPoolCfgs) {
+    fn(&SwitchStateFields::bufferPoolCfgs);
+  } else if (key == kTransceivers) {
+    fn(&SwitchStateFields::transceivers);
+  } else if (key == kDefaultDataplaneQosPolicy) {
+    fn(&SwitchStateFields::defaultDataPlaneQosPolicy);
+  }
+}
+} // namespace
+
+folly::dynamic NodeJsonPath<SwitchState>::get(
+    const SwitchState& state,
+    const JsonPathTokens& path,
+    size_t pos) {
+  std::optional<folly::dynamic> json;
+  if (pos < path.size()) {
+    visitChild(path[pos], [&](auto member) {
+      const auto& child = state.getFields()->*member;
+      using Node = typename std::decay_t<decltype(child)>::element_type;
+      if (child) {
+        json = NodeJsonPath<Node>::get(*child, path, pos + 1);
+      }
+    });
+  }
+  if (json) {
+    return std::move(*json);
+  }
+  // Not in a child node, e.g. the timeouts
+  return json_path::get(state.toFollyDynamic(), path, pos);
+}
+
+std::shared_ptr<SwitchState> NodeJsonPath<SwitchState>::mergePatch(
+    const SwitchState& state,
+    const JsonPathTokens& path,
+    size_t pos,
+    const folly::dynamic& patch) {
+  std::shared_ptr<SwitchState> newState;
+  if (pos < path.size()) {
+    visitChild(path[pos], [&](auto member) {
+      const auto& child = state.getFields()->*member;
+      using Node = typename std::decay_t<decltype(child)>::element_type;
+      if (child) {
+        auto newChild =
+            NodeJsonPath<Node>::mergePatch(*child, path, pos + 1, patch);
+        newState = state.clone();
+        newState->writableFields()->*member = std::move(newChild);
+      }
+    });
+  }
+  if (newState) {
+    return newState;
+  }
+  return SwitchState::fromFollyDynamic(
+      json_path::mergePatch(state.toFollyDynamic(), path, pos, patch));
+}
+
 template class NodeBaseT<SwitchState, SwitchStateFields>;
 
 } // namespace facebook::fboss
@@ -118,4 +118,44 @@ TEST(ForwardingInformationBaseV6, IPv6DefaultPrefixComparesSmallest) {
   EXPECT_EQ(firstRouteObserved->prefix().mask, 0);
 }
 
+TEST(ForwardingInformationBaseV4, DeltaOfClonedFibSeesOnlyChanges) {
+  auto prefix = [](uint32_t i) {
+    return RoutePrefixV4{
+        folly::IPAddressV4::fromLongHBO(0x0a000000 + (i << 8)), 24};
+  };
+  auto oldFib = std::make_shared<ForwardingInformationBaseV4>();
+  for (uint32_t i = 0; i < 100000; ++i) {
+    oldFib->addNode(createRouteFromPrefix(prefix(i)));
+  }
+  oldFib->publish();
+
+  // Delta iteration skips the parts of the FIB the clone still shares, it
+  // must find exactly the entries that changed.
+  auto newFib = oldFib->clone();
+  auto changedPrefix = prefix(10);
+  newFib->updateNode(createRouteFromPrefix(changedPrefix));
+  auto removedPrefix = prefix(50000);
+  newFib->removeNode(removedPrefix);
+  auto addedPrefix = RoutePrefixV4{folly::IPAddressV4("11.0.0.0"), 8};
+  newFib->addNode(createRouteFromPrefix(addedPrefix));
+
+  NodeMapDelta<ForwardingInformationBaseV4> delta(oldFib.get(), newFib.get());
+  std::vector<RoutePrefixV4> changed, added, removed;
+  DeltaFunctions::forEachChanged(
+      delta,
+      [&](const std::shared_ptr<RouteV4>& oldRoute,
+          const std::shared_ptr<RouteV4>& /*newRoute*/) {
+        changed.push_back(oldRoute->prefix());
+      },
+      [&](const std::shared_ptr<RouteV4>& newRoute) {
+        added.push_back(newRoute->prefix());
+      },
+      [&](const std::shared_ptr<RouteV4>& oldRoute) {
+        removed.push_back(oldRoute->prefix());
+      });
+  EXPECT_EQ(std::vector<RoutePrefixV4>{changedPrefix}, changed);
+  EXPECT_EQ(std::vector<RoutePrefixV4>{addedPrefix}, added);
+  EXPECT_EQ(std::vector<RoutePrefixV4>{removedPrefix}, removed);
+}
+
 } // namespace facebook::fboss
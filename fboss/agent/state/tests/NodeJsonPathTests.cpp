@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/state/NodeJsonPath.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/Vlan.h"
+#include "fboss/agent/state/VlanMap.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <folly/json_pointer.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+
+namespace {
+folly::dynamic getPath(
+    const std::shared_ptr<SwitchState>& state,
+    const std::string& pointer) {
+  return NodeJsonPath<SwitchState>::get(
+      *state, folly::json_pointer::parse(pointer).tokens(), 0);
+}
+
+std::shared_ptr<SwitchState> patchPath(
+    const std::shared_ptr<SwitchState>& state,
+    const std::string& pointer,
+    const folly::dynamic& patch) {
+  return NodeJsonPath<SwitchState>::mergePatch(
+      *state, folly::json_pointer::parse(pointer).tokens(), 0, patch);
+}
+} // namespace
+
+TEST(NodeJsonPath, getMatchesFullState) {
+  auto state = testStateA();
+  auto full = state->toFollyDynamic();
+  for (auto pointer :
+       {"",
+        "/vlans",
+        "/vlans/entries/1",
+        "/vlans/entries/1/vlanName",
+        "/ports",
+        "/interfaces/0",
+        "/switchSettings",
+        "/fibs",
+        "/arpTimeout"}) {
+    auto expected = full.get_ptr(folly::json_pointer::parse(pointer));
+    ASSERT_NE(expected, nullptr) << pointer;
+    EXPECT_EQ(getPath(state, pointer), *expected) << pointer;
+  }
+}
+
+TEST(NodeJsonPath, getMissing) {
+  auto state = testStateA();
+  for (auto pointer :
+       {"/vlans/entries/100", "/vlans/entries/x", "/vlans/entries/0/foo"}) {
+    EXPECT_THROW(getPath(state, pointer), FbossError) << pointer;
+  }
+}
+
+TEST(NodeJsonPath, patchMatchesFullState) {
+  auto state = testStateA();
+  state->publish();
+  folly::dynamic patch = folly::dynamic::object("vlanName", "patched");
+
+  auto full = state->toFollyDynamic();
+  full.get_ptr(folly::json_pointer::parse("/vlans/entries/0"))
+      ->merge_patch(patch);
+  auto expected = SwitchState::fromFollyDynamic(full);
+
+  auto newState = patchPath(state, "/vlans/entries/0", patch);
+  EXPECT_EQ(newState->toFollyDynamic(), expected->toFollyDynamic());
+  EXPECT_EQ((*newState->getVlans()->begin())->getName(), "patched");
+  // Only the path to the patched vlan is rebuilt
+  EXPECT_NE(newState->getVlans(), state->getVlans());
+  EXPECT_EQ(
+      *std::next(newState->getVlans()->begin()),
+      *std::next(state->getVlans()->begin()));
+  EXPECT_EQ(newState->getPorts(), state->getPorts());
+  EXPECT_EQ(newState->getInterfaces(), state->getInterfaces());
+  EXPECT_EQ(newState->getFibs(), state->getFibs());
+}
+
+TEST(NodeJsonPath, patchLeafNode) {
+  auto state = testStateA();
+  state->publish();
+  auto newState =
+      patchPath(state, "/interfaces/0", folly::dynamic::object("mtu", 9000));
+  EXPECT_NE(newState->getInterfaces(), state->getInterfaces());
+  EXPECT_EQ(newState->getVlans(), state->getVlans());
+  EXPECT_EQ(newState->getPorts(), state->getPorts());
+}
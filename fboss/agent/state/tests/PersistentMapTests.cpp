@@ -0,0 +1,191 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/state/PersistentMap.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+
+using namespace facebook::fboss;
+
+namespace {
+// Small nodes so that the tests exercise multi level trees
+using TestMap = PersistentMap<int, int, std::less<int>, 4>;
+
+void expectSame(const TestMap& map, const std::map<int, int>& expected) {
+  ASSERT_EQ(expected.size(), map.size());
+  EXPECT_EQ(expected.empty(), map.empty());
+  auto it = map.begin();
+  for (const auto& entry : expected) {
+    ASSERT_NE(map.end(), it);
+    EXPECT_EQ(entry.first, it->first);
+    EXPECT_EQ(entry.second, it->second);
+    ++it;
+  }
+  EXPECT_EQ(map.end(), it);
+
+  auto rit = map.rbegin();
+  for (auto expectedRit = expected.rbegin(); expectedRit != expected.rend();
+       ++expectedRit) {
+    ASSERT_NE(map.rend(), rit);
+    EXPECT_EQ(expectedRit->first, rit->first);
+    EXPECT_EQ(expectedRit->second, rit->second);
+    ++rit;
+  }
+  EXPECT_EQ(map.rend(), rit);
+}
+} // namespace
+
+TEST(PersistentMap, insertFindErase) {
+  TestMap map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.end(), map.begin());
+  for (int i = 0; i < 100; i += 2) {
+    EXPECT_TRUE(map.insert(std::make_pair(i, i * 10)).second);
+  }
+  EXPECT_FALSE(map.insert(std::make_pair(10, 0)).second);
+  EXPECT_EQ(50, map.size());
+  EXPECT_EQ(100, map.find(10)->second);
+  EXPECT_EQ(map.end(), map.find(11));
+  EXPECT_EQ(12, map.lower_bound(11)->first);
+  EXPECT_EQ(12, map.upper_bound(10)->first);
+  EXPECT_EQ(map.end(), map.lower_bound(99));
+
+  map.find(10)->second = 7;
+  EXPECT_EQ(7, map.find(10)->second);
+  map[11] = 3;
+  EXPECT_EQ(3, map.find(11)->second);
+
+  EXPECT_EQ(1, map.erase(11));
+  EXPECT_EQ(0, map.erase(11));
+  auto it = map.erase(map.find(10));
+  EXPECT_EQ(12, it->first);
+  EXPECT_EQ(49, map.size());
+  while (!map.empty()) {
+    map.erase(map.begin());
+  }
+  EXPECT_EQ(map.end(), map.begin());
+}
+
+TEST(PersistentMap, matchesStdMap) {
+  std::mt19937 gen(1234);
+  std::uniform_int_distribution<int> keys(0, 2000);
+  TestMap map;
+  std::map<int, int> expected;
+  for (int i = 0; i < 20000; ++i) {
+    auto key = keys(gen);
+    if (gen() % 3 == 0) {
+      EXPECT_EQ(expected.erase(key), map.erase(key));
+    } else {
+      expected[key] = i;
+      map[key] = i;
+    }
+    if (i % 1000 == 0) {
+      expectSame(map, expected);
+    }
+  }
+  expectSame(map, expected);
+}
+
+TEST(PersistentMap, copiesAreIndependent) {
+  TestMap map;
+  std::map<int, int> expected;
+  for (int i = 0; i < 1000; ++i) {
+    map.insert(std::make_pair(i, i));
+    expected.emplace(i, i);
+  }
+  auto copy = map;
+  auto expectedCopy = expected;
+  for (int i = 0; i < 1000; i += 3) {
+    copy.erase(i);
+    expectedCopy.erase(i);
+  }
+  copy.find(1)->second = 100;
+  expectedCopy[1] = 100;
+  copy.insert(std::make_pair(5000, 1));
+  expectedCopy[5000] = 1;
+
+  expectSame(map, expected);
+  expectSame(copy, expectedCopy);
+  EXPECT_NE(map, copy);
+  EXPECT_EQ(map, TestMap(map));
+}
+
+TEST(PersistentMap, freezeVisitsOnlyModifiedEntries) {
+  TestMap map;
+  for (int i = 0; i < 1000; ++i) {
+    map.insert(std::make_pair(i, i));
+  }
+  int visited = 0;
+  map.freeze([&](const auto&) { ++visited; });
+  EXPECT_EQ(1000, visited);
+
+  visited = 0;
+  map.freeze([&](const auto&) { ++visited; });
+  EXPECT_EQ(0, visited);
+
+  // Modifying a frozen map must leave the frozen tree nodes untouched, and
+  // only the un-shared leaf is visited again.
+  auto copy = map;
+  copy.find(500)->second = -1;
+  std::vector<int> visitedKeys;
+  copy.freeze([&](const auto& entry) { visitedKeys.push_back(entry.first); });
+  EXPECT_NE(
+      visitedKeys.end(),
+      std::find(visitedKeys.begin(), visitedKeys.end(), 500));
+  EXPECT_LE(visitedKeys.size(), 4);
+  EXPECT_EQ(500, map.find(500)->second);
+  EXPECT_EQ(-1, copy.find(500)->second);
+}
+
+TEST(PersistentMap, skipSharedFindsAllChanges) {
+  using BigMap = PersistentMap<int, std::shared_ptr<int>>;
+  BigMap oldMap;
+  for (int i = 0; i < 100000; i += 2) {
+    oldMap.insert(std::make_pair(i, std::make_shared<int>(i)));
+  }
+  auto newMap = oldMap;
+  newMap.find(5000)->second = std::make_shared<int>(-1);
+  newMap.erase(60000);
+  newMap.insert(std::make_pair(60001, std::make_shared<int>(60001)));
+  newMap.insert(std::make_pair(99999, std::make_shared<int>(99999)));
+
+  // Same walk as NodeMapDelta, counting the steps taken
+  std::vector<int> changed;
+  size_t steps = 0;
+  auto oldIt = oldMap.begin();
+  auto newIt = newMap.begin();
+  while (oldIt != oldMap.end() || newIt != newMap.end()) {
+    ++steps;
+    if (oldIt != oldMap.end() && newIt != newMap.end() &&
+        oldIt->first == newIt->first) {
+      if (oldIt->second == newIt->second) {
+        BigMap::skipShared(oldIt, newIt);
+        continue;
+      }
+      changed.push_back(oldIt->first);
+      ++oldIt;
+      ++newIt;
+    } else if (
+        newIt == newMap.end() ||
+        (oldIt != oldMap.end() && oldIt->first < newIt->first)) {
+      changed.push_back(oldIt->first);
+      ++oldIt;
+    } else {
+      changed.push_back(newIt->first);
+      ++newIt;
+    }
+  }
+  EXPECT_EQ((std::vector<int>{5000, 60000, 60001, 99999}), changed);
+  // A handful of tree nodes per change instead of 50k entries
+  EXPECT_LT(steps, 1000);
+}
@@ -10,12 +10,15 @@
 
 #include "common/network/if/gen-cpp2/Address_types.h"
 #include "fboss/agent/AddressUtil.h"
+#include "fboss/agent/FbossError.h"
 #include "fboss/agent/if/gen-cpp2/ctrl_types.h"
 #include "fboss/agent/state/RouteNextHopEntry.h"
 
 #include <folly/IPAddress.h>
+#include <folly/logging/xlog.h>
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <memory>
 #include <numeric>
 #include <vector>
 
@@ -355,3 +358,98 @@ TEST(RouteNextHopEntry, OptimizedUcmpDiscardMultipleLowWeights) {
     EXPECT_EQ(nhop.weight(), expectedWeights[nhop.addr()]);
   }
 }
+
+TEST(RouteNextHopEntry, NextHopSetsAreInterned) {
+  RouteNextHopEntry::NextHopSet nhops(nextHops.begin(), nextHops.end());
+  auto numSets = RouteNextHopEntry::numInternedNextHopSets();
+  RouteNextHopEntry bgpEntry(nhops, kDefaultAdminDistance);
+  RouteNextHopEntry openrEntry(nhops, AdminDistance::OPENR);
+  EXPECT_EQ(bgpEntry.getNextHopSetPtr(), openrEntry.getNextHopSetPtr());
+  EXPECT_EQ(bgpEntry.getNextHopSet(), nhops);
+  EXPECT_EQ(RouteNextHopEntry::numInternedNextHopSets(), numSets + 1);
+  {
+    RouteNextHopEntry otherEntry(
+        RouteNextHopEntry::NextHopSet(nextHops.begin(), nextHops.end() - 1),
+        kDefaultAdminDistance);
+    EXPECT_NE(bgpEntry.getNextHopSetPtr(), otherEntry.getNextHopSetPtr());
+    EXPECT_EQ(RouteNextHopEntry::numInternedNextHopSets(), numSets + 2);
+  }
+  // Gone with its last entry
+  EXPECT_EQ(RouteNextHopEntry::numInternedNextHopSets(), numSets + 1);
+
+  auto deserialized =
+      RouteNextHopEntry::fromFollyDynamic(bgpEntry.toFollyDynamic());
+  EXPECT_EQ(deserialized, bgpEntry);
+  EXPECT_EQ(deserialized.getNextHopSetPtr(), bgpEntry.getNextHopSetPtr());
+  // DROP and TO_CPU entries share the empty set
+  EXPECT_EQ(
+      RouteNextHopEntry::createDrop().getNextHopSetPtr(),
+      RouteNextHopEntry::createToCpu().getNextHopSetPtr());
+}
+
+TEST(RouteNextHopEntry, NextHopSetPtrsAreInterned) {
+  RouteNextHopEntry::NextHopSet nhops(nextHops.begin(), nextHops.end());
+  RouteNextHopEntry entry(nhops, kDefaultAdminDistance);
+  auto numSets = RouteNextHopEntry::numInternedNextHopSets();
+
+  // Interned sets are shared as they are
+  RouteNextHopEntry fromInterned(
+      entry.getNextHopSetPtr(), AdminDistance::OPENR);
+  EXPECT_EQ(fromInterned.getNextHopSetPtr(), entry.getNextHopSetPtr());
+
+  // Others are swapped for the interned copy
+  auto notInterned =
+      std::make_shared<const RouteNextHopEntry::NextHopSet>(nhops);
+  RouteNextHopEntry fromNotInterned(notInterned, AdminDistance::OPENR);
+  EXPECT_EQ(fromNotInterned.getNextHopSetPtr(), entry.getNextHopSetPtr());
+  EXPECT_NE(fromNotInterned.getNextHopSetPtr(), notInterned);
+  EXPECT_EQ(RouteNextHopEntry::numInternedNextHopSets(), numSets);
+
+  EXPECT_THROW(
+      RouteNextHopEntry(
+          std::make_shared<const RouteNextHopEntry::NextHopSet>(),
+          kDefaultAdminDistance),
+      FbossError);
+}
+
+TEST(RouteNextHopEntry, InternedNextHopSetsScale) {
+  // Fabric like scale: a few hundred ECMP sets shared by all the routes
+  constexpr auto kNumRoutes = 200'000;
+  constexpr auto kNumSets = 200;
+  constexpr auto kEcmpWidth = 4;
+  std::vector<RouteNextHopEntry::NextHopSet> nhopSets(kNumSets);
+  for (auto set = 0; set < kNumSets; ++set) {
+    for (auto member = 0; member < kEcmpWidth; ++member) {
+      auto addr = folly::IPAddress(
+          folly::to<std::string>("2401:db00::", set, ":", member));
+      nhopSets[set].emplace(
+          ResolvedNextHop(addr, InterfaceID(member + 1), ECMP_WEIGHT));
+    }
+  }
+  auto numSets = RouteNextHopEntry::numInternedNextHopSets();
+  std::vector<RouteNextHopEntry> entries;
+  entries.reserve(kNumRoutes);
+  for (auto route = 0; route < kNumRoutes; ++route) {
+    entries.emplace_back(nhopSets[route % kNumSets], kDefaultAdminDistance);
+  }
+  EXPECT_EQ(RouteNextHopEntry::numInternedNextHopSets(), numSets + kNumSets);
+  for (auto route = kNumSets; route < kNumRoutes; ++route) {
+    ASSERT_EQ(
+        entries[route].getNextHopSetPtr(),
+        entries[route % kNumSets].getNextHopSetPtr());
+  }
+
+  // Lower bound, each NextHop holding its next hop out of line
+  auto setBytes = sizeof(RouteNextHopEntry::NextHopSet) +
+      kEcmpWidth * sizeof(NextHop) + kEcmpWidth * sizeof(ResolvedNextHop);
+  auto bytesPerRouteOwned = setBytes;
+  auto bytesPerRouteInterned = sizeof(RouteNextHopEntry::NextHopSetPtr) +
+      static_cast<double>(kNumSets * setBytes) / kNumRoutes;
+  XLOG(INFO) << "Next hop set bytes per route: " << bytesPerRouteOwned
+             << " owned, " << bytesPerRouteInterned << " interned, "
+             << bytesPerRouteOwned - bytesPerRouteInterned << " saved";
+  EXPECT_LT(bytesPerRouteInterned, bytesPerRouteOwned);
+
+  entries.clear();
+  EXPECT_EQ(RouteNextHopEntry::numInternedNextHopSets(), numSets);
+}
@@ -11,6 +11,12 @@
 
 #include <folly/Benchmark.h>
 #include <folly/Memory.h>
+#include <folly/logging/xlog.h>
+#include <sys/resource.h>
+#include <chrono>
+#include <thread>
+#include "fboss/agent/ArpHandler.h"
+#include "fboss/agent/NeighborUpdater.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/TunManager.h"
 #include "fboss/agent/hw/mock/MockRxPacket.h"
@@ -31,6 +37,16 @@ using std::make_unique;
 using std::shared_ptr;
 using std::unique_ptr;
 
+DEFINE_int32(
+    arp_aging_entries,
+    0,
+    "Number of ARP entries to age for the ArpCacheAging CPU measurement, "
+    "e.g. 100000. 0 (default) to skip it");
+DEFINE_int32(
+    arp_aging_seconds,
+    10,
+    "How long to measure CPU usage for while the ARP entries age");
+
 namespace {
 
 // Global state used by the benchmarks
@@ -65,6 +81,8 @@ unique_ptr<SwSwitch> setupSwitch() {
     Interface::Addresses addrs1;
     addrs1.emplace(IPAddress("10.0.0.1"), 24);
     addrs1.emplace(IPAddress("192.168.0.1"), 24);
+    // Room for the entries of the ArpCacheAging measurement
+    addrs1.emplace(IPAddress("10.128.0.1"), 15);
     intf1->setAddresses(addrs1);
     state->addIntf(intf1);
 
@@ -136,6 +154,56 @@ void init() {
   arpRequest_10_0_0_5->setSrcVlan(VlanID(1));
 }
 
+std::chrono::microseconds processCpuTime() {
+  struct rusage usage;
+  CHECK_EQ(getrusage(RUSAGE_SELF, &usage), 0);
+  auto toUsecs = [](const timeval& tv) {
+    return std::chrono::seconds(tv.tv_sec) +
+        std::chrono::microseconds(tv.tv_usec);
+  };
+  return toUsecs(usage.ru_utime) + toUsecs(usage.ru_stime);
+}
+
+/*
+ * Measure the CPU spent keeping FLAGS_arp_aging_entries resolved entries
+ * aging in the ARP cache. Entries go stale within a few seconds and, with
+ * no hardware hits, are then revisited every second, so this is dominated
+ * by neighbor cache timer handling.
+ */
+void runArpCacheAging() {
+  sw->updateStateBlocking(
+      "arp aging timeouts", [](const shared_ptr<SwitchState>& oldState) {
+        auto state = oldState->clone();
+        state->setArpTimeout(std::chrono::seconds(2));
+        state->setStaleEntryInterval(std::chrono::seconds(1));
+        return state;
+      });
+
+  auto base = IPAddressV4("10.128.0.2").toLongHBO();
+  for (auto i = 0; i < FLAGS_arp_aging_entries; ++i) {
+    sw->getNeighborUpdater()->receivedArpMine(
+        VlanID(1),
+        IPAddressV4::fromLongHBO(base + i),
+        MacAddress::fromHBO(0x020000000000 + i),
+        PortDescriptor(PortID(1)),
+        ARP_OP_REPLY);
+  }
+  sw->getNeighborUpdater()->waitForPendingUpdates();
+  // Let all entries go through REACHABLE into STALE
+  std::this_thread::sleep_for(std::chrono::seconds(4));
+
+  auto cpuBefore = processCpuTime();
+  auto wallBefore = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(std::chrono::seconds(FLAGS_arp_aging_seconds));
+  std::chrono::duration<double, std::milli> cpu =
+      processCpuTime() - cpuBefore;
+  std::chrono::duration<double> wall =
+      std::chrono::steady_clock::now() - wallBefore;
+
+  XLOG(INFO) << "ArpCacheAging: " << FLAGS_arp_aging_entries << " entries, "
+             << cpu.count() / wall.count() << " ms CPU per second";
+}
+
 } // unnamed namespace
 
 BENCHMARK(ArpRequest, numIters) {
@@ -189,5 +257,8 @@ int main(int argc, char** argv) {
   init();
 
   folly::runBenchmarks();
+  if (FLAGS_arp_aging_entries > 0) {
+    runArpCacheAging();
+  }
   return 0;
 }
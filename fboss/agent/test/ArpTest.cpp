@@ -15,6 +15,7 @@
 #include "fboss/agent/ArpHandler.h"
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/NeighborUpdater.h"
+#include "fboss/agent/StateObserver.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/ThriftHandler.h"
@@ -39,6 +40,7 @@
 #include <boost/range/combine.hpp>
 #include <gtest/gtest.h>
 #include <array>
+#include <atomic>
 #include <future>
 #include <string>
 
@@ -58,6 +60,9 @@ using std::unique_ptr;
 
 using ::testing::_;
 
+DECLARE_int32(neighbor_update_batch_size);
+DECLARE_int32(neighbor_update_batch_window_ms);
+
 namespace {
 const uint8_t kNCStrictPriorityQueue = 7;
 
@@ -1481,3 +1486,72 @@ TEST(ArpTest, receivedPacketWithRouteToDestination) {
   counters.checkDelta(SwitchStats::kCounterPrefix + "ipv4.nexthop.sum", 1);
   counters.checkDelta(SwitchStats::kCounterPrefix + "ipv4.no_arp.sum", 0);
 }
+
+TEST(ArpTest, BatchedNeighborBurst) {
+  gflags::FlagSaver flagSaver;
+  constexpr auto kNumNeighbors = 10000;
+  constexpr auto kBatchSize = 512;
+  FLAGS_neighbor_update_batch_size = kBatchSize;
+  // Long enough for batches to only be programmed once full, or when
+  // waiting for pending updates
+  FLAGS_neighbor_update_batch_window_ms = 10000;
+
+  auto handle = setupTestHandle();
+  auto sw = handle->getSw();
+
+  class StateUpdateCounter : public StateObserver {
+   public:
+    void stateUpdated(const StateDelta& /*delta*/) override {
+      ++updates;
+    }
+    std::atomic<int> updates{0};
+  };
+  StateUpdateCounter counter;
+  sw->registerStateObserver(&counter, "StateUpdateCounter");
+
+  std::atomic<int> hwDeltas{0};
+  EXPECT_HW_CALL(sw, stateChanged(_))
+      .WillRepeatedly(testing::Invoke([&hwDeltas](const StateDelta& delta) {
+        ++hwDeltas;
+        return delta.newState();
+      }));
+
+  // 169.254.0.0/16 is on interface 55
+  VlanID vlanID(55);
+  std::vector<IPAddressV4> targetIPs;
+  for (uint32_t i = 0; i < kNumNeighbors; i++) {
+    targetIPs.push_back(IPAddressV4::fromLongHBO(
+        IPAddressV4("169.254.0.0").toLongHBO() + 256 + i));
+  }
+  auto updater = sw->getNeighborUpdater();
+  for (const auto& ip : targetIPs) {
+    updater->sentArpRequest(vlanID, ip);
+  }
+  for (const auto& ip : targetIPs) {
+    updater->receivedArpMine(
+        vlanID,
+        ip,
+        MacAddress("02:10:20:30:40:22"),
+        PortDescriptor(PortID(15)),
+        ARP_OP_REPLY);
+  }
+  updater->waitForPendingUpdates();
+  waitForStateUpdates(sw);
+
+  auto arpTable = sw->getState()->getVlans()->getVlan(vlanID)->getArpTable();
+  EXPECT_EQ(static_cast<size_t>(kNumNeighbors), arpTable->getAllNodes().size());
+  for (const auto& ip : targetIPs) {
+    auto entry = arpTable->getEntryIf(ip);
+    ASSERT_NE(nullptr, entry);
+    EXPECT_FALSE(entry->isPending());
+  }
+
+  // One update per batch of pending entries and one per batch of resolved
+  // entries, plus a few for the partial batches and the static MAC entry
+  // all neighbors share
+  auto numBatches = (kNumNeighbors + kBatchSize - 1) / kBatchSize;
+  EXPECT_LE(counter.updates.load(), 2 * numBatches + 4);
+  EXPECT_LE(hwDeltas.load(), counter.updates.load());
+
+  sw->unregisterStateObserver(&counter);
+}
@@ -11,11 +11,21 @@
 #include "fboss/agent/AsyncLogger.h"
 
 #include <folly/CPortability.h>
+#include <folly/Conv.h>
+#include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 #include <stdio.h>
 
+#include <algorithm>
+#include <fstream>
+#include <thread>
+#include <vector>
+
 #define TEST_LOG "/tmp/sai_logger_test"
 
+DECLARE_bool(async_logger_drop_on_overflow);
+
 // Test string size that's larger than half of the buffer,
 // such that two strings cannot be flushed together.
 static auto constexpr kTestStringSize =
@@ -133,3 +143,135 @@ TEST_F(AsyncLoggerTest, concurrentWaitTest) {
   // Therefore, the flush count should be equal or greater than two.
   EXPECT_GE(asyncLogger->getFlushCount(), 2);
 }
+
+TEST_F(AsyncLoggerTest, multiProducerTest) {
+  constexpr auto kNumThreads = 8;
+  constexpr auto kNumLogs = 20000;
+
+  // Log kNumLogs lines per thread, timing each append
+  std::vector<std::vector<std::chrono::nanoseconds>> latencies(kNumThreads);
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      std::vector<std::string> logs;
+      for (int j = 0; j < kNumLogs; ++j) {
+        logs.push_back(folly::to<std::string>(i, " ", j, "\n"));
+      }
+      latencies[i].reserve(kNumLogs);
+      for (const auto& log : logs) {
+        auto appendStart = std::chrono::steady_clock::now();
+        asyncLogger->appendLog(log.c_str(), log.size());
+        latencies[i].push_back(std::chrono::steady_clock::now() - appendStart);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  asyncLogger->forceFlush();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  std::vector<std::chrono::nanoseconds> allLatencies;
+  for (const auto& threadLatencies : latencies) {
+    allLatencies.insert(
+        allLatencies.end(), threadLatencies.begin(), threadLatencies.end());
+  }
+  std::sort(allLatencies.begin(), allLatencies.end());
+  auto percentile = [&allLatencies](double p) {
+    return allLatencies[(allLatencies.size() - 1) * p].count();
+  };
+  XLOG(INFO) << kNumThreads * kNumLogs << " logs in "
+             << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed)
+                    .count()
+             << "ms, append latency p50: " << percentile(0.5)
+             << "ns p99: " << percentile(0.99)
+             << "ns p99.9: " << percentile(0.999)
+             << "ns max: " << allLatencies.back().count() << "ns";
+
+  // Every log is written out, in the order each thread logged it
+  EXPECT_EQ(asyncLogger->getDroppedCount(), 0);
+  std::vector<int> nextLog(kNumThreads, 0);
+  std::ifstream logFile(TEST_LOG);
+  std::string line;
+  while (std::getline(logFile, line)) {
+    // Skip the boot header
+    if (line.rfind("//", 0) == 0) {
+      continue;
+    }
+    int thread, log;
+    ASSERT_EQ(sscanf(line.c_str(), "%d %d", &thread, &log), 2) << line;
+    ASSERT_EQ(log, nextLog[thread]++);
+  }
+  for (int i = 0; i < kNumThreads; ++i) {
+    EXPECT_EQ(nextLog[i], kNumLogs);
+  }
+}
+
+TEST_F(AsyncLoggerTest, ringOverflowTest) {
+  // Each log takes a segment of its own, so loggers keep filling up the whole
+  // ring and sealing the current segment while it is full
+  constexpr auto kNumThreads = 4;
+  constexpr auto kNumLogs = AsyncLogger::kNumSegments * 8;
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      for (int j = 0; j < kNumLogs; ++j) {
+        auto log = folly::to<std::string>(i, " ", j, " ");
+        log.append(kTestStringSize - log.size() - 1, '.');
+        log.append("\n");
+        asyncLogger->appendLog(log.c_str(), log.size());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Loggers are not stuck on a segment already written out
+  std::string last = "last\n";
+  asyncLogger->appendLog(last.c_str(), last.size());
+  asyncLogger->forceFlush();
+
+  EXPECT_EQ(asyncLogger->getDroppedCount(), 0);
+  EXPECT_GE(asyncLogger->getFlushCount(), kNumThreads * kNumLogs);
+  std::vector<int> nextLog(kNumThreads, 0);
+  std::ifstream logFile(TEST_LOG);
+  std::string line;
+  std::string lastLine;
+  while (std::getline(logFile, line)) {
+    lastLine = line;
+    if (line.rfind("//", 0) == 0 || line == "last") {
+      continue;
+    }
+    int thread, log;
+    ASSERT_EQ(sscanf(line.c_str(), "%d %d", &thread, &log), 2);
+    ASSERT_EQ(log, nextLog[thread]++);
+  }
+  for (int i = 0; i < kNumThreads; ++i) {
+    EXPECT_EQ(nextLog[i], kNumLogs);
+  }
+  EXPECT_EQ(lastLine, "last");
+}
+
+TEST_F(AsyncLoggerTest, ringOverflowDropTest) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_async_logger_drop_on_overflow = true;
+
+  constexpr auto kNumLogs = AsyncLogger::kNumSegments * 64;
+  std::string str(kTestStringSize, '.');
+  for (int i = 0; i < kNumLogs; ++i) {
+    asyncLogger->appendLog(str.c_str(), str.size());
+  }
+  asyncLogger->forceFlush();
+  auto flushCount = asyncLogger->getFlushCount();
+
+  // Once the ring has been written out, logs are accepted again
+  auto droppedCount = asyncLogger->getDroppedCount();
+  std::string last = "last";
+  asyncLogger->appendLog(last.c_str(), last.size());
+  asyncLogger->forceFlush();
+  EXPECT_EQ(asyncLogger->getDroppedCount(), droppedCount);
+  EXPECT_EQ(asyncLogger->getFlushCount(), flushCount + 1);
+}
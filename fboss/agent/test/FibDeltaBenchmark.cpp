@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include "fboss/agent/state/DeltaFunctions.h"
+#include "fboss/agent/state/ForwardingInformationBase.h"
+#include "fboss/agent/state/NodeMapDelta.h"
+#include "fboss/agent/state/Route.h"
+
+#include <array>
+
+using namespace facebook::fboss;
+
+namespace {
+static constexpr uint32_t kNumRoutes = 200000;
+
+RoutePrefixV6 makePrefix(uint32_t index) {
+  std::array<uint8_t, 16> bytes{0x20, 0x01, 0x0d, 0xb8};
+  bytes[4] = index >> 16;
+  bytes[5] = index >> 8;
+  bytes[6] = index;
+  return RoutePrefixV6{
+      folly::IPAddressV6::fromBinary(folly::ByteRange(bytes.data(), 16)), 64};
+}
+
+std::shared_ptr<RouteV6> makeRoute(uint32_t index) {
+  return std::make_shared<RouteV6>(
+      RouteFields<folly::IPAddressV6>(makePrefix(index)));
+}
+} // namespace
+
+/*
+ * Compute the delta between a published 200k route FIB and a clone of it
+ * with numChanges routes updated, as every HwSwitch and StateObserver does
+ * for each state update.
+ */
+void FibDelta(uint32_t iters, uint32_t numChanges) {
+  std::shared_ptr<ForwardingInformationBaseV6> oldFib;
+  std::shared_ptr<ForwardingInformationBaseV6> newFib;
+  BENCHMARK_SUSPEND {
+    oldFib = std::make_shared<ForwardingInformationBaseV6>();
+    for (uint32_t i = 0; i < kNumRoutes; ++i) {
+      oldFib->addNode(makeRoute(i));
+    }
+    oldFib->publish();
+    newFib = oldFib->clone();
+    for (uint32_t i = 0; i < numChanges; ++i) {
+      newFib->updateNode(makeRoute(folly::Random::rand32(kNumRoutes)));
+    }
+    newFib->publish();
+  }
+  for (uint32_t i = 0; i < iters; ++i) {
+    NodeMapDelta<ForwardingInformationBaseV6> delta(
+        oldFib.get(), newFib.get());
+    uint32_t changed = 0;
+    DeltaFunctions::forEachChanged(
+        delta,
+        [&](const std::shared_ptr<RouteV6>& /*oldRoute*/,
+            const std::shared_ptr<RouteV6>& /*newRoute*/) { ++changed; });
+    folly::doNotOptimizeAway(changed);
+  }
+}
+
+BENCHMARK_PARAM(FibDelta, 1);
+BENCHMARK_PARAM(FibDelta, 10);
+BENCHMARK_PARAM(FibDelta, 100);
+BENCHMARK_PARAM(FibDelta, 1000);
+BENCHMARK_PARAM(FibDelta, 200000);
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
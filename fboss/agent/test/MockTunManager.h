@@ -31,7 +31,7 @@ class MockTunManager : public TunManager {
       sendPacketToHost_,
       bool(std::tuple<InterfaceID, std::shared_ptr<RxPacket>>));
   bool sendPacketToHost(InterfaceID, std::unique_ptr<RxPacket> pkt) override;
-  MOCK_METHOD1(doProbe, void(std::lock_guard<std::mutex>&));
+  MOCK_METHOD1(doProbe, void(std::lock_guard<folly::SharedMutex>&));
 };
 
 } // namespace facebook::fboss
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <boost/container/flat_map.hpp>
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include "fboss/agent/state/PersistentMap.h"
+
+#include <map>
+
+using namespace facebook::fboss;
+
+/*
+ * Compare the NodeMapTraits::NodeContainer candidates on the pattern
+ * SwitchState updates follow: copy the map of the last published state, then
+ * add, update or remove a single entry.
+ */
+namespace {
+struct Entry {
+  uint32_t id;
+};
+using EntryPtr = std::shared_ptr<Entry>;
+} // namespace
+
+template <typename ContainerT>
+void cloneAndModify(uint32_t iters, uint32_t numEntries) {
+  ContainerT published;
+  BENCHMARK_SUSPEND {
+    for (uint32_t i = 0; i < numEntries; ++i) {
+      published.emplace_hint(
+          published.cend(), i * 2, std::make_shared<Entry>(Entry{i * 2}));
+    }
+  }
+  for (uint32_t i = 0; i < iters; ++i) {
+    ContainerT copy(published);
+    auto key = folly::Random::rand32(numEntries) * 2;
+    switch (i % 3) {
+      case 0:
+        copy.find(key)->second = std::make_shared<Entry>(Entry{key});
+        break;
+      case 1:
+        copy.insert(std::make_pair(key + 1, EntryPtr()));
+        break;
+      case 2:
+        copy.erase(key);
+        break;
+    }
+    folly::doNotOptimizeAway(copy.size());
+    published = std::move(copy);
+    // keep the map size (and its layout) stable across iterations
+    BENCHMARK_SUSPEND {
+      published.erase(key + 1);
+      published.insert(
+          std::make_pair(key, std::make_shared<Entry>(Entry{key})));
+    }
+  }
+}
+
+void FlatMapCloneAndModify(uint32_t iters, uint32_t numEntries) {
+  cloneAndModify<boost::container::flat_map<uint32_t, EntryPtr>>(
+      iters, numEntries);
+}
+
+void StdMapCloneAndModify(uint32_t iters, uint32_t numEntries) {
+  cloneAndModify<std::map<uint32_t, EntryPtr>>(iters, numEntries);
+}
+
+void PersistentMapCloneAndModify(uint32_t iters, uint32_t numEntries) {
+  cloneAndModify<PersistentMap<uint32_t, EntryPtr>>(iters, numEntries);
+}
+
+BENCHMARK_PARAM(FlatMapCloneAndModify, 1000);
+BENCHMARK_RELATIVE_PARAM(StdMapCloneAndModify, 1000);
+BENCHMARK_RELATIVE_PARAM(PersistentMapCloneAndModify, 1000);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(FlatMapCloneAndModify, 10000);
+BENCHMARK_RELATIVE_PARAM(StdMapCloneAndModify, 10000);
+BENCHMARK_RELATIVE_PARAM(PersistentMapCloneAndModify, 10000);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(FlatMapCloneAndModify, 100000);
+BENCHMARK_RELATIVE_PARAM(StdMapCloneAndModify, 100000);
+BENCHMARK_RELATIVE_PARAM(PersistentMapCloneAndModify, 100000);
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,270 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RxPacketDispatcher.h"
+#include "fboss/agent/hw/mock/MockRxPacket.h"
+#include "fboss/agent/packet/Ethertype.h"
+
+#include <folly/Synchronized.h>
+#include <folly/io/IOBuf.h>
+#include <folly/synchronization/Baton.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <thread>
+
+using namespace facebook::fboss;
+using PacketClass = RxPacketDispatcher::PacketClass;
+
+namespace {
+
+std::unique_ptr<MockRxPacket> makePacket(
+    ETHERTYPE ethertype,
+    std::vector<uint8_t> payload = {}) {
+  std::vector<uint8_t> frame(12, 0);
+  frame.push_back(static_cast<uint16_t>(ethertype) >> 8);
+  frame.push_back(static_cast<uint16_t>(ethertype) & 0xff);
+  frame.insert(frame.end(), payload.begin(), payload.end());
+  frame.resize(std::max<size_t>(frame.size(), 64), 0);
+  return std::make_unique<MockRxPacket>(
+      folly::IOBuf::copyBuffer(frame.data(), frame.size()));
+}
+
+std::unique_ptr<MockRxPacket> makeIPv6Packet(uint8_t nextHeader, uint8_t type) {
+  std::vector<uint8_t> payload(40, 0);
+  payload[0] = 0x60;
+  payload[6] = nextHeader;
+  payload.push_back(type);
+  return makePacket(ETHERTYPE::ETHERTYPE_IPV6, payload);
+}
+
+std::unique_ptr<MockRxPacket> makePacket(PacketClass packetClass) {
+  switch (packetClass) {
+    case PacketClass::CONTROL:
+      return makePacket(ETHERTYPE::ETHERTYPE_SLOW_PROTOCOLS);
+    case PacketClass::NEIGHBOR:
+      return makePacket(ETHERTYPE::ETHERTYPE_ARP);
+    case PacketClass::DATA:
+      return makePacket(ETHERTYPE::ETHERTYPE_IPV4);
+  }
+  return nullptr;
+}
+
+RxPacketDispatcher::Options withQueueCapacity(uint32_t queueCapacity = 16) {
+  RxPacketDispatcher::Options options;
+  options.queueCapacity = {queueCapacity, queueCapacity, queueCapacity};
+  return options;
+}
+
+/*
+ * Dispatcher whose handler blocks on the first packet until released, so
+ * that tests can build up a backlog.
+ */
+class BlockingDispatcher {
+ public:
+  explicit BlockingDispatcher(RxPacketDispatcher::Options options)
+      : dispatcher_(
+            [this](std::unique_ptr<RxPacket> pkt) {
+              auto packetClass = dispatcher_.classify(pkt.get());
+              if (!blocked_.exchange(true)) {
+                handlerBlocked_.post();
+                release_.wait();
+              }
+              handled_.wlock()->push_back(packetClass);
+            },
+            options) {}
+
+  void dispatchAndBlock(PacketClass packetClass) {
+    EXPECT_TRUE(dispatcher_.dispatch(makePacket(packetClass)));
+    handlerBlocked_.wait();
+  }
+
+  void release() {
+    release_.post();
+  }
+
+  void waitForHandled(size_t numPackets) {
+    while (handled_.rlock()->size() < numPackets) {
+      std::this_thread::yield();
+    }
+  }
+
+  RxPacketDispatcher& dispatcher() {
+    return dispatcher_;
+  }
+
+  std::vector<PacketClass> handled() const {
+    return handled_.copy();
+  }
+
+ private:
+  std::atomic<bool> blocked_{false};
+  folly::Baton<> handlerBlocked_;
+  folly::Baton<> release_;
+  folly::Synchronized<std::vector<PacketClass>> handled_;
+  RxPacketDispatcher dispatcher_;
+};
+} // namespace
+
+TEST(RxPacketDispatcherTest, classify) {
+  RxPacketDispatcher dispatcher(
+      [](std::unique_ptr<RxPacket>) {}, RxPacketDispatcher::Options());
+  // LACP
+  EXPECT_EQ(
+      dispatcher.classify(
+          makePacket(ETHERTYPE::ETHERTYPE_SLOW_PROTOCOLS).get()),
+      PacketClass::CONTROL);
+  EXPECT_EQ(
+      dispatcher.classify(makePacket(ETHERTYPE::ETHERTYPE_LLDP).get()),
+      PacketClass::CONTROL);
+  EXPECT_EQ(
+      dispatcher.classify(makePacket(ETHERTYPE::ETHERRTPE_EAPOL).get()),
+      PacketClass::CONTROL);
+  EXPECT_EQ(
+      dispatcher.classify(makePacket(ETHERTYPE::ETHERTYPE_ARP).get()),
+      PacketClass::NEIGHBOR);
+  // Neighbor solicitation
+  EXPECT_EQ(
+      dispatcher.classify(makeIPv6Packet(58, 135).get()),
+      PacketClass::NEIGHBOR);
+  // ICMPv6 echo request and UDP
+  EXPECT_EQ(
+      dispatcher.classify(makeIPv6Packet(58, 128).get()), PacketClass::DATA);
+  EXPECT_EQ(
+      dispatcher.classify(makeIPv6Packet(17, 135).get()), PacketClass::DATA);
+  EXPECT_EQ(
+      dispatcher.classify(makePacket(ETHERTYPE::ETHERTYPE_IPV4).get()),
+      PacketClass::DATA);
+  // 802.1Q tagged ARP
+  EXPECT_EQ(
+      dispatcher.classify(
+          makePacket(ETHERTYPE::ETHERTYPE_VLAN, {0x00, 0x01, 0x08, 0x06})
+              .get()),
+      PacketClass::NEIGHBOR);
+  // Too short for an ethernet header
+  std::vector<uint8_t> runt(2 * folly::MacAddress::SIZE, 0);
+  auto runtPkt = std::make_unique<MockRxPacket>(
+      folly::IOBuf::copyBuffer(runt.data(), runt.size()));
+  EXPECT_EQ(dispatcher.classify(runtPkt.get()), PacketClass::DATA);
+}
+
+TEST(RxPacketDispatcherTest, busyClassDoesNotDelayOthers) {
+  BlockingDispatcher blocking(withQueueCapacity());
+  blocking.dispatchAndBlock(PacketClass::DATA);
+
+  for (auto packetClass :
+       {PacketClass::DATA, PacketClass::NEIGHBOR, PacketClass::CONTROL}) {
+    for (auto i = 0; i < 3; ++i) {
+      EXPECT_TRUE(blocking.dispatcher().dispatch(makePacket(packetClass)));
+    }
+  }
+  // Handled by their own workers while the DATA worker is still blocked
+  blocking.waitForHandled(6);
+  auto handled = blocking.handled();
+  EXPECT_EQ(std::count(handled.begin(), handled.end(), PacketClass::DATA), 0);
+
+  blocking.release();
+  blocking.waitForHandled(10);
+  handled = blocking.handled();
+  EXPECT_EQ(std::count(handled.begin(), handled.end(), PacketClass::DATA), 4);
+}
+
+TEST(RxPacketDispatcherTest, keepsPortOrderUnderLoad) {
+  constexpr auto kNumPorts = 8;
+  constexpr auto kPacketsPerPort = 500;
+  RxPacketDispatcher::Options options;
+  options.numWorkers = {4, 4, 4};
+  options.queueCapacity = {
+      kNumPorts * kPacketsPerPort,
+      kNumPorts * kPacketsPerPort,
+      kNumPorts * kPacketsPerPort};
+  // Sequence numbers seen, per class and port
+  folly::Synchronized<std::map<std::pair<PacketClass, int>, std::vector<int>>>
+      seen;
+  std::atomic<int> numHandled{0};
+  RxPacketDispatcher dispatcher(
+      [&](std::unique_ptr<RxPacket> pkt) {
+        auto packetClass = dispatcher.classify(pkt.get());
+        const auto* dstMac = pkt->buf()->data();
+        auto port = static_cast<int>(pkt->getSrcPort());
+        (*seen.wlock())[{packetClass, port}].push_back(
+            (dstMac[0] << 8) | dstMac[1]);
+        ++numHandled;
+      },
+      options);
+
+  // One producer per class, all ports interleaved
+  std::vector<std::thread> producers;
+  for (auto packetClass :
+       {PacketClass::CONTROL, PacketClass::NEIGHBOR, PacketClass::DATA}) {
+    producers.emplace_back([&dispatcher, packetClass]() {
+      for (auto seq = 0; seq < kPacketsPerPort; ++seq) {
+        for (auto port = 0; port < kNumPorts; ++port) {
+          auto pkt = makePacket(packetClass);
+          // Sequence number in the (otherwise unused) destination MAC
+          pkt->buf()->writableData()[0] = seq >> 8;
+          pkt->buf()->writableData()[1] = seq & 0xff;
+          pkt->setSrcPort(PortID(port));
+          EXPECT_TRUE(dispatcher.dispatch(std::move(pkt)));
+        }
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  constexpr auto kNumPackets = 3 * kNumPorts * kPacketsPerPort;
+  while (numHandled < kNumPackets) {
+    std::this_thread::yield();
+  }
+  dispatcher.stop();
+
+  std::vector<int> expected(kPacketsPerPort);
+  std::iota(expected.begin(), expected.end(), 0);
+  auto seenLocked = seen.rlock();
+  EXPECT_EQ(seenLocked->size(), static_cast<size_t>(3 * kNumPorts));
+  for (const auto& classPortAndSeqs : *seenLocked) {
+    EXPECT_EQ(classPortAndSeqs.second, expected);
+  }
+}
+
+TEST(RxPacketDispatcherTest, dropWhenQueueFull) {
+  BlockingDispatcher blocking(withQueueCapacity(2));
+  blocking.dispatchAndBlock(PacketClass::NEIGHBOR);
+
+  auto& dispatcher = blocking.dispatcher();
+  EXPECT_TRUE(dispatcher.dispatch(makePacket(PacketClass::NEIGHBOR)));
+  EXPECT_TRUE(dispatcher.dispatch(makePacket(PacketClass::NEIGHBOR)));
+  EXPECT_FALSE(dispatcher.dispatch(makePacket(PacketClass::NEIGHBOR)));
+  // A full NEIGHBOR queue does not hold back control packets
+  EXPECT_TRUE(dispatcher.dispatch(makePacket(PacketClass::CONTROL)));
+
+  auto stats = dispatcher.getStats(PacketClass::NEIGHBOR);
+  EXPECT_EQ(stats.enqueued, 2u);
+  EXPECT_EQ(stats.dropped, 1u);
+  EXPECT_EQ(dispatcher.getStats(PacketClass::CONTROL).dropped, 0u);
+  blocking.release();
+}
+
+TEST(RxPacketDispatcherTest, stopDropsBacklog) {
+  BlockingDispatcher blocking(withQueueCapacity());
+  blocking.dispatchAndBlock(PacketClass::DATA);
+  auto& dispatcher = blocking.dispatcher();
+  EXPECT_TRUE(dispatcher.dispatch(makePacket(PacketClass::DATA)));
+  blocking.release();
+  dispatcher.stop();
+
+  EXPECT_FALSE(dispatcher.dispatch(makePacket(PacketClass::DATA)));
+  auto stats = dispatcher.getStats(PacketClass::DATA);
+  EXPECT_EQ(stats.enqueued, 2u);
+  EXPECT_EQ(stats.handled + stats.dropped, 3u);
+}
@@ -0,0 +1,262 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/StateObserverNotifier.h"
+#include "fboss/agent/StateObserver.h"
+#include "fboss/agent/state/StateDelta.h"
+#include "fboss/agent/state/SwitchState.h"
+
+#include <folly/Synchronized.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
+#include <folly/synchronization/Baton.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace facebook::fboss;
+using Mode = StateObserverNotifier::Mode;
+
+namespace {
+
+/*
+ * Records the new state of every delta it is notified of. Optionally blocks
+ * on the first one until released, so that tests can build up a backlog.
+ */
+class RecordingObserver : public StateObserver {
+ public:
+  explicit RecordingObserver(bool blockFirst = false)
+      : blocked_(!blockFirst) {}
+
+  void stateUpdated(const StateDelta& delta) override {
+    if (!blocked_.exchange(true)) {
+      observerBlocked_.post();
+      release_.wait();
+    }
+    seen_.wlock()->push_back(delta.newState());
+    threadIds_.wlock()->push_back(std::this_thread::get_id());
+  }
+
+  void waitUntilBlocked() {
+    observerBlocked_.wait();
+  }
+  void release() {
+    release_.post();
+  }
+
+  std::vector<std::shared_ptr<SwitchState>> seen() const {
+    return seen_.copy();
+  }
+  std::vector<std::thread::id> threadIds() const {
+    return threadIds_.copy();
+  }
+
+ private:
+  std::atomic<bool> blocked_;
+  folly::Baton<> observerBlocked_;
+  folly::Baton<> release_;
+  folly::Synchronized<std::vector<std::shared_ptr<SwitchState>>> seen_;
+  folly::Synchronized<std::vector<std::thread::id>> threadIds_;
+};
+
+/*
+ * Unregisters itself first thing in its destructor, as ASYNC observers do
+ * with AutoRegisterStateObserver::unregister(). Like SwSwitch, the removal
+ * runs on the update thread.
+ */
+class SelfRemovingObserver : public StateObserver {
+ public:
+  SelfRemovingObserver(
+      StateObserverNotifier* notifier,
+      folly::EventBase* updateEvb,
+      std::atomic<int>* notifiedAfterDestroy)
+      : notifier_(notifier),
+        updateEvb_(updateEvb),
+        notifiedAfterDestroy_(notifiedAfterDestroy) {}
+  ~SelfRemovingObserver() override {
+    updateEvb_->runInEventBaseThreadAndWait(
+        [this]() { notifier_->remove(this); });
+    destroyed_ = true;
+  }
+
+  void stateUpdated(const StateDelta& delta) override {
+    if (destroyed_) {
+      ++*notifiedAfterDestroy_;
+    }
+    // Slow enough for a backlog to build up
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    seen_.wlock()->push_back(delta.newState());
+  }
+
+ private:
+  StateObserverNotifier* notifier_;
+  folly::EventBase* updateEvb_;
+  std::atomic<int>* notifiedAfterDestroy_;
+  std::atomic<bool> destroyed_{false};
+  folly::Synchronized<std::vector<std::shared_ptr<SwitchState>>> seen_;
+};
+
+std::vector<std::shared_ptr<SwitchState>> makeStates(size_t numStates) {
+  std::vector<std::shared_ptr<SwitchState>> states;
+  for (size_t i = 0; i < numStates; ++i) {
+    states.push_back(std::make_shared<SwitchState>());
+  }
+  return states;
+}
+} // namespace
+
+TEST(StateObserverNotifierTest, syncObserverNotifiedInline) {
+  StateObserverNotifier notifier(1, 4);
+  RecordingObserver observer;
+  notifier.add(&observer, "sync", Mode::SYNC);
+  EXPECT_TRUE(notifier.isRegistered(&observer));
+
+  auto states = makeStates(2);
+  notifier.notify(StateDelta(states[0], states[1]));
+  EXPECT_EQ(observer.seen(), std::vector{states[1]});
+  EXPECT_EQ(observer.threadIds(), std::vector{std::this_thread::get_id()});
+  EXPECT_EQ(notifier.getBacklog(&observer), 0u);
+
+  notifier.remove(&observer);
+  EXPECT_FALSE(notifier.isRegistered(&observer));
+}
+
+TEST(StateObserverNotifierTest, asyncObserversKeepOrder) {
+  StateObserverNotifier notifier(4, 8);
+  std::array<RecordingObserver, 3> observers;
+  for (auto& observer : observers) {
+    notifier.add(&observer, "async", Mode::ASYNC);
+  }
+  constexpr auto kNumUpdates = 100;
+  auto states = makeStates(kNumUpdates + 1);
+  for (auto i = 0; i < kNumUpdates; ++i) {
+    notifier.notify(StateDelta(states[i], states[i + 1]));
+  }
+  notifier.waitForAsyncObservers();
+
+  std::vector<std::shared_ptr<SwitchState>> expected(
+      states.begin() + 1, states.end());
+  for (auto& observer : observers) {
+    EXPECT_EQ(observer.seen(), expected);
+    EXPECT_EQ(notifier.getBacklog(&observer), 0u);
+    for (auto threadId : observer.threadIds()) {
+      EXPECT_NE(threadId, std::this_thread::get_id());
+    }
+  }
+}
+
+TEST(StateObserverNotifierTest, slowAsyncObserverDoesNotDelaySync) {
+  StateObserverNotifier notifier(1, 4);
+  RecordingObserver slow(true /* blockFirst */);
+  RecordingObserver sync;
+  notifier.add(&slow, "slow", Mode::ASYNC);
+  notifier.add(&sync, "sync", Mode::SYNC);
+
+  auto states = makeStates(4);
+  for (auto i = 0; i < 3; ++i) {
+    notifier.notify(StateDelta(states[i], states[i + 1]));
+  }
+  slow.waitUntilBlocked();
+  EXPECT_EQ(sync.seen().size(), 3u);
+  EXPECT_EQ(slow.seen().size(), 0u);
+  EXPECT_EQ(notifier.getBacklog(&slow), 3u);
+
+  slow.release();
+  notifier.waitForAsyncObservers();
+  EXPECT_EQ(slow.seen(), sync.seen());
+}
+
+TEST(StateObserverNotifierTest, backlogIsBounded) {
+  constexpr uint32_t kMaxBacklog = 2;
+  StateObserverNotifier notifier(1, kMaxBacklog);
+  RecordingObserver slow(true /* blockFirst */);
+  notifier.add(&slow, "slow", Mode::ASYNC);
+
+  auto states = makeStates(kMaxBacklog + 2);
+  for (uint32_t i = 0; i < kMaxBacklog; ++i) {
+    notifier.notify(StateDelta(states[i], states[i + 1]));
+  }
+  slow.waitUntilBlocked();
+  EXPECT_EQ(notifier.getBacklog(&slow), kMaxBacklog);
+
+  // The next notification waits for the observer to catch up
+  std::atomic<bool> notified{false};
+  std::thread updateThread([&]() {
+    notifier.notify(
+        StateDelta(states[kMaxBacklog], states[kMaxBacklog + 1]));
+    notified = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_FALSE(notified);
+
+  slow.release();
+  updateThread.join();
+  EXPECT_TRUE(notified);
+  notifier.remove(&slow);
+  EXPECT_EQ(slow.seen().size(), kMaxBacklog + 1);
+}
+
+TEST(StateObserverNotifierTest, removeWaitsForBacklog) {
+  StateObserverNotifier notifier(1, 4);
+  RecordingObserver slow(true /* blockFirst */);
+  notifier.add(&slow, "slow", Mode::ASYNC);
+
+  auto states = makeStates(3);
+  notifier.notify(StateDelta(states[0], states[1]));
+  notifier.notify(StateDelta(states[1], states[2]));
+  slow.waitUntilBlocked();
+  slow.release();
+  notifier.remove(&slow);
+  EXPECT_EQ(slow.seen().size(), 2u);
+  EXPECT_FALSE(notifier.isRegistered(&slow));
+}
+
+TEST(StateObserverNotifierTest, destroyAsyncObserverWhileUpdating) {
+  StateObserverNotifier notifier(2, 4);
+  folly::ScopedEventBaseThread updateThread("update");
+  auto updateEvb = updateThread.getEventBase();
+  std::atomic<int> notifiedAfterDestroy{0};
+
+  constexpr auto kNumObservers = 8;
+  std::vector<std::unique_ptr<SelfRemovingObserver>> observers;
+  updateEvb->runInEventBaseThreadAndWait([&]() {
+    for (auto i = 0; i < kNumObservers; ++i) {
+      observers.push_back(std::make_unique<SelfRemovingObserver>(
+          &notifier, updateEvb, &notifiedAfterDestroy));
+      notifier.add(observers.back().get(), "async", Mode::ASYNC);
+    }
+  });
+
+  // Publish updates back to back on the update thread, interleaved with
+  // the removals
+  auto states = makeStates(2);
+  bool stop = false;
+  std::function<void()> publish = [&]() {
+    if (stop) {
+      return;
+    }
+    notifier.notify(StateDelta(states[0], states[1]));
+    updateEvb->runInEventBaseThread(publish);
+  };
+  updateEvb->runInEventBaseThread(publish);
+
+  for (auto& observer : observers) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    observer.reset();
+  }
+  updateEvb->runInEventBaseThreadAndWait([&]() { stop = true; });
+  // Let the last publish queued see stop
+  updateEvb->runInEventBaseThreadAndWait([]() {});
+  EXPECT_EQ(notifiedAfterDestroy, 0);
+}
@@ -289,6 +289,8 @@ std::shared_ptr<SwitchState> waitForStateUpdates(SwSwitch* sw) {
     return nullptr;
   };
   sw->updateStateBlocking("waitForStateUpdates", snapshotUpdate);
+  // Also let the observers notified off the update thread catch up
+  sw->waitForAsyncStateObservers();
   return snapshot;
 }
 
@@ -0,0 +1,245 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+/*
+ * Loopback benchmark of the tun interface I/O, through a local tun interface
+ * set up by a TunManager (needs CAP_NET_ADMIN, and removes the other fboss
+ * tun interfaces of the host). Packets sent to the host through the
+ * TunManager are delivered to a local UDP socket, packets the host sends to
+ * a peer on the tun subnet are read by the TunIntf and handed to the
+ * SwSwitch.
+ *
+ * Run with --tun_intf_queues=N to compare with a multi-queue interface.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+#include <folly/FileUtil.h>
+#include <folly/ScopeGuard.h>
+#include <folly/String.h>
+#include <folly/io/async/EventBase.h>
+#include <folly/logging/xlog.h>
+
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/SysError.h"
+#include "fboss/agent/TunIntf.h"
+#include "fboss/agent/TunManager.h"
+#include "fboss/agent/hw/mock/MockRxPacket.h"
+#include "fboss/agent/hw/sim/SimPlatform.h"
+#include "fboss/agent/state/Interface.h"
+#include "fboss/agent/state/InterfaceMap.h"
+#include "fboss/agent/state/StateUtils.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/Vlan.h"
+#include "fboss/agent/state/VlanMap.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <array>
+#include <thread>
+#include <vector>
+
+using namespace facebook::fboss;
+using folly::IPAddress;
+using folly::MacAddress;
+using std::make_shared;
+using std::make_unique;
+using std::shared_ptr;
+using std::unique_ptr;
+
+namespace {
+
+const InterfaceID kIntfID(4000);
+const VlanID kVlanID(4000);
+constexpr auto kHostAddr = "10.254.254.1";
+constexpr auto kPeerAddr = "10.254.254.2";
+constexpr uint16_t kHostPort = 10001;
+constexpr int kMtu = 1500;
+constexpr int kNumSendThreads = 4;
+// Stay below the tun interface's default txqueuelen of 500
+constexpr size_t kMaxPacketsInFlight = 256;
+
+// Global state used by the benchmarks
+unique_ptr<SwSwitch> sw;
+unique_ptr<folly::EventBase> evb;
+unique_ptr<TunManager> tunMgr;
+std::string tunIntfName;
+unique_ptr<MockRxPacket> udpToHost;
+int hostSock = -1;
+
+unique_ptr<SwSwitch> setupSwitch() {
+  auto sw = make_unique<SwSwitch>(
+      make_unique<SimPlatform>(MacAddress("02:00:01:00:00:01"), 10));
+  sw->init(nullptr /* No custom TunManager */);
+
+  sw->updateStateBlocking("setup", [](const shared_ptr<SwitchState>& old) {
+    auto state = old->clone();
+    state->addVlan(make_shared<Vlan>(kVlanID, "Vlan4000"));
+    auto intf = make_shared<Interface>(
+        kIntfID,
+        RouterID(0),
+        kVlanID,
+        "interface4000",
+        MacAddress("02:00:01:00:00:01"),
+        kMtu,
+        true, /* is virtual, i.e. up without ports */
+        false /* is state_sync disabled*/);
+    Interface::Addresses addrs;
+    addrs.emplace(IPAddress(kHostAddr), 24);
+    intf->setAddresses(addrs);
+    state->addIntf(intf);
+    return state;
+  });
+  return sw;
+}
+
+// UDP socket the packets sent to the host are delivered to
+int openHostSocket() {
+  auto sock = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+  sysCheckError(sock, "Failed to open socket");
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(kHostPort);
+  inet_pton(AF_INET, kHostAddr, &addr.sin_addr);
+  auto ret = bind(sock, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+  sysCheckError(ret, "Failed to bind to ", kHostAddr, ":", kHostPort);
+  return sock;
+}
+
+void drainHostSocket() {
+  std::array<char, kMtu> buf;
+  while (recv(hostSock, buf.data(), buf.size(), 0) > 0) {
+  }
+}
+
+// Packets the kernel handed over to the tun fds, i.e. read by the TunIntf
+uint64_t tunTxPackets() {
+  std::string stat;
+  auto path = folly::to<std::string>(
+      "/sys/class/net/", tunIntfName, "/statistics/tx_packets");
+  if (!folly::readFile(path.c_str(), stat)) {
+    throw SysError(errno, "Failed to read ", path);
+  }
+  return folly::to<uint64_t>(folly::trimWhitespace(stat));
+}
+
+void init() {
+  sw = setupSwitch();
+  evb = make_unique<folly::EventBase>();
+
+  // Creates the tun interface, with the host address, and starts reading it.
+  // The evb is only looped by the read benchmark, on this thread.
+  tunMgr = make_unique<TunManager>(sw.get(), evb.get());
+  tunMgr->sync(sw->getState());
+  tunIntfName = util::createTunIntfName(kIntfID);
+  hostSock = openHostSocket();
+
+  udpToHost = MockRxPacket::fromHex(
+      // dst mac, src mac, ethertype
+      "02 00 01 00 00 01  02 00 00 00 00 02  08 00"
+      // IPv4, length 92, DF, TTL 64, UDP, checksum
+      "45 00 00 5c  00 00 40 00  40 11 28 91"
+      // src 10.254.254.2, dst 10.254.254.1
+      "0a fe fe 02  0a fe fe 01"
+      // UDP 10000 -> 10001, length 72, no checksum
+      "27 10 27 11  00 48 00 00"
+      // 64 bytes of payload
+      "00 00 00 00 00 00 00 00  00 00 00 00 00 00 00 00"
+      "00 00 00 00 00 00 00 00  00 00 00 00 00 00 00 00"
+      "00 00 00 00 00 00 00 00  00 00 00 00 00 00 00 00"
+      "00 00 00 00 00 00 00 00  00 00 00 00 00 00 00 00");
+}
+
+void sendPacketsToHost(size_t numPackets) {
+  for (size_t n = 0; n < numPackets; ++n) {
+    CHECK(tunMgr->sendPacketToHost(kIntfID, udpToHost->clone()));
+  }
+}
+
+} // unnamed namespace
+
+BENCHMARK(TunIntfSendPacketsToHost, numIters) {
+  sendPacketsToHost(numIters);
+  BENCHMARK_SUSPEND {
+    drainHostSocket();
+  }
+}
+
+BENCHMARK_RELATIVE(TunIntfSendPacketsToHostFromThreads, numIters) {
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumSendThreads; ++i) {
+    threads.emplace_back(sendPacketsToHost, numIters / kNumSendThreads);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  BENCHMARK_SUSPEND {
+    drainHostSocket();
+  }
+}
+
+BENCHMARK(TunIntfReadPacketsFromHost, numIters) {
+  folly::BenchmarkSuspender suspender;
+  auto sock = socket(AF_INET, SOCK_DGRAM, 0);
+  sysCheckError(sock, "Failed to open socket");
+  SCOPE_EXIT {
+    close(sock);
+  };
+  struct sockaddr_in peer;
+  memset(&peer, 0, sizeof(peer));
+  peer.sin_family = AF_INET;
+  peer.sin_port = htons(kHostPort);
+  inet_pton(AF_INET, kPeerAddr, &peer.sin_addr);
+  std::array<char, 64> payload{};
+
+  // Queue packets to the tun interface, then time reading them
+  for (size_t sent = 0; sent < numIters;) {
+    auto toSend = std::min(numIters - sent, kMaxPacketsInFlight);
+    auto readBefore = tunTxPackets();
+    for (size_t n = 0; n < toSend; ++n) {
+      auto ret = sendto(
+          sock,
+          payload.data(),
+          payload.size(),
+          0,
+          reinterpret_cast<struct sockaddr*>(&peer),
+          sizeof(peer));
+      sysCheckError(ret, "Failed to send to ", kPeerAddr);
+    }
+    suspender.dismiss();
+    while (tunTxPackets() - readBefore < toSend) {
+      evb->loopOnce(EVLOOP_NONBLOCK);
+    }
+    suspender.rehire();
+    sent += toSend;
+  }
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  // Creating the tun interface is fairly expensive, do it once for all
+  // benchmark functions.
+  init();
+  XLOG(INFO) << "Benchmarking " << tunIntfName << " with "
+             << FLAGS_tun_intf_queues << " queues";
+
+  folly::runBenchmarks();
+
+  // Syncing a state without interfaces deletes the tun interface
+  auto state = sw->getState()->clone();
+  state->resetIntfs(make_shared<InterfaceMap>());
+  tunMgr->sync(state);
+  tunMgr.reset();
+  close(hostSock);
+  return 0;
+}
@@ -8,6 +8,7 @@
 #include <exception>
 #include <functional>
 #include <memory>
+#include <new>
 #include <string>
 #include <utility>
 #include <vector>
@@ -22,12 +23,20 @@
 #include <optional>
 
 namespace facebook::network {
+
+template <typename NODE>
+class RadixTreeNodePool;
+
 /*
  * Node in RadixTree, holds IP, mask. Will hold  value for nodes
  * created as a result of user inserts. Other type of nodes are
  * ones created by the radix tree implementation, which will
  * hold no values. All non value nodes will have 2 children,
  * this invariant must be maintained at all times.
+ *
+ * Nodes are allocated from, and returned to, the RadixTreeNodePool of the
+ * tree they were created by. The node delete callback is held by the pool
+ * rather than by every node.
  */
 template <typename IPADDRTYPE, typename T>
 class RadixTreeNode {
@@ -35,29 +44,29 @@ class RadixTreeNode {
   // Optional function parameter to call from destructor
   typedef std::function<void(const RadixTreeNode<IPADDRTYPE, T>&)>
       NodeDeleteCallback;
+  typedef RadixTreeNodePool<RadixTreeNode> NodePool;
 
-  RadixTreeNode(
-      const IPADDRTYPE& ipAddr,
-      uint8_t mlen,
-      NodeDeleteCallback deleteCallback)
-      : ipAddress_(ipAddr), masklen_(mlen), deleteCallback_(deleteCallback) {}
+  // Destroys the node and returns its memory to its pool
+  struct Deleter {
+    void operator()(RadixTreeNode* node) const;
+  };
+  typedef std::unique_ptr<RadixTreeNode, Deleter> Ptr;
+
+  RadixTreeNode(const IPADDRTYPE& ipAddr, uint8_t mlen, NodePool* pool)
+      : ipAddress_(ipAddr), masklen_(mlen), pool_(pool) {}
 
   template <typename VALUE>
   RadixTreeNode(
       const IPADDRTYPE& ipAddr,
       uint8_t mlen,
       VALUE&& val,
-      NodeDeleteCallback deleteCallback)
+      NodePool* pool)
       : ipAddress_(ipAddr),
         masklen_(mlen),
-        value_(std::forward<VALUE>(val)),
-        deleteCallback_(deleteCallback) {}
+        pool_(pool),
+        value_(std::forward<VALUE>(val)) {}
 
-  ~RadixTreeNode() {
-    if (deleteCallback_) {
-      deleteCallback_(*this);
-    }
-  }
+  ~RadixTreeNode();
 
   enum class TreeDirection { LEFT, RIGHT, PARENT, THIS_NODE };
 
@@ -100,11 +109,9 @@ class RadixTreeNode {
   T& value() {
     return value_.value();
   }
-  NodeDeleteCallback nodeDeleteCallback() const {
-    return deleteCallback_;
-  }
+  NodeDeleteCallback nodeDeleteCallback() const;
   std::string str(bool printValue = true) const {
-    auto nodeStr = folly::to<std::string>(ipAddress_.str(), "/", masklen_);
+    auto nodeStr = folly::to<std::string>(ipAddress_.str(), "/", masklen());
     if (printValue) {
       nodeStr += isNonValueNode()
           ? "(*)"
@@ -129,8 +136,7 @@ class RadixTreeNode {
         (!isValueNode() || this->value() == r.value());
   }
 
-  std::unique_ptr<RadixTreeNode> resetLeft(
-      std::unique_ptr<RadixTreeNode> newLeft) {
+  Ptr resetLeft(Ptr newLeft) {
     auto old = std::move(left_);
     left_ = std::move(newLeft);
     if (left_) {
@@ -139,8 +145,7 @@ class RadixTreeNode {
     return old;
   }
 
-  std::unique_ptr<RadixTreeNode> resetRight(
-      std::unique_ptr<RadixTreeNode> newRight) {
+  Ptr resetRight(Ptr newRight) {
     auto old = std::move(right_);
     right_ = std::move(newRight);
     if (right_) {
@@ -163,15 +168,107 @@ class RadixTreeNode {
   }
 
  protected:
+  // Links first, they are what lookups and iteration touch
+  Ptr left_{nullptr};
+  Ptr right_{nullptr};
+  RadixTreeNode* parent_{nullptr};
   IPADDRTYPE ipAddress_;
-  uint32_t masklen_{0}; // Number of bits to match.
+  uint8_t masklen_{0}; // Number of bits to match.
+  NodePool* pool_;
   std::optional<T> value_;
-  std::unique_ptr<RadixTreeNode> left_{nullptr};
-  std::unique_ptr<RadixTreeNode> right_{nullptr};
-  RadixTreeNode* parent_{nullptr};
+};
+
+/*
+ * Slab allocator for the nodes of a radix tree. Nodes are carved out of
+ * slabs of kNodesPerSlab and recycled through a free list, keeping the nodes
+ * of a tree close together rather than spread all over the heap. Slabs are
+ * only released when the pool is destroyed. Not thread safe, like the tree.
+ */
+template <typename NODE>
+class RadixTreeNodePool {
+ public:
+  typedef typename NODE::NodeDeleteCallback NodeDeleteCallback;
+  static constexpr size_t kNodesPerSlab = 256;
+
+  explicit RadixTreeNodePool(NodeDeleteCallback deleteCallback)
+      : deleteCallback_(std::move(deleteCallback)) {}
+
+  RadixTreeNodePool(const RadixTreeNodePool&) = delete;
+  RadixTreeNodePool& operator=(const RadixTreeNodePool&) = delete;
+
+  template <typename... Args>
+  typename NODE::Ptr makeNode(Args&&... args) {
+    auto slot = allocate();
+    try {
+      return typename NODE::Ptr(
+          new (slot) NODE(std::forward<Args>(args)..., this));
+    } catch (...) {
+      deallocate(slot);
+      throw;
+    }
+  }
+
+  void deallocate(void* node) {
+    auto slot = static_cast<Slot*>(node);
+    slot->next = freeList_;
+    freeList_ = slot;
+  }
+
+  const NodeDeleteCallback& deleteCallback() const {
+    return deleteCallback_;
+  }
+
+  // Memory held by the pool, whether in use by nodes or not
+  size_t memoryUsage() const {
+    return slabs_.size() * kNodesPerSlab * sizeof(Slot);
+  }
+
+ private:
+  union Slot {
+    Slot* next;
+    alignas(NODE) unsigned char storage[sizeof(NODE)];
+  };
+
+  void* allocate() {
+    if (freeList_) {
+      auto slot = freeList_;
+      freeList_ = slot->next;
+      return slot;
+    }
+    if (slabs_.empty() || nextInSlab_ == kNodesPerSlab) {
+      slabs_.emplace_back(new Slot[kNodesPerSlab]);
+      nextInSlab_ = 0;
+    }
+    return &slabs_.back()[nextInSlab_++];
+  }
+
+  std::vector<std::unique_ptr<Slot[]>> slabs_;
+  size_t nextInSlab_{0};
+  Slot* freeList_{nullptr};
   NodeDeleteCallback deleteCallback_;
 };
 
+template <typename IPADDRTYPE, typename T>
+RadixTreeNode<IPADDRTYPE, T>::~RadixTreeNode() {
+  if (pool_->deleteCallback()) {
+    pool_->deleteCallback()(*this);
+  }
+}
+
+template <typename IPADDRTYPE, typename T>
+typename RadixTreeNode<IPADDRTYPE, T>::NodeDeleteCallback
+RadixTreeNode<IPADDRTYPE, T>::nodeDeleteCallback() const {
+  return pool_->deleteCallback();
+}
+
+template <typename IPADDRTYPE, typename T>
+void RadixTreeNode<IPADDRTYPE, T>::Deleter::operator()(
+    RadixTreeNode* node) const {
+  auto pool = node->pool_;
+  node->~RadixTreeNode();
+  pool->deallocate(node);
+}
+
 /*
  * Forward Iterator to traverse a Radix tree
  * Traverses the tree in DFS/preorder fashion
@@ -378,6 +475,7 @@ class RadixTree {
   typedef RadixTreeNode<IPADDRTYPE, T> TreeNode;
   typedef typename TreeNode::TreeDirection TreeDirection;
   typedef typename TreeNode::NodeDeleteCallback NodeDeleteCallback;
+  typedef typename TreeNode::NodePool NodePool;
   typedef typename TreeTraits::Iterator Iterator;
   typedef typename TreeTraits::ConstIterator ConstIterator;
   typedef typename std::vector<ConstIterator> VecConstIterators;
@@ -406,6 +504,7 @@ class RadixTree {
   // Free all nodes and clear the tree.
   void clear() {
     root_.reset(nullptr);
+    adoptedPools_.clear();
     size_ = 0;
   }
   RadixTree(RadixTree&& r) noexcept
@@ -418,6 +517,13 @@ class RadixTree {
     // ones with which this Radix tree was created
     size_ = r.size_;
     makeRoot(std::move(r.root_));
+    // The moved nodes still belong to r's pools, which we now keep alive.
+    // r starts over with a pool of its own if it gets reused.
+    adoptedPools_ = std::move(r.adoptedPools_);
+    if (r.pool_) {
+      adoptedPools_.push_back(std::move(r.pool_));
+    }
+    r.adoptedPools_.clear();
     r.size_ = 0;
     return *this;
   }
@@ -430,7 +536,7 @@ class RadixTree {
         "clone template type must be the same as Radix tree value type");
     RadixTree copy(nodeDeleteCallback_, traits_);
     copy.size_ = size_;
-    copy.root_ = cloneSubTree(root_.get());
+    copy.root_ = cloneSubTree(root_.get(), copy.nodePool());
     return copy;
   }
   /*
@@ -588,9 +694,19 @@ class RadixTree {
   const TreeTraits& traits() const {
     return traits_;
   }
+  // Memory held for the nodes of this tree
+  size_t nodeMemoryUsage() const {
+    auto usage = pool_ ? pool_->memoryUsage() : 0;
+    for (const auto& pool : adoptedPools_) {
+      usage += pool->memoryUsage();
+    }
+    return usage;
+  }
 
  private:
-  static std::unique_ptr<TreeNode> cloneSubTree(const TreeNode* node);
+  static typename TreeNode::Ptr cloneSubTree(
+      const TreeNode* node,
+      NodePool* pool);
   // Worker function to do the actual longest match lookup.
   const TreeNode* longestMatchImpl(
       const IPADDRTYPE& ipaddr,
@@ -611,18 +727,25 @@ class RadixTree {
             ipaddr, masklen, foundExact, includeNonValueNodes, trail));
   }
 
-  std::unique_ptr<TreeNode> makeNode(const IPADDRTYPE& ip, uint8_t masklen) {
-    return std::make_unique<TreeNode>(ip, masklen, nodeDeleteCallback_);
+  // Pools are created on first use, moved from trees don't allocate
+  NodePool* nodePool() {
+    if (!pool_) {
+      pool_ = std::make_unique<NodePool>(nodeDeleteCallback_);
+    }
+    return pool_.get();
+  }
+
+  typename TreeNode::Ptr makeNode(const IPADDRTYPE& ip, uint8_t masklen) {
+    return nodePool()->makeNode(ip, masklen);
   }
 
   template <typename VALUE>
-  std::unique_ptr<TreeNode>
+  typename TreeNode::Ptr
   makeNode(const IPADDRTYPE& ip, uint8_t masklen, VALUE&& value) {
-    return std::make_unique<TreeNode>(
-        ip, masklen, std::forward<VALUE>(value), nodeDeleteCallback_);
+    return nodePool()->makeNode(ip, masklen, std::forward<VALUE>(value));
   }
 
-  void makeRoot(std::unique_ptr<TreeNode> newRoot) {
+  void makeRoot(typename TreeNode::Ptr newRoot) {
     CHECK(root_ != newRoot || root_ == nullptr);
     if (newRoot) {
       newRoot->setParent(nullptr);
@@ -635,7 +758,11 @@ class RadixTree {
       bool includeNonValueNodes,
       const TreeNode* node) const;
 
-  std::unique_ptr<TreeNode> root_{nullptr};
+  // Declared ahead of root_, nodes must be freed before their pools
+  std::unique_ptr<NodePool> pool_;
+  // Pools of the nodes taken over from moved trees
+  std::vector<std::unique_ptr<NodePool>> adoptedPools_;
+  typename TreeNode::Ptr root_{nullptr};
   size_t size_{0};
   NodeDeleteCallback nodeDeleteCallback_;
   TreeTraits traits_;
@@ -10,12 +10,196 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <new>
+#include <set>
 #include <unordered_map>
+#include <vector>
 
 #include <boost/container/flat_map.hpp>
 
 namespace facebook::fboss {
+
+/*
+ * Slab allocator for the values of a RefMap. Each value is allocated along
+ * with its shared_ptr control block, in a fixed size slot carved out of
+ * slabs of kSlotsPerSlab slots and recycled through a per slab free list.
+ * That is one allocation per value instead of two, without the per
+ * allocation overhead of the heap, which adds up for maps holding hundreds
+ * of thousands of values (SAI routes, neighbors, ...).
+ *
+ * Slots are handed out from the lowest addressed slab with room, so that
+ * values concentrate in few slabs as the map shrinks. Slabs left empty go
+ * back to the system, except for one kept around so that a map hovering at
+ * a slab boundary does not allocate and free a slab on every change.
+ *
+ * The slot size is set by the first allocation: the pool only ever sees
+ * allocations of one control block type.
+ *
+ * Allocation is not thread safe, but slotsInUse() and bytesAllocated() may
+ * be read from any thread.
+ */
+class RefMapSlabPool {
+ public:
+  static constexpr size_t kSlotsPerSlab = 512;
+
+  RefMapSlabPool() {}
+  RefMapSlabPool(const RefMapSlabPool&) = delete;
+  RefMapSlabPool& operator=(const RefMapSlabPool&) = delete;
+
+  bool fits(size_t size, size_t alignment) const {
+    return alignment <= alignof(std::max_align_t) &&
+        (!slotSize_ || slotSize(size) == slotSize_);
+  }
+
+  void* allocate(size_t size) {
+    if (!slotSize_) {
+      slotSize_ = slotSize(size);
+    }
+    if (available_.empty()) {
+      auto slots = new std::byte[kSlotsPerSlab * slotSize_];
+      slabs_.emplace(slots, Slab(slots));
+      available_.insert(slots);
+      ++emptySlabs_;
+      bytesAllocated_ += kSlotsPerSlab * slotSize_;
+    }
+    auto& slab = slabs_.find(*available_.begin())->second;
+    void* slot;
+    if (slab.freeList) {
+      slot = slab.freeList;
+      slab.freeList = slab.freeList->next;
+    } else {
+      slot = slab.slots.get() + slotSize_ * slab.nextUnused++;
+    }
+    if (slab.inUse++ == 0) {
+      --emptySlabs_;
+    }
+    if (slab.inUse == kSlotsPerSlab) {
+      available_.erase(slab.slots.get());
+    }
+    ++slotsInUse_;
+    return slot;
+  }
+
+  void deallocate(void* slot) {
+    auto itr = std::prev(slabs_.upper_bound(static_cast<std::byte*>(slot)));
+    auto& slab = itr->second;
+    slab.freeList = new (slot) FreeSlot{slab.freeList};
+    if (slab.inUse-- == kSlotsPerSlab) {
+      available_.insert(slab.slots.get());
+    }
+    --slotsInUse_;
+    if (slab.inUse) {
+      return;
+    }
+    if (emptySlabs_) {
+      available_.erase(slab.slots.get());
+      slabs_.erase(itr);
+      bytesAllocated_ -= kSlotsPerSlab * slotSize_;
+    } else {
+      ++emptySlabs_;
+    }
+  }
+
+  size_t slotsInUse() const {
+    return slotsInUse_.load(std::memory_order_relaxed);
+  }
+  // Memory held by the slabs, used or free
+  size_t bytesAllocated() const {
+    return bytesAllocated_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct FreeSlot {
+    FreeSlot* next;
+  };
+
+  struct Slab {
+    explicit Slab(std::byte* slots) : slots(slots) {}
+    std::unique_ptr<std::byte[]> slots;
+    size_t inUse{0};
+    // Slots past this one were never handed out
+    size_t nextUnused{0};
+    FreeSlot* freeList{nullptr};
+  };
+
+  static size_t slotSize(size_t size) {
+    constexpr auto kAlignment = alignof(std::max_align_t);
+    size = std::max(size, sizeof(FreeSlot));
+    return (size + kAlignment - 1) / kAlignment * kAlignment;
+  }
+
+  size_t slotSize_{0};
+  // Keyed by the address of their first slot, to find the slab of a slot
+  std::map<std::byte*, Slab> slabs_;
+  // Slabs with free slots
+  std::set<std::byte*> available_;
+  size_t emptySlabs_{0};
+  std::atomic<size_t> slotsInUse_{0};
+  std::atomic<size_t> bytesAllocated_{0};
+};
+
+/*
+ * Allocator handing out RefMapSlabPool slots. Control blocks keep a copy of
+ * their allocator, so the pool lives on as long as any value does, even past
+ * the RefMap.
+ */
+template <typename T>
+class RefMapSlabAllocator {
+ public:
+  using value_type = T;
+
+  explicit RefMapSlabAllocator(std::shared_ptr<RefMapSlabPool> pool)
+      : pool_(std::move(pool)) {}
+  template <typename U>
+  RefMapSlabAllocator(const RefMapSlabAllocator<U>& other)
+      : pool_(other.pool()) {}
+
+  T* allocate(size_t n) {
+    if (n == 1 && pool_->fits(sizeof(T), alignof(T))) {
+      return static_cast<T*>(pool_->allocate(sizeof(T)));
+    }
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, size_t n) {
+    if (n == 1 && pool_->fits(sizeof(T), alignof(T))) {
+      pool_->deallocate(p);
+      return;
+    }
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  const std::shared_ptr<RefMapSlabPool>& pool() const {
+    return pool_;
+  }
+
+  template <typename U>
+  bool operator==(const RefMapSlabAllocator<U>& other) const {
+    return pool_ == other.pool();
+  }
+  template <typename U>
+  bool operator!=(const RefMapSlabAllocator<U>& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  std::shared_ptr<RefMapSlabPool> pool_;
+};
+
+struct RefMapMemoryUsage {
+  size_t numValues{0};
+  /*
+   * Slabs plus map entries. Does not include the memory the values own
+   * themselves.
+   */
+  size_t bytes{0};
+};
 /*
  * RefMap is a helper class template for managing SAI objects with shared
  * ownership _within_ SAI. If the creation or deletion of an object is
@@ -109,6 +293,16 @@ class RefMap {
     return map_.cend();
   }
 
+  RefMapMemoryUsage memoryUsage() const {
+    RefMapMemoryUsage usage;
+    usage.numValues = pool_->slotsInUse();
+    // One map entry per value, counted off the pool rather than the map so
+    // that usage can be read while the map is being changed
+    usage.bytes = pool_->bytesAllocated() +
+        usage.numValues * sizeof(typename MapType::value_type);
+    return usage;
+  }
+
   long referenceCount(const K& k) const {
     auto iter = map_.find(k);
     if (iter == map_.cend() || iter->second.expired()) {
@@ -122,13 +316,31 @@ class RefMap {
   }
 
  private:
+  /*
+   * Values are allocated along with the key they are mapped from, to unmap
+   * it once the last reference to them goes away.
+   */
+  struct Node {
+    template <typename... Args>
+    Node(MapType* map, const K& key, Args&&... args)
+        : map(map), key(key), value{std::forward<Args>(args)...} {}
+    ~Node() {
+      map->erase(key);
+    }
+
+    MapType* map;
+    K key;
+    V value;
+  };
+
   template <typename... Args>
   std::shared_ptr<V> makeShared(const K& k, Args&&... args) {
-    auto del = [&m = map_, k](V* v) {
-      m.erase(k);
-      std::default_delete<V>()(v);
-    };
-    return std::shared_ptr<V>(new V{std::forward<Args>(args)...}, del);
+    auto node = std::allocate_shared<Node>(
+        RefMapSlabAllocator<Node>(pool_),
+        &map_,
+        k,
+        std::forward<Args>(args)...);
+    return std::shared_ptr<V>(node, &node->value);
   }
 
   template <typename... Args>
@@ -147,6 +359,7 @@ class RefMap {
   }
 
   MapType map_;
+  std::shared_ptr<RefMapSlabPool> pool_{std::make_shared<RefMapSlabPool>()};
 };
 
 template <typename K, typename V>
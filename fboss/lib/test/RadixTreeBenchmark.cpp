@@ -117,6 +117,26 @@ BENCHMARK_RELATIVE(RadixTreeLongestMatch4) {
   }
 }
 
+BENCHMARK(RadixTreeIterate4) {
+  RadixTree<IPAddressV4, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree4(rtree);
+  }
+  auto sum = 0;
+  for (const auto& node : rtree) {
+    sum += node.value();
+  }
+  doNotOptimizeAway(sum);
+}
+
+BENCHMARK(RadixTreeClear4) {
+  RadixTree<IPAddressV4, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree4(rtree);
+  }
+  rtree.clear();
+}
+
 // V6 benchmarks
 
 template <typename TREE>
@@ -197,6 +217,26 @@ BENCHMARK_RELATIVE(RadixTreeLongestMatch6) {
   }
 }
 
+BENCHMARK(RadixTreeIterate6) {
+  RadixTree<IPAddressV6, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree6(rtree);
+  }
+  auto sum = 0;
+  for (const auto& node : rtree) {
+    sum += node.value();
+  }
+  doNotOptimizeAway(sum);
+}
+
+BENCHMARK(RadixTreeClear6) {
+  RadixTree<IPAddressV6, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree6(rtree);
+  }
+  rtree.clear();
+}
+
 } // namespace
 
 int main(int /*argc*/, char* /*argv*/[]) {
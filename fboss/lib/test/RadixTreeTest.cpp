@@ -1527,3 +1527,64 @@ TEST(RadixTree, SubTreeIterator) {
   }
   EXPECT_EQ(rtree.end().subTreeIterator(), rtree.end());
 }
+
+TEST(RadixTree, NodeMemoryReused) {
+  RadixTree<IPAddressV4, int> rtree;
+  EXPECT_EQ(0, rtree.nodeMemoryUsage());
+  auto prefixesInserted = setupTestTree4(rtree);
+  auto memoryUsage = rtree.nodeMemoryUsage();
+  EXPECT_GT(memoryUsage, 0);
+  // Erased nodes go back to the tree's pool and are handed out again
+  for (auto i = 0; i < 10; ++i) {
+    for (const auto& pfx : prefixesInserted) {
+      EXPECT_TRUE(rtree.erase(pfx.ip, pfx.mask));
+    }
+    EXPECT_EQ(0, rtree.size());
+    setupTestTree4(rtree);
+    EXPECT_EQ(memoryUsage, rtree.nodeMemoryUsage());
+  }
+  RadixTree<IPAddressV4, int> rtreeOrig;
+  setupTestTree4(rtreeOrig);
+  EXPECT_TRUE(rtree == rtreeOrig);
+}
+
+TEST(RadixTree, MoveKeepsDeleteCallback) {
+  auto deleteCount = 0;
+  auto deleteCallback = [&](const RadixTreeNode<IPAddressV4, int>& /*node*/) {
+    ++deleteCount;
+  };
+  RadixTree<IPAddressV4, int> rtree(deleteCallback), rtreeOrig;
+  setupTestTree4(rtree);
+  setupTestTree4(rtreeOrig);
+  auto numPrefixes = rtree.size();
+
+  RadixTree<IPAddressV4, int> moved(std::move(rtree));
+  EXPECT_EQ(0, rtree.size());
+  EXPECT_TRUE(moved == rtreeOrig);
+  // Both the moved from and the moved to trees remain usable
+  rtree.insert(ip48_0_0_0, 8, 42);
+  EXPECT_EQ(42, rtree.exactMatch(ip48_0_0_0, 8)->value());
+  RadixTree<IPAddressV4, int> assigned;
+  assigned.insert(ip48_0_0_0, 8, 42);
+  assigned = std::move(moved);
+  EXPECT_TRUE(assigned == rtreeOrig);
+  EXPECT_EQ(0, moved.size());
+
+  auto beforeDeleteCount = deleteCount;
+  assigned.clear();
+  EXPECT_GE(deleteCount - beforeDeleteCount, numPrefixes);
+}
+
+TEST(RadixTree, CloneIsIndependent) {
+  RadixTree<IPAddressV6, int> rtree, rtreeOrig;
+  auto prefixesInserted = setupTestTree6(rtree);
+  setupTestTree6(rtreeOrig);
+  auto rtreeCopy = rtree.clone();
+  for (const auto& pfx : prefixesInserted) {
+    rtree.erase(pfx.ip, pfx.mask);
+  }
+  EXPECT_TRUE(rtreeCopy == rtreeOrig);
+  for (const auto& pfx : prefixesInserted) {
+    EXPECT_NE(rtreeCopy.exactMatch(pfx.ip, pfx.mask), rtreeCopy.end());
+  }
+}
@@ -12,6 +12,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 using namespace facebook::fboss;
 
 // Dummy struct for placement into a RefMap
@@ -250,3 +252,57 @@ TEST(RefMap, UnorderedRefMapRefCountTest) {
   }
   EXPECT_EQ(refMap.referenceCount(101), 0);
 }
+
+TEST(RefMap, memoryUsage) {
+  UnorderedRefMap<int, A> refMap;
+  EXPECT_EQ(refMap.memoryUsage().numValues, 0);
+  EXPECT_EQ(refMap.memoryUsage().bytes, 0);
+  std::vector<std::shared_ptr<A>> values;
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(refMap.refOrEmplace(i, i).first);
+  }
+  auto usage = refMap.memoryUsage();
+  EXPECT_EQ(usage.numValues, 1000);
+  EXPECT_GE(usage.bytes, 1000 * sizeof(A));
+  values.resize(500);
+  EXPECT_EQ(refMap.size(), 500);
+  EXPECT_EQ(refMap.memoryUsage().numValues, 500);
+}
+
+TEST(RefMap, slabSlotsReused) {
+  FlatRefMap<int, A> refMap;
+  std::vector<std::shared_ptr<A>> values;
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(refMap.refOrEmplace(i, i).first);
+  }
+  auto usage = refMap.memoryUsage();
+  values.clear();
+  EXPECT_EQ(refMap.size(), 0);
+  // Freed slots get reused rather than new slabs allocated
+  for (int i = 1000; i < 2000; ++i) {
+    values.push_back(refMap.refOrEmplace(i, i).first);
+    EXPECT_EQ(values.back()->x, i);
+  }
+  EXPECT_EQ(refMap.memoryUsage().numValues, usage.numValues);
+  EXPECT_EQ(refMap.memoryUsage().bytes, usage.bytes);
+}
+
+TEST(RefMap, emptySlabsReleased) {
+  UnorderedRefMap<int, A> refMap;
+  std::vector<std::shared_ptr<A>> values;
+  constexpr int kNumValues = 10 * RefMapSlabPool::kSlotsPerSlab;
+  for (int i = 0; i < kNumValues; ++i) {
+    values.push_back(refMap.refOrEmplace(i, i).first);
+  }
+  auto bytesPerSlab = refMap.memoryUsage().bytes / 10;
+  values.clear();
+  // Only one empty slab is kept around
+  EXPECT_EQ(refMap.memoryUsage().numValues, 0);
+  EXPECT_LE(refMap.memoryUsage().bytes, bytesPerSlab);
+  // A map going back and forth over a slab boundary does not churn slabs
+  values.push_back(refMap.refOrEmplace(0, 0).first);
+  auto usage = refMap.memoryUsage();
+  values.clear();
+  values.push_back(refMap.refOrEmplace(1, 1).first);
+  EXPECT_EQ(refMap.memoryUsage().bytes, usage.bytes);
+}
@@ -45,6 +45,14 @@ QsfpServiceHandler::QsfpServiceHandler(
   XLOG(INFO) << "FbossPhyMacsecService inside QsfpServiceHandler Started";
 }
 
+QsfpServiceHandler::~QsfpServiceHandler() {
+  // Complete the streams outside the lock, their completion callbacks take it
+  auto publishers = std::move(tcvrInfoSubscriptions_.wlock()->publishers);
+  for (auto& [id, publisher] : publishers) {
+    std::move(publisher).complete();
+  }
+}
+
 void QsfpServiceHandler::init() {
   // Initialize the PhyManager all ExternalPhy for the system
   manager_->initExternalPhyMap();
@@ -98,6 +106,95 @@ void QsfpServiceHandler::syncPorts(
   manager_->syncPorts(info, std::move(ports));
 }
 
+// timeCollected changes with every refresh, it alone doesn't make an update
+static bool sameTransceiverInfo(
+    const TransceiverInfo& published,
+    TransceiverInfo& info) {
+  auto timeCollected = info.timeCollected_ref().to_optional();
+  info.timeCollected_ref().copy_from(published.timeCollected_ref());
+  bool same = info == published;
+  info.timeCollected_ref().from_optional(timeCollected);
+  return same;
+}
+
+apache::thrift::ServerStream<TransceiverInfoUpdate>
+QsfpServiceHandler::subscribeTransceiverInfo() {
+  auto log = LOG_THRIFT_CALL(INFO);
+  return tcvrInfoSubscriptions_.withWLock([this](auto& subscriptions) {
+    // Bring the published info up to date for existing subscribers first,
+    // so that the new one starts at the same generation as they are.
+    publishTransceiverInfoChangesLocked(subscriptions);
+
+    auto id = subscriptions.nextId++;
+    auto streamAndPublisher =
+        apache::thrift::ServerStream<TransceiverInfoUpdate>::createPublisher(
+            [this, id] {
+              XLOG(INFO) << "Transceiver info subscriber " << id << " gone";
+              tcvrInfoSubscriptions_.wlock()->publishers.erase(id);
+            });
+    TransceiverInfoUpdate update;
+    update.generation_ref() = subscriptions.generation;
+    update.full_ref() = true;
+    update.changed_ref() = subscriptions.published;
+    streamAndPublisher.second.next(std::move(update));
+    subscriptions.publishers.emplace(
+        id, std::move(streamAndPublisher.second));
+    XLOG(INFO) << "Transceiver info subscriber " << id << " starts at generation "
+               << subscriptions.generation;
+    return std::move(streamAndPublisher.first);
+  });
+}
+
+void QsfpServiceHandler::publishTransceiverInfoChanges() {
+  tcvrInfoSubscriptions_.withWLock([this](auto& subscriptions) {
+    // Nobody to publish to. Subscribing catches up from wherever we are.
+    if (subscriptions.publishers.empty()) {
+      return;
+    }
+    publishTransceiverInfoChangesLocked(subscriptions);
+  });
+}
+
+void QsfpServiceHandler::publishTransceiverInfoChangesLocked(
+    TransceiverInfoSubscriptions& subscriptions) {
+  std::map<int32_t, TransceiverInfo> current;
+  manager_->getTransceiversInfo(
+      current, std::make_unique<std::vector<int32_t>>());
+
+  TransceiverInfoUpdate update;
+  auto& published = subscriptions.published;
+  for (auto& [id, info] : current) {
+    auto it = published.find(id);
+    if (it != published.end() && sameTransceiverInfo(it->second, info)) {
+      continue;
+    }
+    update.changed_ref()->emplace(id, info);
+    published[id] = std::move(info);
+  }
+  for (auto it = published.begin(); it != published.end();) {
+    if (current.find(it->first) == current.end()) {
+      update.removed_ref()->push_back(it->first);
+      it = published.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  if (update.changed_ref()->empty() && update.removed_ref()->empty()) {
+    return;
+  }
+
+  update.generation_ref() = ++subscriptions.generation;
+  update.full_ref() = false;
+  XLOG(DBG2) << "Publishing transceiver info generation "
+             << subscriptions.generation << ": "
+             << update.changed_ref()->size() << " changed, "
+             << update.removed_ref()->size() << " removed, to "
+             << subscriptions.publishers.size() << " subscribers";
+  for (auto& [id, publisher] : subscriptions.publishers) {
+    publisher.next(update);
+  }
+}
+
 void QsfpServiceHandler::pauseRemediation(int32_t timeout) {
   auto log = LOG_THRIFT_CALL(INFO);
   manager_->setPauseRemediation(timeout);
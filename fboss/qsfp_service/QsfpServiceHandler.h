@@ -1,6 +1,7 @@
 // Copyright 2004-present Facebook. All Rights Reserved.
 #pragma once
 
+#include <folly/Synchronized.h>
 #include <folly/futures/Future.h>
 
 #include "common/fb303/cpp/FacebookBase2.h"
@@ -23,7 +24,7 @@ class QsfpServiceHandler : public facebook::fboss::QsfpServiceSvIf,
   QsfpServiceHandler(
       std::unique_ptr<TransceiverManager> manager,
       std::shared_ptr<mka::MacsecHandler> handler);
-  ~QsfpServiceHandler() override = default;
+  ~QsfpServiceHandler() override;
 
   void init();
   facebook::fb303::cpp2::fb_status getStatus() override;
@@ -50,6 +51,19 @@ class QsfpServiceHandler : public facebook::fboss::QsfpServiceSvIf,
       std::map<int32_t, DOMDataUnion>& info,
       std::unique_ptr<std::vector<int32_t>> ids) override;
 
+  /*
+   * Stream transceiver info to the subscriber, starting with all of it and
+   * then whatever publishTransceiverInfoChanges() finds changed.
+   */
+  apache::thrift::ServerStream<TransceiverInfoUpdate> subscribeTransceiverInfo()
+      override;
+
+  /*
+   * Send the transceivers whose info changed since the last update to the
+   * subscribers of subscribeTransceiverInfo. Called after each refresh.
+   */
+  void publishTransceiverInfoChanges();
+
   /*
    * Store port status information and return relevant transceiver map.
    */
@@ -145,8 +159,22 @@ class QsfpServiceHandler : public facebook::fboss::QsfpServiceSvIf,
 
   void validateHandler() const;
 
+  struct TransceiverInfoSubscriptions {
+    // generation and content of the last update sent to subscribers
+    int64_t generation{0};
+    std::map<int32_t, TransceiverInfo> published;
+    uint64_t nextId{0};
+    std::unordered_map<
+        uint64_t,
+        apache::thrift::ServerStreamPublisher<TransceiverInfoUpdate>>
+        publishers;
+  };
+  void publishTransceiverInfoChangesLocked(
+      TransceiverInfoSubscriptions& subscriptions);
+
   std::unique_ptr<TransceiverManager> manager_{nullptr};
   std::shared_ptr<mka::MacsecHandler> macsecHandler_;
+  folly::Synchronized<TransceiverInfoSubscriptions> tcvrInfoSubscriptions_;
 };
 } // namespace fboss
 } // namespace facebook
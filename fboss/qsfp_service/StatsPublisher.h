@@ -29,6 +29,9 @@ class StatsPublisher {
   static void bumpModuleErrors();
   static void missingPorts(TransceiverID module);
   static void bumpAOIOverride();
+  static void bumpI2cBytesRead(uint64_t bytes);
+  static void bumpPageCacheHit();
+  static void bumpPageCacheMiss();
 
  private:
   TransceiverManager* transceiverManager_{nullptr};
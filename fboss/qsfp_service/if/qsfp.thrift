@@ -11,6 +11,20 @@ include "fboss/qsfp_service/if/transceiver.thrift"
 include "fboss/agent/switch_config.thrift"
 include "fboss/mka_service/if/mka_structs.thrift"
 
+/*
+ * An update on the transceiver info stream. Generations of one stream are
+ * consecutive. A full update carries all transceivers and replaces whatever
+ * the subscriber knew about, the others only carry what changed since the
+ * previous generation. A subscriber that sees a gap in generations must
+ * subscribe again to get a new full update.
+ */
+struct TransceiverInfoUpdate {
+  1: i64 generation;
+  2: bool full;
+  3: map<i32, transceiver.TransceiverInfo> changed;
+  4: list<i32> removed;
+}
+
 service QsfpService extends fb303.FacebookService {
   transceiver.TransceiverType getType(1: i32 idx);
 
@@ -20,6 +34,13 @@ service QsfpService extends fb303.FacebookService {
   map<i32, transceiver.TransceiverInfo> getTransceiverInfo(
     1: list<i32> idx,
   ) throws (1: fboss.FbossBaseError error);
+  /*
+   * Stream transceiver info as it changes. The first update is a full one,
+   * later ones are sent after qsfp_service refreshes transceivers, for the
+   * transceivers whose info changed (other than timeCollected).
+   */
+  stream<TransceiverInfoUpdate> subscribeTransceiverInfo();
+
   /*
    * Customise the transceiver based on the speed at which it should run
    */
@@ -319,6 +319,11 @@ struct TransceiverStats {
   1: double readDownTime;
   // duration between last write and last successful write
   2: double writeDownTime;
+  // bytes read from the module by data refreshes
+  3: i64 i2cBytesRead;
+  // upper page reads served from / missing the page cache
+  4: i64 pageCacheHits;
+  5: i64 pageCacheMisses;
 }
 
 struct ModuleStatus {
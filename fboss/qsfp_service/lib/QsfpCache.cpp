@@ -13,9 +13,15 @@
 
 #include "fboss/lib/AlertLogger.h"
 
+#include <folly/ExceptionString.h>
 #include <folly/logging/xlog.h>
 #include <chrono>
 
+DEFINE_bool(
+    qsfp_cache_stream_transceivers,
+    true,
+    "Get transceiver info updates streamed from qsfp_service");
+
 namespace facebook {
 namespace fboss {
 
@@ -23,6 +29,8 @@ namespace {
 constexpr std::chrono::seconds kLivenessCheckInterval(30);
 }
 
+QsfpCache::~QsfpCache() = default;
+
 void QsfpCache::init(folly::EventBase* evb, const PortMapThrift& ports) {
   if (!evb) {
     throw std::runtime_error("must pass in non-null evb");
@@ -37,7 +45,11 @@ void QsfpCache::init(folly::EventBase* evb, const PortMapThrift& ports) {
 
   portsChanged(ports);
 
-  syncAllPresentTransceivers();
+  if (FLAGS_qsfp_cache_stream_transceivers) {
+    evb_->runInEventBaseThread([this] { subscribe(); });
+  } else {
+    syncAllPresentTransceivers();
+  }
 
   attachEventBase(evb);
   scheduleTimeout(kLivenessCheckInterval);
@@ -151,7 +163,10 @@ folly::Future<folly::Unit> QsfpCache::doSync(PortMapThrift&& toSync) {
                     gen = incrementGen(),
                     oldAliveSince = remoteAliveSince_](auto&& tcvrs) {
     XLOG(DBG1) << "Got " << tcvrs.size() << " transceivers from qsfp_service";
-    updateCache(tcvrs);
+    if (!streamGen_) {
+      // The stream, when there is one, is more recent
+      updateCache(tcvrs);
+    }
     if (remoteAliveSince_ == oldAliveSince || oldAliveSince < 0) {
       // no restart occurred in middle of request, store gen
       remoteGen_ = gen;
@@ -240,6 +255,9 @@ QsfpCache::getAllTransceivers() const {
 
 void QsfpCache::timeoutExpired() noexcept {
   confirmAlive().then(&QsfpCache::maybeSync, this);
+  if (FLAGS_qsfp_cache_stream_transceivers) {
+    subscribe();
+  }
   scheduleTimeout(kLivenessCheckInterval);
 }
 
@@ -285,6 +303,108 @@ void QsfpCache::syncAllPresentTransceivers() {
       });
 }
 
+void QsfpCache::subscribe() {
+  CHECK(evb_->isInEventBaseThread());
+  if (streamActive_) {
+    return;
+  }
+  streamActive_ = true;
+  auto epoch = ++streamEpoch_;
+
+  auto onUpdate = [this, epoch](auto&& update) {
+    if (epoch != streamEpoch_) {
+      // left over from a stream we dropped
+      return;
+    }
+    if (update.hasValue()) {
+      streamUpdate(std::move(update.value()));
+    } else if (update.hasException()) {
+      XLOG(ERR) << PlatformAlert()
+                << "Transceiver info stream from qsfp_service failed: "
+                << folly::exceptionStr(update.exception());
+      streamClosed();
+    } else {
+      XLOG(INFO) << "Transceiver info stream from qsfp_service completed";
+      streamClosed();
+    }
+  };
+
+  XLOG(DBG1) << "Subscribing to transceiver info from qsfp_service";
+  QsfpClient::createStreamClient(evb_)
+      .thenValue([this, epoch](std::unique_ptr<QsfpServiceAsyncClient> client) {
+        if (epoch != streamEpoch_) {
+          throw std::runtime_error("unsubscribed");
+        }
+        streamClient_ = std::move(client);
+        auto options = QsfpClient::getRpcOptions();
+        return streamClient_->semifuture_subscribeTransceiverInfo(options).via(
+            evb_);
+      })
+      .thenValue([this, onUpdate = std::move(onUpdate)](auto&& stream) mutable {
+        std::move(stream).subscribeExTry(evb_, std::move(onUpdate)).detach();
+      })
+      .thenError(
+          folly::tag_t<std::exception>{},
+          [this, epoch](const std::exception& e) {
+            if (epoch != streamEpoch_) {
+              return;
+            }
+            XLOG(ERR) << PlatformAlert()
+                      << "Failed to subscribe to transceiver info from "
+                      << "qsfp_service: " << e.what();
+            streamClosed();
+            if (tcvrs_.rlock()->empty()) {
+              // Don't wait for ports to change to get transceivers from
+              // a qsfp_service that can't stream them
+              syncAllPresentTransceivers();
+            }
+          });
+}
+
+void QsfpCache::streamUpdate(TransceiverInfoUpdate&& update) {
+  auto generation = *update.generation_ref();
+  if (!*update.full_ref() && (!streamGen_ || generation != *streamGen_ + 1)) {
+    XLOG(WARN) << "Transceiver info generation " << generation << " after "
+               << (streamGen_ ? *streamGen_ : -1) << ", subscribing again";
+    streamClosed();
+    evb_->runInEventBaseThread([this] { subscribe(); });
+    return;
+  }
+  streamGen_ = generation;
+
+  tcvrs_.withWLock([&update](auto& lockedTcvrs) {
+    if (*update.full_ref()) {
+      lockedTcvrs.clear();
+    }
+    // Only store present transceivers
+    for (auto& [id, info] : *update.changed_ref()) {
+      if (*info.present_ref()) {
+        lockedTcvrs[TransceiverID(id)] = std::move(info);
+      } else {
+        lockedTcvrs.erase(TransceiverID(id));
+      }
+    }
+    for (auto id : *update.removed_ref()) {
+      lockedTcvrs.erase(TransceiverID(id));
+    }
+  });
+  XLOG(DBG2) << "Got transceiver info generation " << generation << ", "
+             << (*update.full_ref() ? "full" : "partial") << " update of "
+             << update.changed_ref()->size() << " transceivers";
+}
+
+void QsfpCache::streamClosed() {
+  CHECK(evb_->isInEventBaseThread());
+  ++streamEpoch_;
+  streamActive_ = false;
+  streamGen_.reset();
+}
+
+void QsfpCache::unsubscribe() {
+  streamClosed();
+  streamClient_.reset();
+}
+
 AutoInitQsfpCache::AutoInitQsfpCache() {
   init(&evb_);
   thread_.reset(new std::thread([=] { evb_.loopForever(); }));
@@ -292,6 +412,7 @@ AutoInitQsfpCache::AutoInitQsfpCache() {
 
 AutoInitQsfpCache::~AutoInitQsfpCache() {
   if (thread_) {
+    evb_.runInEventBaseThreadAndWait([this] { unsubscribe(); });
     evb_.runInEventBaseThread([this] { evb_.terminateLoopSoon(); });
     thread_->join();
   }
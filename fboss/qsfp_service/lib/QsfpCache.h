@@ -10,6 +10,7 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <optional>
 
@@ -20,11 +21,15 @@
 #include <folly/futures/SharedPromise.h>
 #include <folly/io/async/AsyncTimeout.h>
 #include <folly/io/async/EventBase.h>
+#include <gflags/gflags.h>
 
 #include "fboss/agent/if/gen-cpp2/ctrl_types.h"
 #include "fboss/agent/types.h"
+#include "fboss/qsfp_service/if/gen-cpp2/QsfpService.h"
 #include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
 
+DECLARE_bool(qsfp_cache_stream_transceivers);
+
 /*
  * This class is a helper for clients that want to exchange port state w/ qsfp
  * service. It is built around a single thrift call defined in qsfp.thrift:
@@ -60,6 +65,16 @@
  * and store the last aliveSince. If this changes, we reset remoteGen_
  * back to zero so we will re-sync all ports.
  *
+ * Transceiver info
+ * ----------------
+ * Transceiver info comes from the subscribeTransceiverInfo stream: a
+ * full update when subscribing, then updates with the transceivers that
+ * changed. Updates carry consecutive generation numbers, on a gap we drop
+ * the stream and subscribe again to get a new full update. While there is
+ * no stream (e.g. qsfp_service restarting, or too old to support it) the
+ * transceivers returned by syncPorts are cached instead, and we try to
+ * subscribe again on each liveness check.
+ *
  * Threading model
  * ---------------
  * All thrift calls to qsfp_service are done on evb_. No guarantee for
@@ -78,6 +93,7 @@ class QsfpCache : private folly::AsyncTimeout {
   using TcvrMapThrift = std::map<int32_t, TransceiverInfo>;
 
   QsfpCache() = default;
+  ~QsfpCache() override;
 
   /* Initializers. Sets the Eventbase and optionally the initial port
    * map to sync to qsfp_service.
@@ -113,6 +129,10 @@ class QsfpCache : private folly::AsyncTimeout {
   // output state of the cache. Useful for debugging
   void dump();
 
+ protected:
+  // Drops the transceiver info stream. Call in the evb thread before it stops.
+  void unsubscribe();
+
  private:
   // Forbidden copy constructor and assignment operator
   QsfpCache(QsfpCache const&) = delete;
@@ -141,6 +161,11 @@ class QsfpCache : private folly::AsyncTimeout {
 
   void syncAllPresentTransceivers();
 
+  // subscribes to the transceiver info stream, unless already subscribed
+  void subscribe();
+  void streamUpdate(TransceiverInfoUpdate&& update);
+  void streamClosed();
+
   struct PortCacheValue {
     PortStatus port;
     uint32_t generation{0};
@@ -162,6 +187,15 @@ class QsfpCache : private folly::AsyncTimeout {
   int64_t remoteAliveSince_{-1};
 
   std::atomic_bool initialized_{false};
+
+  // Transceiver info stream state, only accessed from evb_. The client has
+  // to outlive the stream. The epoch is bumped whenever a stream is dropped,
+  // to ignore whatever it still delivers.
+  std::unique_ptr<QsfpServiceAsyncClient> streamClient_;
+  uint64_t streamEpoch_{0};
+  bool streamActive_{false};
+  // generation of the last update, set once the full update is received
+  std::optional<int64_t> streamGen_;
 };
 
 class AutoInitQsfpCache : public QsfpCache {
@@ -39,6 +39,10 @@ class QsfpClient {
   static folly::Future<std::unique_ptr<QsfpServiceAsyncClient>> createClient(
       folly::EventBase* eb);
 
+  // Client over a rocket channel, needed for streaming calls
+  static folly::Future<std::unique_ptr<QsfpServiceAsyncClient>>
+  createStreamClient(folly::EventBase* eb);
+
   static apache::thrift::RpcOptions getRpcOptions();
 };
 
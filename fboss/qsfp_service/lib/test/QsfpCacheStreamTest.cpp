@@ -0,0 +1,220 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/qsfp_service/lib/QsfpCache.h"
+
+#include "fboss/qsfp_service/QsfpServiceHandler.h"
+#include "fboss/qsfp_service/platforms/wedge/tests/MockWedgeManager.h"
+#include "fboss/qsfp_service/test/FakeConfigsHelper.h"
+
+#include <folly/Synchronized.h>
+#include <folly/experimental/TestUtil.h>
+#include <thrift/lib/cpp2/util/ScopedServerInterfaceThread.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+DECLARE_string(qsfp_service_host);
+DECLARE_int32(qsfp_service_port);
+
+using namespace facebook::fboss;
+using namespace ::testing;
+
+namespace {
+
+constexpr int kNumModules = 16;
+
+TransceiverInfo presentTransceiver(int32_t id) {
+  TransceiverInfo info;
+  info.present_ref() = true;
+  info.port_ref() = id;
+  return info;
+}
+
+/*
+ * Serves scripted transceiver info streams, one per subscription.
+ */
+class FakeQsfpService : public QsfpServiceSvIf {
+ public:
+  explicit FakeQsfpService(std::vector<std::vector<TransceiverInfoUpdate>> s)
+      : streams_(std::move(s)) {}
+
+  ~FakeQsfpService() override {
+    auto publishers = std::move(*publishers_.wlock());
+    for (auto& publisher : publishers) {
+      std::move(publisher).complete();
+    }
+  }
+
+  apache::thrift::ServerStream<TransceiverInfoUpdate> subscribeTransceiverInfo()
+      override {
+    auto streamAndPublisher =
+        apache::thrift::ServerStream<TransceiverInfoUpdate>::createPublisher(
+            [] {});
+    auto subscription = numSubscriptions_++;
+    for (const auto& update : streams_.at(subscription)) {
+      streamAndPublisher.second.next(update);
+    }
+    publishers_.wlock()->push_back(std::move(streamAndPublisher.second));
+    return std::move(streamAndPublisher.first);
+  }
+
+  int numSubscriptions() const {
+    return numSubscriptions_.load();
+  }
+
+ private:
+  std::vector<std::vector<TransceiverInfoUpdate>> streams_;
+  std::atomic<int> numSubscriptions_{0};
+  folly::Synchronized<
+      std::vector<apache::thrift::ServerStreamPublisher<TransceiverInfoUpdate>>>
+      publishers_;
+};
+
+template <typename Condition>
+bool waitFor(Condition condition) {
+  for (int retries = 0; retries < 500; ++retries) {
+    if (condition()) {
+      return true;
+    }
+    /* sleep override */
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return false;
+}
+
+class QsfpCacheStreamTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setupFakeAgentConfig(tmpDir_.path().string() + "/fakeAgentConfig");
+    setupFakeQsfpConfig(tmpDir_.path().string() + "/fakeQsfpConfig");
+    gflags::SetCommandLineOptionWithMode(
+        "qsfp_data_refresh_interval", "0", gflags::SET_FLAGS_DEFAULT);
+
+    // A qsfp_service running in process, over mock transceivers
+    auto manager =
+        std::make_unique<NiceMock<MockWedgeManager>>(kNumModules, 4);
+    manager->initTransceiverMap();
+    manager_ = manager.get();
+    handler_ = std::make_shared<QsfpServiceHandler>(std::move(manager), nullptr);
+    serve(handler_);
+  }
+
+  void TearDown() override {
+    cache_.reset();
+    server_.reset();
+  }
+
+ protected:
+  void serve(std::shared_ptr<apache::thrift::ServerInterface> handler) {
+    server_ =
+        std::make_unique<apache::thrift::ScopedServerInterfaceThread>(handler);
+    FLAGS_qsfp_service_host = "::1";
+    FLAGS_qsfp_service_port = server_->getPort();
+  }
+
+  bool cached(int32_t id) {
+    return cache_->getIf(TransceiverID(id)).has_value();
+  }
+
+  bool allCached() {
+    for (int32_t id = 0; id < kNumModules; ++id) {
+      if (!cached(id)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  folly::test::TemporaryDirectory tmpDir_;
+  MockWedgeManager* manager_{nullptr};
+  std::shared_ptr<QsfpServiceHandler> handler_;
+  std::unique_ptr<apache::thrift::ScopedServerInterfaceThread> server_;
+  std::unique_ptr<AutoInitQsfpCache> cache_;
+};
+
+} // namespace
+
+TEST_F(QsfpCacheStreamTest, fullUpdateOnSubscribe) {
+  cache_ = std::make_unique<AutoInitQsfpCache>();
+  EXPECT_TRUE(waitFor([this] { return allCached(); }));
+  EXPECT_EQ(*cache_->get(TransceiverID(3)).port_ref(), 3);
+}
+
+TEST_F(QsfpCacheStreamTest, transceiverChangesStreamed) {
+  cache_ = std::make_unique<AutoInitQsfpCache>();
+  ASSERT_TRUE(waitFor([this] { return allCached(); }));
+
+  // Transceiver 4 (module 5) goes away
+  manager_->overridePresence(5, false);
+  manager_->refreshTransceivers();
+  handler_->publishTransceiverInfoChanges();
+  EXPECT_TRUE(waitFor([this] { return !cached(4); }));
+
+  // and comes back
+  manager_->overridePresence(5, true);
+  manager_->refreshTransceivers();
+  handler_->publishTransceiverInfoChanges();
+  EXPECT_TRUE(waitFor([this] { return allCached(); }));
+}
+
+TEST_F(QsfpCacheStreamTest, multipleSubscribers) {
+  cache_ = std::make_unique<AutoInitQsfpCache>();
+  ASSERT_TRUE(waitFor([this] { return allCached(); }));
+
+  // A second subscriber starts at the same generation as the first one, and
+  // both see later changes
+  manager_->overridePresence(2, false);
+  manager_->refreshTransceivers();
+  AutoInitQsfpCache otherCache;
+  EXPECT_TRUE(waitFor([&otherCache] {
+    return otherCache.getIf(TransceiverID(0)).has_value() &&
+        !otherCache.getIf(TransceiverID(1)).has_value();
+  }));
+  EXPECT_TRUE(waitFor([this] { return !cached(1); }));
+
+  manager_->overridePresence(2, true);
+  manager_->refreshTransceivers();
+  handler_->publishTransceiverInfoChanges();
+  EXPECT_TRUE(waitFor([this] { return cached(1); }));
+  EXPECT_TRUE(waitFor(
+      [&otherCache] { return otherCache.getIf(TransceiverID(1)).has_value(); }));
+}
+
+TEST_F(QsfpCacheStreamTest, resubscribeOnGap) {
+  auto update = [](int64_t generation, bool full, std::vector<int32_t> ids) {
+    TransceiverInfoUpdate update;
+    update.generation_ref() = generation;
+    update.full_ref() = full;
+    for (auto id : ids) {
+      update.changed_ref()->emplace(id, presentTransceiver(id));
+    }
+    return update;
+  };
+  // Generation 2 is missing from the first stream
+  auto fakeService = std::make_shared<FakeQsfpService>(
+      std::vector<std::vector<TransceiverInfoUpdate>>{
+          {update(1, true, {0}), update(3, false, {1})},
+          {update(7, true, {2, 3}), update(8, false, {4})},
+      });
+  serve(fakeService);
+
+  cache_ = std::make_unique<AutoInitQsfpCache>();
+  EXPECT_TRUE(waitFor([this] { return cached(4); }));
+  EXPECT_EQ(fakeService->numSubscriptions(), 2);
+  // Only the second full update and what followed it are cached
+  EXPECT_FALSE(cached(0));
+  EXPECT_FALSE(cached(1));
+  EXPECT_TRUE(cached(2));
+  EXPECT_TRUE(cached(3));
+}
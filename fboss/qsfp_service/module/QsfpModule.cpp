@@ -27,6 +27,20 @@ DEFINE_int32(
     qsfp_data_refresh_interval,
     10,
     "how often to refetch qsfp data that changes frequently");
+DEFINE_int32(
+    passive_cable_data_refresh_interval,
+    60,
+    "how often to refetch data of passive copper cables, which have no DOM");
+DEFINE_int32(
+    qsfp_static_page_ttl,
+    3600,
+    "seconds before re-reading upper pages holding static data, which are "
+    "otherwise only re-read when the module is replaced or reset");
+DEFINE_int32(
+    qsfp_dom_page_ttl,
+    0,
+    "seconds before re-reading upper pages holding DOM data. 0 re-reads "
+    "them on every data refresh");
 DEFINE_int32(
     customize_interval,
     30,
@@ -162,6 +176,67 @@ void QsfpModule::getQsfpValue(
   memcpy(data, ptr, length);
 }
 
+void QsfpModule::readFromModuleLocked(
+    int dataAddress,
+    int offset,
+    int length,
+    uint8_t* data) {
+  qsfpImpl_->readTransceiver(dataAddress, offset, length, data);
+  pageCacheStats_.bytesRead += length;
+  StatsPublisher::bumpI2cBytesRead(length);
+}
+
+bool QsfpModule::readUpperPageLocked(
+    uint8_t page,
+    PageType type,
+    int length,
+    uint8_t* data) {
+  auto now = std::time(nullptr);
+  auto ttl = type == PageType::STATIC ? FLAGS_qsfp_static_page_ttl
+                                      : FLAGS_qsfp_dom_page_ttl;
+  auto& entry = pageCache_[page];
+  if (entry.valid && entry.type == type && now - entry.lastRead < ttl) {
+    ++pageCacheStats_.hits;
+    StatsPublisher::bumpPageCacheHit();
+    return false;
+  }
+  // Invalidate first, a failed read must not leave a half updated page
+  // marked as valid
+  entry.valid = false;
+  // If we have flat memory, we don't have to set the page
+  if (!flatMem_) {
+    qsfpImpl_->writeTransceiver(
+        TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
+  }
+  readFromModuleLocked(TransceiverI2CApi::ADDR_QSFP, 128, length, data);
+  entry.type = type;
+  entry.lastRead = now;
+  entry.valid = true;
+  ++pageCacheStats_.misses;
+  StatsPublisher::bumpPageCacheMiss();
+  return true;
+}
+
+void QsfpModule::invalidatePageCacheLocked() {
+  pageCache_.clear();
+}
+
+bool QsfpModule::staticPagesExpiredLocked() const {
+  auto now = std::time(nullptr);
+  for (const auto& [page, entry] : pageCache_) {
+    if (entry.type == PageType::STATIC && entry.valid &&
+        now - entry.lastRead >= FLAGS_qsfp_static_page_ttl) {
+      return true;
+    }
+  }
+  return false;
+}
+
+QsfpModule::PageCacheStats QsfpModule::getPageCacheStats() const {
+  lock_guard<std::mutex> g(qsfpModuleMutex_);
+  return pageCacheStats_;
+}
+
 // Note that this needs to be called while holding the
 // qsfpModuleMutex_
 bool QsfpModule::cacheIsValid() const {
@@ -191,6 +266,7 @@ bool QsfpModule::detectPresenceLocked() {
     dirty_ = true;
     present_ = currentQsfpStatus;
     moduleResetCounter_ = 0;
+    invalidatePageCacheLocked();
 
     // If a transceiver went from present to missing, clear the cached data.
     if (!present_) {
@@ -248,6 +324,9 @@ TransceiverInfo QsfpModule::parseDataLocked() {
   }
 
   if (auto transceiverStats = getTransceiverStats()) {
+    transceiverStats->i2cBytesRead_ref() = pageCacheStats_.bytesRead;
+    transceiverStats->pageCacheHits_ref() = pageCacheStats_.hits;
+    transceiverStats->pageCacheMisses_ref() = pageCacheStats_.misses;
     info.stats_ref() = *transceiverStats;
   }
   info.signalFlag_ref() = getSignalFlagInfo();
@@ -321,6 +400,15 @@ bool QsfpModule::shouldRefresh(time_t cooldown) const {
   return std::time(nullptr) - lastRefreshTime_ >= cooldown;
 }
 
+time_t QsfpModule::dataRefreshInterval() const {
+  if (getQsfpTransmitterTechnology() == TransmitterTechnology::COPPER) {
+    return std::max(
+        FLAGS_qsfp_data_refresh_interval,
+        FLAGS_passive_cable_data_refresh_interval);
+  }
+  return FLAGS_qsfp_data_refresh_interval;
+}
+
 void QsfpModule::ensureOutOfReset() const {
   qsfpImpl_->ensureOutOfReset();
   XLOG(DBG3) << "Cleared the reset register of QSFP.";
@@ -469,6 +557,10 @@ void QsfpModule::refresh() {
   refreshLocked();
 }
 
+folly::EventBase* QsfpModule::getI2cEventBase() {
+  return qsfpImpl_->getI2cEventBase();
+}
+
 folly::Future<folly::Unit> QsfpModule::futureRefresh() {
   auto i2cEvb = qsfpImpl_->getI2cEventBase();
   if (!i2cEvb) {
@@ -496,7 +588,9 @@ void QsfpModule::refreshLocked() {
 
   bool newTransceiverDetected = false;
   auto customizeWanted = customizationWanted(FLAGS_customize_interval);
-  auto willRefresh = !dirty_ && shouldRefresh(FLAGS_qsfp_data_refresh_interval);
+  auto willRefresh = !dirty_ && shouldRefresh(dataRefreshInterval());
+  // Static pages are only read on full updates, do one once they expire
+  auto staticPagesExpired = willRefresh && staticPagesExpiredLocked();
   if (!dirty_ && !customizeWanted && !willRefresh) {
     return;
   }
@@ -526,6 +620,7 @@ void QsfpModule::refreshLocked() {
 
     if (shouldRemediate(FLAGS_remediate_interval)) {
       remediateFlakyTransceiver();
+      invalidatePageCacheLocked();
       ++numRemediation_;
     }
   }
@@ -546,7 +641,7 @@ void QsfpModule::refreshLocked() {
     // these fields are in the LOWER qsfp page. There are a small
     // number of writable fields on other qsfp pages, but we don't
     // currently use them.
-    updateQsfpData(false);
+    updateQsfpData(staticPagesExpired);
   }
 
   // assign
@@ -711,6 +806,8 @@ bool QsfpModule::writeTransceiverLocked(
     }
     qsfpImpl_->writeTransceiver(
         TransceiverI2CApi::ADDR_QSFP, offset, sizeof(data), &data);
+    // Raw writes may change any page behind our back
+    invalidatePageCacheLocked();
   } catch (const std::exception& ex) {
     XLOG(ERR) << "Error writing data to transceiver:"
               << folly::to<std::string>(qsfpImpl_->getName()) << ": "
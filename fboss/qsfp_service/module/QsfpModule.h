@@ -8,7 +8,9 @@
  *
  */
 #pragma once
+#include <atomic>
 #include <cstdint>
+#include <map>
 #include <mutex>
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/lib/link_snapshots/SnapshotManager-defs.h"
@@ -83,6 +85,10 @@ class QsfpModule : public Transceiver {
 
   virtual void refresh() override;
   folly::Future<folly::Unit> futureRefresh() override;
+  folly::EventBase* getI2cEventBase() override;
+  bool needsFullRefresh() const override {
+    return dirty_;
+  }
 
   /*
    * Customize QSPF fields as necessary
@@ -221,6 +227,15 @@ class QsfpModule : public Transceiver {
     return diagsCapability_;
   }
 
+  struct PageCacheStats {
+    // Bytes read from the module over I2C by cache refreshes
+    uint64_t bytesRead{0};
+    uint64_t hits{0};
+    uint64_t misses{0};
+  };
+
+  PageCacheStats getPageCacheStats() const;
+
   /*
    * Verifies the Optics module register checksum from EEPROM
    */
@@ -253,8 +268,9 @@ class QsfpModule : public Transceiver {
   std::unique_ptr<TransceiverImpl> qsfpImpl_;
   // QSFP Presence status
   bool present_{false};
-  // Denotes if the cache value is valid or stale
-  bool dirty_{true};
+  // Denotes if the cache value is valid or stale. Atomic so that refresh
+  // scheduling can peek at it without waiting for qsfpModuleMutex_
+  std::atomic<bool> dirty_{true};
   // Flat memory systems don't support paged access to extra data
   bool flatMem_{false};
   // This transceiver needs customization
@@ -294,6 +310,30 @@ class QsfpModule : public Transceiver {
   // Diagnostic capabilities of the module
   std::optional<DiagsCapability> diagsCapability_;
 
+  /*
+   * Upper pages either hold static data (vendor info, thresholds,
+   * advertised capabilities) that only changes when the module is swapped,
+   * or DOM data that is refreshed on every cache refresh. Each kind has its
+   * own TTL, see FLAGS_qsfp_static_page_ttl and FLAGS_qsfp_dom_page_ttl.
+   */
+  enum class PageType {
+    STATIC,
+    DOM,
+  };
+
+  struct PageCacheEntry {
+    PageType type{PageType::STATIC};
+    time_t lastRead{0};
+    bool valid{false};
+  };
+
+  /*
+   * Per upper page read time and validity. These MUST be accessed holding
+   * qsfpModuleMutex_.
+   */
+  std::map<uint8_t, PageCacheEntry> pageCache_;
+  PageCacheStats pageCacheStats_;
+
   /*
    * This function will return the local module port id for the given system
    * port id. The local module port id is used to index into PSM instance
@@ -317,6 +357,37 @@ class QsfpModule : public Transceiver {
    */
   virtual const uint8_t*
   getQsfpValuePtr(int dataAddress, int offset, int length) const = 0;
+  /*
+   * Read from the module and account the bytes read. The thread needs to
+   * have the lock before calling this function.
+   */
+  void readFromModuleLocked(
+      int dataAddress,
+      int offset,
+      int length,
+      uint8_t* data);
+  /*
+   * Read the upper page 'page' into data, unless the copy read earlier is
+   * still within the TTL for its page type. Selects the page first on paged
+   * memory. Returns true if the page was read from the module. The thread
+   * needs to have the lock before calling this function.
+   */
+  bool readUpperPageLocked(
+      uint8_t page,
+      PageType type,
+      int length,
+      uint8_t* data);
+  /*
+   * Forget every cached upper page, so that the next refresh reads them
+   * from the module again. Called when the module may have changed under
+   * us: presence changes, read errors, resets and raw writes.
+   */
+  void invalidatePageCacheLocked();
+  /*
+   * Returns true if any static page has outlived FLAGS_qsfp_static_page_ttl
+   * and needs a full refresh to be read again.
+   */
+  bool staticPagesExpiredLocked() const;
   /*
    * This function returns the values on the offset and length
    * from the static cached data. The thread needs to have the lock
@@ -485,6 +556,13 @@ class QsfpModule : public Transceiver {
    */
   bool shouldRefresh(time_t cooldown) const;
 
+  /*
+   * How often the DOM data of this module needs refreshing. Passive
+   * copper cables have no DOM to monitor, so they are refreshed less
+   * often than optics.
+   */
+  virtual time_t dataRefreshInterval() const;
+
   /*
    * In the case of Minipack using Facebook FPGA, we need to clear the reset
    * register of QSFP whenever it is newly inserted.
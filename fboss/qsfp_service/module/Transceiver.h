@@ -15,6 +15,7 @@
 #include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
 
 #include <folly/futures/Future.h>
+#include <folly/io/async/EventBase.h>
 
 namespace facebook {
 namespace fboss {
@@ -53,6 +54,24 @@ class Transceiver {
   virtual void refresh() = 0;
   virtual folly::Future<folly::Unit> futureRefresh() = 0;
 
+  /*
+   * EventBase of the I2C controller this transceiver sits behind, nullptr
+   * if it shares the platform's single I2C bus with all other transceivers.
+   * Used to refresh transceivers behind different controllers in parallel.
+   */
+  virtual folly::EventBase* getI2cEventBase() {
+    return nullptr;
+  }
+
+  /*
+   * Whether the next refresh will read the whole EEPROM, static pages
+   * included, e.g. because the transceiver was just inserted. Such
+   * refreshes are scheduled behind DOM only refreshes on the same bus.
+   */
+  virtual bool needsFullRefresh() const {
+    return false;
+  }
+
   /*
    * Return all of the transceiver information
    */
@@ -1358,7 +1358,7 @@ void CmisModule::updateQsfpData(bool allPages) {
     XLOG(DBG2) << "Performing " << ((allPages) ? "full" : "partial")
                << " qsfp data cache refresh for transceiver "
                << folly::to<std::string>(qsfpImpl_->getName());
-    qsfpImpl_->readTransceiver(
+    readFromModuleLocked(
         TransceiverI2CApi::ADDR_QSFP, 0, sizeof(lowerPage_), lowerPage_);
     lastRefreshTime_ = std::time(nullptr);
     dirty_ = false;
@@ -1370,29 +1370,17 @@ void CmisModule::updateQsfpData(bool allPages) {
       setLegacyModuleStateMachineCmisModuleReady(false);
     }
 
-    // If we have flat memory, we don't have to set the page
+    // Page 0 only holds static vendor and media info, the page cache makes
+    // sure we only read it again once it expires or the module changes.
+    readUpperPageLocked(0x00, PageType::STATIC, sizeof(page0_), page0_);
     if (!flatMem_) {
-      uint8_t page = 0x00;
-      qsfpImpl_->writeTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-    }
-    qsfpImpl_->readTransceiver(
-        TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page0_), page0_);
-    if (!flatMem_) {
-      uint8_t page = 0x10;
-      qsfpImpl_->writeTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page10_), page10_);
-
-      page = 0x11;
-      qsfpImpl_->writeTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page11_), page11_);
+      readUpperPageLocked(0x10, PageType::DOM, sizeof(page10_), page10_);
+      readUpperPageLocked(0x11, PageType::DOM, sizeof(page11_), page11_);
 
       if (getLegacyModuleStateMachineCmisModuleReady()) {
-        page = 0x14;
+        // The SNR diagnostics are latched by the diagFeature write, so this
+        // page is never served from the page cache.
+        uint8_t page = 0x14;
         auto diagFeature = (uint8_t)DiagnosticFeatureEncoding::SNR;
         qsfpImpl_->writeTransceiver(
             TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
@@ -1401,33 +1389,14 @@ void CmisModule::updateQsfpData(bool allPages) {
             128,
             sizeof(diagFeature),
             &diagFeature);
-        qsfpImpl_->readTransceiver(
+        readFromModuleLocked(
             TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page14_), page14_);
 
         if (isVdmSupported()) {
-          page = 0x20;
-          qsfpImpl_->writeTransceiver(
-              TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-          qsfpImpl_->readTransceiver(
-              TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page20_), page20_);
-
-          page = 0x21;
-          qsfpImpl_->writeTransceiver(
-              TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-          qsfpImpl_->readTransceiver(
-              TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page21_), page21_);
-
-          page = 0x24;
-          qsfpImpl_->writeTransceiver(
-              TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-          qsfpImpl_->readTransceiver(
-              TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page24_), page24_);
-
-          page = 0x25;
-          qsfpImpl_->writeTransceiver(
-              TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-          qsfpImpl_->readTransceiver(
-              TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page25_), page25_);
+          readUpperPageLocked(0x20, PageType::DOM, sizeof(page20_), page20_);
+          readUpperPageLocked(0x21, PageType::DOM, sizeof(page21_), page21_);
+          readUpperPageLocked(0x24, PageType::DOM, sizeof(page24_), page24_);
+          readUpperPageLocked(0x25, PageType::DOM, sizeof(page25_), page25_);
         }
       }
     }
@@ -1435,33 +1404,20 @@ void CmisModule::updateQsfpData(bool allPages) {
     if (!allPages) {
       // The information on the following pages are static. Thus no need to
       // fetch them every time. We just need to do it when we first retriving
-      // the data from this module.
+      // the data from this module, or once the cached copy expires.
       return;
     }
 
     if (!flatMem_) {
-      uint8_t page = 0x01;
-      qsfpImpl_->writeTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page01_), page01_);
-
-      page = 0x02;
-      qsfpImpl_->writeTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page02_), page02_);
-
-      page = 0x13;
-      qsfpImpl_->writeTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page13_), page13_);
+      readUpperPageLocked(0x01, PageType::STATIC, sizeof(page01_), page01_);
+      readUpperPageLocked(0x02, PageType::STATIC, sizeof(page02_), page02_);
+      readUpperPageLocked(0x13, PageType::STATIC, sizeof(page13_), page13_);
     }
   } catch (const std::exception& ex) {
     // No matter what kind of exception throws, we need to set the dirty_ flag
     // to true.
     dirty_ = true;
+    invalidatePageCacheLocked();
     XLOG(ERR) << "Error update data for transceiver:"
               << folly::to<std::string>(qsfpImpl_->getName()) << ": "
               << ex.what();
@@ -845,7 +845,7 @@ void SffModule::updateQsfpData(bool allPages) {
     XLOG(DBG2) << "Performing " << ((allPages) ? "full" : "partial")
                << " qsfp data cache refresh for transceiver "
                << folly::to<std::string>(qsfpImpl_->getName());
-    qsfpImpl_->readTransceiver(
+    readFromModuleLocked(
         TransceiverI2CApi::ADDR_QSFP, 0, sizeof(lowerPage_), lowerPage_);
     lastRefreshTime_ = std::time(nullptr);
     dirty_ = false;
@@ -860,25 +860,17 @@ void SffModule::updateQsfpData(bool allPages) {
       return;
     }
 
-    // If we have flat memory, we don't have to set the page
+    // Both pages are static, the page cache skips them (and the slow page
+    // select writes) unless they expired or the module changed.
+    readUpperPageLocked(0, PageType::STATIC, sizeof(page0_), page0_);
     if (!flatMem_) {
-      uint8_t page = 0;
-      qsfpImpl_->writeTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-    }
-    qsfpImpl_->readTransceiver(
-        TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page0_), page0_);
-    if (!flatMem_) {
-      uint8_t page = 3;
-      qsfpImpl_->writeTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 127, sizeof(page), &page);
-      qsfpImpl_->readTransceiver(
-          TransceiverI2CApi::ADDR_QSFP, 128, sizeof(page3_), page3_);
+      readUpperPageLocked(3, PageType::STATIC, sizeof(page3_), page3_);
     }
   } catch (const std::exception& ex) {
     // No matter what kind of exception throws, we need to set the dirty_ flag
     // to true.
     dirty_ = true;
+    invalidatePageCacheLocked();
     XLOG(ERR) << "Error update data for transceiver:"
               << folly::to<std::string>(qsfpImpl_->getName()) << ": "
               << ex.what();
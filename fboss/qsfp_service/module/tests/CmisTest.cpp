@@ -23,6 +23,9 @@
 using namespace facebook::fboss;
 using std::make_unique;
 
+DECLARE_int32(qsfp_data_refresh_interval);
+DECLARE_int32(qsfp_static_page_ttl);
+
 namespace {
 
 // Tests that the transceiverInfo object is correctly populated
@@ -413,6 +416,35 @@ TEST(CmisTest, testOpticsRemoval) {
   EXPECT_EQ(CurrState, 0);
 }
 
+// Static pages are served from the page cache until they expire
+TEST(CmisTest, pageCacheSkipsStaticPages) {
+  gflags::FlagSaver saver;
+  FLAGS_qsfp_data_refresh_interval = 0;
+  int idx = 1;
+  std::unique_ptr<CmisModule> xcvr = std::make_unique<CmisModule>(
+      nullptr, std::make_unique<Cmis200GTransceiver>(idx), 4);
+
+  // First refresh reads every page
+  xcvr->refresh();
+  auto fullRead = xcvr->getPageCacheStats();
+  EXPECT_EQ(fullRead.hits, 0u);
+  EXPECT_GT(fullRead.misses, 0u);
+
+  // DOM refresh only re-reads the lower page and DOM pages
+  xcvr->refresh();
+  auto domRead = xcvr->getPageCacheStats();
+  EXPECT_GT(domRead.hits, fullRead.hits);
+  EXPECT_LT(domRead.bytesRead - fullRead.bytesRead, fullRead.bytesRead);
+
+  // Expired static pages 00h, 01h, 02h and 13h get read again
+  FLAGS_qsfp_static_page_ttl = 0;
+  xcvr->refresh();
+  auto expiredRead = xcvr->getPageCacheStats();
+  EXPECT_GE(
+      expiredRead.misses - domRead.misses,
+      domRead.misses - fullRead.misses + 4);
+}
+
 TEST(Cmis400GLr4Test, transceiverInfoTest) {
   int idx = 1;
   std::unique_ptr<Cmis400GLr4Transceiver> qsfpImpl =
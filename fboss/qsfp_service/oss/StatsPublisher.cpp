@@ -26,5 +26,11 @@ void StatsPublisher::missingPorts(TransceiverID /* unused */) {}
 void StatsPublisher::bumpModuleErrors() {}
 // static
 void StatsPublisher::bumpAOIOverride() {}
+// static
+void StatsPublisher::bumpI2cBytesRead(uint64_t /* unused */) {}
+// static
+void StatsPublisher::bumpPageCacheHit() {}
+// static
+void StatsPublisher::bumpPageCacheMiss() {}
 } // namespace fboss
 } // namespace facebook
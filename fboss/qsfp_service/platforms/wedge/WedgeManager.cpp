@@ -25,6 +25,7 @@
 #include <folly/logging/xlog.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 #include <chrono>
+#include <map>
 
 // allow us to configure the qsfp_service dir so that the qsfp cold boot test
 // can run concurrently with itself
@@ -452,18 +453,16 @@ std::vector<TransceiverID> WedgeManager::refreshTransceivers() {
 
   // Use block to set the scope of the rlock of transceivers_
   {
-    std::vector<folly::Future<folly::Unit>> futs;
+    std::vector<Transceiver*> transceivers;
     XLOG(INFO) << "Start refreshing all transceivers...";
 
     auto lockedTransceivers = transceivers_.rlock();
     for (const auto& transceiver : *lockedTransceivers) {
-      XLOG(DBG3) << "Fired to refresh transceiver "
-                 << transceiver.second->getID();
       transceiverIds.push_back(TransceiverID(transceiver.second->getID()));
-      futs.push_back(transceiver.second->futureRefresh());
+      transceivers.push_back(transceiver.second.get());
     }
 
-    folly::collectAll(futs.begin(), futs.end()).wait();
+    refreshTransceiversByBus(transceivers);
     XLOG(INFO) << "Finished refreshing all transceivers";
   }
 
@@ -471,6 +470,53 @@ std::vector<TransceiverID> WedgeManager::refreshTransceivers() {
   return transceiverIds;
 }
 
+void WedgeManager::refreshTransceiversByBus(
+    const std::vector<Transceiver*>& transceivers) {
+  // Refreshes reading static pages take much longer than DOM only ones,
+  // queue them last on each bus so they don't hold up their neighbours
+  std::map<folly::EventBase*, std::vector<Transceiver*>> busToTransceivers;
+  std::vector<Transceiver*> fullRefreshes;
+  for (auto transceiver : transceivers) {
+    if (transceiver->needsFullRefresh()) {
+      fullRefreshes.push_back(transceiver);
+    } else {
+      busToTransceivers[transceiver->getI2cEventBase()].push_back(transceiver);
+    }
+  }
+  for (auto transceiver : fullRefreshes) {
+    busToTransceivers[transceiver->getI2cEventBase()].push_back(transceiver);
+  }
+  auto refresh = [](const std::vector<Transceiver*>& busTransceivers) {
+    for (auto transceiver : busTransceivers) {
+      try {
+        transceiver->refresh();
+      } catch (const std::exception& ex) {
+        XLOG(DBG2) << "Transceiver " << static_cast<int>(transceiver->getID())
+                   << ": Error calling refresh(): " << ex.what();
+      }
+    }
+  };
+
+  std::vector<folly::Future<folly::Unit>> futs;
+  for (const auto& [evb, busTransceivers] : busToTransceivers) {
+    if (evb) {
+      XLOG(DBG3) << "Fired to refresh " << busTransceivers.size()
+                 << " transceivers behind I2C controller " << evb;
+      futs.push_back(folly::via(evb).thenValue(
+          [&busTransceivers = busTransceivers, refresh](auto&&) {
+            refresh(busTransceivers);
+          }));
+    }
+  }
+  // Transceivers on the shared bus are refreshed here, while the I2C
+  // controllers work through theirs
+  if (auto it = busToTransceivers.find(nullptr);
+      it != busToTransceivers.end()) {
+    refresh(it->second);
+  }
+  folly::collectAll(futs.begin(), futs.end()).wait();
+}
+
 int WedgeManager::scanTransceiverPresence(
     std::unique_ptr<std::vector<int32_t>> ids) {
   // If the id list is empty, we default to scan the presence of all the
@@ -64,6 +64,17 @@ class WedgeManager : public TransceiverManager {
   }
   std::vector<TransceiverID> refreshTransceivers() override;
 
+  /*
+   * Refresh the given transceivers and wait for all refreshes to finish.
+   * Transceivers behind the same I2C controller are refreshed back to back
+   * on that controller's EventBase, with DOM only refreshes ahead of full
+   * EEPROM reads. Different controllers are refreshed in parallel, and
+   * transceivers on the shared bus are refreshed in the calling thread
+   * meanwhile.
+   */
+  static void refreshTransceiversByBus(
+      const std::vector<Transceiver*>& transceivers);
+
   int scanTransceiverPresence(
       std::unique_ptr<std::vector<int32_t>> ids) override;
 
@@ -0,0 +1,279 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/qsfp_service/module/cmis/CmisModule.h"
+#include "fboss/qsfp_service/module/tests/FakeTransceiverImpl.h"
+#include "fboss/qsfp_service/platforms/wedge/WedgeManager.h"
+
+#include <folly/Synchronized.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
+#include <folly/logging/xlog.h>
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace facebook::fboss;
+
+namespace {
+constexpr auto kNumBuses = 4;
+// Transceivers without an I2C controller, refreshed in the calling thread
+constexpr auto kSharedBus = kNumBuses;
+constexpr auto kModulesPerBus = 8;
+constexpr auto kReadLatency = std::chrono::microseconds(200);
+// Long enough for every bus to get to its first read on a loaded test host
+constexpr auto kRendezvousTimeout = std::chrono::seconds(10);
+
+/*
+ * Reads of all modules, which bus they went through and how many reads
+ * were in flight at once.
+ */
+class ReadLog {
+ public:
+  /*
+   * Have the first read on each bus wait for numBuses buses to be reading
+   * at once, so a refresh that doesn't run buses concurrently never gets
+   * there.
+   */
+  void setRendezvous(int numBuses) {
+    rendezvous_ = numBuses;
+    for (auto& met : rendezvousMet_) {
+      met = false;
+    }
+  }
+
+  void startRead(int bus, int module) {
+    reads_.wlock()->push_back(module);
+    busReads_[bus].wlock()->push_back(module);
+    auto inFlight = ++inFlight_[bus];
+    updateMax(maxInFlightOnABus_, inFlight);
+    if (inFlight == 1) {
+      updateMax(maxBusesReading_, ++busesReading_);
+    }
+    if (rendezvous_ && !rendezvousMet_[bus].exchange(true)) {
+      auto deadline = std::chrono::steady_clock::now() + kRendezvousTimeout;
+      while (maxBusesReading_.load() < rendezvous_ &&
+             std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  void endRead(int bus) {
+    if (--inFlight_[bus] == 0) {
+      --busesReading_;
+    }
+  }
+
+  void clear() {
+    reads_.wlock()->clear();
+    for (auto& busReads : busReads_) {
+      busReads.wlock()->clear();
+    }
+    maxInFlightOnABus_ = 0;
+    maxBusesReading_ = 0;
+  }
+
+  std::vector<int> reads() const {
+    return reads_.copy();
+  }
+
+  // Modules read through bus, each listed once per run of back to back reads
+  std::vector<int> busModules(int bus) const {
+    auto modules = busReads_[bus].copy();
+    modules.erase(std::unique(modules.begin(), modules.end()), modules.end());
+    return modules;
+  }
+
+  int maxInFlightOnABus() const {
+    return maxInFlightOnABus_;
+  }
+
+  int maxBusesReading() const {
+    return maxBusesReading_;
+  }
+
+ private:
+  static void updateMax(std::atomic<int>& max, int value) {
+    auto cur = max.load();
+    while (cur < value && !max.compare_exchange_weak(cur, value)) {
+    }
+  }
+
+  folly::Synchronized<std::vector<int>> reads_;
+  std::array<folly::Synchronized<std::vector<int>>, kNumBuses + 1> busReads_;
+  std::array<std::atomic<int>, kNumBuses + 1> inFlight_{};
+  std::array<std::atomic<bool>, kNumBuses + 1> rendezvousMet_{};
+  std::atomic<int> busesReading_{0};
+  std::atomic<int> maxInFlightOnABus_{0};
+  std::atomic<int> maxBusesReading_{0};
+  std::atomic<int> rendezvous_{0};
+};
+
+/*
+ * CMIS module behind an I2C controller, where every read takes
+ * kReadLatency.
+ */
+class SlowCmisTransceiver : public Cmis200GTransceiver {
+ public:
+  SlowCmisTransceiver(
+      int module,
+      int bus,
+      folly::EventBase* evb,
+      ReadLog* readLog)
+      : Cmis200GTransceiver(module), bus_(bus), evb_(evb), readLog_(readLog) {}
+
+  int readTransceiver(int dataAddress, int offset, int len, uint8_t* fieldValue)
+      override {
+    readLog_->startRead(bus_, getNum());
+    std::this_thread::sleep_for(kReadLatency);
+    auto ret = Cmis200GTransceiver::readTransceiver(
+        dataAddress, offset, len, fieldValue);
+    readLog_->endRead(bus_);
+    return ret;
+  }
+
+  folly::EventBase* getI2cEventBase() override {
+    return evb_;
+  }
+
+ private:
+  int bus_;
+  folly::EventBase* evb_;
+  ReadLog* readLog_;
+};
+
+class WedgeManagerRefreshStressTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    gflags::SetCommandLineOption("qsfp_data_refresh_interval", "0");
+    for (auto bus = 0; bus < kNumBuses; ++bus) {
+      busThreads_.push_back(std::make_unique<folly::ScopedEventBaseThread>());
+    }
+  }
+
+  // Returns the modules added, in order
+  std::vector<int> addModules(int numModules, int bus) {
+    auto evb =
+        bus == kSharedBus ? nullptr : busThreads_[bus]->getEventBase();
+    std::vector<int> added;
+    for (auto i = 0; i < numModules; ++i) {
+      int module = modules_.size();
+      modules_.push_back(std::make_unique<CmisModule>(
+          nullptr,
+          std::make_unique<SlowCmisTransceiver>(module, bus, evb, &readLog_),
+          4));
+      added.push_back(module);
+    }
+    return added;
+  }
+
+  std::vector<Transceiver*> transceivers() const {
+    std::vector<Transceiver*> transceivers;
+    for (const auto& module : modules_) {
+      transceivers.push_back(module.get());
+    }
+    return transceivers;
+  }
+
+  template <typename Fn>
+  std::chrono::milliseconds timeRefreshCycle(Fn fn) {
+    auto begin = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - begin);
+  }
+
+ protected:
+  gflags::FlagSaver flagSaver_;
+  std::vector<std::unique_ptr<folly::ScopedEventBaseThread>> busThreads_;
+  std::vector<std::unique_ptr<CmisModule>> modules_;
+  ReadLog readLog_;
+};
+} // namespace
+
+TEST_F(WedgeManagerRefreshStressTest, parallelBusesRefreshCycle) {
+  std::vector<std::vector<int>> busModules;
+  for (auto bus = 0; bus < kNumBuses; ++bus) {
+    busModules.push_back(addModules(kModulesPerBus, bus));
+  }
+  // First refresh reads the whole EEPROM of every module
+  auto fullCycle = timeRefreshCycle(
+      [this]() { WedgeManager::refreshTransceiversByBus(transceivers()); });
+
+  readLog_.clear();
+  auto serialCycle = timeRefreshCycle([this]() {
+    for (auto transceiver : transceivers()) {
+      transceiver->refresh();
+    }
+  });
+  EXPECT_EQ(1, readLog_.maxBusesReading());
+  readLog_.clear();
+  readLog_.setRendezvous(kNumBuses);
+  auto parallelCycle = timeRefreshCycle(
+      [this]() { WedgeManager::refreshTransceiversByBus(transceivers()); });
+
+  XLOG(INFO) << kNumBuses << " buses x " << kModulesPerBus
+             << " modules, refresh cycle time: full read "
+             << fullCycle.count() << "ms, serial DOM refresh "
+             << serialCycle.count() << "ms, per bus DOM refresh "
+             << parallelCycle.count() << "ms";
+  // All buses were read concurrently, one read at a time on each of them
+  EXPECT_EQ(kNumBuses, readLog_.maxBusesReading());
+  EXPECT_EQ(1, readLog_.maxInFlightOnABus());
+  // Every bus refreshed its modules back to back, in order
+  for (auto bus = 0; bus < kNumBuses; ++bus) {
+    EXPECT_EQ(busModules[bus], readLog_.busModules(bus));
+  }
+}
+
+TEST_F(WedgeManagerRefreshStressTest, sharedBusRefreshCycle) {
+  auto sharedBusModules = addModules(kModulesPerBus, kSharedBus);
+  auto controllerModules = addModules(kModulesPerBus, 0);
+  WedgeManager::refreshTransceiversByBus(transceivers());
+  readLog_.clear();
+  // The shared bus is refreshed while the I2C controller works
+  readLog_.setRendezvous(2);
+
+  auto cycle = timeRefreshCycle(
+      [this]() { WedgeManager::refreshTransceiversByBus(transceivers()); });
+  XLOG(INFO) << "Shared bus and one I2C controller with " << kModulesPerBus
+             << " modules each, refresh cycle time: " << cycle.count()
+             << "ms";
+
+  EXPECT_EQ(2, readLog_.maxBusesReading());
+  EXPECT_EQ(1, readLog_.maxInFlightOnABus());
+  EXPECT_EQ(sharedBusModules, readLog_.busModules(kSharedBus));
+  EXPECT_EQ(controllerModules, readLog_.busModules(0));
+}
+
+TEST_F(WedgeManagerRefreshStressTest, domRefreshesBeforeFullReads) {
+  addModules(kModulesPerBus, 0);
+  WedgeManager::refreshTransceiversByBus(transceivers());
+
+  // Newly inserted module, listed first but needing a full EEPROM read
+  int newModule = addModules(1, 0).front();
+  std::rotate(modules_.begin(), modules_.end() - 1, modules_.end());
+  EXPECT_TRUE(modules_.front()->needsFullRefresh());
+  readLog_.clear();
+
+  WedgeManager::refreshTransceiversByBus(transceivers());
+  auto reads = readLog_.reads();
+  auto firstNewModuleRead = std::find(reads.begin(), reads.end(), newModule);
+  ASSERT_NE(firstNewModuleRead, reads.end());
+  EXPECT_TRUE(std::all_of(firstNewModuleRead, reads.end(), [=](int module) {
+    return module == newModule;
+  }));
+}